@@ -11,6 +11,7 @@ namespace torch_ipex {
 namespace cpu {
 
 DEFINE_DISPATCH(add_layer_norm_kernel_stub);
+DEFINE_DISPATCH(add_layer_norm_quantize_kernel_stub);
 
 at::Tensor AddLayerNorm(
     const at::Tensor& a,
@@ -57,5 +58,60 @@ at::Tensor dil_add_layernorm(
     return at::layer_norm(add_res, normalized_shape, weight_opt, bias_opt, eps);
   }
 }
+
+std::tuple<at::Tensor, at::Tensor> dil_add_layernorm_quantize(
+    const at::Tensor& a,
+    const at::Tensor& b,
+    const at::Scalar& alpha,
+    at::IntArrayRef normalized_shape,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    float eps,
+    double q_scale,
+    int64_t q_zero_point,
+    at::ScalarType q_dtype,
+    bool output_float) {
+  RECORD_FUNCTION("dil_add_layernorm_quantize", c10::ArrayRef<c10::IValue>({}));
+
+  // same constraints as dil_add_layernorm, plus a hidden size of at least
+  // one vector for the kernel
+  bool fusable = a.sizes() == b.sizes() && a.is_contiguous() &&
+      b.is_contiguous() && alpha.to<double>() == 1.0 &&
+      a.scalar_type() == b.scalar_type() &&
+      (a.scalar_type() == at::kFloat || a.scalar_type() == at::kBFloat16) &&
+      (q_dtype == at::kQUInt8 || q_dtype == at::kQInt8) &&
+      !normalized_shape.empty() && normalized_shape.back() >= 16;
+  // gamma and beta are read with one dtype, FP32 or the one of the input
+  for (const auto& t : {weight_opt, bias_opt}) {
+    if (t.has_value() && t->defined()) {
+      fusable = fusable &&
+          (t->scalar_type() == at::kFloat ||
+           t->scalar_type() == a.scalar_type());
+    }
+  }
+  if (weight_opt.has_value() && weight_opt->defined() && bias_opt.has_value() &&
+      bias_opt->defined()) {
+    fusable = fusable && weight_opt->scalar_type() == bias_opt->scalar_type();
+  }
+  if (fusable) {
+    return add_layer_norm_quantize_kernel_stub(
+        kCPU,
+        a,
+        b,
+        normalized_shape,
+        weight_opt,
+        bias_opt,
+        eps,
+        q_scale,
+        q_zero_point,
+        q_dtype,
+        output_float);
+  }
+  auto y = at::layer_norm(
+      at::add(a, b, alpha), normalized_shape, weight_opt, bias_opt, eps);
+  auto y_q = at::quantize_per_tensor(y, q_scale, q_zero_point, q_dtype);
+  return std::make_tuple(output_float ? y : at::Tensor(), y_q);
+}
+
 } // namespace cpu
 } // namespace torch_ipex
@@ -81,6 +81,24 @@ at::Tensor dil_add_layernorm(
     float eps,
     bool cuda_enable);
 
+/**
+ * add + layernorm + quantize_per_tensor in one pass over the hidden state.
+ * Returns the layernorm output (undefined unless output_float is set) and the
+ * quantized output (kQUInt8 or kQInt8 with the given scale and zero point).
+ * */
+std::tuple<at::Tensor, at::Tensor> dil_add_layernorm_quantize(
+    const at::Tensor& a,
+    const at::Tensor& b,
+    const at::Scalar& alpha,
+    at::IntArrayRef normalized_shape,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    float eps,
+    double q_scale,
+    int64_t q_zero_point,
+    at::ScalarType q_dtype,
+    bool output_float);
+
 namespace {
 
 at::Tensor add_layer_norm_kernel_impl(
@@ -91,6 +109,18 @@ at::Tensor add_layer_norm_kernel_impl(
     const c10::optional<at::Tensor>& weight_opt,
     const c10::optional<at::Tensor>& bias_opt,
     float eps);
+
+std::tuple<at::Tensor, at::Tensor> add_layer_norm_quantize_kernel_impl(
+    const at::Tensor& a,
+    const at::Tensor& b,
+    at::IntArrayRef normalized_shape,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    float eps,
+    double q_scale,
+    int64_t q_zero_point,
+    at::ScalarType q_dtype,
+    bool output_float);
 }
 
 using add_layer_norm_kernel_fn = at::Tensor (*)(
@@ -103,5 +133,21 @@ using add_layer_norm_kernel_fn = at::Tensor (*)(
     float);
 DECLARE_DISPATCH(add_layer_norm_kernel_fn, add_layer_norm_kernel_stub);
 
+using add_layer_norm_quantize_kernel_fn =
+    std::tuple<at::Tensor, at::Tensor> (*)(
+        const at::Tensor&,
+        const at::Tensor&,
+        at::IntArrayRef,
+        const c10::optional<at::Tensor>&,
+        const c10::optional<at::Tensor>&,
+        float,
+        double,
+        int64_t,
+        at::ScalarType,
+        bool);
+DECLARE_DISPATCH(
+    add_layer_norm_quantize_kernel_fn,
+    add_layer_norm_quantize_kernel_stub);
+
 } // namespace cpu
 } // namespace torch_ipex
\ No newline at end of file
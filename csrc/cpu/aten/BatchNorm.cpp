@@ -7,6 +7,9 @@
 namespace torch_ipex {
 namespace cpu {
 
+DEFINE_DISPATCH(batch_norm_relu_forward_stub);
+DEFINE_DISPATCH(batch_norm_relu_backward_stub);
+
 std::tuple<at::Tensor, at::Tensor, at::Tensor> batch_norm_forward(
     const at::Tensor& input,
     const at::Tensor& weight,
@@ -305,6 +308,206 @@ at::Tensor frozen_batch_norm(
       input, weight, bias, running_mean, running_var, false, 0, eps);
 }
 
+at::Tensor IPEXBatchNormReLUOp::forward(
+    torch::autograd::AutogradContext* ctx,
+    const at::Tensor& input,
+    const at::Tensor& other,
+    const at::Tensor& weight,
+    const at::Tensor& bias,
+    const c10::optional<at::Tensor>& running_mean_opt,
+    const c10::optional<at::Tensor>& running_var_opt,
+    double momentum,
+    double eps) {
+  RECORD_FUNCTION(
+      "IPEXBatchNormReLUOp::forward", c10::ArrayRef<c10::IValue>({}));
+
+  const int64_t C = input.size(1);
+  const int64_t M = input.numel() / C;
+  auto output = at::empty_like(input, input.suggest_memory_format());
+  auto mean = at::empty({C}, weight.options().dtype(at::kFloat));
+  auto var = at::empty({C}, weight.options().dtype(at::kFloat));
+  auto mask = at::empty(
+      batch_norm_relu_mask_size(input), input.options().dtype(at::kByte));
+  batch_norm_relu_forward_stub(
+      kCPU,
+      input,
+      other,
+      weight.to(at::kFloat),
+      bias.to(at::kFloat),
+      eps,
+      output,
+      mean,
+      var,
+      mask);
+
+  {
+    at::NoGradGuard no_grad;
+    if (running_mean_opt.has_value() && running_mean_opt.value().defined()) {
+      auto running_mean = running_mean_opt.value();
+      running_mean.mul_(1 - momentum).add_(mean, momentum);
+    }
+    if (running_var_opt.has_value() && running_var_opt.value().defined()) {
+      // the running var is unbiased
+      auto running_var = running_var_opt.value();
+      running_var.mul_(1 - momentum)
+          .add_(var, momentum * M / std::max<int64_t>(M - 1, 1));
+    }
+  }
+
+  ctx->saved_data["has_other"] = other.defined();
+  ctx->saved_data["weight_dtype"] = weight.scalar_type();
+  ctx->save_for_backward(
+      {input, mask, mean, at::rsqrt(var + eps), weight.to(at::kFloat)});
+  return output;
+}
+
+torch::autograd::variable_list IPEXBatchNormReLUOp::backward(
+    torch::autograd::AutogradContext* ctx,
+    torch::autograd::variable_list grad_outputs) {
+  RECORD_FUNCTION(
+      "IPEXBatchNormReLUOp::backward", c10::ArrayRef<c10::IValue>({}));
+
+  auto saved = ctx->get_saved_variables();
+  at::Tensor input = saved[0];
+  at::Tensor mask = saved[1];
+  at::Tensor mean = saved[2];
+  at::Tensor invstd = saved[3];
+  at::Tensor weight = saved[4];
+  auto weight_dtype = ctx->saved_data["weight_dtype"].toScalarType();
+
+  auto grad_output =
+      grad_outputs[0].contiguous(input.suggest_memory_format());
+  auto grad_input = at::empty_like(input, input.suggest_memory_format());
+  auto grad_other = ctx->saved_data["has_other"].toBool()
+      ? at::empty_like(input, input.suggest_memory_format())
+      : at::Tensor();
+  auto grad_weight = at::empty_like(weight);
+  auto grad_bias = at::empty_like(weight);
+  batch_norm_relu_backward_stub(
+      kCPU,
+      grad_output,
+      input,
+      mask,
+      mean,
+      invstd,
+      weight,
+      grad_input,
+      grad_other,
+      grad_weight,
+      grad_bias);
+  return {
+      grad_input,
+      grad_other,
+      grad_weight.to(weight_dtype),
+      grad_bias.to(weight_dtype),
+      at::Tensor(),
+      at::Tensor(),
+      at::Tensor(),
+      at::Tensor()};
+}
+
+static bool use_fused_batch_norm_relu(
+    const at::Tensor& input,
+    const at::Tensor& other,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    bool train) {
+  if (!train || (input.dim() != 4 && input.dim() != 5) || input.numel() == 0) {
+    return false;
+  }
+  if (input.scalar_type() != at::kFloat &&
+      input.scalar_type() != at::kBFloat16) {
+    return false;
+  }
+  auto memory_format = input.dim() == 4 ? at::MemoryFormat::ChannelsLast
+                                        : at::MemoryFormat::ChannelsLast3d;
+  if (!input.is_contiguous(memory_format)) {
+    return false;
+  }
+  if (!weight_opt.has_value() || !weight_opt.value().defined() ||
+      !bias_opt.has_value() || !bias_opt.value().defined()) {
+    return false;
+  }
+  return !other.defined() ||
+      (other.sizes() == input.sizes() &&
+       other.scalar_type() == input.scalar_type() &&
+       other.is_contiguous(memory_format));
+}
+
+at::Tensor batch_norm_relu(
+    const at::Tensor& input,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    const c10::optional<at::Tensor>& running_mean_opt,
+    const c10::optional<at::Tensor>& running_var_opt,
+    bool train,
+    double momentum,
+    double eps) {
+  RECORD_FUNCTION(
+      "torch_ipex::batch_norm_relu", c10::ArrayRef<c10::IValue>({}));
+
+  if (use_fused_batch_norm_relu(
+          input, at::Tensor(), weight_opt, bias_opt, train)) {
+    return IPEXBatchNormReLUOp::apply(
+        input,
+        at::Tensor(),
+        weight_opt.value(),
+        bias_opt.value(),
+        running_mean_opt,
+        running_var_opt,
+        momentum,
+        eps);
+  }
+  return at::relu(at::batch_norm(
+      input,
+      weight_opt,
+      bias_opt,
+      running_mean_opt,
+      running_var_opt,
+      train,
+      momentum,
+      eps,
+      false));
+}
+
+at::Tensor batch_norm_add_relu(
+    const at::Tensor& input,
+    const at::Tensor& other,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    const c10::optional<at::Tensor>& running_mean_opt,
+    const c10::optional<at::Tensor>& running_var_opt,
+    bool train,
+    double momentum,
+    double eps) {
+  RECORD_FUNCTION(
+      "torch_ipex::batch_norm_add_relu", c10::ArrayRef<c10::IValue>({}));
+
+  if (use_fused_batch_norm_relu(input, other, weight_opt, bias_opt, train)) {
+    return IPEXBatchNormReLUOp::apply(
+        input,
+        other,
+        weight_opt.value(),
+        bias_opt.value(),
+        running_mean_opt,
+        running_var_opt,
+        momentum,
+        eps);
+  }
+  return at::relu(
+      at::batch_norm(
+          input,
+          weight_opt,
+          bias_opt,
+          running_mean_opt,
+          running_var_opt,
+          train,
+          momentum,
+          eps,
+          false) +
+      other);
+}
+
 } // namespace cpu
 } // namespace torch_ipex
 
@@ -363,6 +566,30 @@ TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
       "batch_norm_backward",
       c10::DispatchKey::CPU,
       torch_ipex::cpu::batch_norm_backward);
+  m.def(
+      "batch_norm_relu(Tensor input, Tensor? weight, Tensor? bias, Tensor? "
+      "running_mean, Tensor? running_var, bool train, float momentum, float "
+      "eps) -> Tensor");
+  m.impl(
+      "batch_norm_relu",
+      c10::DispatchKey::AutogradCPU,
+      torch_ipex::cpu::batch_norm_relu);
+  m.impl(
+      "batch_norm_relu",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::batch_norm_relu);
+  m.def(
+      "batch_norm_add_relu(Tensor input, Tensor other, Tensor? weight, Tensor? "
+      "bias, Tensor? running_mean, Tensor? running_var, bool train, float "
+      "momentum, float eps) -> Tensor");
+  m.impl(
+      "batch_norm_add_relu",
+      c10::DispatchKey::AutogradCPU,
+      torch_ipex::cpu::batch_norm_add_relu);
+  m.impl(
+      "batch_norm_add_relu",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::batch_norm_add_relu);
 }
 
 } // namespace
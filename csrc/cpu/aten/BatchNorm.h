@@ -2,6 +2,7 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Tensor.h>
+#include <dyndisp/DispatchStub.h>
 #include <torch/csrc/autograd/custom_function.h>
 
 #include <ideep.hpp>
@@ -27,5 +28,93 @@ class IPEXBatchNormOp : public torch::autograd::Function<IPEXBatchNormOp> {
       torch::autograd::variable_list grad_outputs);
 };
 
+// Y = relu(batch_norm(X) (+ other)) with batch statistics, channels last
+// only. Writes the per channel batch mean and biased var, and one bit per
+// element of Y into mask (see batch_norm_relu_mask_size).
+using batch_norm_relu_forward_fn = void (*)(
+    const at::Tensor& /* X */,
+    const at::Tensor& /* other */,
+    const at::Tensor& /* weight */,
+    const at::Tensor& /* bias */,
+    double /* eps */,
+    at::Tensor& /* Y */,
+    at::Tensor& /* mean */,
+    at::Tensor& /* var */,
+    at::Tensor& /* mask */);
+
+// Writes dX and, if other was added in the forward, dother.
+using batch_norm_relu_backward_fn = void (*)(
+    const at::Tensor& /* dY */,
+    const at::Tensor& /* X */,
+    const at::Tensor& /* mask */,
+    const at::Tensor& /* mean */,
+    const at::Tensor& /* invstd */,
+    const at::Tensor& /* weight */,
+    at::Tensor& /* dX */,
+    at::Tensor& /* dother */,
+    at::Tensor& /* dweight */,
+    at::Tensor& /* dbias */);
+
+DECLARE_DISPATCH(batch_norm_relu_forward_fn, batch_norm_relu_forward_stub);
+DECLARE_DISPATCH(batch_norm_relu_backward_fn, batch_norm_relu_backward_stub);
+
+// The ReLU mask holds one bit per channel, rounded up to whole bytes per
+// {n, spatial} row.
+inline std::vector<int64_t> batch_norm_relu_mask_size(const at::Tensor& input) {
+  return {input.numel() / input.size(1), (input.size(1) + 7) / 8};
+}
+
+// Fused BatchNorm + ReLU (+ residual add) for training. Only the batch mean,
+// invstd and a ReLU mask bitmap are saved for the backward besides the input,
+// which the backward of the batch norm needs anyway.
+class IPEXBatchNormReLUOp
+    : public torch::autograd::Function<IPEXBatchNormReLUOp> {
+ public:
+  static at::Tensor forward(
+      torch::autograd::AutogradContext* ctx,
+      const at::Tensor& input,
+      const at::Tensor& other,
+      const at::Tensor& weight,
+      const at::Tensor& bias,
+      const c10::optional<at::Tensor>& running_mean_opt,
+      const c10::optional<at::Tensor>& running_var_opt,
+      double momentum,
+      double eps);
+
+  static torch::autograd::variable_list backward(
+      torch::autograd::AutogradContext* ctx,
+      torch::autograd::variable_list grad_outputs);
+};
+
+/**
+ * relu(batch_norm(input)). The fused kernels cover training on FP32/BF16
+ * channels last 4D/5D inputs with affine parameters, anything else runs the
+ * unfused ops.
+ */
+at::Tensor batch_norm_relu(
+    const at::Tensor& input,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    const c10::optional<at::Tensor>& running_mean_opt,
+    const c10::optional<at::Tensor>& running_var_opt,
+    bool train,
+    double momentum,
+    double eps);
+
+/**
+ * relu(batch_norm(input) + other), the tail of a ResNet block. The fused path
+ * additionally requires other to have the shape and dtype of input.
+ */
+at::Tensor batch_norm_add_relu(
+    const at::Tensor& input,
+    const at::Tensor& other,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    const c10::optional<at::Tensor>& running_mean_opt,
+    const c10::optional<at::Tensor>& running_var_opt,
+    bool train,
+    double momentum,
+    double eps);
+
 } // namespace cpu
 } // namespace torch_ipex
@@ -0,0 +1,144 @@
+#include <torch/all.h>
+
+#include <torch/csrc/autograd/function.h>
+#include "DynamicQuantLinear.h"
+#include "cpu/kernels/OpContext.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+DEFINE_DISPATCH(dynamic_quant_linear_kernel_stub);
+
+DynamicQuantPostOp dynamic_quant_post_op(const std::string& post_op) {
+  if (post_op == "none") {
+    return DynamicQuantPostOp::None;
+  } else if (post_op == "relu") {
+    return DynamicQuantPostOp::ReLU;
+  }
+  TORCH_CHECK(
+      post_op == "gelu",
+      "Dynamic quantized linear supports \"none\", \"relu\" and \"gelu\" "
+      "post ops, but got ",
+      post_op);
+  return DynamicQuantPostOp::GELU;
+}
+
+std::tuple<at::Tensor, at::Tensor, at::Tensor> dynamic_quant_linear_pack_weight(
+    const at::Tensor& weight,
+    bool per_channel) {
+  TORCH_CHECK(
+      weight.dim() == 2 && weight.size(1) > 0,
+      "Dynamic quantized linear expects a non-empty 2-D weight");
+  auto N = weight.size(0);
+  auto K = weight.size(1);
+  auto Kp = (K + kDqKGroup - 1) / kDqKGroup * kDqKGroup;
+  auto blocks = (N + kDqNBlock - 1) / kDqNBlock;
+
+  auto w = weight.to(at::kFloat);
+  auto amax = per_channel ? w.abs().amax(1) : w.abs().max().expand({N});
+  auto scales = amax.div(127.f);
+  // all-zero channels get scale 1 to avoid dividing by zero
+  scales.masked_fill_(scales == 0, 1.f);
+  auto q = w.div(scales.unsqueeze(1)).round_().clamp_(-127, 127);
+
+  // pad N to whole blocks and K to whole groups with zeros, which neither
+  // change the dot products nor the compensation
+  auto q_padded = at::zeros({blocks * kDqNBlock, Kp}, at::kFloat);
+  q_padded.narrow(0, 0, N).narrow(1, 0, K).copy_(q);
+  auto compensation = q_padded.sum(1).to(at::kInt);
+  auto qweight = q_padded.to(at::kChar)
+                     .view({blocks, kDqNBlock, Kp / kDqKGroup, kDqKGroup})
+                     .permute({0, 2, 1, 3})
+                     .contiguous();
+  auto packed_scales = at::ones({blocks * kDqNBlock}, at::kFloat);
+  packed_scales.narrow(0, 0, N).copy_(scales);
+  return std::make_tuple(qweight, packed_scales, compensation);
+}
+
+at::Tensor dynamic_quant_linear_unpack_weight(
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    int64_t out_features,
+    int64_t in_features) {
+  auto Kp = qweight.size(1) * kDqKGroup;
+  return qweight.permute({0, 2, 1, 3})
+      .reshape({-1, Kp})
+      .narrow(0, 0, out_features)
+      .narrow(1, 0, in_features)
+      .to(at::kFloat)
+      .mul_(scales.narrow(0, 0, out_features).unsqueeze(1))
+      .contiguous();
+}
+
+/**
+ * Dynamic quantized linear: the activation is quantized to u8 with
+ * asymmetric per-tensor or per-token scales computed at run time, multiplied
+ * with the prepacked s8 weight in int32, and dequantized together with the
+ * bias and the post op in the epilogue.
+ *
+ *@param self Activation input for Linear
+ *@param qweight Packed s8 weight, see dynamic_quant_linear_pack_weight
+ *@param scales Padded FP32 weight scales
+ *@param compensation Padded int32 sums of the quantized weight, which remove
+ * the activation zero point from the int32 results
+ *@param bias Bias for Linear, may be undefined
+ *@param out_features Size of N-dim for Linear
+ *@param per_token Whether each row of the activation has its own scale
+ *@param post_op Eltwise applied to the output
+ */
+at::Tensor dynamic_quant_linear_kernel(
+    const at::Tensor& self,
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    const at::Tensor& compensation,
+    const at::Tensor& bias,
+    int64_t out_features,
+    bool per_token,
+    DynamicQuantPostOp post_op) {
+  TORCH_CHECK(
+      self.scalar_type() == at::kFloat || self.scalar_type() == at::kBFloat16,
+      "Dynamic quantized linear only supports FP32 and BF16 inputs");
+  auto input_size = self.sizes();
+  std::vector<int64_t> output_size(input_size.begin(), input_size.end() - 1);
+  output_size.push_back(out_features);
+  auto output = at::empty(output_size, self.options());
+  dynamic_quant_linear_kernel_stub(
+      kCPU,
+      self,
+      qweight,
+      scales,
+      compensation,
+      bias,
+      out_features,
+      per_token,
+      post_op,
+      output);
+  return output;
+}
+
+at::Tensor dynamic_quant_linear_forward(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias,
+    const at::Tensor& op_context) {
+  return reinterpret_cast<IpexDynamicQuantLinearOpContext*>(
+             op_context.data_ptr<int64_t>()[0])
+      ->run(input, DynamicQuantPostOp::None);
+}
+
+} // namespace cpu
+} // namespace torch_ipex
+
+namespace {
+
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def(
+      "ipex_dynamic_quant_linear(Tensor input, Tensor weight, Tensor? bias, "
+      "Tensor W_prepack) -> Tensor");
+  m.impl(
+      "ipex_dynamic_quant_linear",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::dynamic_quant_linear_forward);
+}
+
+} // namespace
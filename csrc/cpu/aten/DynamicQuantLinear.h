@@ -0,0 +1,97 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/Tensor.h>
+#include <dyndisp/DispatchStub.h>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace torch_ipex {
+namespace cpu {
+
+// The s8 weight is stored in blocks of kDqNBlock output channels. Inside a
+// block, the kDqKGroup values of the same output channel are contiguous and
+// the kDqNBlock groups of the same input channels follow each other, so that
+// one 64-byte load feeds one VNNI dot product of 16 output channels.
+constexpr int64_t kDqNBlock = 16;
+constexpr int64_t kDqKGroup = 4;
+
+// Eltwise fused into the epilogue of the dynamic quantized linear
+enum class DynamicQuantPostOp : int64_t {
+  None = 0,
+  ReLU = 1,
+  GELU = 2,
+};
+
+DynamicQuantPostOp dynamic_quant_post_op(const std::string& post_op);
+
+/**
+ * Quantize a 2-D [N, K] weight to s8 with symmetric per-channel or
+ * per-tensor scales, and pack it to the blocked layout used by the dynamic
+ * quantized linear kernel.
+ *
+ *@param weight FP32 or BF16 weight of the linear
+ *@param per_channel Whether each output channel has its own scale
+ *@return The packed weight, the FP32 scales and the int32 sums of the
+ * quantized weight of each output channel, the latter two padded to whole
+ * blocks
+ */
+std::tuple<at::Tensor, at::Tensor, at::Tensor> dynamic_quant_linear_pack_weight(
+    const at::Tensor& weight,
+    bool per_channel);
+
+// Dequantize a packed weight back to the public FP32 [N, K] layout.
+at::Tensor dynamic_quant_linear_unpack_weight(
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    int64_t out_features,
+    int64_t in_features);
+
+at::Tensor dynamic_quant_linear_kernel(
+    const at::Tensor& self,
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    const at::Tensor& compensation,
+    const at::Tensor& bias,
+    int64_t out_features,
+    bool per_token,
+    DynamicQuantPostOp post_op);
+
+at::Tensor dynamic_quant_linear_forward(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias,
+    const at::Tensor& op_context);
+
+namespace {
+
+void dynamic_quant_linear_kernel_impl(
+    const at::Tensor& self,
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    const at::Tensor& compensation,
+    const at::Tensor& bias,
+    int64_t out_features,
+    bool per_token,
+    DynamicQuantPostOp post_op,
+    at::Tensor& output);
+
+} // namespace
+
+using dynamic_quant_linear_kernel_fn = void (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    int64_t,
+    bool,
+    DynamicQuantPostOp,
+    at::Tensor&);
+DECLARE_DISPATCH(
+    dynamic_quant_linear_kernel_fn,
+    dynamic_quant_linear_kernel_stub);
+
+} // namespace cpu
+} // namespace torch_ipex
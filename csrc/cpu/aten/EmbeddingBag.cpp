@@ -18,6 +18,7 @@ namespace torch_ipex {
 namespace cpu {
 
 DEFINE_DISPATCH(embedding_bag_kernel_stub);
+DEFINE_DISPATCH(embedding_bag_out_kernel_stub);
 DEFINE_DISPATCH(embedding_bag_backward_kernel_stub);
 DEFINE_DISPATCH(embedding_bag_int8_kernel_stub);
 
@@ -24,6 +24,13 @@ at::Tensor embedding_bag_kernel_impl(
     const at::Tensor& offsets,
     bool include_last_offset);
 
+void embedding_bag_out_kernel_impl(
+    const at::Tensor& weight,
+    const at::Tensor& indices,
+    const at::Tensor& offsets,
+    bool include_last_offset,
+    at::Tensor& output);
+
 at::Tensor embedding_bag_backward_kernel_impl(
     const at::Tensor& grad,
     const at::Tensor& indices,
@@ -46,6 +53,16 @@ using embedding_bag_kernel_fn = at::Tensor (*)(
     bool);
 DECLARE_DISPATCH(embedding_bag_kernel_fn, embedding_bag_kernel_stub);
 
+// Forward only, writes the bags into the rows of a given [bags, dim] output
+// whose rows may be strided
+using embedding_bag_out_kernel_fn = void (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    bool,
+    at::Tensor&);
+DECLARE_DISPATCH(embedding_bag_out_kernel_fn, embedding_bag_out_kernel_stub);
+
 using embedding_bag_backward_kernel_fn = at::Tensor (*)(
     const at::Tensor&,
     const at::Tensor&,
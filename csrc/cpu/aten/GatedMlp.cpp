@@ -0,0 +1,92 @@
+#include <torch/all.h>
+
+#include "GatedMlp.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+DEFINE_DISPATCH(gated_mlp_epilogue_kernel_stub);
+
+namespace {
+
+// Row i of the interleaved tensor is row index[i] of cat({gate, up})
+at::Tensor gated_mlp_interleave_index(int64_t hidden) {
+  auto index = at::empty({2 * hidden}, at::kLong);
+  auto index_data = index.data_ptr<int64_t>();
+  for (int64_t start = 0; start < hidden; start += kGatedMlpBlock) {
+    auto block = std::min(kGatedMlpBlock, hidden - start);
+    for (int64_t j = 0; j < block; j++) {
+      index_data[2 * start + j] = start + j;
+      index_data[2 * start + block + j] = hidden + start + j;
+    }
+  }
+  return index;
+}
+
+} // namespace
+
+GatedMlpAct gated_mlp_act(const std::string& act) {
+  if (act == "silu") {
+    return GatedMlpAct::SiLU;
+  } else if (act == "gelu") {
+    return GatedMlpAct::GELU;
+  }
+  TORCH_CHECK(
+      act == "gelu_tanh",
+      "Gated MLP supports \"silu\", \"gelu\" and \"gelu_tanh\" activations, "
+      "but got ",
+      act);
+  return GatedMlpAct::GELUTanh;
+}
+
+std::string gated_mlp_act_name(GatedMlpAct act) {
+  switch (act) {
+    case GatedMlpAct::SiLU:
+      return "silu";
+    case GatedMlpAct::GELU:
+      return "gelu";
+    default:
+      return "gelu_tanh";
+  }
+}
+
+at::Tensor gated_mlp_interleave(const at::Tensor& gate, const at::Tensor& up) {
+  TORCH_CHECK(
+      gate.sizes() == up.sizes() && gate.scalar_type() == up.scalar_type(),
+      "Gated MLP expects gate and up projections of the same shape and "
+      "dtype");
+  return at::cat({gate, up}).index_select(
+      0, gated_mlp_interleave_index(gate.size(0)));
+}
+
+std::tuple<at::Tensor, at::Tensor> gated_mlp_deinterleave(
+    const at::Tensor& interleaved) {
+  auto hidden = interleaved.size(0) / 2;
+  auto gate_up = at::empty_like(interleaved);
+  gate_up.index_copy_(0, gated_mlp_interleave_index(hidden), interleaved);
+  return std::make_tuple(
+      gate_up.narrow(0, 0, hidden).contiguous(),
+      gate_up.narrow(0, hidden, hidden).contiguous());
+}
+
+void gated_mlp_epilogue(
+    const at::Tensor& gate_up,
+    GatedMlpAct act,
+    at::Tensor& output) {
+  TORCH_CHECK(
+      gate_up.dim() == 2 && output.dim() == 2 &&
+          gate_up.size(0) == output.size(0) &&
+          gate_up.size(1) == 2 * output.size(1),
+      "Gated MLP epilogue expects [M, 2 * H] gate_up and [M, H] output");
+  TORCH_CHECK(
+      gate_up.scalar_type() == output.scalar_type() &&
+          (output.scalar_type() == at::kFloat ||
+           output.scalar_type() == at::kBFloat16),
+      "Gated MLP only supports FP32 and BF16");
+  TORCH_INTERNAL_ASSERT(gate_up.is_contiguous() && output.is_contiguous());
+  // pointer to gated_mlp_epilogue_kernel_impl(gate_up, act, output)
+  gated_mlp_epilogue_kernel_stub(kCPU, gate_up, act, output);
+}
+
+} // namespace cpu
+} // namespace torch_ipex
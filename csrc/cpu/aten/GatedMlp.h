@@ -0,0 +1,53 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include <dyndisp/DispatchStub.h>
+
+#include <string>
+
+namespace torch_ipex {
+namespace cpu {
+
+// Gated MLP of transformer FFNs, act(x W_gate^T) * (x W_up^T), e.g. SwiGLU
+// with act = SiLU and GeGLU with act = GELU.
+enum class GatedMlpAct { SiLU, GELU, GELUTanh };
+
+// "silu", "gelu" or "gelu_tanh"
+GatedMlpAct gated_mlp_act(const std::string& act);
+std::string gated_mlp_act_name(GatedMlpAct act);
+
+// The output channels of the gate and up projections are interleaved in
+// blocks of kGatedMlpBlock channels, [gate block 0, up block 0, gate block 1,
+// ...], so that a single GEMM computes both and the epilogue reads a gate
+// value and its up value from neighbouring cache lines.
+constexpr int64_t kGatedMlpBlock = 64;
+
+// [H, ...] gate and up weights or biases -> [2 * H, ...] interleaved
+at::Tensor gated_mlp_interleave(const at::Tensor& gate, const at::Tensor& up);
+
+// Inverse of gated_mlp_interleave, returns the gate and the up halves
+std::tuple<at::Tensor, at::Tensor> gated_mlp_deinterleave(
+    const at::Tensor& interleaved);
+
+// output[m, h] = act(gate[m, h]) * up[m, h] of the interleaved [M, 2 * H]
+// gate_up into the [M, H] output
+void gated_mlp_epilogue(
+    const at::Tensor& gate_up,
+    GatedMlpAct act,
+    at::Tensor& output);
+
+namespace {
+
+void gated_mlp_epilogue_kernel_impl(
+    const at::Tensor& gate_up,
+    GatedMlpAct act,
+    at::Tensor& output);
+
+}
+
+using gated_mlp_epilogue_kernel_fn =
+    void (*)(const at::Tensor&, GatedMlpAct, at::Tensor&);
+DECLARE_DISPATCH(gated_mlp_epilogue_kernel_fn, gated_mlp_epilogue_kernel_stub);
+
+} // namespace cpu
+} // namespace torch_ipex
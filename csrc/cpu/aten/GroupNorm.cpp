@@ -21,6 +21,7 @@ namespace cpu {
 
 DEFINE_DISPATCH(GroupNormKernel);
 DEFINE_DISPATCH(GroupNormBackwardKernel);
+DEFINE_DISPATCH(GroupNormSiLUKernel);
 
 std::tuple<at::Tensor, at::Tensor, at::Tensor> native_group_norm(
     const at::Tensor& X,
@@ -202,6 +203,128 @@ at::Tensor group_norm(
       at::native_group_norm(X, gamma, beta, N, C, HxW, num_groups, eps));
 }
 
+namespace {
+
+bool is_group_norm_silu_fusable(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const at::Tensor& bias,
+    const at::Tensor& other) {
+  if (!input.device().is_cpu() ||
+      (input.scalar_type() != at::kFloat &&
+       input.scalar_type() != at::kBFloat16)) {
+    return false;
+  }
+  auto memory_format = input.suggest_memory_format();
+  if (memory_format != at::MemoryFormat::ChannelsLast &&
+      memory_format != at::MemoryFormat::ChannelsLast3d) {
+    return false;
+  }
+  for (const auto& t : {weight, bias}) {
+    if (t.defined() && t.scalar_type() != input.scalar_type()) {
+      return false;
+    }
+  }
+  return !other.defined() ||
+      (other.sizes() == input.sizes() &&
+       other.scalar_type() == input.scalar_type());
+}
+
+at::Tensor group_norm_silu_impl(
+    const at::Tensor& input,
+    int64_t num_groups,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    double eps,
+    const at::Tensor& other) {
+  c10::MaybeOwned<at::Tensor> weight_maybe_owned =
+      at::borrow_from_optional_tensor(weight_opt);
+  const at::Tensor& weight = *weight_maybe_owned;
+  const at::Tensor& bias =
+      c10::value_or_else(bias_opt, [] { return at::Tensor(); });
+
+  if (!is_group_norm_silu_fusable(input, weight, bias, other)) {
+    auto Y = at::silu(at::group_norm(input, num_groups, weight, bias, eps));
+    return other.defined() ? at::add(Y, other) : Y;
+  }
+
+  const int64_t N = input.size(0);
+  const int64_t C = input.size(1);
+  TORCH_CHECK(
+      C % num_groups == 0,
+      "Expected number of channels in input to be divisible by ",
+      "num_groups, but got input of shape ",
+      input.sizes(),
+      " and num_groups=",
+      num_groups);
+  TORCH_CHECK(
+      !weight.defined() || (weight.dim() == 1 && weight.numel() == C),
+      "Expected weight to be a vector of size equal to the number of ",
+      "channels in input, but got weight of shape ",
+      weight.sizes(),
+      " and input of shape ",
+      input.sizes());
+  TORCH_CHECK(
+      !bias.defined() || (bias.dim() == 1 && bias.numel() == C),
+      "Expected bias to be a vector of size equal to the number of ",
+      "channels in input, but got bias of shape ",
+      bias.sizes(),
+      " and input of shape ",
+      input.sizes());
+  const auto input_shape = input.sizes();
+  const int64_t HxW =
+      c10::multiply_integers(input_shape.cbegin() + 2, input_shape.cend());
+
+  auto memory_format = input.suggest_memory_format();
+  auto X = input.contiguous(memory_format);
+  auto gamma = weight.defined() ? weight.contiguous() : weight;
+  auto beta = bias.defined() ? bias.contiguous() : bias;
+  auto residual = other.defined() ? other.contiguous(memory_format) : other;
+  auto Y = at::empty_like(X, memory_format);
+  GroupNormSiLUKernel(
+      kCPU, X, gamma, beta, residual, N, C, HxW, num_groups, eps, Y);
+  return Y;
+}
+
+} // namespace
+
+at::Tensor group_norm_silu(
+    const at::Tensor& input,
+    int64_t num_groups,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    double eps) {
+#if defined(IPEX_DISP_OP)
+  printf("torch_ipex::group_norm_silu\n");
+#endif
+  RECORD_FUNCTION(
+      "torch_ipex::group_norm_silu", c10::ArrayRef<c10::IValue>({}));
+  return group_norm_silu_impl(
+      input, num_groups, weight_opt, bias_opt, eps, at::Tensor());
+}
+
+at::Tensor group_norm_silu_add(
+    const at::Tensor& input,
+    int64_t num_groups,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    double eps,
+    const at::Tensor& other,
+    const at::Scalar& alpha) {
+#if defined(IPEX_DISP_OP)
+  printf("torch_ipex::group_norm_silu_add\n");
+#endif
+  RECORD_FUNCTION(
+      "torch_ipex::group_norm_silu_add", c10::ArrayRef<c10::IValue>({}));
+  if (alpha.to<double>() != 1.0) {
+    auto Y = group_norm_silu_impl(
+        input, num_groups, weight_opt, bias_opt, eps, at::Tensor());
+    return at::add(Y, other, alpha);
+  }
+  return group_norm_silu_impl(
+      input, num_groups, weight_opt, bias_opt, eps, other);
+}
+
 IPEX_TORCH_LIBRARY_IMPL(aten, CPU, m) {
   m.impl(
       TORCH_SELECTIVE_NAME("aten::group_norm"),
@@ -35,8 +35,48 @@ using backward_fn = void (*)(
     at::Tensor& /* dgamma */,
     at::Tensor& /* dbeta */);
 
+// Y = silu(group_norm(X)) (+ other if other is defined), channels last only
+using silu_forward_fn = void (*)(
+    const at::Tensor& /* X */,
+    const at::Tensor& /* gamma */,
+    const at::Tensor& /* beta */,
+    const at::Tensor& /* other */,
+    int64_t /* N */,
+    int64_t /* C */,
+    int64_t /* HxW */,
+    int64_t /* group */,
+    double /* eps */,
+    at::Tensor& /* Y */);
+
 DECLARE_DISPATCH(forward_fn, GroupNormKernel);
 DECLARE_DISPATCH(backward_fn, GroupNormBackwardKernel);
+DECLARE_DISPATCH(silu_forward_fn, GroupNormSiLUKernel);
+
+/**
+ * Fused GroupNorm + SiLU, saves the extra pass of the SiLU over the
+ * activation. Falls back to the unfused ops for inputs not in channels last
+ * or not in FP32/BF16.
+ */
+at::Tensor group_norm_silu(
+    const at::Tensor& input,
+    int64_t num_groups,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    double eps);
+
+/**
+ * Fused GroupNorm + SiLU + residual add: silu(group_norm(input)) + alpha *
+ * other. The fused path requires other to have the same shape and dtype as
+ * input and alpha to be 1.
+ */
+at::Tensor group_norm_silu_add(
+    const at::Tensor& input,
+    int64_t num_groups,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    double eps,
+    const at::Tensor& other,
+    const at::Scalar& alpha);
 
 } // namespace cpu
 } // namespace torch_ipex
\ No newline at end of file
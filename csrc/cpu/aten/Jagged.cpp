@@ -0,0 +1,409 @@
+#include "Jagged.h"
+#include "Cumsum.h"
+
+#include <ATen/Parallel.h>
+#include <ATen/Tensor.h>
+#include <c10/util/Exception.h>
+#include <c10/util/Optional.h>
+#include <torch/csrc/autograd/custom_function.h>
+#include <torch/csrc/autograd/function.h>
+#include <torch/csrc/autograd/variable.h>
+
+/*
+ Custom ops on the jagged tensors of recommendation input pipelines
+*/
+
+namespace torch_ipex {
+namespace cpu {
+
+DEFINE_DISPATCH(jagged_to_padded_dense_kernel_stub);
+DEFINE_DISPATCH(dense_to_jagged_kernel_stub);
+DEFINE_DISPATCH(jagged_index_select_kernel_stub);
+DEFINE_DISPATCH(jagged_index_add_kernel_stub);
+DEFINE_DISPATCH(segment_sum_kernel_stub);
+DEFINE_DISPATCH(segment_sum_backward_kernel_stub);
+
+namespace {
+
+void check_offsets(const at::Tensor& offsets, const char* name) {
+  TORCH_CHECK(
+      offsets.dim() == 1 && offsets.numel() >= 1,
+      name,
+      ": expected non-empty 1-D offsets");
+  TORCH_CHECK(
+      offsets.scalar_type() == at::kInt || offsets.scalar_type() == at::kLong,
+      name,
+      ": expected int32 or int64 offsets, but got ",
+      offsets.scalar_type());
+}
+
+// [total] or [total, D] values -> contiguous [total, D]
+at::Tensor values_2d(const at::Tensor& values, const char* name) {
+  TORCH_CHECK(
+      values.dim() == 1 || values.dim() == 2,
+      name,
+      ": expected 1-D or 2-D values, but got ",
+      values.dim(),
+      "-D");
+  auto values_ = values.contiguous();
+  return values.dim() == 1 ? values_.view({-1, 1}) : values_;
+}
+
+// Jagged values of total rows, they are zero initialized if the segments of
+// offsets do not cover all of them
+at::Tensor empty_values(
+    const at::Tensor& offsets,
+    int64_t total,
+    int64_t D,
+    const at::TensorOptions& options) {
+  bool covered = offsets[0].item<int64_t>() == 0 &&
+      offsets[-1].item<int64_t>() == total;
+  return covered ? at::empty({total, D}, options)
+                 : at::zeros({total, D}, options);
+}
+
+at::Tensor _jagged_to_padded_dense(
+    const at::Tensor& values,
+    const at::Tensor& offsets,
+    int64_t max_length,
+    double padding_value) {
+  auto dense = at::empty(
+      {offsets.numel() - 1, max_length, values.size(1)}, values.options());
+  /*
+  pointer to jagged_to_padded_dense_kernel_impl(
+      values, offsets, padding_value, dense);
+  */
+  jagged_to_padded_dense_kernel_stub(
+      kCPU, values, offsets, padding_value, dense);
+  return dense;
+}
+
+at::Tensor _dense_to_jagged(
+    const at::Tensor& dense,
+    const at::Tensor& offsets,
+    int64_t total) {
+  auto values = empty_values(offsets, total, dense.size(2), dense.options());
+  // pointer to dense_to_jagged_kernel_impl(dense, offsets, values);
+  dense_to_jagged_kernel_stub(kCPU, dense, offsets, values);
+  return values;
+}
+
+} // namespace
+
+// Both directions are the backward of each other: the padding does not get
+// a grad and the rows truncated by max_length get a zero grad.
+class JaggedToPaddedDenseOp
+    : public torch::autograd::Function<JaggedToPaddedDenseOp> {
+ public:
+  static at::Tensor forward(
+      torch::autograd::AutogradContext* ctx,
+      const at::Tensor& values,
+      const at::Tensor& offsets,
+      int64_t max_length,
+      double padding_value) {
+    RECORD_FUNCTION(
+        "IPEXJaggedToPaddedDenseOp::forward", c10::ArrayRef<c10::IValue>({}));
+
+    at::AutoNonVariableTypeMode g;
+    ctx->saved_data["total"] = values.size(0);
+    ctx->save_for_backward({offsets});
+    return _jagged_to_padded_dense(
+        values, offsets, max_length, padding_value);
+  }
+
+  static torch::autograd::tensor_list backward(
+      torch::autograd::AutogradContext* ctx,
+      torch::autograd::tensor_list grad_outputs) {
+    RECORD_FUNCTION(
+        "IPEXJaggedToPaddedDenseOp::backward", c10::ArrayRef<c10::IValue>({}));
+
+    at::AutoNonVariableTypeMode g;
+    auto offsets = ctx->get_saved_variables()[0];
+    int64_t total = ctx->saved_data["total"].toInt();
+    return {
+        _dense_to_jagged(grad_outputs[0].contiguous(), offsets, total),
+        at::Tensor(),
+        at::Tensor(),
+        at::Tensor()};
+  }
+};
+
+class DenseToJaggedOp : public torch::autograd::Function<DenseToJaggedOp> {
+ public:
+  static at::Tensor forward(
+      torch::autograd::AutogradContext* ctx,
+      const at::Tensor& dense,
+      const at::Tensor& offsets,
+      int64_t total) {
+    RECORD_FUNCTION(
+        "IPEXDenseToJaggedOp::forward", c10::ArrayRef<c10::IValue>({}));
+
+    at::AutoNonVariableTypeMode g;
+    ctx->saved_data["max_length"] = dense.size(1);
+    ctx->save_for_backward({offsets});
+    return _dense_to_jagged(dense, offsets, total);
+  }
+
+  static torch::autograd::tensor_list backward(
+      torch::autograd::AutogradContext* ctx,
+      torch::autograd::tensor_list grad_outputs) {
+    RECORD_FUNCTION(
+        "IPEXDenseToJaggedOp::backward", c10::ArrayRef<c10::IValue>({}));
+
+    at::AutoNonVariableTypeMode g;
+    auto offsets = ctx->get_saved_variables()[0];
+    int64_t max_length = ctx->saved_data["max_length"].toInt();
+    return {
+        _jagged_to_padded_dense(
+            grad_outputs[0].contiguous(), offsets, max_length, 0.0),
+        at::Tensor(),
+        at::Tensor()};
+  }
+};
+
+class JaggedIndexSelectOp
+    : public torch::autograd::Function<JaggedIndexSelectOp> {
+ public:
+  static at::Tensor _forward(
+      const at::Tensor& values,
+      const at::Tensor& input_offsets,
+      const at::Tensor& indices,
+      const at::Tensor& output_offsets) {
+    RECORD_FUNCTION(
+        "IPEXJaggedIndexSelectOp::_forward", c10::ArrayRef<c10::IValue>({}));
+
+    auto output = at::empty(
+        {output_offsets[-1].item<int64_t>(), values.size(1)},
+        values.options());
+    /*
+    pointer to jagged_index_select_kernel_impl(
+        values, input_offsets, indices, output_offsets, output);
+    */
+    jagged_index_select_kernel_stub(
+        kCPU, values, input_offsets, indices, output_offsets, output);
+    return output;
+  }
+
+  static at::Tensor forward(
+      torch::autograd::AutogradContext* ctx,
+      const at::Tensor& values,
+      const at::Tensor& input_offsets,
+      const at::Tensor& indices,
+      const at::Tensor& output_offsets) {
+    RECORD_FUNCTION(
+        "IPEXJaggedIndexSelectOp::forward", c10::ArrayRef<c10::IValue>({}));
+
+    at::AutoNonVariableTypeMode g;
+    ctx->saved_data["total"] = values.size(0);
+    ctx->save_for_backward({input_offsets, indices, output_offsets});
+    return _forward(values, input_offsets, indices, output_offsets);
+  }
+
+  static torch::autograd::tensor_list backward(
+      torch::autograd::AutogradContext* ctx,
+      torch::autograd::tensor_list grad_outputs) {
+    RECORD_FUNCTION(
+        "IPEXJaggedIndexSelectOp::backward", c10::ArrayRef<c10::IValue>({}));
+
+    at::AutoNonVariableTypeMode g;
+    auto saved = ctx->get_saved_variables();
+    at::Tensor input_offsets = saved[0];
+    at::Tensor indices = saved[1];
+    at::Tensor output_offsets = saved[2];
+    int64_t total = ctx->saved_data["total"].toInt();
+
+    at::Tensor grad = grad_outputs[0].contiguous();
+    auto grad_input = at::zeros({total, grad.size(1)}, grad.options());
+    /*
+    pointer to jagged_index_add_kernel_impl(
+        grad, output_offsets, indices, input_offsets, grad_input);
+    */
+    jagged_index_add_kernel_stub(
+        kCPU, grad, output_offsets, indices, input_offsets, grad_input);
+    return {grad_input, at::Tensor(), at::Tensor(), at::Tensor()};
+  }
+};
+
+class SegmentSumOp : public torch::autograd::Function<SegmentSumOp> {
+ public:
+  static at::Tensor _forward(
+      const at::Tensor& values,
+      const at::Tensor& offsets) {
+    RECORD_FUNCTION(
+        "IPEXSegmentSumOp::_forward", c10::ArrayRef<c10::IValue>({}));
+
+    auto output =
+        at::empty({offsets.numel() - 1, values.size(1)}, values.options());
+    // pointer to segment_sum_kernel_impl(values, offsets, output);
+    segment_sum_kernel_stub(kCPU, values, offsets, output);
+    return output;
+  }
+
+  static at::Tensor forward(
+      torch::autograd::AutogradContext* ctx,
+      const at::Tensor& values,
+      const at::Tensor& offsets) {
+    RECORD_FUNCTION(
+        "IPEXSegmentSumOp::forward", c10::ArrayRef<c10::IValue>({}));
+
+    at::AutoNonVariableTypeMode g;
+    ctx->saved_data["total"] = values.size(0);
+    ctx->save_for_backward({offsets});
+    return _forward(values, offsets);
+  }
+
+  static torch::autograd::tensor_list backward(
+      torch::autograd::AutogradContext* ctx,
+      torch::autograd::tensor_list grad_outputs) {
+    RECORD_FUNCTION(
+        "IPEXSegmentSumOp::backward", c10::ArrayRef<c10::IValue>({}));
+
+    at::AutoNonVariableTypeMode g;
+    auto offsets = ctx->get_saved_variables()[0];
+    int64_t total = ctx->saved_data["total"].toInt();
+
+    at::Tensor grad = grad_outputs[0].contiguous();
+    auto grad_values =
+        empty_values(offsets, total, grad.size(1), grad.options());
+    // pointer to segment_sum_backward_kernel_impl(grad, offsets, grad_values);
+    segment_sum_backward_kernel_stub(kCPU, grad, offsets, grad_values);
+    return {grad_values, at::Tensor()};
+  }
+};
+
+at::Tensor lengths_to_offsets(const at::Tensor& lengths) {
+  TORCH_CHECK(
+      lengths.dim() == 1 &&
+          (lengths.scalar_type() == at::kInt ||
+           lengths.scalar_type() == at::kLong),
+      "lengths_to_offsets: expected 1-D int32 or int64 lengths");
+  auto B = lengths.numel();
+  auto offsets = at::empty({B + 1}, lengths.options());
+  offsets.narrow(0, 0, 1).zero_();
+  auto tail = offsets.narrow(0, 1, B);
+  // pointer to cumsum_kernel_impl, the parallel block scan of long lengths
+  cumsum_kernel_stub(
+      kCPU, tail, lengths.contiguous(), 0, lengths.scalar_type());
+  return offsets;
+}
+
+at::Tensor jagged_to_padded_dense(
+    const at::Tensor& values,
+    const at::Tensor& offsets,
+    int64_t max_length,
+    double padding_value) {
+  check_offsets(offsets, "jagged_to_padded_dense");
+  TORCH_CHECK(
+      max_length >= 0, "jagged_to_padded_dense: expected max_length >= 0");
+  auto values_ = values_2d(values, "jagged_to_padded_dense");
+  auto offsets_ = offsets.contiguous();
+  at::Tensor dense;
+  if (at::GradMode::is_enabled() && values.requires_grad()) {
+    dense = JaggedToPaddedDenseOp::apply(
+        values_, offsets_, max_length, padding_value);
+  } else {
+    dense =
+        _jagged_to_padded_dense(values_, offsets_, max_length, padding_value);
+  }
+  return values.dim() == 1 ? dense.squeeze(2) : dense;
+}
+
+at::Tensor dense_to_jagged(
+    const at::Tensor& dense,
+    const at::Tensor& offsets,
+    c10::optional<int64_t> total_length) {
+  check_offsets(offsets, "dense_to_jagged");
+  TORCH_CHECK(
+      dense.dim() == 2 || dense.dim() == 3,
+      "dense_to_jagged: expected 2-D or 3-D dense, but got ",
+      dense.dim(),
+      "-D");
+  TORCH_CHECK(
+      dense.size(0) == offsets.numel() - 1,
+      "dense_to_jagged: expected ",
+      offsets.numel() - 1,
+      " segments in dense, but got ",
+      dense.size(0));
+  auto dense_ = dense.contiguous();
+  if (dense.dim() == 2) {
+    dense_ = dense_.unsqueeze(2);
+  }
+  auto offsets_ = offsets.contiguous();
+  int64_t total = total_length.has_value() ? total_length.value()
+                                           : offsets_[-1].item<int64_t>();
+  at::Tensor values;
+  if (at::GradMode::is_enabled() && dense.requires_grad()) {
+    values = DenseToJaggedOp::apply(dense_, offsets_, total);
+  } else {
+    values = _dense_to_jagged(dense_, offsets_, total);
+  }
+  return dense.dim() == 2 ? values.squeeze(1) : values;
+}
+
+std::tuple<at::Tensor, at::Tensor> jagged_index_select(
+    const at::Tensor& values,
+    const at::Tensor& lengths,
+    const at::Tensor& indices) {
+  TORCH_CHECK(
+      indices.dim() <= 1,
+      "jagged_index_select: indices are supposed to be a vector");
+  auto values_ = values_2d(values, "jagged_index_select");
+  auto input_offsets = lengths_to_offsets(lengths);
+  auto indices_ = indices.to(at::kLong).contiguous().view(-1);
+  // checks the range of the indices
+  auto output_lengths = at::index_select(lengths, 0, indices_);
+  auto output_offsets = lengths_to_offsets(output_lengths);
+  at::Tensor output;
+  if (at::GradMode::is_enabled() && values.requires_grad()) {
+    output = JaggedIndexSelectOp::apply(
+        values_, input_offsets, indices_, output_offsets);
+  } else {
+    output = JaggedIndexSelectOp::_forward(
+        values_, input_offsets, indices_, output_offsets);
+  }
+  return std::make_tuple(
+      values.dim() == 1 ? output.squeeze(1) : output, output_lengths);
+}
+
+at::Tensor segment_sum(const at::Tensor& values, const at::Tensor& offsets) {
+  check_offsets(offsets, "segment_sum");
+  TORCH_CHECK(
+      at::isFloatingType(values.scalar_type()),
+      "segment_sum: expected floating point values, but got ",
+      values.scalar_type());
+  auto values_ = values_2d(values, "segment_sum");
+  auto offsets_ = offsets.contiguous();
+  at::Tensor output;
+  if (at::GradMode::is_enabled() && values.requires_grad()) {
+    output = SegmentSumOp::apply(values_, offsets_);
+  } else {
+    output = SegmentSumOp::_forward(values_, offsets_);
+  }
+  return values.dim() == 1 ? output.squeeze(1) : output;
+}
+
+} // namespace cpu
+} // namespace torch_ipex
+
+namespace {
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def(
+      "lengths_to_offsets(Tensor lengths) -> Tensor",
+      torch_ipex::cpu::lengths_to_offsets);
+  m.def(
+      "jagged_to_padded_dense(Tensor values, Tensor offsets, int max_length, "
+      "float padding_value=0.0) -> Tensor",
+      torch_ipex::cpu::jagged_to_padded_dense);
+  m.def(
+      "dense_to_jagged(Tensor dense, Tensor offsets, int? total_length=None) "
+      "-> Tensor",
+      torch_ipex::cpu::dense_to_jagged);
+  m.def(
+      "jagged_index_select(Tensor values, Tensor lengths, Tensor indices) -> "
+      "(Tensor, Tensor)",
+      torch_ipex::cpu::jagged_index_select);
+  m.def(
+      "segment_sum(Tensor values, Tensor offsets) -> Tensor",
+      torch_ipex::cpu::segment_sum);
+}
+} // namespace
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include <dyndisp/DispatchStub.h>
+#include <torch/all.h>
+
+namespace torch_ipex {
+namespace cpu {
+
+// Jagged tensors of recommendation input pipelines (e.g. the values of one
+// feature of a KeyedJaggedTensor) are stored as:
+//  - values: [total, D] (or [total] for D == 1), the rows of all the
+//    segments one after the other,
+//  - offsets: [B + 1] int32 or int64, segment b is the rows
+//    [offsets[b], offsets[b + 1]) of values,
+// or with lengths: [B], lengths[b] = offsets[b + 1] - offsets[b].
+
+// offsets of the segments of the given lengths, [B] -> [B + 1] of the same
+// dtype, the first one is 0.
+at::Tensor lengths_to_offsets(const at::Tensor& lengths);
+
+// [total, D] values -> [B, max_length, D], segments longer than max_length
+// are truncated and shorter ones padded with padding_value.
+at::Tensor jagged_to_padded_dense(
+    const at::Tensor& values,
+    const at::Tensor& offsets,
+    int64_t max_length,
+    double padding_value);
+
+// [B, L, D] dense -> [total, D] values, the inverse of jagged_to_padded_dense:
+// the first rows of each dense segment are kept, the rows of segments longer
+// than L are zero. total defaults to offsets[B].
+at::Tensor dense_to_jagged(
+    const at::Tensor& dense,
+    const at::Tensor& offsets,
+    c10::optional<int64_t> total_length);
+
+// Selects the segments indices[i] of a jagged tensor given by its lengths,
+// e.g. to slice a batch. Returns the values and the lengths of the result.
+std::tuple<at::Tensor, at::Tensor> jagged_index_select(
+    const at::Tensor& values,
+    const at::Tensor& lengths,
+    const at::Tensor& indices);
+
+// [total, D] values -> [B, D] sum of the rows of each segment.
+at::Tensor segment_sum(const at::Tensor& values, const at::Tensor& offsets);
+
+namespace {
+
+void jagged_to_padded_dense_kernel_impl(
+    const at::Tensor& values,
+    const at::Tensor& offsets,
+    double padding_value,
+    at::Tensor& dense);
+
+void dense_to_jagged_kernel_impl(
+    const at::Tensor& dense,
+    const at::Tensor& offsets,
+    at::Tensor& values);
+
+void jagged_index_select_kernel_impl(
+    const at::Tensor& values,
+    const at::Tensor& input_offsets,
+    const at::Tensor& indices,
+    const at::Tensor& output_offsets,
+    at::Tensor& output);
+
+void jagged_index_add_kernel_impl(
+    const at::Tensor& grad,
+    const at::Tensor& grad_offsets,
+    const at::Tensor& indices,
+    const at::Tensor& input_offsets,
+    at::Tensor& grad_input);
+
+void segment_sum_kernel_impl(
+    const at::Tensor& values,
+    const at::Tensor& offsets,
+    at::Tensor& output);
+
+void segment_sum_backward_kernel_impl(
+    const at::Tensor& grad,
+    const at::Tensor& offsets,
+    at::Tensor& grad_values);
+
+} // namespace
+
+using jagged_to_padded_dense_kernel_fn = void (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    double,
+    at::Tensor&);
+DECLARE_DISPATCH(
+    jagged_to_padded_dense_kernel_fn,
+    jagged_to_padded_dense_kernel_stub);
+
+using dense_to_jagged_kernel_fn =
+    void (*)(const at::Tensor&, const at::Tensor&, at::Tensor&);
+DECLARE_DISPATCH(dense_to_jagged_kernel_fn, dense_to_jagged_kernel_stub);
+
+// Copies the segments indices[i] of values into the consecutive segments of
+// output given by output_offsets.
+using jagged_index_select_kernel_fn = void (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    at::Tensor&);
+DECLARE_DISPATCH(
+    jagged_index_select_kernel_fn,
+    jagged_index_select_kernel_stub);
+
+// Backward of jagged_index_select, adds segment i of grad into segment
+// indices[i] of the zero initialized grad_input. indices may repeat.
+using jagged_index_add_kernel_fn = void (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    at::Tensor&);
+DECLARE_DISPATCH(jagged_index_add_kernel_fn, jagged_index_add_kernel_stub);
+
+using segment_sum_kernel_fn =
+    void (*)(const at::Tensor&, const at::Tensor&, at::Tensor&);
+DECLARE_DISPATCH(segment_sum_kernel_fn, segment_sum_kernel_stub);
+
+// Broadcasts row b of grad to the rows of segment b of grad_values.
+using segment_sum_backward_kernel_fn =
+    void (*)(const at::Tensor&, const at::Tensor&, at::Tensor&);
+DECLARE_DISPATCH(
+    segment_sum_backward_kernel_fn,
+    segment_sum_backward_kernel_stub);
+
+} // namespace cpu
+} // namespace torch_ipex
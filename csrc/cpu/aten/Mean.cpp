@@ -1,7 +1,9 @@
 #include <ATen/ATen.h>
+#include <ATen/CPUFunctions.h>
 #include <ATen/NamedTensorUtils.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/Parallel.h>
+#include <ATen/WrapDimUtils.h>
 #include <ATen/cpu/vec/vec.h>
 #include <ATen/native/cpu/utils.h>
 #include <ATen/record_function.h>
@@ -12,11 +14,78 @@
 namespace torch_ipex {
 namespace cpu {
 
+DEFINE_DISPATCH(spatial_reduce_kernel_stub);
+
+bool is_spatial_reduction(
+    const at::Tensor& input,
+    c10::OptionalIntArrayRef dim_opt) {
+  if (!dim_opt.has_value() || dim_opt.value().empty()) {
+    return false;
+  }
+  if (input.scalar_type() != at::kFloat &&
+      input.scalar_type() != at::kBFloat16) {
+    return false;
+  }
+  auto ndim = input.dim();
+  if (!(ndim == 4 && input.is_contiguous(at::MemoryFormat::ChannelsLast)) &&
+      !(ndim == 5 && input.is_contiguous(at::MemoryFormat::ChannelsLast3d))) {
+    return false;
+  }
+  if (input.numel() == 0) {
+    return false;
+  }
+  // dims must be exactly the spatial dims, in any order
+  auto dims = dim_opt.value();
+  if (static_cast<int64_t>(dims.size()) != ndim - 2) {
+    return false;
+  }
+  std::vector<bool> seen(ndim, false);
+  for (auto d : dims) {
+    auto wrapped = at::maybe_wrap_dim(d, ndim);
+    if (wrapped < 2 || seen[wrapped]) {
+      return false;
+    }
+    seen[wrapped] = true;
+  }
+  return true;
+}
+
+std::tuple<at::Tensor, at::Tensor> spatial_reduce(
+    const at::Tensor& input,
+    SpatialReduceOp op,
+    double correction,
+    bool keepdim) {
+  auto N = input.size(0);
+  auto C = input.size(1);
+  auto output = at::empty({N, C}, input.options());
+  at::Tensor mean;
+  if (op == SpatialReduceOp::VarMean || op == SpatialReduceOp::StdMean) {
+    mean = at::empty({N, C}, input.options());
+  }
+  // pointer to spatial_reduce_kernel_impl(input, op, correction, output, mean)
+  spatial_reduce_kernel_stub(kCPU, input, op, correction, output, mean);
+  if (keepdim) {
+    std::vector<int64_t> shape(input.dim(), 1);
+    shape[0] = N;
+    shape[1] = C;
+    output = output.view(shape);
+    if (mean.defined()) {
+      mean = mean.view(shape);
+    }
+  }
+  return std::make_tuple(output, mean);
+}
+
 at::Tensor mean_dim_impl(
     const at::Tensor& input,
     c10::OptionalIntArrayRef dim_opt,
     bool keepdim,
     c10::optional<c10::ScalarType> dtype) {
+  if ((!dtype.has_value() || dtype.value() == input.scalar_type()) &&
+      is_spatial_reduction(input, dim_opt)) {
+    return std::get<0>(
+        spatial_reduce(input, SpatialReduceOp::Mean, 0, keepdim));
+  }
   int64_t dim_prod = 1;
   if (dim_opt.has_value()) {
     auto dim = dim_opt.value();
@@ -31,10 +100,56 @@ at::Tensor mean_dim_impl(
   return at::sum(input, dim_opt, keepdim, dtype).div_(dim_prod);
 }
 
+std::tuple<at::Tensor, at::Tensor> var_mean_impl(
+    const at::Tensor& input,
+    c10::OptionalIntArrayRef dim_opt,
+    const c10::optional<at::Scalar>& correction,
+    bool keepdim) {
+#if defined(IPEX_DISP_OP)
+  printf("torch_ipex::var_mean_impl\n");
+#endif
+  RECORD_FUNCTION("torch_ipex::var_mean_impl", c10::ArrayRef<c10::IValue>({}));
+
+  if (!is_spatial_reduction(input, dim_opt)) {
+    return at::cpu::var_mean(input, dim_opt, correction, keepdim);
+  }
+  return spatial_reduce(
+      input,
+      SpatialReduceOp::VarMean,
+      correction.has_value() ? correction.value().toDouble() : 1,
+      keepdim);
+}
+
+std::tuple<at::Tensor, at::Tensor> std_mean_impl(
+    const at::Tensor& input,
+    c10::OptionalIntArrayRef dim_opt,
+    const c10::optional<at::Scalar>& correction,
+    bool keepdim) {
+#if defined(IPEX_DISP_OP)
+  printf("torch_ipex::std_mean_impl\n");
+#endif
+  RECORD_FUNCTION("torch_ipex::std_mean_impl", c10::ArrayRef<c10::IValue>({}));
+
+  if (!is_spatial_reduction(input, dim_opt)) {
+    return at::cpu::std_mean(input, dim_opt, correction, keepdim);
+  }
+  return spatial_reduce(
+      input,
+      SpatialReduceOp::StdMean,
+      correction.has_value() ? correction.value().toDouble() : 1,
+      keepdim);
+}
+
 IPEX_TORCH_LIBRARY_IMPL(aten, CPU, m) {
   m.impl(
       TORCH_SELECTIVE_NAME("aten::mean.dim"),
       TORCH_FN((&torch_ipex::cpu::mean_dim_impl)));
+  m.impl(
+      TORCH_SELECTIVE_NAME("aten::var_mean.correction"),
+      TORCH_FN((&torch_ipex::cpu::var_mean_impl)));
+  m.impl(
+      TORCH_SELECTIVE_NAME("aten::std_mean.correction"),
+      TORCH_FN((&torch_ipex::cpu::std_mean_impl)));
 }
 
 } // namespace cpu
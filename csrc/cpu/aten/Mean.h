@@ -1,17 +1,69 @@
 #pragma once
 
 #include <ATen/Tensor.h>
+#include <dyndisp/DispatchStub.h>
 
 #include <vector>
 
 namespace torch_ipex {
 namespace cpu {
 
+// Reductions over all the spatial dims of a channels last tensor, i.e.
+// [N, C, *spatial] -> [N, C]
+enum class SpatialReduceOp { Sum, Mean, VarMean, StdMean };
+
+// Whether the reduction of input over dim_opt is a reduction over the
+// spatial dims of an FP32 or BF16 channels last (3d) tensor.
+bool is_spatial_reduction(
+    const at::Tensor& input,
+    c10::OptionalIntArrayRef dim_opt);
+
+// Reduces input over its spatial dims in a single pass. Returns the sum, mean,
+// var or std, and for VarMean and StdMean the mean as the second output.
+std::tuple<at::Tensor, at::Tensor> spatial_reduce(
+    const at::Tensor& input,
+    SpatialReduceOp op,
+    double correction,
+    bool keepdim);
+
 at::Tensor mean_dim_impl(
     const at::Tensor& input,
     c10::OptionalIntArrayRef dim_opt,
     bool keepdim,
     c10::optional<at::ScalarType> dtype);
 
+std::tuple<at::Tensor, at::Tensor> var_mean_impl(
+    const at::Tensor& input,
+    c10::OptionalIntArrayRef dim_opt,
+    const c10::optional<at::Scalar>& correction,
+    bool keepdim);
+
+std::tuple<at::Tensor, at::Tensor> std_mean_impl(
+    const at::Tensor& input,
+    c10::OptionalIntArrayRef dim_opt,
+    const c10::optional<at::Scalar>& correction,
+    bool keepdim);
+
+namespace {
+
+void spatial_reduce_kernel_impl(
+    const at::Tensor& input,
+    SpatialReduceOp op,
+    double correction,
+    at::Tensor& output,
+    at::Tensor& mean);
+
+}
+
+// input is [N, C, *spatial] channels last, output and mean are [N, C]
+// contiguous of the input dtype, mean is only written for VarMean and StdMean.
+using spatial_reduce_kernel_fn = void (*)(
+    const at::Tensor&,
+    SpatialReduceOp,
+    double,
+    at::Tensor&,
+    at::Tensor&);
+DECLARE_DISPATCH(spatial_reduce_kernel_fn, spatial_reduce_kernel_stub);
+
 } // namespace cpu
 } // namespace torch_ipex
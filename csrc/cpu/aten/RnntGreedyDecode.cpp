@@ -0,0 +1,239 @@
+#include <torch/all.h>
+
+#include <torch/csrc/autograd/function.h>
+#include "RnntEmbedding.h"
+#include "RnntGreedyDecode.h"
+#include "UpdateBatch.h"
+#include "cpu/kernels/OpContext.h"
+#include "ideep/IDeepConversions.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+DEFINE_DISPATCH(rnnt_lstm_cell_kernel_stub);
+
+namespace {
+
+LinearOpContext* linear_context_from_handle(const at::Tensor& handle) {
+  return reinterpret_cast<LinearOpContext*>(handle.data_ptr<int64_t>()[0]);
+}
+
+int64_t linear_out_features(LinearOpContext* op_context) {
+  return op_context->get_context().weight_packed_.get_dim(0);
+}
+
+} // namespace
+
+/**
+ * Greedy RNN-T decoding of a whole batch in one op: prediction net LSTM,
+ * joint network, argmax and batch update are run in a C++ loop until all the
+ * time steps of all the samples are consumed, so that there is no Python
+ * dispatch per emitted symbol.
+ *
+ * All the linears are passed as prepacked LinearOpContext handles, see
+ * ipex_prepack::linear_prepack and get_data_handle(). Every buffer of the
+ * loop is allocated once up front and written by the out variant of the
+ * linear contexts:
+ *   pred net: gates = x * W_ih^T + b_ih + h * W_hh^T + b_hh per layer, the
+ *             second linear is accumulated into the first one with a sum
+ *             post op
+ *   joint:    relu(enc(x) + pred(g)), enc(x) is computed once for all the
+ *             time steps and added through a residual (sum + relu) post op
+ *             of the pred linear, followed by the joint linear
+ *
+ *@param x Encoder output in [T, batch_size, enc_features], FP32 or BF16
+ *@param out_lens Valid time steps of each sample, [batch_size]
+ *@param embedding_table Embedding of the prediction net, [vocab - 1, E]
+ *@param lstm_ih_prepack Input-hidden linear of each LSTM layer, [4H, E or H]
+ *@param lstm_hh_prepack Hidden-hidden linear of each LSTM layer, [4H, H]
+ *@param enc_prepack Encoder side linear of the joint network, [J, enc]
+ *@param pred_prepack Prediction side linear of the joint network, [J, H]
+ *@param joint_prepack Output linear of the joint network, [vocab, J]
+ *@param max_symbols Max symbols emitted per time step
+ *@param blank_id Id of the blank symbol
+ *@param _SOS The mark of the Start Of Sequence, must be -1
+ *@return The decoded tokens of each sample as int64 tensors
+ */
+std::vector<at::Tensor> rnnt_greedy_decode(
+    const at::Tensor& x,
+    const at::Tensor& out_lens,
+    const at::Tensor& embedding_table,
+    at::TensorList lstm_ih_prepack,
+    at::TensorList lstm_hh_prepack,
+    const at::Tensor& enc_prepack,
+    const at::Tensor& pred_prepack,
+    const at::Tensor& joint_prepack,
+    int64_t max_symbols,
+    int64_t blank_id,
+    int64_t _SOS) {
+#if defined(IPEX_DISP_OP)
+  printf("IPEX::rnnt_greedy_decode\n");
+#endif
+  RECORD_FUNCTION("IPEX::rnnt_greedy_decode", c10::ArrayRef<c10::IValue>({}));
+
+  TORCH_CHECK(
+      x.dim() == 3 &&
+          (x.scalar_type() == at::kFloat || x.scalar_type() == at::kBFloat16),
+      "rnnt_greedy_decode: expects a 3-D float or bf16 encoder output");
+  TORCH_CHECK(
+      embedding_table.scalar_type() == x.scalar_type(),
+      "rnnt_greedy_decode: embedding_table should have the same dtype as x");
+  TORCH_CHECK(
+      !lstm_ih_prepack.empty() &&
+          lstm_ih_prepack.size() == lstm_hh_prepack.size(),
+      "rnnt_greedy_decode: expects the same number of input-hidden and "
+      "hidden-hidden linears for the LSTM");
+  TORCH_CHECK(max_symbols > 0, "rnnt_greedy_decode: max_symbols should be > 0");
+
+  const int64_t time_steps = x.size(0);
+  const int64_t batch_size = x.size(1);
+  const int64_t num_layers = lstm_ih_prepack.size();
+  const int64_t embedding_dim = embedding_table.size(1);
+  if (batch_size == 0) {
+    return {};
+  }
+
+  std::vector<LinearOpContext*> ih_ctx, hh_ctx;
+  for (int64_t l = 0; l < num_layers; l++) {
+    ih_ctx.push_back(linear_context_from_handle(lstm_ih_prepack[l]));
+    hh_ctx.push_back(linear_context_from_handle(lstm_hh_prepack[l]));
+  }
+  auto enc_ctx = linear_context_from_handle(enc_prepack);
+  auto pred_ctx = linear_context_from_handle(pred_prepack);
+  auto joint_ctx = linear_context_from_handle(joint_prepack);
+  const int64_t hidden_size = linear_out_features(hh_ctx[0]) / 4;
+  const int64_t joint_size = linear_out_features(pred_ctx);
+  const int64_t vocab_size = linear_out_features(joint_ctx);
+
+  auto lens = out_lens.to(at::kInt).contiguous();
+  const int64_t max_len = lens.max().item<int64_t>();
+  TORCH_CHECK(
+      max_len <= time_steps,
+      "rnnt_greedy_decode: out_lens exceeds the time steps of x");
+  if (max_len <= 0) {
+    return std::vector<at::Tensor>(
+        batch_size, at::empty({0}, x.options().dtype(at::kLong)));
+  }
+
+  auto attr = ideep::attr_t(torch_ipex::fpmath_mode);
+  auto sum_attr = ideep::attr_t::fuse_sum().set_fpmath_mode(
+      torch_ipex::fpmath_mode);
+  auto residual_attr = ideep::attr_t::residual().set_fpmath_mode(
+      torch_ipex::fpmath_mode);
+
+  // The encoder side of the joint network does not depend on the emitted
+  // symbols, project all the time steps at once. The batch update kernel
+  // reads it as [batch_size, T, J] on top of the time-major memory.
+  auto x_proj = enc_ctx->run(x.contiguous().view({-1, x.size(2)}), attr)
+                    .view({time_steps, batch_size, joint_size});
+  auto x_view = x_proj.transpose(0, 1);
+  auto f = x_proj[0].clone();
+
+  auto options = x.options();
+  auto int_options = options.dtype(at::kInt);
+  auto long_options = options.dtype(at::kLong);
+  auto hidden_0 = at::zeros({num_layers, batch_size, hidden_size}, options);
+  auto hidden_1 = at::zeros({num_layers, batch_size, hidden_size}, options);
+  auto hidden_prime_0 = at::empty_like(hidden_0);
+  auto hidden_prime_1 = at::empty_like(hidden_1);
+  auto gates = at::empty({batch_size, 4 * hidden_size}, options);
+  auto embedding_out = at::empty({batch_size, embedding_dim}, options);
+  auto joint = at::empty({batch_size, joint_size}, options);
+  auto logits = at::empty({batch_size, vocab_size}, options);
+
+  auto k = at::empty({batch_size}, long_options);
+  auto label_col = at::zeros({batch_size}, int_options);
+  auto symbols_added = at::zeros({batch_size}, int_options);
+  auto time_idxs = at::zeros({batch_size}, int_options);
+  auto blankness = at::zeros({batch_size}, int_options);
+  auto blank_vec = at::zeros({batch_size}, int_options);
+  auto not_blank = at::zeros({batch_size}, int_options);
+  auto label_to_put = at::zeros({batch_size}, long_options);
+  // one extra column for the start of sequence, a sample can emit
+  // max_symbols symbols at every time step
+  auto label_tensor =
+      at::full({batch_size, max_len * max_symbols + 1}, _SOS, long_options);
+  auto label_for_next_loop = at::full({batch_size}, _SOS, long_options);
+
+  while (true) {
+    // prediction net on the last emitted symbol, the new states go to
+    // hidden_prime and only replace hidden for the non blank samples
+    rnnt_embedding_kernel_stub(
+        kCPU,
+        embedding_table,
+        label_for_next_loop,
+        embedding_out,
+        _SOS,
+        batch_size,
+        embedding_dim);
+    at::Tensor layer_input = embedding_out;
+    for (int64_t l = 0; l < num_layers; l++) {
+      ih_ctx[l]->run(layer_input, gates, attr);
+      hh_ctx[l]->run(hidden_0[l], gates, sum_attr);
+      rnnt_lstm_cell_kernel_stub(
+          kCPU, gates, hidden_1[l], hidden_prime_0[l], hidden_prime_1[l]);
+      layer_input = hidden_prime_0[l];
+    }
+
+    // joint network and greedy pick
+    joint.copy_(f);
+    pred_ctx->run(layer_input, joint, residual_attr);
+    joint_ctx->run(joint, logits, attr);
+    at::argmax_out(k, logits, 1);
+
+    bool finished = rnnt_update_batch_kernel_stub(
+        kCPU,
+        k,
+        lens,
+        label_col,
+        symbols_added,
+        time_idxs,
+        blankness,
+        blank_vec,
+        not_blank,
+        label_to_put,
+        label_tensor,
+        label_for_next_loop,
+        hidden_0,
+        hidden_1,
+        hidden_prime_0,
+        hidden_prime_1,
+        x_view,
+        f,
+        max_symbols,
+        blank_id,
+        batch_size,
+        _SOS,
+        max_len);
+    if (finished) {
+      break;
+    }
+  }
+
+  // column 0 of label_tensor keeps the start of sequence
+  std::vector<at::Tensor> tokens;
+  auto label_col_ptr = label_col.data_ptr<int32_t>();
+  for (int64_t b = 0; b < batch_size; b++) {
+    tokens.push_back(label_tensor[b].narrow(0, 1, label_col_ptr[b]).clone());
+  }
+  return tokens;
+}
+
+} // namespace cpu
+} // namespace torch_ipex
+
+namespace {
+
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def(
+      "rnnt_greedy_decode(Tensor x, Tensor out_lens, Tensor embedding_table, "
+      "Tensor[] lstm_ih_prepack, Tensor[] lstm_hh_prepack, "
+      "Tensor enc_prepack, Tensor pred_prepack, Tensor joint_prepack, "
+      "int max_symbols, int blank_id, int _SOS) -> Tensor[]");
+  m.impl(
+      "rnnt_greedy_decode",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::rnnt_greedy_decode);
+}
+
+} // namespace
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <dyndisp/DispatchStub.h>
+
+#include <vector>
+
+namespace torch_ipex {
+namespace cpu {
+
+std::vector<at::Tensor> rnnt_greedy_decode(
+    const at::Tensor& x,
+    const at::Tensor& out_lens,
+    const at::Tensor& embedding_table,
+    at::TensorList lstm_ih_prepack,
+    at::TensorList lstm_hh_prepack,
+    const at::Tensor& enc_prepack,
+    const at::Tensor& pred_prepack,
+    const at::Tensor& joint_prepack,
+    int64_t max_symbols,
+    int64_t blank_id,
+    int64_t _SOS);
+
+namespace {
+
+void rnnt_lstm_cell_kernel_impl(
+    const at::Tensor& gates,
+    const at::Tensor& cx,
+    at::Tensor hy,
+    at::Tensor cy);
+
+}
+
+using rnnt_lstm_cell_kernel_fn =
+    void (*)(const at::Tensor&, const at::Tensor&, at::Tensor, at::Tensor);
+DECLARE_DISPATCH(rnnt_lstm_cell_kernel_fn, rnnt_lstm_cell_kernel_stub);
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,177 @@
+#include <torch/all.h>
+
+#include <torch/csrc/autograd/function.h>
+#include "SparseLinear.h"
+#include "cpu/kernels/OpContext.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+DEFINE_DISPATCH(sparse_linear_kernel_stub);
+
+namespace {
+
+// Weight padded with zeros to whole blocks, viewed as [N / kSparseNBlock,
+// kSparseNBlock, K / kSparseKBlock, kSparseKBlock]
+at::Tensor sparse_linear_blocked_weight(const at::Tensor& weight) {
+  TORCH_CHECK(
+      weight.dim() == 2 && weight.size(1) > 0,
+      "Sparse linear expects a non-empty 2-D weight");
+  TORCH_CHECK(
+      weight.scalar_type() == at::kFloat ||
+          weight.scalar_type() == at::kBFloat16,
+      "Sparse linear only supports FP32 and BF16 weights, but got ",
+      weight.scalar_type());
+  auto N = weight.size(0);
+  auto K = weight.size(1);
+  auto n_blocks = (N + kSparseNBlock - 1) / kSparseNBlock;
+  auto k_blocks = (K + kSparseKBlock - 1) / kSparseKBlock;
+  auto w = at::zeros(
+      {n_blocks * kSparseNBlock, k_blocks * kSparseKBlock}, weight.options());
+  w.narrow(0, 0, N).narrow(1, 0, K).copy_(weight);
+  return w.view({n_blocks, kSparseNBlock, k_blocks, kSparseKBlock});
+}
+
+// [N / kSparseNBlock, K / kSparseKBlock] mask of the non-zero blocks
+at::Tensor sparse_linear_block_mask(const at::Tensor& blocked_weight) {
+  return blocked_weight.ne(0).any(3).any(1);
+}
+
+} // namespace
+
+SparseLinearPostOp sparse_linear_post_op(const std::string& post_op) {
+  if (post_op == "none") {
+    return SparseLinearPostOp::None;
+  } else if (post_op == "relu") {
+    return SparseLinearPostOp::ReLU;
+  }
+  TORCH_CHECK(
+      post_op == "gelu",
+      "Sparse linear supports \"none\", \"relu\" and \"gelu\" post ops, but "
+      "got ",
+      post_op);
+  return SparseLinearPostOp::GELU;
+}
+
+double sparse_linear_block_density(const at::Tensor& weight) {
+  auto mask = sparse_linear_block_mask(sparse_linear_blocked_weight(weight));
+  return static_cast<double>(mask.sum().item<int64_t>()) / mask.numel();
+}
+
+std::tuple<at::Tensor, at::Tensor, at::Tensor> sparse_linear_pack_weight(
+    const at::Tensor& weight) {
+  auto blocked = sparse_linear_blocked_weight(weight);
+  auto n_blocks = blocked.size(0);
+  auto k_blocks = blocked.size(2);
+  auto mask = sparse_linear_block_mask(blocked);
+
+  // nonzero() is in row-major order, so the blocks of a block row are
+  // contiguous and sorted by input channel
+  auto indices = mask.nonzero();
+  auto block_rows = indices.select(1, 0);
+  auto block_cols = indices.select(1, 1);
+  auto values =
+      blocked.permute({0, 2, 3, 1})
+          .reshape({n_blocks * k_blocks, kSparseKBlock, kSparseNBlock})
+          .index_select(0, block_rows * k_blocks + block_cols)
+          .contiguous();
+  auto row_ptr = at::zeros({n_blocks + 1}, at::kLong);
+  row_ptr.narrow(0, 1, n_blocks).copy_(mask.sum(1).cumsum(0));
+  return std::make_tuple(
+      values, block_cols.to(at::kInt).contiguous(), row_ptr.to(at::kInt));
+}
+
+at::Tensor sparse_linear_unpack_weight(
+    const at::Tensor& values,
+    const at::Tensor& col_index,
+    const at::Tensor& row_ptr,
+    int64_t out_features,
+    int64_t in_features) {
+  auto n_blocks = row_ptr.numel() - 1;
+  auto k_blocks = (in_features + kSparseKBlock - 1) / kSparseKBlock;
+  auto row_ptr_ = row_ptr.to(at::kLong);
+  auto block_rows = at::repeat_interleave(
+      row_ptr_.narrow(0, 1, n_blocks) - row_ptr_.narrow(0, 0, n_blocks));
+  auto blocks = at::zeros(
+      {n_blocks * k_blocks, kSparseKBlock, kSparseNBlock}, at::kFloat);
+  blocks.index_copy_(
+      0,
+      block_rows * k_blocks + col_index.to(at::kLong),
+      values.to(at::kFloat));
+  return blocks.view({n_blocks, k_blocks, kSparseKBlock, kSparseNBlock})
+      .permute({0, 3, 1, 2})
+      .reshape({n_blocks * kSparseNBlock, k_blocks * kSparseKBlock})
+      .narrow(0, 0, out_features)
+      .narrow(1, 0, in_features)
+      .contiguous();
+}
+
+/**
+ * Block-sparse linear: only the non-zero blocks of the weight are read and
+ * multiplied, the bias and the post op are applied in the epilogue.
+ *
+ *@param self Activation input for Linear
+ *@param values Non-zero weight blocks, see sparse_linear_pack_weight
+ *@param col_index Input channel block index of each non-zero block
+ *@param row_ptr Offsets of the blocks of each block of output channels
+ *@param bias Bias for Linear, may be undefined
+ *@param out_features Size of N-dim for Linear
+ *@param post_op Eltwise applied to the output
+ */
+at::Tensor sparse_linear_kernel(
+    const at::Tensor& self,
+    const at::Tensor& values,
+    const at::Tensor& col_index,
+    const at::Tensor& row_ptr,
+    const at::Tensor& bias,
+    int64_t out_features,
+    SparseLinearPostOp post_op) {
+  TORCH_CHECK(
+      self.scalar_type() == at::kFloat || self.scalar_type() == at::kBFloat16,
+      "Sparse linear only supports FP32 and BF16 inputs");
+  auto input_size = self.sizes();
+  std::vector<int64_t> output_size(input_size.begin(), input_size.end() - 1);
+  output_size.push_back(out_features);
+  auto output = at::empty(output_size, self.options());
+  sparse_linear_kernel_stub(
+      kCPU,
+      self,
+      values,
+      col_index,
+      row_ptr,
+      bias,
+      out_features,
+      post_op,
+      output);
+  return output;
+}
+
+at::Tensor sparse_linear_forward(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias,
+    const at::Tensor& op_context) {
+  return reinterpret_cast<IpexSparseLinearOpContext*>(
+             op_context.data_ptr<int64_t>()[0])
+      ->run(input, SparseLinearPostOp::None);
+}
+
+} // namespace cpu
+} // namespace torch_ipex
+
+namespace {
+
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def(
+      "ipex_sparse_linear(Tensor input, Tensor weight, Tensor? bias, "
+      "Tensor W_prepack) -> Tensor");
+  m.impl(
+      "ipex_sparse_linear",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::sparse_linear_forward);
+  m.def(
+      "sparse_linear_block_density(Tensor weight) -> float",
+      torch_ipex::cpu::sparse_linear_block_density);
+}
+
+} // namespace
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/Tensor.h>
+#include <dyndisp/DispatchStub.h>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace torch_ipex {
+namespace cpu {
+
+// The weight is stored in block-CSR format with blocks of kSparseNBlock
+// output channels by kSparseKBlock input channels. Inside a block, the
+// kSparseNBlock values of the same input channel are contiguous, so that one
+// vector load gets one column of the block. Blocks that are all zero are not
+// stored and not computed.
+constexpr int64_t kSparseNBlock = 16;
+constexpr int64_t kSparseKBlock = 4;
+
+// Eltwise fused into the epilogue of the sparse linear
+enum class SparseLinearPostOp : int64_t {
+  None = 0,
+  ReLU = 1,
+  GELU = 2,
+};
+
+SparseLinearPostOp sparse_linear_post_op(const std::string& post_op);
+
+// Fraction of the kSparseNBlock x kSparseKBlock blocks of a 2-D [N, K]
+// weight that have a non-zero value, i.e. the fraction of the dense work the
+// sparse linear kernel does.
+double sparse_linear_block_density(const at::Tensor& weight);
+
+/**
+ * Pack a 2-D [N, K] weight to the block-CSR layout used by the sparse linear
+ * kernel. The values keep the dtype of the weight.
+ *
+ *@param weight FP32 or BF16 weight of the linear
+ *@return The non-zero blocks in [nnz_blocks, kSparseKBlock, kSparseNBlock]
+ * layout, the int32 input channel block index of each of them, and the int32
+ * offsets of the first block of each block of output channels in the former
+ * two, with N / kSparseNBlock + 1 values
+ */
+std::tuple<at::Tensor, at::Tensor, at::Tensor> sparse_linear_pack_weight(
+    const at::Tensor& weight);
+
+// Unpack a block-CSR weight back to the public FP32 [N, K] layout.
+at::Tensor sparse_linear_unpack_weight(
+    const at::Tensor& values,
+    const at::Tensor& col_index,
+    const at::Tensor& row_ptr,
+    int64_t out_features,
+    int64_t in_features);
+
+at::Tensor sparse_linear_kernel(
+    const at::Tensor& self,
+    const at::Tensor& values,
+    const at::Tensor& col_index,
+    const at::Tensor& row_ptr,
+    const at::Tensor& bias,
+    int64_t out_features,
+    SparseLinearPostOp post_op);
+
+at::Tensor sparse_linear_forward(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias,
+    const at::Tensor& op_context);
+
+namespace {
+
+void sparse_linear_kernel_impl(
+    const at::Tensor& self,
+    const at::Tensor& values,
+    const at::Tensor& col_index,
+    const at::Tensor& row_ptr,
+    const at::Tensor& bias,
+    int64_t out_features,
+    SparseLinearPostOp post_op,
+    at::Tensor& output);
+
+} // namespace
+
+using sparse_linear_kernel_fn = void (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    int64_t,
+    SparseLinearPostOp,
+    at::Tensor&);
+DECLARE_DISPATCH(sparse_linear_kernel_fn, sparse_linear_kernel_stub);
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -7,6 +7,7 @@
 #include <ATen/record_function.h>
 #include <c10/util/irange.h>
 
+#include "Mean.h"
 #include "Sum.h"
 #include "utils/library.h"
 
@@ -34,6 +35,14 @@ at::Tensor sum_out_cpu(
     }
   }
 
+  // reduction over the spatial dims of a channels last tensor, e.g. global
+  // pooling, is done in a single pass with channel-contiguous accumulation
+  if (dtype.value() == input.scalar_type() &&
+      is_spatial_reduction(input, opt_dims)) {
+    return std::get<0>(
+        spatial_reduce(input, SpatialReduceOp::Sum, 0, keepdim));
+  }
+
   at::DimVector dims_ = at::native::make_dim_vector(opt_dims, input.dim());
   at::maybe_wrap_dims(dims_, input.dim());
   auto shape = at::meta::get_reduction_shape(input, dims_, keepdim);
@@ -1,4 +1,5 @@
 #include <ATen/ATen.h>
+#include <ATen/CPUFunctions.h>
 #include <ATen/ExpandUtils.h>
 #include <ATen/MemoryOverlap.h>
 #include <ATen/NativeFunctions.h>
@@ -28,6 +29,8 @@ namespace cpu {
 
 DEFINE_DISPATCH(index_select_contig_stub);
 DEFINE_DISPATCH(copy_stub);
+DEFINE_DISPATCH(gather_contig_stub);
+DEFINE_DISPATCH(index_add_contig_stub);
 
 at::Tensor& index_select_out_cpu_(
     const at::Tensor& self,
@@ -252,6 +255,281 @@ at::Tensor index_select_cpu_(
   return index_select_out_cpu_(self, dim, index, result);
 }
 
+namespace {
+
+bool is_index_fast_path_dtype(at::ScalarType st) {
+  return st == at::kFloat || st == at::kDouble || st == at::kBFloat16;
+}
+
+// True if index only varies along dim 0, e.g. x.gather(0, idx.view(-1, 1)
+// .expand(-1, F)) or the scatter_add of graph neural networks: each index
+// value then picks or updates a whole row.
+bool is_row_index(const at::Tensor& self, const at::Tensor& index) {
+  if (index.dim() != self.dim() || index.dim() == 0) {
+    return false;
+  }
+  for (int64_t d = 1; d < index.dim(); d++) {
+    if (index.size(d) != self.size(d) ||
+        (index.stride(d) != 0 && index.size(d) != 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The row index of a row index, see is_row_index
+at::Tensor row_index(const at::Tensor& index) {
+  auto rows = index;
+  while (rows.dim() > 1) {
+    rows = rows.select(1, 0);
+  }
+  return rows.contiguous();
+}
+
+// Conditions of index_add_contig_stub: self gets rows along dim, i.e. all
+// the dims before dim have size 1, and source has the rows of self.
+bool index_add_fast_path(
+    const at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index,
+    const at::Tensor& source) {
+  if (!is_index_fast_path_dtype(self.scalar_type()) ||
+      source.scalar_type() != self.scalar_type() || index.dim() > 1 ||
+      self.dim() == 0 || source.dim() != self.dim() || self.numel() == 0 ||
+      index.numel() != source.size(dim) ||
+      (index.scalar_type() != at::kLong && index.scalar_type() != at::kInt)) {
+    return false;
+  }
+  for (int64_t d = 0; d < self.dim(); d++) {
+    if (d < dim && self.size(d) != 1) {
+      return false;
+    }
+    if (d != dim && source.size(d) != self.size(d)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// self[index[i]] += alpha * source[i] on the rows along dim of a contiguous
+// self, see index_add_fast_path
+void index_add_rows(
+    at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index,
+    const at::Tensor& source,
+    const at::Scalar& alpha) {
+  at::assert_no_internal_overlap(self);
+  at::assert_no_overlap(self, index);
+  at::assert_no_overlap(self, source);
+  if (index.numel() == 0) {
+    return;
+  }
+  auto dim_size = self.size(dim);
+  // pointer to index_add_contig_kernel(self, index, source, alpha);
+  index_add_contig_stub(
+      kCPU,
+      self.view({dim_size, -1}),
+      index.contiguous().view(-1),
+      source.contiguous().view({index.numel(), -1}),
+      alpha);
+}
+
+} // namespace
+
+at::Tensor gather_cpu_(
+    const at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index,
+    bool sparse_grad) {
+#if defined(IPEX_DISP_OP)
+  printf("torch_ipex::gather_cpu_\n");
+#endif
+  RECORD_FUNCTION("torch_ipex::gather_cpu_", c10::ArrayRef<c10::IValue>({}));
+
+  dim = at::maybe_wrap_dim(dim, self.dim());
+  bool fast_path = !sparse_grad && self.is_contiguous() &&
+      is_index_fast_path_dtype(self.scalar_type()) &&
+      index.scalar_type() == at::kLong && self.dim() > 0 &&
+      index.dim() == self.dim() && self.numel() > 0 && index.numel() > 0;
+  if (fast_path && dim == 0 && self.dim() > 1 && is_row_index(self, index)) {
+    // a gather of whole rows is an index_select
+    return index_select_cpu_(self, 0, row_index(index));
+  }
+  if (fast_path && index.is_contiguous()) {
+    for (int64_t d = 0; d < self.dim(); d++) {
+      fast_path &= d == dim || index.size(d) == self.size(d);
+    }
+  } else {
+    fast_path = false;
+  }
+  if (!fast_path) {
+    return at::cpu::gather(self, dim, index, sparse_grad);
+  }
+  auto result = at::empty(index.sizes(), self.options());
+  // pointer to gather_contig_kernel(result, self, dim, index);
+  gather_contig_stub(kCPU, result, self, dim, index);
+  return result;
+}
+
+at::Tensor index_cpu_(
+    const at::Tensor& self,
+    const c10::List<c10::optional<at::Tensor>>& indices) {
+#if defined(IPEX_DISP_OP)
+  printf("torch_ipex::index_cpu_\n");
+#endif
+  RECORD_FUNCTION("torch_ipex::index_cpu_", c10::ArrayRef<c10::IValue>({}));
+
+  // Fast path for x[i0, i1, ..., ik-1] with int64 index tensors of the same
+  // shape on the first k dims of a contiguous x, e.g. the edge lookups of
+  // graph neural networks: the k indices are linearized into one row index
+  // of x viewed as [size(0) * ... * size(k-1), -1] and the rows are gathered
+  // by index_select.
+  const int64_t k = indices.size();
+  bool fast_path = k > 0 && k <= self.dim() && self.is_contiguous() &&
+      self.numel() > 0 && is_index_fast_path_dtype(self.scalar_type());
+  std::vector<at::Tensor> index_tensors;
+  for (int64_t d = 0; fast_path && d < k; d++) {
+    c10::optional<at::Tensor> index = indices.get(d);
+    fast_path = index.has_value() && index->defined() &&
+        index->scalar_type() == at::kLong &&
+        (d == 0 || index->sizes() == index_tensors[0].sizes());
+    if (fast_path) {
+      index_tensors.push_back(index->contiguous());
+    }
+  }
+  if (!fast_path) {
+    return at::cpu::index(self, indices);
+  }
+
+  const int64_t numel = index_tensors[0].numel();
+  int64_t rows = 1;
+  for (int64_t d = 0; d < k; d++) {
+    rows *= self.size(d);
+  }
+  auto linear_index = at::empty({numel}, index_tensors[0].options());
+  int64_t* linear_data = linear_index.data_ptr<int64_t>();
+  std::vector<const int64_t*> index_data;
+  for (const auto& index : index_tensors) {
+    index_data.push_back(index.data_ptr<int64_t>());
+  }
+  auto self_sizes = self.sizes();
+  at::parallel_for(
+      0, numel, at::internal::GRAIN_SIZE / k, [&](int64_t begin, int64_t end) {
+        for (const auto i : c10::irange(begin, end)) {
+          int64_t linear = 0;
+          for (int64_t d = 0; d < k; d++) {
+            int64_t size = self_sizes[d];
+            int64_t idx = index_data[d][i];
+            TORCH_CHECK_INDEX(
+                idx >= -size && idx < size,
+                "index ",
+                idx,
+                " is out of bounds for dimension ",
+                d,
+                " with size ",
+                size);
+            linear = linear * size + (idx < 0 ? idx + size : idx);
+          }
+          linear_data[i] = linear;
+        }
+      });
+
+  auto result_size = index_tensors[0].sizes().vec();
+  result_size.insert(
+      result_size.end(), self_sizes.begin() + k, self_sizes.end());
+  return index_select_cpu_(self.view({rows, -1}), 0, linear_index)
+      .view(result_size);
+}
+
+at::Tensor& index_add_cpu_(
+    at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index,
+    const at::Tensor& source,
+    const at::Scalar& alpha) {
+#if defined(IPEX_DISP_OP)
+  printf("torch_ipex::index_add_cpu_\n");
+#endif
+  RECORD_FUNCTION("torch_ipex::index_add_cpu_", c10::ArrayRef<c10::IValue>({}));
+
+  dim = at::maybe_wrap_dim(dim, self.dim());
+  if (!self.is_contiguous() || !index_add_fast_path(self, dim, index, source)) {
+    return at::cpu::index_add_(self, dim, index, source, alpha);
+  }
+  index_add_rows(self, dim, index, source, alpha);
+  return self;
+}
+
+at::Tensor index_add_cpu(
+    const at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index,
+    const at::Tensor& source,
+    const at::Scalar& alpha) {
+#if defined(IPEX_DISP_OP)
+  printf("torch_ipex::index_add_cpu\n");
+#endif
+  RECORD_FUNCTION("torch_ipex::index_add_cpu", c10::ArrayRef<c10::IValue>({}));
+
+  dim = at::maybe_wrap_dim(dim, self.dim());
+  if (!index_add_fast_path(self, dim, index, source)) {
+    return at::cpu::index_add(self, dim, index, source, alpha);
+  }
+  auto result = self.clone(at::MemoryFormat::Contiguous);
+  index_add_rows(result, dim, index, source, alpha);
+  return result;
+}
+
+at::Tensor& scatter_add_cpu_(
+    at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index,
+    const at::Tensor& src) {
+#if defined(IPEX_DISP_OP)
+  printf("torch_ipex::scatter_add_cpu_\n");
+#endif
+  RECORD_FUNCTION(
+      "torch_ipex::scatter_add_cpu_", c10::ArrayRef<c10::IValue>({}));
+
+  // The scatter_add of whole rows along dim 0 (e.g. the backward of a row
+  // gather, or the message aggregation of graph neural networks) is an
+  // index_add of the rows of src selected by the index.
+  dim = at::maybe_wrap_dim(dim, self.dim());
+  if (dim != 0 || !self.is_contiguous() || index.scalar_type() != at::kLong ||
+      !is_row_index(self, index) || src.dim() != self.dim() ||
+      src.size(0) < index.size(0)) {
+    return at::cpu::scatter_add_(self, dim, index, src);
+  }
+  auto source = src.narrow(0, 0, index.size(0));
+  for (int64_t d = 1; d < src.dim(); d++) {
+    if (src.size(d) != self.size(d)) {
+      return at::cpu::scatter_add_(self, dim, index, src);
+    }
+  }
+  auto rows = row_index(index);
+  if (!index_add_fast_path(self, 0, rows, source)) {
+    return at::cpu::scatter_add_(self, dim, index, src);
+  }
+  index_add_rows(self, 0, rows, source, 1);
+  return self;
+}
+
+at::Tensor scatter_add_cpu(
+    const at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index,
+    const at::Tensor& src) {
+#if defined(IPEX_DISP_OP)
+  printf("torch_ipex::scatter_add_cpu\n");
+#endif
+  RECORD_FUNCTION(
+      "torch_ipex::scatter_add_cpu", c10::ArrayRef<c10::IValue>({}));
+
+  auto result = self.clone(at::MemoryFormat::Contiguous);
+  return scatter_add_cpu_(result, dim, index, src);
+}
+
 IPEX_TORCH_LIBRARY_IMPL(aten, CPU, m) {
   m.impl(
       TORCH_SELECTIVE_NAME("aten::index_select"),
@@ -259,6 +537,24 @@ IPEX_TORCH_LIBRARY_IMPL(aten, CPU, m) {
   m.impl(
       TORCH_SELECTIVE_NAME("aten::index_select.out"),
       TORCH_FN((&torch_ipex::cpu::index_select_out_cpu_)));
+  m.impl(
+      TORCH_SELECTIVE_NAME("aten::gather"),
+      TORCH_FN((&torch_ipex::cpu::gather_cpu_)));
+  m.impl(
+      TORCH_SELECTIVE_NAME("aten::index.Tensor"),
+      TORCH_FN((&torch_ipex::cpu::index_cpu_)));
+  m.impl(
+      TORCH_SELECTIVE_NAME("aten::index_add_"),
+      TORCH_FN((&torch_ipex::cpu::index_add_cpu_)));
+  m.impl(
+      TORCH_SELECTIVE_NAME("aten::index_add"),
+      TORCH_FN((&torch_ipex::cpu::index_add_cpu)));
+  m.impl(
+      TORCH_SELECTIVE_NAME("aten::scatter_add_"),
+      TORCH_FN((&torch_ipex::cpu::scatter_add_cpu_)));
+  m.impl(
+      TORCH_SELECTIVE_NAME("aten::scatter_add"),
+      TORCH_FN((&torch_ipex::cpu::scatter_add_cpu)));
 }
 
 } // namespace cpu
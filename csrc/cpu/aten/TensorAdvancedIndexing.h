@@ -18,6 +18,42 @@ at::Tensor index_select_cpu_(
     int64_t dim,
     const at::Tensor& index);
 
+at::Tensor gather_cpu_(
+    const at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index,
+    bool sparse_grad);
+
+at::Tensor index_cpu_(
+    const at::Tensor& self,
+    const c10::List<c10::optional<at::Tensor>>& indices);
+
+at::Tensor& index_add_cpu_(
+    at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index,
+    const at::Tensor& source,
+    const at::Scalar& alpha);
+
+at::Tensor index_add_cpu(
+    const at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index,
+    const at::Tensor& source,
+    const at::Scalar& alpha);
+
+at::Tensor& scatter_add_cpu_(
+    at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index,
+    const at::Tensor& src);
+
+at::Tensor scatter_add_cpu(
+    const at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index,
+    const at::Tensor& src);
+
 namespace {
 
 void index_select_contig_kernel(
@@ -28,6 +64,18 @@ void index_select_contig_kernel(
 
 void copy_kernel(at::TensorIterator& iter, bool /*non_blocking*/);
 
+void gather_contig_kernel(
+    const at::Tensor& result,
+    const at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index);
+
+void index_add_contig_kernel(
+    const at::Tensor& self,
+    const at::Tensor& index,
+    const at::Tensor& source,
+    const at::Scalar& alpha);
+
 } // namespace
 
 using index_select_fn =
@@ -37,5 +85,20 @@ DECLARE_DISPATCH(index_select_fn, index_select_contig_stub);
 using copy_fn = void (*)(at::TensorIterator&, bool non_blocking);
 DECLARE_DISPATCH(copy_fn, copy_stub);
 
+// gather of contiguous self and int64 index, the index has the sizes of self
+// except along dim
+using gather_contig_fn =
+    void (*)(const at::Tensor&, const at::Tensor&, int64_t, const at::Tensor&);
+DECLARE_DISPATCH(gather_contig_fn, gather_contig_stub);
+
+// self[index[i]] += alpha * source[i] on the rows of contiguous self and
+// source, index may repeat
+using index_add_contig_fn = void (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Scalar&);
+DECLARE_DISPATCH(index_add_contig_fn, index_add_contig_stub);
+
 } // namespace cpu
 } // namespace torch_ipex
\ No newline at end of file
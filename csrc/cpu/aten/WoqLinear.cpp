@@ -0,0 +1,166 @@
+#include <torch/all.h>
+
+#include <torch/csrc/autograd/function.h>
+#include "WoqLinear.h"
+#include "cpu/kernels/OpContext.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+DEFINE_DISPATCH(woq_linear_kernel_stub);
+
+namespace {
+
+int64_t woq_qmax(at::ScalarType weight_dtype) {
+  TORCH_CHECK(
+      weight_dtype == at::kQInt8 || weight_dtype == at::kQUInt4x2,
+      "Weight-only quantized linear only supports torch.qint8 and "
+      "torch.quint4x2 weights, but got ",
+      weight_dtype);
+  return weight_dtype == at::kQInt8 ? 127 : 7;
+}
+
+int64_t woq_group_size(int64_t group_size, int64_t in_features) {
+  return group_size <= 0 || group_size > in_features ? in_features
+                                                     : group_size;
+}
+
+} // namespace
+
+std::tuple<at::Tensor, at::Tensor> woq_linear_pack_weight(
+    const at::Tensor& weight,
+    at::ScalarType weight_dtype,
+    int64_t group_size) {
+  TORCH_CHECK(
+      weight.dim() == 2 && weight.size(1) > 0,
+      "Weight-only quantized linear expects a non-empty 2-D weight");
+  auto qmax = woq_qmax(weight_dtype);
+  auto N = weight.size(0);
+  auto K = weight.size(1);
+  auto gs = woq_group_size(group_size, K);
+  auto groups = (K + gs - 1) / gs;
+  auto blocks = (N + kWoqNBlock - 1) / kWoqNBlock;
+
+  // pad N to whole blocks and K to whole groups with zeros
+  auto w = at::zeros({blocks * kWoqNBlock, groups * gs}, at::kFloat);
+  w.narrow(0, 0, N).narrow(1, 0, K).copy_(weight);
+  auto w_grouped = w.view({blocks * kWoqNBlock, groups, gs});
+  auto scales = w_grouped.abs().amax(-1).div_(qmax);
+  // all-zero groups get scale 1 to avoid dividing by zero
+  scales.masked_fill_(scales == 0, 1.f);
+  auto q = w_grouped.div(scales.unsqueeze(-1))
+               .round_()
+               .clamp_(-qmax, qmax)
+               .view({blocks, kWoqNBlock, groups * gs})
+               .narrow(2, 0, K)
+               .transpose(1, 2);
+
+  at::Tensor qweight;
+  if (weight_dtype == at::kQInt8) {
+    qweight = q.to(at::kChar).contiguous();
+  } else {
+    // two int4 values per byte: channel j of the block in the low nibble and
+    // channel j + kWoqNBlock / 2 in the high nibble
+    auto u = q.add(8).to(at::kByte);
+    auto lo = u.narrow(2, 0, kWoqNBlock / 2);
+    auto hi = u.narrow(2, kWoqNBlock / 2, kWoqNBlock / 2);
+    qweight = lo.bitwise_or(hi.__lshift__(4)).contiguous();
+  }
+  auto packed_scales = scales.view({blocks, kWoqNBlock, groups})
+                           .transpose(1, 2)
+                           .contiguous();
+  return std::make_tuple(qweight, packed_scales);
+}
+
+at::Tensor woq_linear_unpack_weight(
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    at::ScalarType weight_dtype,
+    int64_t out_features,
+    int64_t in_features,
+    int64_t group_size) {
+  woq_qmax(weight_dtype);
+  auto gs = woq_group_size(group_size, in_features);
+  at::Tensor q;
+  if (weight_dtype == at::kQInt8) {
+    q = qweight.to(at::kFloat);
+  } else {
+    auto lo = qweight.bitwise_and(0xF);
+    auto hi = qweight.__rshift__(4);
+    q = at::cat({lo, hi}, -1).to(at::kFloat).sub_(8);
+  }
+  auto group_index = at::arange(in_features, at::kLong).div_(gs, "floor");
+  auto w = q.mul_(scales.index_select(1, group_index));
+  return w.transpose(1, 2)
+      .reshape({-1, in_features})
+      .narrow(0, 0, out_features)
+      .contiguous();
+}
+
+/**
+ * Weight-only quantized linear: the weight is kept as int8/int4 and
+ * dequantized on the fly inside the GEMM micro kernel, the activation and
+ * the output stay in FP32 or BF16.
+ *
+ *@param self Activation input for Linear
+ *@param qweight Packed quantized weight, see woq_linear_pack_weight
+ *@param scales Packed FP32 scales, see woq_linear_pack_weight
+ *@param bias Bias for Linear, may be undefined
+ *@param weight_dtype at::kQInt8 or at::kQUInt4x2
+ *@param out_features Size of N-dim for Linear
+ *@param group_size Number of input channels sharing one scale
+ */
+at::Tensor woq_linear_kernel(
+    const at::Tensor& self,
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    const at::Tensor& bias,
+    at::ScalarType weight_dtype,
+    int64_t out_features,
+    int64_t group_size) {
+  TORCH_CHECK(
+      self.scalar_type() == at::kFloat || self.scalar_type() == at::kBFloat16,
+      "Weight-only quantized linear only supports FP32 and BF16 inputs");
+  auto input_size = self.sizes();
+  std::vector<int64_t> output_size(input_size.begin(), input_size.end() - 1);
+  output_size.push_back(out_features);
+  auto output = at::empty(output_size, self.options());
+  woq_linear_kernel_stub(
+      kCPU,
+      self,
+      qweight,
+      scales,
+      bias,
+      weight_dtype,
+      out_features,
+      group_size,
+      output);
+  return output;
+}
+
+at::Tensor woq_linear_forward(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias,
+    const at::Tensor& op_context) {
+  return reinterpret_cast<IpexWoqLinearOpContext*>(
+             op_context.data_ptr<int64_t>()[0])
+      ->run(input);
+}
+
+} // namespace cpu
+} // namespace torch_ipex
+
+namespace {
+
+TORCH_LIBRARY_FRAGMENT(torch_ipex, m) {
+  m.def(
+      "ipex_woq_linear(Tensor input, Tensor weight, Tensor? bias, "
+      "Tensor W_prepack) -> Tensor");
+  m.impl(
+      "ipex_woq_linear",
+      c10::DispatchKey::CPU,
+      torch_ipex::cpu::woq_linear_forward);
+}
+
+} // namespace
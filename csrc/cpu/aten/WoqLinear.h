@@ -0,0 +1,83 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/Tensor.h>
+#include <dyndisp/DispatchStub.h>
+#include <tuple>
+#include <vector>
+
+namespace torch_ipex {
+namespace cpu {
+
+// The quantized weight is stored in blocks of kWoqNBlock output channels.
+// Inside a block, the kWoqNBlock values of the same input channel are
+// contiguous, so that one vector load gets one column of the block.
+constexpr int64_t kWoqNBlock = 16;
+
+/**
+ * Quantize a 2-D [N, K] weight to int8 or int4 with symmetric per-channel
+ * (group_size <= 0) or group-wise scales along K, and pack it to the blocked
+ * layout used by the weight-only quantized linear kernel.
+ *
+ *@param weight FP32 or BF16 weight of the linear
+ *@param weight_dtype at::kQInt8 or at::kQUInt4x2
+ *@param group_size Number of input channels sharing one scale
+ *@return The packed weight and the FP32 scales in [N / kWoqNBlock, groups,
+ * kWoqNBlock] layout
+ */
+std::tuple<at::Tensor, at::Tensor> woq_linear_pack_weight(
+    const at::Tensor& weight,
+    at::ScalarType weight_dtype,
+    int64_t group_size);
+
+// Dequantize a packed weight back to the public FP32 [N, K] layout.
+at::Tensor woq_linear_unpack_weight(
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    at::ScalarType weight_dtype,
+    int64_t out_features,
+    int64_t in_features,
+    int64_t group_size);
+
+at::Tensor woq_linear_kernel(
+    const at::Tensor& self,
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    const at::Tensor& bias,
+    at::ScalarType weight_dtype,
+    int64_t out_features,
+    int64_t group_size);
+
+at::Tensor woq_linear_forward(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias,
+    const at::Tensor& op_context);
+
+namespace {
+
+void woq_linear_kernel_impl(
+    const at::Tensor& self,
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    const at::Tensor& bias,
+    at::ScalarType weight_dtype,
+    int64_t out_features,
+    int64_t group_size,
+    at::Tensor& output);
+
+} // namespace
+
+using woq_linear_kernel_fn = void (*)(
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    const at::Tensor&,
+    at::ScalarType,
+    int64_t,
+    int64_t,
+    at::Tensor&);
+DECLARE_DISPATCH(woq_linear_kernel_fn, woq_linear_kernel_stub);
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -8,6 +8,8 @@
 #include <torch/csrc/autograd/function.h>
 #include "vec/vec.h"
 
+#include <vector>
+
 namespace torch_ipex {
 namespace cpu {
 
@@ -56,6 +58,52 @@ void AddLayerNormKernelImpl(
     }
   });
 }
+
+template <typename T, typename T1>
+void AddLayerNormQuantizeKernelImpl(
+    const at::Tensor& a,
+    const at::Tensor& b,
+    const at::Tensor& gamma,
+    const at::Tensor& beta,
+    int64_t M,
+    int64_t N,
+    float eps,
+    float q_scale,
+    int64_t q_zero_point,
+    at::Tensor& Y,
+    at::Tensor& Y_q) {
+  const T* a_data = a.data_ptr<T>();
+  const T* b_data = b.data_ptr<T>();
+  const T1* gamma_data = gamma.defined() ? gamma.data_ptr<T1>() : nullptr;
+  const T1* beta_data = beta.defined() ? beta.data_ptr<T1>() : nullptr;
+  T* Y_data = Y.defined() ? Y.data_ptr<T>() : nullptr;
+  auto Y_q_data = static_cast<int8_t*>(Y_q.data_ptr());
+  const bool is_signed = Y_q.scalar_type() == at::kQInt8;
+  const float c = float(1) / static_cast<float>(N);
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    std::vector<float> tmp_out(N);
+    for (const auto i : c10::irange(start, end)) {
+      float mean_val;
+      float rstd_val;
+      std::tie(mean_val, rstd_val) = kernel::_add_and_compute_mean_var<T>(
+          a_data + i * N, b_data + i * N, N, tmp_out.data());
+      rstd_val = std::max(rstd_val * c - mean_val * mean_val, float(0));
+      rstd_val = float(1.0) / std::sqrt(rstd_val + eps);
+      kernel::_normalize_quantize_kernel<T, T1>(
+          Y_data == nullptr ? nullptr : Y_data + i * N,
+          Y_q_data + i * N,
+          tmp_out.data(),
+          N,
+          rstd_val,
+          -rstd_val * mean_val,
+          gamma_data,
+          beta_data,
+          q_scale,
+          q_zero_point,
+          is_signed);
+    }
+  });
+}
 #endif
 
 at::Tensor add_layer_norm_kernel_impl(
@@ -108,9 +156,61 @@ at::Tensor add_layer_norm_kernel_impl(
 #endif
 }
 
+std::tuple<at::Tensor, at::Tensor> add_layer_norm_quantize_kernel_impl(
+    const at::Tensor& a,
+    const at::Tensor& b,
+    at::IntArrayRef normalized_shape,
+    const c10::optional<at::Tensor>& weight_opt,
+    const c10::optional<at::Tensor>& bias_opt,
+    float eps,
+    double q_scale,
+    int64_t q_zero_point,
+    at::ScalarType q_dtype,
+    bool output_float) {
+#if defined(CPU_CAPABILITY_AVX512)
+  c10::MaybeOwned<Tensor> weight_maybe_owned =
+      at::borrow_from_optional_tensor(weight_opt);
+  const at::Tensor& weight = *weight_maybe_owned;
+  c10::MaybeOwned<Tensor> bias_maybe_owned =
+      at::borrow_from_optional_tensor(bias_opt);
+  const at::Tensor& bias = *bias_maybe_owned;
+
+  auto M_N = _check_layer_norm_inputs(a, normalized_shape, weight, bias);
+  auto M = M_N.first;
+  auto N = M_N.second;
+  auto gamma = weight.defined() ? weight.contiguous() : weight;
+  auto beta = bias.defined() ? bias.contiguous() : bias;
+
+  // gamma and beta have the same dtype, see dil_add_layernorm_quantize
+  const auto& affine = gamma.defined() ? gamma : beta;
+  at::Tensor Y = output_float ? at::empty_like(a) : at::Tensor();
+  at::Tensor Y_q = at::_empty_affine_quantized(
+      a.sizes(), a.options().dtype(q_dtype), q_scale, q_zero_point);
+  if (a.scalar_type() == at::kFloat) {
+    AddLayerNormQuantizeKernelImpl<float, float>(
+        a, b, gamma, beta, M, N, eps, q_scale, q_zero_point, Y, Y_q);
+  } else if (affine.defined() && affine.scalar_type() == at::kBFloat16) {
+    AddLayerNormQuantizeKernelImpl<at::BFloat16, at::BFloat16>(
+        a, b, gamma, beta, M, N, eps, q_scale, q_zero_point, Y, Y_q);
+  } else {
+    AddLayerNormQuantizeKernelImpl<at::BFloat16, float>(
+        a, b, gamma, beta, M, N, eps, q_scale, q_zero_point, Y, Y_q);
+  }
+  return std::make_tuple(Y, Y_q);
+#else
+  auto Y = at::layer_norm(
+      at::add(a, b), normalized_shape, weight_opt, bias_opt, eps);
+  auto Y_q = at::quantize_per_tensor(Y, q_scale, q_zero_point, q_dtype);
+  return std::make_tuple(output_float ? Y : at::Tensor(), Y_q);
+#endif
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(add_layer_norm_kernel_stub, &add_layer_norm_kernel_impl);
+REGISTER_DISPATCH(
+    add_layer_norm_quantize_kernel_stub,
+    &add_layer_norm_quantize_kernel_impl);
 
 } // namespace cpu
 } // namespace torch_ipex
\ No newline at end of file
@@ -0,0 +1,403 @@
+#include <aten/BatchNorm.h>
+
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec/vec.h>
+#include <c10/util/irange.h>
+
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+using at::BFloat16;
+using fVec = at::vec::Vectorized<float>;
+using bVec = at::vec::Vectorized<BFloat16>;
+
+// The channel sums of a thread are accumulated in FP32 over blocks of rows and
+// folded into FP64, which keeps the statistics of large batches accurate.
+constexpr int64_t kRowBlock = 64;
+
+// Returns a row of C channels as FP32, converted into tmp for BF16.
+inline const float* LoadRow(const float* X, float* tmp, int64_t C) {
+  return X;
+}
+
+inline const float* LoadRow(const BFloat16* X, float* tmp, int64_t C) {
+  constexpr int64_t K = bVec::size();
+  int64_t c = 0;
+  for (; c < C / K * K; c += K) {
+    fVec x0, x1;
+    std::tie(x0, x1) = at::vec::convert_bfloat16_float(bVec::loadu(X + c));
+    x0.store(tmp + c);
+    x1.store(tmp + c + fVec::size());
+  }
+  for (; c < C; c++) {
+    tmp[c] = static_cast<float>(X[c]);
+  }
+  return tmp;
+}
+
+inline void StoreRow(const float* src, float* Y, int64_t C) {
+  if (src != Y) {
+    std::copy(src, src + C, Y);
+  }
+}
+
+inline void StoreRow(const float* src, BFloat16* Y, int64_t C) {
+  constexpr int64_t K = bVec::size();
+  int64_t c = 0;
+  for (; c < C / K * K; c += K) {
+    at::vec::convert_float_bfloat16(
+        fVec::loadu(src + c), fVec::loadu(src + c + fVec::size()))
+        .store(Y + c);
+  }
+  for (; c < C; c++) {
+    Y[c] = static_cast<BFloat16>(src[c]);
+  }
+}
+
+// acc += x, or acc += (x - mean)^2 if kCentered
+template <bool kCentered>
+inline void AccumulateRow(
+    float* acc,
+    const float* x,
+    const float* mean,
+    int64_t C) {
+  for (int64_t c = 0; c < C; c += fVec::size()) {
+    auto count = std::min<int64_t>(fVec::size(), C - c);
+    fVec v = fVec::loadu(x + c, count);
+    if (kCentered) {
+      v = v - fVec::loadu(mean + c, count);
+      v = v * v;
+    }
+    (fVec::loadu(acc + c, count) + v).store(acc + c, count);
+  }
+}
+
+// Sums over the rows of X per channel, of (X - mean)^2 if kCentered.
+template <typename T, bool kCentered>
+std::vector<double> ChannelSums(
+    const T* X_data,
+    const float* mean,
+    int64_t M,
+    int64_t C) {
+  int num_threads = at::get_num_threads();
+  std::vector<double> sums(num_threads * C, 0.0);
+  at::parallel_for(0, M, kRowBlock, [&](int64_t begin, int64_t end) {
+    double* sum_ptr = sums.data() + at::get_thread_num() * C;
+    std::vector<float> block(C);
+    std::vector<float> tmp(C);
+    for (int64_t i = begin; i < end; i += kRowBlock) {
+      std::fill(block.begin(), block.end(), 0.f);
+      for (int64_t r = i; r < std::min(i + kRowBlock, end); r++) {
+        AccumulateRow<kCentered>(
+            block.data(), LoadRow(X_data + r * C, tmp.data(), C), mean, C);
+      }
+      for (const auto c : c10::irange(C)) {
+        sum_ptr[c] += block[c];
+      }
+    }
+  });
+  for (const auto t : c10::irange(1, num_threads)) {
+    for (const auto c : c10::irange(C)) {
+      sums[c] += sums[t * C + c];
+    }
+  }
+  sums.resize(C);
+  return sums;
+}
+
+// y = relu(x * scale + shift (+ other)) for a row, one mask bit per channel
+template <bool kAdd>
+inline void ApplyScaleShiftReLU(
+    float* y,
+    const float* x,
+    const float* scale,
+    const float* shift,
+    const float* other,
+    uint8_t* mask,
+    int64_t C) {
+  const fVec zero(0.f);
+  for (int64_t c = 0; c < C; c += fVec::size()) {
+    auto count = std::min<int64_t>(fVec::size(), C - c);
+    fVec v = fVec::loadu(x + c, count) * fVec::loadu(scale + c, count) +
+        fVec::loadu(shift + c, count);
+    if (kAdd) {
+      v = v + fVec::loadu(other + c, count);
+    }
+    at::vec::maximum(v, zero).store(y + c, count);
+  }
+  for (int64_t c = 0; c < C; c += 8) {
+    uint8_t bits = 0;
+    for (int64_t k = 0; k < std::min<int64_t>(8, C - c); k++) {
+      bits |= static_cast<uint8_t>(y[c + k] > 0.f) << k;
+    }
+    mask[c / 8] = bits;
+  }
+}
+
+inline void UnpackMask(const uint8_t* mask, float* m, int64_t C) {
+  for (const auto c : c10::irange(C)) {
+    m[c] = static_cast<float>((mask[c / 8] >> (c % 8)) & 1);
+  }
+}
+
+// The batch mean and biased var per channel, in two passes over X. A second
+// centered pass is as cheap as the fused E[x^2] - E[x]^2 on channels last
+// rows and does not lose the variance to cancellation.
+template <typename T>
+void BatchNormStatisticsInternal(
+    const at::Tensor& X,
+    at::Tensor& mean,
+    at::Tensor& var) {
+  const int64_t C = X.size(1);
+  const int64_t M = X.numel() / C;
+  const T* X_data = X.data_ptr<T>();
+  float* mean_data = mean.data_ptr<float>();
+  float* var_data = var.data_ptr<float>();
+
+  auto sums = ChannelSums<T, false>(X_data, nullptr, M, C);
+  for (const auto c : c10::irange(C)) {
+    mean_data[c] = static_cast<float>(sums[c] / M);
+  }
+  auto var_sums = ChannelSums<T, true>(X_data, mean_data, M, C);
+  for (const auto c : c10::irange(C)) {
+    var_data[c] = static_cast<float>(var_sums[c] / M);
+  }
+}
+
+// Y = relu(X * scale + shift (+ other)) and its mask in one pass over X. The
+// unfused ops make at least two more passes, and the ReLU saves its whole
+// output for the backward instead of the mask.
+template <typename T, bool kAdd>
+void BatchNormReLUApplyImplInternal(
+    const at::Tensor& X,
+    const at::Tensor& other,
+    const at::Tensor& weight,
+    const at::Tensor& bias,
+    const at::Tensor& mean,
+    const at::Tensor& var,
+    double eps,
+    at::Tensor& Y,
+    at::Tensor& mask) {
+  const int64_t C = X.size(1);
+  const int64_t M = X.numel() / C;
+  const int64_t mask_row = (C + 7) / 8;
+  const T* X_data = X.data_ptr<T>();
+  const T* other_data = kAdd ? other.data_ptr<T>() : nullptr;
+  const float* weight_data = weight.data_ptr<float>();
+  const float* bias_data = bias.data_ptr<float>();
+  const float* mean_data = mean.data_ptr<float>();
+  const float* var_data = var.data_ptr<float>();
+  T* Y_data = Y.data_ptr<T>();
+  uint8_t* mask_data = mask.data_ptr<uint8_t>();
+
+  std::vector<float> scale(C), shift(C);
+  for (const auto c : c10::irange(C)) {
+    float invstd = 1.f / std::sqrt(var_data[c] + static_cast<float>(eps));
+    scale[c] = invstd * weight_data[c];
+    shift[c] = bias_data[c] - mean_data[c] * scale[c];
+  }
+
+  at::parallel_for(0, M, kRowBlock, [&](int64_t begin, int64_t end) {
+    std::vector<float> x_tmp(C), other_tmp(C), y_tmp(C);
+    for (const auto i : c10::irange(begin, end)) {
+      float* y = std::is_same<T, float>::value
+          ? reinterpret_cast<float*>(Y_data + i * C)
+          : y_tmp.data();
+      ApplyScaleShiftReLU<kAdd>(
+          y,
+          LoadRow(X_data + i * C, x_tmp.data(), C),
+          scale.data(),
+          shift.data(),
+          kAdd ? LoadRow(other_data + i * C, other_tmp.data(), C) : nullptr,
+          mask_data + i * mask_row,
+          C);
+      StoreRow(y, Y_data + i * C, C);
+    }
+  });
+}
+
+void BatchNormReLUForwardImpl(
+    const at::Tensor& X,
+    const at::Tensor& other,
+    const at::Tensor& weight,
+    const at::Tensor& bias,
+    double eps,
+    at::Tensor& Y,
+    at::Tensor& mean,
+    at::Tensor& var,
+    at::Tensor& mask) {
+  TORCH_CHECK(
+      X.scalar_type() == at::kFloat || X.scalar_type() == at::kBFloat16,
+      "BatchNormReLUForwardImpl: only supports FP32 and BF16");
+  if (X.scalar_type() == at::kFloat) {
+    BatchNormStatisticsInternal<float>(X, mean, var);
+    if (other.defined()) {
+      BatchNormReLUApplyImplInternal<float, true>(
+          X, other, weight, bias, mean, var, eps, Y, mask);
+    } else {
+      BatchNormReLUApplyImplInternal<float, false>(
+          X, other, weight, bias, mean, var, eps, Y, mask);
+    }
+  } else {
+    BatchNormStatisticsInternal<BFloat16>(X, mean, var);
+    if (other.defined()) {
+      BatchNormReLUApplyImplInternal<BFloat16, true>(
+          X, other, weight, bias, mean, var, eps, Y, mask);
+    } else {
+      BatchNormReLUApplyImplInternal<BFloat16, false>(
+          X, other, weight, bias, mean, var, eps, Y, mask);
+    }
+  }
+}
+
+// The backward of relu(batch_norm(X) (+ other)) in two passes over dY and X.
+// With g = dY * mask and x_hat = (X - mean) * invstd:
+//   dbias = sum(g), dweight = sum(g * x_hat)
+//   dX = weight * invstd * (g - dbias / M - x_hat * dweight / M)
+//   dother = g
+template <typename T, bool kAdd>
+void BatchNormReLUBackwardImplInternal(
+    const at::Tensor& dY,
+    const at::Tensor& X,
+    const at::Tensor& mask,
+    const at::Tensor& mean,
+    const at::Tensor& invstd,
+    const at::Tensor& weight,
+    at::Tensor& dX,
+    at::Tensor& dother,
+    at::Tensor& dweight,
+    at::Tensor& dbias) {
+  const int64_t C = X.size(1);
+  const int64_t M = X.numel() / C;
+  const int64_t mask_row = (C + 7) / 8;
+  const T* dY_data = dY.data_ptr<T>();
+  const T* X_data = X.data_ptr<T>();
+  const uint8_t* mask_data = mask.data_ptr<uint8_t>();
+  const float* mean_data = mean.data_ptr<float>();
+  const float* invstd_data = invstd.data_ptr<float>();
+  const float* weight_data = weight.data_ptr<float>();
+  T* dX_data = dX.data_ptr<T>();
+  T* dother_data = kAdd ? dother.data_ptr<T>() : nullptr;
+
+  // sum(g) and sum(g * (X - mean)) per channel
+  int num_threads = at::get_num_threads();
+  std::vector<double> sums(num_threads * 2 * C, 0.0);
+  at::parallel_for(0, M, kRowBlock, [&](int64_t begin, int64_t end) {
+    double* sum_ptr = sums.data() + at::get_thread_num() * 2 * C;
+    std::vector<float> block(2 * C), m(C), dy_tmp(C), x_tmp(C);
+    for (int64_t i = begin; i < end; i += kRowBlock) {
+      std::fill(block.begin(), block.end(), 0.f);
+      for (int64_t r = i; r < std::min(i + kRowBlock, end); r++) {
+        UnpackMask(mask_data + r * mask_row, m.data(), C);
+        const float* dy = LoadRow(dY_data + r * C, dy_tmp.data(), C);
+        const float* x = LoadRow(X_data + r * C, x_tmp.data(), C);
+        for (int64_t c = 0; c < C; c += fVec::size()) {
+          auto count = std::min<int64_t>(fVec::size(), C - c);
+          fVec g =
+              fVec::loadu(dy + c, count) * fVec::loadu(m.data() + c, count);
+          fVec xc =
+              fVec::loadu(x + c, count) - fVec::loadu(mean_data + c, count);
+          float* sum_g = block.data() + c;
+          float* sum_gx = block.data() + C + c;
+          (fVec::loadu(sum_g, count) + g).store(sum_g, count);
+          (fVec::loadu(sum_gx, count) + g * xc).store(sum_gx, count);
+        }
+      }
+      for (const auto c : c10::irange(2 * C)) {
+        sum_ptr[c] += block[c];
+      }
+    }
+  });
+  for (const auto t : c10::irange(1, num_threads)) {
+    for (const auto c : c10::irange(2 * C)) {
+      sums[c] += sums[t * 2 * C + c];
+    }
+  }
+
+  // dX = a * g - k * X + d per channel
+  std::vector<float> a(C), k(C), d(C);
+  float* dweight_data = dweight.data_ptr<float>();
+  float* dbias_data = dbias.data_ptr<float>();
+  for (const auto c : c10::irange(C)) {
+    const float sum_g = static_cast<float>(sums[c]);
+    const float sum_gx = static_cast<float>(sums[C + c]);
+    dbias_data[c] = sum_g;
+    dweight_data[c] = sum_gx * invstd_data[c];
+    a[c] = weight_data[c] * invstd_data[c];
+    k[c] = a[c] * invstd_data[c] * invstd_data[c] * sum_gx / M;
+    d[c] = k[c] * mean_data[c] - a[c] * sum_g / M;
+  }
+
+  at::parallel_for(0, M, kRowBlock, [&](int64_t begin, int64_t end) {
+    std::vector<float> m(C), dy_tmp(C), x_tmp(C), g(C), dx_tmp(C);
+    for (const auto i : c10::irange(begin, end)) {
+      UnpackMask(mask_data + i * mask_row, m.data(), C);
+      const float* dy = LoadRow(dY_data + i * C, dy_tmp.data(), C);
+      const float* x = LoadRow(X_data + i * C, x_tmp.data(), C);
+      float* dx = std::is_same<T, float>::value
+          ? reinterpret_cast<float*>(dX_data + i * C)
+          : dx_tmp.data();
+      for (int64_t c = 0; c < C; c += fVec::size()) {
+        auto count = std::min<int64_t>(fVec::size(), C - c);
+        fVec gv = fVec::loadu(dy + c, count) * fVec::loadu(m.data() + c, count);
+        gv.store(g.data() + c, count);
+        (fVec::loadu(a.data() + c, count) * gv -
+         fVec::loadu(k.data() + c, count) * fVec::loadu(x + c, count) +
+         fVec::loadu(d.data() + c, count))
+            .store(dx + c, count);
+      }
+      StoreRow(dx, dX_data + i * C, C);
+      if (kAdd) {
+        StoreRow(g.data(), dother_data + i * C, C);
+      }
+    }
+  });
+}
+
+void BatchNormReLUBackwardImpl(
+    const at::Tensor& dY,
+    const at::Tensor& X,
+    const at::Tensor& mask,
+    const at::Tensor& mean,
+    const at::Tensor& invstd,
+    const at::Tensor& weight,
+    at::Tensor& dX,
+    at::Tensor& dother,
+    at::Tensor& dweight,
+    at::Tensor& dbias) {
+  TORCH_CHECK(
+      X.scalar_type() == at::kFloat || X.scalar_type() == at::kBFloat16,
+      "BatchNormReLUBackwardImpl: only supports FP32 and BF16");
+  if (X.scalar_type() == at::kFloat) {
+    if (dother.defined()) {
+      BatchNormReLUBackwardImplInternal<float, true>(
+          dY, X, mask, mean, invstd, weight, dX, dother, dweight, dbias);
+    } else {
+      BatchNormReLUBackwardImplInternal<float, false>(
+          dY, X, mask, mean, invstd, weight, dX, dother, dweight, dbias);
+    }
+  } else {
+    if (dother.defined()) {
+      BatchNormReLUBackwardImplInternal<BFloat16, true>(
+          dY, X, mask, mean, invstd, weight, dX, dother, dweight, dbias);
+    } else {
+      BatchNormReLUBackwardImplInternal<BFloat16, false>(
+          dY, X, mask, mean, invstd, weight, dX, dother, dweight, dbias);
+    }
+  }
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(batch_norm_relu_forward_stub, &BatchNormReLUForwardImpl);
+REGISTER_DISPATCH(batch_norm_relu_backward_stub, &BatchNormReLUBackwardImpl);
+
+} // namespace cpu
+} // namespace torch_ipex
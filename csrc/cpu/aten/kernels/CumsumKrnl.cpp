@@ -22,103 +22,262 @@ inline int64_t divup(int64_t x, int64_t y) {
   return (x + y - 1) / y;
 }
 
+// Accumulation type of the scan, BF16 values are summed in FP32 and rounded
+// once when they are stored
 template <typename scalar_t>
-static inline void cumsum_lastdim_kernel(
-    at::Tensor& result,
-    const at::Tensor& self,
-    int64_t dim) {
-  const auto input_ndim = self.dim();
-  TORCH_CHECK(
-      dim == input_ndim - 1,
-      "cumsum_lastdim_kernel: expect dim to be ",
-      input_ndim - 1,
-      " got ",
-      dim);
-  TORCH_CHECK(
-      self.scalar_type() == result.scalar_type(),
-      "cumsum_lastdim_kernel: expect same data type for self and result");
-
-  if (result.sizes() != self.sizes()) {
-    result.resize_as_(self);
+struct CumsumAccType {
+  using type = scalar_t;
+};
+
+template <>
+struct CumsumAccType<at::BFloat16> {
+  using type = float;
+};
+
+// Input bytes scanned by one thread per block of the block scan, so that the
+// block read by the reduction pass is still in L2 for the scan pass
+constexpr int64_t kCumsumBlockBytes = 256 * 1024;
+// Inner elements scanned together when scanning along a non-last dim
+constexpr int64_t kCumsumInnerBlock = 256;
+
+// Sum of src[0, n)
+template <typename scalar_t>
+inline scalar_t cumsum_reduce(const scalar_t* src, int64_t n) {
+  return at::vec::reduce_all<scalar_t>(
+      [](Vectorized<scalar_t>& x, Vectorized<scalar_t>& y) { return x + y; },
+      src,
+      n);
+}
+
+inline float cumsum_reduce(const at::BFloat16* src, int64_t n) {
+  using bVec = Vectorized<at::BFloat16>;
+  using fVec = Vectorized<float>;
+  fVec acc0(0.f);
+  fVec acc1(0.f);
+  int64_t i = 0;
+  for (; i + bVec::size() <= n; i += bVec::size()) {
+    fVec x0, x1;
+    std::tie(x0, x1) = convert_bfloat16_float(bVec::loadu(src + i));
+    acc0 = acc0 + x0;
+    acc1 = acc1 + x1;
+  }
+  float sum = vec_reduce_all<float>(
+      [](fVec& x, fVec& y) { return x + y; }, acc0 + acc1);
+  for (; i < n; i++) {
+    sum += static_cast<float>(src[i]);
+  }
+  return sum;
+}
+
+// dst[i] = init + src[0] + ... + src[i] for i < n, returns the last sum
+template <typename scalar_t>
+inline scalar_t cumsum_row(
+    const scalar_t* src,
+    scalar_t* dst,
+    scalar_t init,
+    int64_t n) {
+  prefix_sum<scalar_t>(src, dst, init, n);
+  return n > 0 ? dst[n - 1] : init;
+}
+
+inline float cumsum_row(
+    const at::BFloat16* src,
+    at::BFloat16* dst,
+    float init,
+    int64_t n) {
+  float sum = init;
+  for (int64_t i = 0; i < n; i++) {
+    sum += static_cast<float>(src[i]);
+    dst[i] = static_cast<at::BFloat16>(sum);
+  }
+  return sum;
+}
+
+// acc[i] += src[i] for i < n, and dst[i] = acc[i] if dst is not null. Used
+// to scan along a non-last dim, where the n inner elements of one row are
+// contiguous and are summed with the same elements of the previous rows.
+template <typename scalar_t>
+inline void cumsum_accumulate(
+    const scalar_t* src,
+    scalar_t* dst,
+    scalar_t* acc,
+    int64_t n) {
+  using Vec = Vectorized<scalar_t>;
+  int64_t i = 0;
+  for (; i + Vec::size() <= n; i += Vec::size()) {
+    auto sum = Vec::loadu(acc + i) + Vec::loadu(src + i);
+    sum.store(acc + i);
+    if (dst != nullptr) {
+      sum.store(dst + i);
+    }
+  }
+  for (; i < n; i++) {
+    acc[i] += src[i];
+    if (dst != nullptr) {
+      dst[i] = acc[i];
+    }
+  }
+}
+
+inline void cumsum_accumulate(
+    const at::BFloat16* src,
+    at::BFloat16* dst,
+    float* acc,
+    int64_t n) {
+  using bVec = Vectorized<at::BFloat16>;
+  using fVec = Vectorized<float>;
+  int64_t i = 0;
+  for (; i + bVec::size() <= n; i += bVec::size()) {
+    fVec x0, x1;
+    std::tie(x0, x1) = convert_bfloat16_float(bVec::loadu(src + i));
+    auto sum0 = fVec::loadu(acc + i) + x0;
+    auto sum1 = fVec::loadu(acc + i + fVec::size()) + x1;
+    sum0.store(acc + i);
+    sum1.store(acc + i + fVec::size());
+    if (dst != nullptr) {
+      convert_float_bfloat16(sum0, sum1).store(dst + i);
+    }
   }
+  for (; i < n; i++) {
+    acc[i] += static_cast<float>(src[i]);
+    if (dst != nullptr) {
+      dst[i] = static_cast<at::BFloat16>(acc[i]);
+    }
+  }
+}
+
+// Scans rows [begin, end) of a [N, inner] slice starting from acc, and
+// leaves the sums of the last row in acc. Only accumulates if dst is null.
+template <typename scalar_t, typename acc_t>
+inline void cumsum_rows(
+    const scalar_t* src,
+    scalar_t* dst,
+    acc_t* acc,
+    int64_t begin,
+    int64_t end,
+    int64_t inner) {
+  if (inner == 1) {
+    if (dst == nullptr) {
+      acc[0] += cumsum_reduce(src + begin, end - begin);
+    } else {
+      acc[0] = cumsum_row(src + begin, dst + begin, acc[0], end - begin);
+    }
+    return;
+  }
+  for (int64_t n = begin; n < end; n++) {
+    cumsum_accumulate(
+        src + n * inner,
+        dst != nullptr ? dst + n * inner : nullptr,
+        acc,
+        inner);
+  }
+}
+
+// Cumulative sum of a contiguous tensor along dim, viewed as [outer, N,
+// inner]. Independent [N] lines are scanned in parallel when there are
+// enough of them for the threads. Otherwise each line is scanned by a
+// two-pass block scan: the line is split into chunks of one block per
+// thread, the first pass sums each block, the sums are scanned serially and
+// the second pass scans each block starting from the sum of the blocks
+// before it, while the block is still in L2.
+template <typename scalar_t>
+void cumsum_kernel(at::Tensor& result, const at::Tensor& self, int64_t dim) {
+  using acc_t = typename CumsumAccType<scalar_t>::type;
   if (self.numel() == 0) {
     return;
   }
-  if (input_ndim == 0) {
+  if (self.dim() == 0) {
     result.fill_(self);
     return;
   }
 
-  int64_t N = self.size(dim);
-  int64_t M = self.numel() / N;
+  const int64_t N = self.size(dim);
+  int64_t outer = 1;
+  for (int64_t i = 0; i < dim; i++) {
+    outer *= self.size(i);
+  }
+  const int64_t inner = self.numel() / outer / N;
   const scalar_t* self_data = self.data_ptr<scalar_t>();
   scalar_t* result_data = result.data_ptr<scalar_t>();
 
-  int64_t T = at::get_num_threads();
-
-  // bytes per core for each chunk, set to 256KB (L2 cache reside)
-  constexpr int64_t CHUNK_SIZE_PER_CORE = 256 * 1024 / sizeof(scalar_t);
-  int64_t CHUNK_SIZE = std::max(int64_t(1), CHUNK_SIZE_PER_CORE / M * T);
-  int64_t K = divup(N, CHUNK_SIZE);
-
-  // offset value per chunk
-  std::vector<scalar_t> outer_offsets(M, scalar_t(0));
-
-  // offset value per thread
-  std::vector<scalar_t> inner_offsets(M * T, scalar_t(0));
-
-  for (int64_t k = 0; k < K; k++) {
-    int64_t k_begin = k * CHUNK_SIZE;
-    int64_t k_end = std::min(k_begin + CHUNK_SIZE, N);
-
-    // Parallel Path I: accumulate locally per thread
-    at::parallel_for(k_begin, k_end, 1, [&](int64_t begin, int64_t end) {
-      int64_t tid = at::get_thread_num();
-      for (int64_t m = 0; m < M; m++) {
-        const scalar_t* self_ptr = self_data + m * N + begin;
-        scalar_t* result_ptr = result_data + m * N + begin;
-        int64_t len = end - begin;
+  const int64_t num_threads = at::get_num_threads();
+  const int64_t inner_block = std::min(inner, kCumsumInnerBlock);
+  const int64_t inner_blocks = divup(inner, inner_block);
+  const int64_t block_rows = std::max(
+      int64_t(1), kCumsumBlockBytes / int64_t(sizeof(scalar_t)) / inner);
+
+  if (outer * inner_blocks >= num_threads || N <= block_rows) {
+    at::parallel_for(
+        0, outer * inner_blocks, 1, [&](int64_t begin, int64_t end) {
+          std::vector<acc_t> acc(inner_block);
+          for (int64_t task = begin; task < end; task++) {
+            int64_t o = task / inner_blocks;
+            int64_t i_begin = task % inner_blocks * inner_block;
+            int64_t len = std::min(inner_block, inner - i_begin);
+            std::fill(acc.begin(), acc.end(), acc_t(0));
+            const scalar_t* src = self_data + o * N * inner + i_begin;
+            scalar_t* dst = result_data + o * N * inner + i_begin;
+            if (inner == 1) {
+              cumsum_rows(src, dst, acc.data(), 0, N, 1);
+              continue;
+            }
+            for (int64_t n = 0; n < N; n++) {
+              cumsum_accumulate(
+                  src + n * inner, dst + n * inner, acc.data(), len);
+            }
+          }
+        });
+    return;
+  }
 
-        prefix_sum<scalar_t>(self_ptr, result_ptr, scalar_t(0), len);
-        inner_offsets[m * T + tid] = result_ptr[len - 1];
-      }
-    });
-
-    // update offset value for each thread
-    for (int64_t m = 0; m < M; m++) {
-      for (int64_t t = T - 1; t >= 0; t--) {
-        scalar_t offset = scalar_t(0);
-        for (int64_t i = t - 1; i >= 0; i--) {
-          offset += inner_offsets[m * T + i];
+  const int64_t chunk_rows = block_rows * num_threads;
+  // carry: sums of the chunks before the current one
+  std::vector<acc_t> carry(inner);
+  // sums of the blocks of the current chunk, exclusive-scanned in place
+  std::vector<acc_t> partial(num_threads * inner);
+  for (int64_t o = 0; o < outer; o++) {
+    const scalar_t* src = self_data + o * N * inner;
+    scalar_t* dst = result_data + o * N * inner;
+    std::fill(carry.begin(), carry.end(), acc_t(0));
+    for (int64_t c_begin = 0; c_begin < N; c_begin += chunk_rows) {
+      const int64_t c_end = std::min(N, c_begin + chunk_rows);
+      const int64_t blocks = divup(c_end - c_begin, block_rows);
+
+      // Pass I: sum of each block
+      std::fill(partial.begin(), partial.end(), acc_t(0));
+      at::parallel_for(0, blocks, 1, [&](int64_t begin, int64_t end) {
+        for (int64_t b = begin; b < end; b++) {
+          int64_t r_begin = c_begin + b * block_rows;
+          int64_t r_end = std::min(c_end, r_begin + block_rows);
+          cumsum_rows(
+              src,
+              static_cast<scalar_t*>(nullptr),
+              partial.data() + b * inner,
+              r_begin,
+              r_end,
+              inner);
+        }
+      });
+
+      // offset of each block: carry + sums of the blocks before it
+      for (int64_t b = 0; b < blocks; b++) {
+        acc_t* block_partial = partial.data() + b * inner;
+        for (int64_t i = 0; i < inner; i++) {
+          acc_t sum = block_partial[i];
+          block_partial[i] = carry[i];
+          carry[i] += sum;
         }
-        inner_offsets[m * T + t] = offset;
-      }
-    }
-
-    // Parallel Path II: apply offset (result should be in L2)
-    at::parallel_for(k_begin, k_end, 1, [&](int64_t begin, int64_t end) {
-      int64_t tid = at::get_thread_num();
-      for (int64_t m = 0; m < M; m++) {
-        scalar_t* result_ptr = result_data + m * N + begin;
-        int64_t len = end - begin;
-
-        scalar_t offset = outer_offsets[m] + inner_offsets[m * T + tid];
-        at::vec::map(
-            [=](Vectorized<scalar_t> x) {
-              return x + Vectorized<scalar_t>(offset);
-            },
-            result_ptr,
-            result_ptr,
-            len);
       }
-    });
 
-    // reinit inner offset value
-    std::fill(inner_offsets.begin(), inner_offsets.end(), scalar_t(0));
-
-    // update outer offset value
-    for (int64_t m = 0; m < M; m++) {
-      outer_offsets[m] = result_data[m * N + k_end - 1];
+      // Pass II: scan each block from its offset, the block is in L2
+      at::parallel_for(0, blocks, 1, [&](int64_t begin, int64_t end) {
+        for (int64_t b = begin; b < end; b++) {
+          int64_t r_begin = c_begin + b * block_rows;
+          int64_t r_end = std::min(c_end, r_begin + block_rows);
+          cumsum_rows(
+              src, dst, partial.data() + b * inner, r_begin, r_end, inner);
+        }
+      });
     }
   }
 }
@@ -132,17 +291,16 @@ bool cumsum_fast_path(
   bool is_contig = self.is_contiguous() && (result.is_contiguous());
   if (!is_contig)
     return false;
-  // check dim
-  auto wrap_dim = at::maybe_wrap_dim(dim, self.dim());
-  if (wrap_dim != self.dim() - 1)
-    return false;
   // check dtype matched
   auto out_dtype = result.scalar_type();
-  if (dtype.has_value() && out_dtype != dtype.value())
+  if (self.scalar_type() != out_dtype ||
+      (dtype.has_value() && out_dtype != dtype.value()))
     return false;
   // check dtype enabled
   bool is_dtype_enabled = out_dtype == at::ScalarType::Double ||
-      out_dtype == at::ScalarType::Float || out_dtype == at::ScalarType::Long;
+      out_dtype == at::ScalarType::Float ||
+      out_dtype == at::ScalarType::BFloat16 ||
+      out_dtype == at::ScalarType::Long || out_dtype == at::ScalarType::Int;
   if (!is_dtype_enabled)
     return false;
   return true;
@@ -161,10 +319,14 @@ class NewCumSumOp : public torch::autograd::Function<NewCumSumOp> {
       at::native::resize_output(result, self.sizes());
     }
     if (cumsum_fast_path(result, self, dim, dtype)) {
-      AT_DISPATCH_FLOATING_TYPES_AND(
-          at::ScalarType::Long, self.scalar_type(), "cumsum_lastdim_cpu", [&] {
-            cumsum_lastdim_kernel<scalar_t>(result, self, dim);
-          });
+      auto wrap_dim = at::maybe_wrap_dim(dim, self.dim());
+      AT_DISPATCH_FLOATING_TYPES_AND3(
+          at::ScalarType::BFloat16,
+          at::ScalarType::Long,
+          at::ScalarType::Int,
+          self.scalar_type(),
+          "cumsum_cpu",
+          [&] { cumsum_kernel<scalar_t>(result, self, wrap_dim); });
       return result;
     }
     return at::cumsum_out(result, self, dim, dtype);
@@ -0,0 +1,357 @@
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec/vec.h>
+#include <c10/util/irange.h>
+#include <torch/csrc/autograd/function.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "aten/DynamicQuantLinear.h"
+#include "aten/utils/row_tile.h"
+#include "vec/vec.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+// Rows of the activation computed together, so that each weight vector is
+// reused from registers for all of them.
+constexpr int64_t kDqMTile = 4;
+// Rows of the activation per task. The quantized rows of a chunk stay in
+// L1/L2 while the task walks over the weight blocks.
+constexpr int64_t kDqMChunk = 64;
+
+// Asymmetric u8 parameters covering [min, max] and zero
+inline void dq_qparams(float min, float max, float& scale, int32_t& zp) {
+  min = std::min(min, 0.f);
+  max = std::max(max, 0.f);
+  scale = (max - min) / 255.f;
+  if (scale == 0.f || !std::isfinite(scale)) {
+    scale = 1.f;
+  }
+  zp = static_cast<int32_t>(std::nearbyint(-min / scale));
+  zp = std::min(std::max(zp, 0), 255);
+}
+
+inline int32_t dq_load_u8x4(const uint8_t* x) {
+  int32_t value;
+  std::memcpy(&value, x, sizeof(value));
+  return value;
+}
+
+#if defined(CPU_CAPABILITY_AVX512)
+inline void dq_min_max(const float* x, int64_t K, float& min, float& max) {
+  auto min_vec = _mm512_set1_ps(std::numeric_limits<float>::infinity());
+  auto max_vec = _mm512_set1_ps(-std::numeric_limits<float>::infinity());
+  int64_t k = 0;
+  for (; k + 16 <= K; k += 16) {
+    auto values = _mm512_loadu_ps(x + k);
+    min_vec = _mm512_min_ps(min_vec, values);
+    max_vec = _mm512_max_ps(max_vec, values);
+  }
+  if (k < K) {
+    __mmask16 mask = (1 << (K - k)) - 1;
+    auto values = _mm512_maskz_loadu_ps(mask, x + k);
+    min_vec = _mm512_mask_min_ps(min_vec, mask, min_vec, values);
+    max_vec = _mm512_mask_max_ps(max_vec, mask, max_vec, values);
+  }
+  min = std::min(min, _mm512_reduce_min_ps(min_vec));
+  max = std::max(max, _mm512_reduce_max_ps(max_vec));
+}
+
+inline void dq_quantize_row(
+    const float* x,
+    int64_t K,
+    int64_t Kp,
+    float scale,
+    int32_t zp,
+    uint8_t* q) {
+  auto inv_scale = _mm512_set1_ps(1.f / scale);
+  auto zp_vec = _mm512_set1_epi32(zp);
+  auto zero = _mm512_setzero_si512();
+  auto qmax = _mm512_set1_epi32(255);
+  for (int64_t k = 0; k < K; k += 16) {
+    __mmask16 mask = K - k >= 16 ? 0xFFFF : (1 << (K - k)) - 1;
+    auto values = _mm512_maskz_loadu_ps(mask, x + k);
+    // rounds to nearest even like std::nearbyint
+    auto q_vec = _mm512_cvtps_epi32(_mm512_mul_ps(values, inv_scale));
+    q_vec = _mm512_add_epi32(q_vec, zp_vec);
+    q_vec = _mm512_min_epi32(_mm512_max_epi32(q_vec, zero), qmax);
+    _mm512_mask_cvtepi32_storeu_epi8(q + k, mask, q_vec);
+  }
+  for (int64_t k = K; k < Kp; k++) {
+    q[k] = 0;
+  }
+}
+
+// 16 int32 lanes, each the dot product of 4 u8 activations and 4 s8 weights
+inline __m512i dq_dot(__m512i acc, __m512i a, __m512i w) {
+#if defined(CPU_CAPABILITY_AVX512_VNNI)
+  return _mm512_dpbusd_epi32(acc, a, w);
+#else
+  // split the bytes into 16-bit even and odd lanes so that the products are
+  // summed exactly, unlike _mm512_maddubs_epi16 which saturates
+  auto a_even = _mm512_and_si512(a, _mm512_set1_epi16(0x00FF));
+  auto a_odd = _mm512_srli_epi16(a, 8);
+  auto w_even = _mm512_srai_epi16(_mm512_slli_epi16(w, 8), 8);
+  auto w_odd = _mm512_srai_epi16(w, 8);
+  acc = _mm512_add_epi32(acc, _mm512_madd_epi16(a_even, w_even));
+  return _mm512_add_epi32(acc, _mm512_madd_epi16(a_odd, w_odd));
+#endif
+}
+
+// Computes rows x 16 outputs for one block of output channels. The int32
+// results are dequantized with the activation and weight scales, the zero
+// point is removed through the weight sums, and bias and ReLU are applied
+// before the single store.
+template <int64_t rows>
+void dq_gemm_block(
+    const uint8_t* qx,
+    int64_t ldx,
+    const float* a_scales,
+    const int32_t* a_zps,
+    const int8_t* w,
+    const float* w_scales,
+    const int32_t* compensation,
+    const float* bias,
+    bool relu,
+    float* out,
+    int64_t ldc,
+    int64_t n_valid) {
+  __m512i acc[rows];
+  for (int64_t r = 0; r < rows; r++) {
+    acc[r] = _mm512_setzero_si512();
+  }
+  for (int64_t k = 0; k < ldx; k += kDqKGroup) {
+    auto weight = _mm512_loadu_si512(w + k * kDqNBlock);
+    for (int64_t r = 0; r < rows; r++) {
+      auto a = _mm512_set1_epi32(dq_load_u8x4(qx + r * ldx + k));
+      acc[r] = dq_dot(acc[r], a, weight);
+    }
+  }
+  __mmask16 mask = (1 << n_valid) - 1;
+  auto comp_vec = _mm512_loadu_si512(compensation);
+  auto w_scale = _mm512_loadu_ps(w_scales);
+  auto bias_vec = bias != nullptr ? _mm512_maskz_loadu_ps(mask, bias)
+                                  : _mm512_setzero_ps();
+  for (int64_t r = 0; r < rows; r++) {
+    auto values = _mm512_sub_epi32(
+        acc[r], _mm512_mullo_epi32(_mm512_set1_epi32(a_zps[r]), comp_vec));
+    auto scale = _mm512_mul_ps(_mm512_set1_ps(a_scales[r]), w_scale);
+    auto out_vec =
+        _mm512_fmadd_ps(_mm512_cvtepi32_ps(values), scale, bias_vec);
+    if (relu) {
+      out_vec = _mm512_max_ps(out_vec, _mm512_setzero_ps());
+    }
+    _mm512_mask_storeu_ps(out + r * ldc, mask, out_vec);
+  }
+}
+#else
+inline void dq_min_max(const float* x, int64_t K, float& min, float& max) {
+  for (int64_t k = 0; k < K; k++) {
+    min = std::min(min, x[k]);
+    max = std::max(max, x[k]);
+  }
+}
+
+inline void dq_quantize_row(
+    const float* x,
+    int64_t K,
+    int64_t Kp,
+    float scale,
+    int32_t zp,
+    uint8_t* q) {
+  float inv_scale = 1.f / scale;
+  for (int64_t k = 0; k < K; k++) {
+    auto q_val = static_cast<int32_t>(std::nearbyint(x[k] * inv_scale)) + zp;
+    q[k] = static_cast<uint8_t>(std::min(std::max(q_val, 0), 255));
+  }
+  for (int64_t k = K; k < Kp; k++) {
+    q[k] = 0;
+  }
+}
+
+template <int64_t rows>
+void dq_gemm_block(
+    const uint8_t* qx,
+    int64_t ldx,
+    const float* a_scales,
+    const int32_t* a_zps,
+    const int8_t* w,
+    const float* w_scales,
+    const int32_t* compensation,
+    const float* bias,
+    bool relu,
+    float* out,
+    int64_t ldc,
+    int64_t n_valid) {
+  int32_t acc[rows][kDqNBlock] = {};
+  for (int64_t k = 0; k < ldx; k += kDqKGroup) {
+    auto weight = w + k * kDqNBlock;
+    for (int64_t r = 0; r < rows; r++) {
+      auto a = qx + r * ldx + k;
+      for (int64_t j = 0; j < kDqNBlock; j++) {
+        for (int64_t g = 0; g < kDqKGroup; g++) {
+          acc[r][j] += static_cast<int32_t>(a[g]) *
+              static_cast<int32_t>(weight[j * kDqKGroup + g]);
+        }
+      }
+    }
+  }
+  for (int64_t r = 0; r < rows; r++) {
+    for (int64_t j = 0; j < n_valid; j++) {
+      auto value = static_cast<float>(acc[r][j] - a_zps[r] * compensation[j]) *
+              (a_scales[r] * w_scales[j]) +
+          (bias != nullptr ? bias[j] : 0.f);
+      out[r * ldc + j] = relu ? std::max(value, 0.f) : value;
+    }
+  }
+}
+#endif
+
+// Quantizes the activation to u8 with one (scale, zero point) per row. With
+// per-token scales each row is reduced and quantized while it is in cache,
+// so the FP32 activation is read from memory once. Per-tensor scales need a
+// parallel min/max over the whole activation first.
+void dq_quantize_activation(
+    const float* x,
+    int64_t M,
+    int64_t K,
+    int64_t Kp,
+    bool per_token,
+    uint8_t* q,
+    float* a_scales,
+    int32_t* a_zps) {
+  if (per_token) {
+    at::parallel_for(0, M, 1, [&](int64_t begin, int64_t end) {
+      for (const auto m : c10::irange(begin, end)) {
+        float min = std::numeric_limits<float>::infinity();
+        float max = -std::numeric_limits<float>::infinity();
+        dq_min_max(x + m * K, K, min, max);
+        dq_qparams(min, max, a_scales[m], a_zps[m]);
+        dq_quantize_row(x + m * K, K, Kp, a_scales[m], a_zps[m], q + m * Kp);
+      }
+    });
+    return;
+  }
+
+  const int64_t num_threads = at::get_num_threads();
+  std::vector<float> mins(num_threads, std::numeric_limits<float>::infinity());
+  std::vector<float> maxs(
+      num_threads, -std::numeric_limits<float>::infinity());
+  at::parallel_for(0, M, 1, [&](int64_t begin, int64_t end) {
+    const int64_t tid = at::get_thread_num();
+    for (const auto m : c10::irange(begin, end)) {
+      dq_min_max(x + m * K, K, mins[tid], maxs[tid]);
+    }
+  });
+  float scale;
+  int32_t zp;
+  dq_qparams(
+      *std::min_element(mins.begin(), mins.end()),
+      *std::max_element(maxs.begin(), maxs.end()),
+      scale,
+      zp);
+  at::parallel_for(0, M, 1, [&](int64_t begin, int64_t end) {
+    for (const auto m : c10::irange(begin, end)) {
+      a_scales[m] = scale;
+      a_zps[m] = zp;
+      dq_quantize_row(x + m * K, K, Kp, scale, zp, q + m * Kp);
+    }
+  });
+}
+
+void dynamic_quant_linear_kernel_impl(
+    const at::Tensor& self,
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    const at::Tensor& compensation,
+    const at::Tensor& bias,
+    int64_t out_features,
+    bool per_token,
+    DynamicQuantPostOp post_op,
+    at::Tensor& output) {
+  const int64_t K = self.size(-1);
+  const int64_t M = self.numel() / K;
+  const int64_t N = out_features;
+  if (M == 0 || N == 0) {
+    return;
+  }
+  const int64_t Kp = qweight.size(1) * kDqKGroup;
+  const int64_t block_size = Kp * kDqNBlock;
+
+  auto input = self.to(at::kFloat).contiguous();
+  auto qx = at::empty({M, Kp}, self.options().dtype(at::kByte));
+  auto a_scales = at::empty({M}, self.options().dtype(at::kFloat));
+  auto a_zps = at::empty({M}, self.options().dtype(at::kInt));
+  dq_quantize_activation(
+      input.data_ptr<float>(),
+      M,
+      K,
+      Kp,
+      per_token,
+      qx.data_ptr<uint8_t>(),
+      a_scales.data_ptr<float>(),
+      a_zps.data_ptr<int32_t>());
+
+  auto bias_ = bias.defined() ? bias.to(at::kFloat).contiguous() : bias;
+  auto out_fp32 = output.scalar_type() == at::kFloat && output.is_contiguous()
+      ? output
+      : at::empty(output.sizes(), output.options().dtype(at::kFloat));
+
+  const uint8_t* qx_ptr = qx.data_ptr<uint8_t>();
+  const float* as_ptr = a_scales.data_ptr<float>();
+  const int32_t* azp_ptr = a_zps.data_ptr<int32_t>();
+  const int8_t* w_ptr = qweight.data_ptr<int8_t>();
+  const float* ws_ptr = scales.data_ptr<float>();
+  const int32_t* comp_ptr = compensation.data_ptr<int32_t>();
+  const float* b_ptr = bias_.defined() ? bias_.data_ptr<float>() : nullptr;
+  float* out_ptr = out_fp32.data_ptr<float>();
+  const bool relu = post_op == DynamicQuantPostOp::ReLU;
+  const bool gelu = post_op == DynamicQuantPostOp::GELU;
+
+  parallel_row_tiles<kDqMTile>(
+      M,
+      N,
+      kDqNBlock,
+      kDqMChunk,
+      [&](int64_t m,
+          int64_t rows,
+          int64_t nb,
+          int64_t n_start,
+          int64_t n_valid) {
+        float* out = out_ptr + m * N + n_start;
+        dispatch_row_tile<kDqMTile>(rows, [&](auto tile) {
+          dq_gemm_block<decltype(tile)::value>(
+              qx_ptr + m * Kp,
+              Kp,
+              as_ptr + m,
+              azp_ptr + m,
+              w_ptr + nb * block_size,
+              ws_ptr + n_start,
+              comp_ptr + n_start,
+              b_ptr != nullptr ? b_ptr + n_start : nullptr,
+              relu,
+              out,
+              N,
+              n_valid);
+        });
+        if (gelu) {
+          gelu_erf_rows(out, rows, N, n_valid);
+        }
+      });
+
+  if (!out_fp32.is_same(output)) {
+    output.copy_(out_fp32);
+  }
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(
+    dynamic_quant_linear_kernel_stub,
+    &dynamic_quant_linear_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
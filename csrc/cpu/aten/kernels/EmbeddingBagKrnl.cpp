@@ -42,28 +42,33 @@ static inline bool is_bfloat16_tensor(const at::Tensor tensor_) {
   return false;
 }
 
+static inline int64_t embedding_bag_output_size(
+    const at::Tensor& offsets,
+    bool include_last_offset) {
+  return include_last_offset ? offsets.numel() - 1 : offsets.numel();
+}
+
+// The rows of output may be strided, e.g. when output is a slice of a concat
 template <typename T>
-static inline at::Tensor _embedding_bag_index_add_select_fast(
+static inline void _embedding_bag_index_add_select_fast(
     const at::Tensor indices,
     const at::Tensor src,
     const at::Tensor offsets,
-    bool include_last_offset) {
+    bool include_last_offset,
+    at::Tensor& output) {
   int64_t ddim = src.size(1);
   T* src_data = src.data_ptr<T>();
-  int64_t output_size = offsets.numel();
-  if (include_last_offset) {
-    output_size -= 1;
-  }
+  int64_t output_size = embedding_bag_output_size(offsets, include_last_offset);
   int64_t* offsets_data = offsets.data_ptr<int64_t>();
   auto indices_accessor = indices.accessor<int64_t, 1>();
   int64_t last_index = indices.numel();
   int64_t last_offset = output_size - 1;
 
-  at::Tensor output = at::empty({output_size, src.size(1)}, src.options());
   auto* output_data = output.data_ptr<T>();
+  int64_t output_stride = output.stride(0);
   at::parallel_for(0, output_size, 16, [&](int64_t start, int64_t end) {
     for (int64_t i = start; i < end; i++) {
-      auto* out_data_ptr = &output_data[i * ddim];
+      auto* out_data_ptr = &output_data[i * output_stride];
       auto inputs_start = offsets_data[i];
       auto inputs_end = i == last_offset ? last_index : offsets_data[i + 1];
       if (inputs_end - inputs_start == 1) {
@@ -81,26 +86,45 @@ static inline at::Tensor _embedding_bag_index_add_select_fast(
       }
     }
   });
-
-  return output;
 }
 
-at::Tensor embedding_bag_kernel_impl(
+void embedding_bag_out_kernel_impl(
     const at::Tensor& weight,
     const at::Tensor& indices,
     const at::Tensor& offsets,
-    bool include_last_offset) {
+    bool include_last_offset,
+    at::Tensor& output) {
+  TORCH_CHECK(
+      output.dim() == 2 && output.stride(1) == 1 &&
+          output.scalar_type() == weight.scalar_type() &&
+          output.size(0) ==
+              embedding_bag_output_size(offsets, include_last_offset) &&
+          output.size(1) == weight.size(1),
+      "embedding_bag_out: expects an output of [bags, embedding_dim] with "
+      "unit stride rows of the weight dtype");
   at::Tensor offsets_ =
       offsets.is_contiguous() ? offsets : offsets.contiguous();
 
-  at::Tensor output;
   if (is_bfloat16_tensor(weight)) {
-    output = _embedding_bag_index_add_select_fast<at::BFloat16>(
-        indices, weight, offsets_, include_last_offset);
+    _embedding_bag_index_add_select_fast<at::BFloat16>(
+        indices, weight, offsets_, include_last_offset, output);
   } else {
-    output = _embedding_bag_index_add_select_fast<float>(
-        indices, weight, offsets_, include_last_offset);
+    _embedding_bag_index_add_select_fast<float>(
+        indices, weight, offsets_, include_last_offset, output);
   }
+}
+
+at::Tensor embedding_bag_kernel_impl(
+    const at::Tensor& weight,
+    const at::Tensor& indices,
+    const at::Tensor& offsets,
+    bool include_last_offset) {
+  at::Tensor output = at::empty(
+      {embedding_bag_output_size(offsets, include_last_offset),
+       weight.size(1)},
+      weight.options());
+  embedding_bag_out_kernel_impl(
+      weight, indices, offsets, include_last_offset, output);
   return output;
 }
 
@@ -358,6 +382,9 @@ at::Tensor embedding_bag_int8_kernel_impl(
 } // anonymous namespace
 
 REGISTER_DISPATCH(embedding_bag_kernel_stub, &embedding_bag_kernel_impl);
+REGISTER_DISPATCH(
+    embedding_bag_out_kernel_stub,
+    &embedding_bag_out_kernel_impl);
 REGISTER_DISPATCH(
     embedding_bag_backward_kernel_stub,
     &embedding_bag_backward_kernel_impl);
@@ -0,0 +1,122 @@
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec/vec.h>
+#include <algorithm>
+#include <cmath>
+#include "aten/GatedMlp.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+using fVec = at::vec::Vectorized<float>;
+
+inline fVec gated_mlp_load(const float* ptr, int64_t n) {
+  return fVec::loadu(ptr, n);
+}
+
+inline fVec gated_mlp_load(const at::BFloat16* ptr, int64_t n) {
+  if (n == fVec::size()) {
+    fVec values;
+    at::vec::load_fp32_from_bf16(ptr, values);
+    return values;
+  }
+  float buffer[fVec::size()];
+  for (int64_t i = 0; i < n; i++) {
+    buffer[i] = static_cast<float>(ptr[i]);
+  }
+  return fVec::loadu(buffer, n);
+}
+
+inline void gated_mlp_store(float* ptr, const fVec& values, int64_t n) {
+  values.store(ptr, n);
+}
+
+inline void gated_mlp_store(
+    at::BFloat16* ptr,
+    const fVec& values,
+    int64_t n) {
+  at::vec::convert_float_bfloat16(values, values).store(ptr, n);
+}
+
+template <GatedMlpAct act>
+inline fVec gated_mlp_activation(const fVec& x) {
+  const fVec one(1.f);
+  switch (act) {
+    case GatedMlpAct::SiLU:
+      return x / (one + x.neg().exp());
+    case GatedMlpAct::GELU:
+      return x * fVec(0.5f) *
+          (one + (x * fVec(static_cast<float>(M_SQRT1_2))).erf());
+    default: {
+      // sqrt(2 / pi)
+      const fVec kBeta(static_cast<float>(M_SQRT2 * M_2_SQRTPI * 0.5));
+      const fVec kKappa(0.044715f);
+      auto inner = kBeta * (x + kKappa * x * x * x);
+      return x * fVec(0.5f) * (one + inner.tanh());
+    }
+  }
+}
+
+template <typename scalar_t, GatedMlpAct act>
+void gated_mlp_epilogue_kernel(const at::Tensor& gate_up, at::Tensor& output) {
+  auto M = output.size(0);
+  auto H = output.size(1);
+  auto num_blocks = (H + kGatedMlpBlock - 1) / kGatedMlpBlock;
+  const scalar_t* gate_up_data = gate_up.data_ptr<scalar_t>();
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+  at::parallel_for(0, M * num_blocks, 16, [&](int64_t begin, int64_t end) {
+    for (int64_t task = begin; task < end; task++) {
+      auto m = task / num_blocks;
+      auto start = (task % num_blocks) * kGatedMlpBlock;
+      auto block = std::min(kGatedMlpBlock, H - start);
+      const scalar_t* gate = gate_up_data + m * 2 * H + 2 * start;
+      const scalar_t* up = gate + block;
+      scalar_t* out = output_data + m * H + start;
+      for (int64_t j = 0; j < block; j += fVec::size()) {
+        auto n = std::min(static_cast<int64_t>(fVec::size()), block - j);
+        auto x = gated_mlp_load(gate + j, n);
+        auto y = gated_mlp_load(up + j, n);
+        gated_mlp_store(out + j, gated_mlp_activation<act>(x) * y, n);
+      }
+    }
+  });
+}
+
+template <typename scalar_t>
+void gated_mlp_epilogue_kernel(
+    const at::Tensor& gate_up,
+    GatedMlpAct act,
+    at::Tensor& output) {
+  switch (act) {
+    case GatedMlpAct::SiLU:
+      gated_mlp_epilogue_kernel<scalar_t, GatedMlpAct::SiLU>(gate_up, output);
+      break;
+    case GatedMlpAct::GELU:
+      gated_mlp_epilogue_kernel<scalar_t, GatedMlpAct::GELU>(gate_up, output);
+      break;
+    default:
+      gated_mlp_epilogue_kernel<scalar_t, GatedMlpAct::GELUTanh>(
+          gate_up, output);
+  }
+}
+
+void gated_mlp_epilogue_kernel_impl(
+    const at::Tensor& gate_up,
+    GatedMlpAct act,
+    at::Tensor& output) {
+  if (output.scalar_type() == at::kBFloat16) {
+    gated_mlp_epilogue_kernel<at::BFloat16>(gate_up, act, output);
+  } else {
+    gated_mlp_epilogue_kernel<float>(gate_up, act, output);
+  }
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(
+    gated_mlp_epilogue_kernel_stub,
+    &gated_mlp_epilogue_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
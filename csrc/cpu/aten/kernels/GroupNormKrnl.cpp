@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <array>
 #include <numeric>
+#include <vector>
 
 #include <aten/GroupNorm.h>
 
@@ -775,10 +776,241 @@ void GroupNormBackwardKernelImpl(
       });
 }
 
+// Y = silu(X * scale + bias) (+ other), scale and bias are per channel
+template <bool kAdd>
+inline void ApplyScaleBiasSiLU(
+    float* Y,
+    const float* X,
+    const float* scale,
+    const float* bias,
+    const float* other,
+    int64_t size) {
+  using fVec = at::vec::Vectorized<float>;
+  for (int64_t d = 0; d < size; d += fVec::size()) {
+    auto count = std::min<int64_t>(fVec::size(), size - d);
+    fVec y = fVec::loadu(X + d, count) * fVec::loadu(scale + d, count) +
+        fVec::loadu(bias + d, count);
+    y = y / (fVec(1) + y.neg().exp());
+    if (kAdd) {
+      y = y + fVec::loadu(other + d, count);
+    }
+    y.store(Y + d, count);
+  }
+}
+
+template <bool kAdd>
+inline void ApplyScaleBiasSiLU(
+    BFloat16* Y,
+    const BFloat16* X,
+    const float* scale,
+    const float* bias,
+    const BFloat16* other,
+    int64_t size) {
+  using bVec = at::vec::Vectorized<BFloat16>;
+  using fVec = at::vec::Vectorized<float>;
+  constexpr int64_t K = bVec::size();
+  constexpr int64_t kF = fVec::size();
+  int64_t d = 0;
+  for (; d < size / K * K; d += K) {
+    fVec y0, y1;
+    std::tie(y0, y1) = convert_bfloat16_float(bVec::loadu(X + d));
+    y0 = y0 * fVec::loadu(scale + d) + fVec::loadu(bias + d);
+    y1 = y1 * fVec::loadu(scale + d + kF) + fVec::loadu(bias + d + kF);
+    y0 = y0 / (fVec(1) + y0.neg().exp());
+    y1 = y1 / (fVec(1) + y1.neg().exp());
+    if (kAdd) {
+      fVec o0, o1;
+      std::tie(o0, o1) = convert_bfloat16_float(bVec::loadu(other + d));
+      y0 = y0 + o0;
+      y1 = y1 + o1;
+    }
+    convert_float_bfloat16(y0, y1).store(Y + d);
+  }
+  for (; d < size; d++) {
+    float y = static_cast<float>(X[d]) * scale[d] + bias[d];
+    y = y / (1.f + std::exp(-y));
+    if (kAdd) {
+      y += static_cast<float>(other[d]);
+    }
+    Y[d] = static_cast<BFloat16>(y);
+  }
+}
+
+// sum += X, sqsum += X * X for a row of C channels
+inline void AccumulateMoments(
+    const float* X,
+    float* sum,
+    float* sqsum,
+    int64_t C) {
+  using fVec = at::vec::Vectorized<float>;
+  for (int64_t c = 0; c < C; c += fVec::size()) {
+    auto count = std::min<int64_t>(fVec::size(), C - c);
+    fVec x = fVec::loadu(X + c, count);
+    (fVec::loadu(sum + c, count) + x).store(sum + c, count);
+    (fVec::loadu(sqsum + c, count) + x * x).store(sqsum + c, count);
+  }
+}
+
+inline void AccumulateMoments(
+    const BFloat16* X,
+    float* sum,
+    float* sqsum,
+    int64_t C) {
+  using bVec = at::vec::Vectorized<BFloat16>;
+  using fVec = at::vec::Vectorized<float>;
+  constexpr int64_t K = bVec::size();
+  constexpr int64_t kF = fVec::size();
+  int64_t c = 0;
+  for (; c < C / K * K; c += K) {
+    fVec x0, x1;
+    std::tie(x0, x1) = convert_bfloat16_float(bVec::loadu(X + c));
+    (fVec::loadu(sum + c) + x0).store(sum + c);
+    (fVec::loadu(sum + c + kF) + x1).store(sum + c + kF);
+    (fVec::loadu(sqsum + c) + x0 * x0).store(sqsum + c);
+    (fVec::loadu(sqsum + c + kF) + x1 * x1).store(sqsum + c + kF);
+  }
+  for (; c < C; c++) {
+    float x = static_cast<float>(X[c]);
+    sum[c] += x;
+    sqsum[c] += x * x;
+  }
+}
+
+// GroupNorm + SiLU (+ residual add) on channels last in two passes over X:
+// one for the moments, one to normalize, activate and add, instead of the
+// three to four passes of the unfused ops. The scale and bias are kept in
+// FP32 for BF16 too.
+template <typename T, bool kAdd>
+void GroupNormSiLUKernelImplChannelsLastInternal(
+    const at::Tensor& X,
+    const at::Tensor& gamma,
+    const at::Tensor& beta,
+    const at::Tensor& other,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    double eps,
+    at::Tensor& Y) {
+  TORCH_CHECK(X.numel() == N * C * HxW);
+  TORCH_CHECK(!kAdd || other.numel() == N * C * HxW);
+  const int64_t G = group;
+  const int64_t D = C / G;
+  const T* X_data = X.data_ptr<T>();
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  const T* beta_data = beta.defined() ? beta.data_ptr<T>() : nullptr;
+  const T* other_data = kAdd ? other.data_ptr<T>() : nullptr;
+  T* Y_data = Y.data_ptr<T>();
+
+  // {sum, sum of squares} per {n, g}, then {mean, rstd}
+  std::vector<float> moments(N * G * 2, 0.f);
+  constexpr int64_t feature_map_threshold = 1024;
+  if (HxW < feature_map_threshold) {
+    // parallel on N * G, see GroupNormKernelImplChannelsLastInternal
+    at::parallel_for(0, N * G, 1, [&](int64_t begin, int64_t end) {
+      for (const auto i : c10::irange(begin, end)) {
+        const int64_t n = i / G;
+        const int64_t g = i % G;
+        std::tie(moments[i * 2], moments[i * 2 + 1]) =
+            ColumnwiseMoments(X_data + n * HxW * C + g * D, HxW, C, D);
+      }
+    });
+  } else {
+    // parallel on N * HxW with a {T, N, 2C} buffer per thread
+    int num_threads = at::get_num_threads();
+    std::vector<float> buffer(num_threads * N * 2 * C, 0.f);
+    at::parallel_for(0, N * HxW, 1, [&](int64_t begin, int64_t end) {
+      float* buffer_ptr = buffer.data() + at::get_thread_num() * N * 2 * C;
+      for (const auto i : c10::irange(begin, end)) {
+        float* sum_ptr = buffer_ptr + (i / HxW) * 2 * C;
+        AccumulateMoments(X_data + i * C, sum_ptr, sum_ptr + C, C);
+      }
+    });
+    for (const auto t : c10::irange(num_threads)) {
+      for (const auto n : c10::irange(N)) {
+        const float* sum_ptr = buffer.data() + (t * N + n) * 2 * C;
+        for (const auto c : c10::irange(C)) {
+          moments[(n * G + c / D) * 2] += sum_ptr[c];
+          moments[(n * G + c / D) * 2 + 1] += sum_ptr[C + c];
+        }
+      }
+    }
+  }
+
+  // per {n, c} scale and bias
+  std::vector<float> scale_bias(N * 2 * C);
+  const float s = 1.f / static_cast<float>(D * HxW);
+  for (const auto i : c10::irange(N * G)) {
+    const int64_t n = i / G;
+    const int64_t g = i % G;
+    float mean_val = moments[i * 2] * s;
+    float rstd_val =
+        std::max(moments[i * 2 + 1] * s - mean_val * mean_val, 0.f);
+    rstd_val = 1.f / std::sqrt(rstd_val + static_cast<float>(eps));
+    float* scale_ptr = scale_bias.data() + n * 2 * C;
+    float* bias_ptr = scale_ptr + C;
+    for (const auto d : c10::irange(D)) {
+      const int64_t c = g * D + d;
+      scale_ptr[c] = rstd_val *
+          (gamma_data == nullptr ? 1.f : static_cast<float>(gamma_data[c]));
+      bias_ptr[c] = -scale_ptr[c] * mean_val +
+          (beta_data == nullptr ? 0.f : static_cast<float>(beta_data[c]));
+    }
+  }
+
+  // normalize, activate and add, vectorized on C
+  at::parallel_for(0, N * HxW, 1, [&](int64_t begin, int64_t end) {
+    for (const auto i : c10::irange(begin, end)) {
+      const float* scale_ptr = scale_bias.data() + (i / HxW) * 2 * C;
+      ApplyScaleBiasSiLU<kAdd>(
+          Y_data + i * C,
+          X_data + i * C,
+          scale_ptr,
+          scale_ptr + C,
+          kAdd ? other_data + i * C : nullptr,
+          C);
+    }
+  });
+}
+
+void GroupNormSiLUKernelImpl(
+    const at::Tensor& X,
+    const at::Tensor& gamma,
+    const at::Tensor& beta,
+    const at::Tensor& other,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    double eps,
+    at::Tensor& Y) {
+  TORCH_CHECK(
+      X.scalar_type() == at::kFloat || X.scalar_type() == at::kBFloat16,
+      "GroupNormSiLUKernelImpl: only supports FP32 and BF16");
+  if (X.scalar_type() == at::kFloat) {
+    if (other.defined()) {
+      GroupNormSiLUKernelImplChannelsLastInternal<float, true>(
+          X, gamma, beta, other, N, C, HxW, group, eps, Y);
+    } else {
+      GroupNormSiLUKernelImplChannelsLastInternal<float, false>(
+          X, gamma, beta, other, N, C, HxW, group, eps, Y);
+    }
+  } else {
+    if (other.defined()) {
+      GroupNormSiLUKernelImplChannelsLastInternal<BFloat16, true>(
+          X, gamma, beta, other, N, C, HxW, group, eps, Y);
+    } else {
+      GroupNormSiLUKernelImplChannelsLastInternal<BFloat16, false>(
+          X, gamma, beta, other, N, C, HxW, group, eps, Y);
+    }
+  }
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(GroupNormKernel, &GroupNormKernelImpl);
 REGISTER_DISPATCH(GroupNormBackwardKernel, &GroupNormBackwardKernelImpl);
+REGISTER_DISPATCH(GroupNormSiLUKernel, &GroupNormSiLUKernelImpl);
 
 } // namespace cpu
 } // namespace torch_ipex
\ No newline at end of file
@@ -12,6 +12,10 @@
 #include <c10/util/TypeCast.h>
 #include <c10/util/irange.h>
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 #include <utils/library.h>
 
 #include <aten/TensorAdvancedIndexing.h>
@@ -39,6 +43,24 @@ static inline void check_indexarray_range(
   }
 }
 
+// Rows ahead of the current one that are prefetched. The rows are picked by
+// the index, so the hardware prefetcher cannot see them coming.
+constexpr int64_t kPrefetchDistance = 4;
+// Bytes prefetched at the start of a row, the hardware prefetcher follows the
+// sequential access to the rest of a long row.
+constexpr int64_t kPrefetchBytes = 256;
+
+template <typename scalar_t>
+static inline void prefetch_row(const scalar_t* row, int64_t size) {
+#ifdef __GNUC__
+  const char* ptr = reinterpret_cast<const char*>(row);
+  int64_t bytes = std::min<int64_t>(size * sizeof(scalar_t), kPrefetchBytes);
+  for (int64_t b = 0; b < bytes; b += 64) {
+    __builtin_prefetch(ptr + b, 0, 1);
+  }
+#endif // __GNUC__
+}
+
 template <typename scalar_t>
 static inline void copy_stub(scalar_t* result, scalar_t* self, int64_t size) {
   using Vec = at::vec::Vectorized<scalar_t>;
@@ -93,12 +115,11 @@ static void index_select_firstdim_impl(
         [&](int64_t begin, int64_t end) {
           for (const auto j : c10::irange(begin, end)) {
             index_t offset = index_data[j];
-#ifdef __GNUC__
-            if (j + 1 < index_size) {
-              __builtin_prefetch(
-                  self_data + index_data[j + 1] * inner_size, 0, 1);
+            if (j + kPrefetchDistance < end) {
+              prefetch_row(
+                  self_data + index_data[j + kPrefetchDistance] * inner_size,
+                  inner_size);
             }
-#endif // __GNUC__
             scalar_t* self_ptr = self_data + offset * inner_size;
             scalar_t* result_ptr = result_data + j * inner_size;
             copy_stub(result_ptr, self_ptr, inner_size);
@@ -127,6 +148,15 @@ static void index_select_non_firstdim_impl(
         at::native::data_index_init(begin, i, outer_size, j, index_size);
         for (const auto ii : c10::irange(begin, end)) {
           index_t offset = index_data[j];
+          if (ii + kPrefetchDistance < end) {
+            // the row kPrefetchDistance ahead in {outer_size, index_size}
+            int64_t jj = j + kPrefetchDistance;
+            int64_t i_ahead = i + jj / index_size;
+            prefetch_row(
+                self_data + i_ahead * dim_size * inner_size +
+                    index_data[jj % index_size] * inner_size,
+                inner_size);
+          }
           scalar_t* self_ptr =
               self_data + i * dim_size * inner_size + offset * inner_size;
           scalar_t* result_ptr = result_data + ii * inner_size;
@@ -277,6 +307,282 @@ void index_select_contig_kernel(
       });
 }
 
+template <typename scalar_t, typename index_t>
+static void gather_contig_impl(
+    scalar_t* result_data,
+    const scalar_t* self_data,
+    const index_t* index_data,
+    int64_t outer_size,
+    int64_t dim_size,
+    int64_t index_size,
+    int64_t inner_size) {
+  constexpr int64_t grain_size = at::internal::GRAIN_SIZE / 2;
+  at::parallel_for(
+      0,
+      outer_size * index_size,
+      std::max(int64_t(1), grain_size / inner_size),
+      [&](int64_t begin, int64_t end) {
+        for (const auto ii : c10::irange(begin, end)) {
+          const int64_t i = ii / index_size;
+          const scalar_t* self_ptr = self_data + i * dim_size * inner_size;
+          const index_t* index_ptr = index_data + ii * inner_size;
+          scalar_t* result_ptr = result_data + ii * inner_size;
+          for (const auto k : c10::irange(inner_size)) {
+            index_t idx = index_ptr[k];
+            TORCH_CHECK(
+                idx >= 0 && idx < dim_size,
+                "index ",
+                idx,
+                " is out of bounds for dimension with size ",
+                dim_size);
+            result_ptr[k] = self_ptr[idx * inner_size + k];
+          }
+        }
+      });
+}
+
+void gather_contig_kernel(
+    const at::Tensor& result,
+    const at::Tensor& self,
+    int64_t dim,
+    const at::Tensor& index) {
+  // normalize self, index and result shape as:
+  //   self: [outer_size, dim_size, inner_size]
+  //   index, result: [outer_size, index_size, inner_size]
+  auto self_sizes = self.sizes();
+  int64_t outer_size = c10::size_to_dim_(dim, self_sizes);
+  int64_t dim_size = self_sizes[dim];
+  int64_t inner_size = c10::size_from_dim_(dim + 1, self_sizes);
+  int64_t index_size = index.size(dim);
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, result.scalar_type(), "gather_contig", [&] {
+        gather_contig_impl<scalar_t, int64_t>(
+            result.data_ptr<scalar_t>(),
+            self.data_ptr<scalar_t>(),
+            index.data_ptr<int64_t>(),
+            outer_size,
+            dim_size,
+            index_size,
+            inner_size);
+      });
+}
+
+// Rows added by the index_add are summed in FP32 for BF16 self
+template <typename scalar_t>
+struct IndexAddAccType {
+  using type = scalar_t;
+};
+
+template <>
+struct IndexAddAccType<at::BFloat16> {
+  using type = float;
+};
+
+template <typename scalar_t>
+static inline void index_add_load(
+    scalar_t* acc,
+    const scalar_t* self,
+    int64_t size) {
+  copy_stub(acc, const_cast<scalar_t*>(self), size);
+}
+
+static inline void index_add_load(
+    float* acc,
+    const at::BFloat16* self,
+    int64_t size) {
+  using bVec = at::vec::Vectorized<at::BFloat16>;
+  using fVec = at::vec::Vectorized<float>;
+  int64_t d = 0;
+  for (; d < size - (size % bVec::size()); d += bVec::size()) {
+    fVec x0, x1;
+    std::tie(x0, x1) = at::vec::convert_bfloat16_float(bVec::loadu(self + d));
+    x0.store(acc + d);
+    x1.store(acc + d + fVec::size());
+  }
+  for (; d < size; ++d) {
+    acc[d] = static_cast<float>(self[d]);
+  }
+}
+
+// acc[d] += alpha * source[d]
+template <typename scalar_t>
+static inline void index_add_accumulate(
+    scalar_t* acc,
+    const scalar_t* source,
+    scalar_t alpha,
+    int64_t size) {
+  using Vec = at::vec::Vectorized<scalar_t>;
+  const Vec alpha_vec(alpha);
+  int64_t d = 0;
+  for (; d < size - (size % Vec::size()); d += Vec::size()) {
+    at::vec::fmadd(alpha_vec, Vec::loadu(source + d), Vec::loadu(acc + d))
+        .store(acc + d);
+  }
+  for (; d < size; ++d) {
+    acc[d] += alpha * source[d];
+  }
+}
+
+static inline void index_add_accumulate(
+    float* acc,
+    const at::BFloat16* source,
+    float alpha,
+    int64_t size) {
+  using bVec = at::vec::Vectorized<at::BFloat16>;
+  using fVec = at::vec::Vectorized<float>;
+  const fVec alpha_vec(alpha);
+  int64_t d = 0;
+  for (; d < size - (size % bVec::size()); d += bVec::size()) {
+    fVec x0, x1;
+    std::tie(x0, x1) = at::vec::convert_bfloat16_float(bVec::loadu(source + d));
+    at::vec::fmadd(alpha_vec, x0, fVec::loadu(acc + d)).store(acc + d);
+    at::vec::fmadd(alpha_vec, x1, fVec::loadu(acc + d + fVec::size()))
+        .store(acc + d + fVec::size());
+  }
+  for (; d < size; ++d) {
+    acc[d] += alpha * static_cast<float>(source[d]);
+  }
+}
+
+static inline void index_add_store(
+    at::BFloat16* self,
+    const float* acc,
+    int64_t size) {
+  using bVec = at::vec::Vectorized<at::BFloat16>;
+  using fVec = at::vec::Vectorized<float>;
+  int64_t d = 0;
+  for (; d < size - (size % bVec::size()); d += bVec::size()) {
+    at::vec::convert_float_bfloat16(
+        fVec::loadu(acc + d), fVec::loadu(acc + d + fVec::size()))
+        .store(self + d);
+  }
+  for (; d < size; ++d) {
+    self[d] = static_cast<at::BFloat16>(acc[d]);
+  }
+}
+
+template <typename scalar_t>
+static inline void index_add_store(
+    scalar_t* self,
+    const scalar_t* acc,
+    int64_t size) {
+  copy_stub(self, const_cast<scalar_t*>(acc), size);
+}
+
+template <typename scalar_t, typename index_t>
+static void index_add_rows_impl(
+    scalar_t* self_data,
+    const index_t* index_data,
+    const scalar_t* source_data,
+    int64_t dim_size,
+    int64_t index_size,
+    int64_t inner_size,
+    typename IndexAddAccType<scalar_t>::type alpha) {
+  using acc_t = typename IndexAddAccType<scalar_t>::type;
+  constexpr bool same_acc = std::is_same<acc_t, scalar_t>::value;
+  for (const auto i : c10::irange(index_size)) {
+    TORCH_CHECK_INDEX(
+        index_data[i] >= 0 && index_data[i] < dim_size,
+        "index out of range in self");
+  }
+
+  // Several source rows may be added to the same row of self. The source rows
+  // are ordered by the row they are added to, so that each row of self is
+  // updated by a single task: no atomics, and the rows are added in the order
+  // of the index like the serial kernel. A counting sort is used when self
+  // has few rows compared to the index, a stable sort otherwise.
+  std::vector<int64_t> order(index_size);
+  if (dim_size <= 4 * index_size) {
+    std::vector<int64_t> pos(dim_size + 1, 0);
+    for (const auto i : c10::irange(index_size)) {
+      pos[index_data[i] + 1]++;
+    }
+    std::partial_sum(pos.begin(), pos.end(), pos.begin());
+    for (const auto i : c10::irange(index_size)) {
+      order[pos[index_data[i]]++] = i;
+    }
+  } else {
+    std::iota(order.begin(), order.end(), int64_t(0));
+    std::stable_sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+      return index_data[a] < index_data[b];
+    });
+  }
+  std::vector<int64_t> groups;
+  for (const auto g : c10::irange(index_size)) {
+    if (g == 0 || index_data[order[g]] != index_data[order[g - 1]]) {
+      groups.push_back(g);
+    }
+  }
+  const int64_t num_groups = groups.size();
+  groups.push_back(index_size);
+
+  // Wide rows are also split into column blocks, so that a row of self that
+  // gets many source rows is shared by several threads.
+  constexpr int64_t block_size = 512;
+  const int64_t num_blocks = at::divup(inner_size, block_size);
+  const int64_t avg_rows = index_size / std::max(num_groups, int64_t(1));
+  const int64_t task_size =
+      std::min(inner_size, block_size) * std::max(avg_rows, int64_t(1));
+  at::parallel_for(
+      0,
+      num_groups * num_blocks,
+      std::max(int64_t(1), at::internal::GRAIN_SIZE / task_size),
+      [&](int64_t begin, int64_t end) {
+        std::vector<acc_t> buffer(same_acc ? 0 : block_size);
+        for (const auto task : c10::irange(begin, end)) {
+          const int64_t g = task / num_blocks;
+          const int64_t col = task % num_blocks * block_size;
+          const int64_t size = std::min(block_size, inner_size - col);
+          scalar_t* self_ptr =
+              self_data + index_data[order[groups[g]]] * inner_size + col;
+          acc_t* acc = same_acc ? reinterpret_cast<acc_t*>(self_ptr)
+                                : buffer.data();
+          if (!same_acc) {
+            index_add_load(acc, self_ptr, size);
+          }
+          for (int64_t r = groups[g]; r < groups[g + 1]; r++) {
+            if (r + kPrefetchDistance < groups[g + 1]) {
+              prefetch_row(
+                  source_data + order[r + kPrefetchDistance] * inner_size + col,
+                  size);
+            }
+            index_add_accumulate(
+                acc,
+                source_data + order[r] * inner_size + col,
+                alpha,
+                size);
+          }
+          if (!same_acc) {
+            index_add_store(self_ptr, acc, size);
+          }
+        }
+      });
+}
+
+void index_add_contig_kernel(
+    const at::Tensor& self,
+    const at::Tensor& index,
+    const at::Tensor& source,
+    const at::Scalar& alpha) {
+  int64_t dim_size = self.size(0);
+  int64_t inner_size = self.numel() / dim_size;
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, self.scalar_type(), "index_add_contig", [&] {
+        using acc_t = typename IndexAddAccType<scalar_t>::type;
+        AT_DISPATCH_INDEX_TYPES(
+            index.scalar_type(), "cpu_index_add_contig", [&] {
+              index_add_rows_impl<scalar_t, index_t>(
+                  self.data_ptr<scalar_t>(),
+                  index.data_ptr<index_t>(),
+                  source.data_ptr<scalar_t>(),
+                  dim_size,
+                  index.numel(),
+                  inner_size,
+                  alpha.to<acc_t>());
+            });
+      });
+}
+
 void direct_copy_kernel(at::TensorIteratorBase& iter) {
   // TODO: we don't actually need separate instantiations per dtype;
   // we only need a separate instantiation per dtype size. This would
@@ -317,6 +623,8 @@ void copy_kernel(at::TensorIterator& iter, bool /*non_blocking*/) {
 
 REGISTER_DISPATCH(index_select_contig_stub, &index_select_contig_kernel);
 REGISTER_DISPATCH(copy_stub, &copy_kernel);
+REGISTER_DISPATCH(gather_contig_stub, &gather_contig_kernel);
+REGISTER_DISPATCH(index_add_contig_stub, &index_add_contig_kernel);
 
 } // namespace cpu
 } // namespace torch_ipex
\ No newline at end of file
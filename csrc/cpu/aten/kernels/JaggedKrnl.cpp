@@ -0,0 +1,524 @@
+#include <ATen/ATen.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec/functional.h>
+#include <ATen/cpu/vec/vec.h>
+#include <c10/util/irange.h>
+
+#include <aten/Jagged.h>
+
+#include "vec/vec.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+using namespace at::vec;
+
+// Segments are summed in FP32 for BF16 values
+template <typename scalar_t>
+struct JaggedAccType {
+  using type = scalar_t;
+};
+
+template <>
+struct JaggedAccType<at::BFloat16> {
+  using type = float;
+};
+
+// Check that the offsets are non-decreasing and within the values
+// Avoid redispatch call to min/max
+template <typename index_t>
+static inline void check_jagged_offsets(
+    const index_t* offsets,
+    int64_t num_segments,
+    int64_t total) {
+  TORCH_CHECK(
+      num_segments == 0 || offsets[0] >= 0,
+      "Jagged offsets must be non-negative, got ",
+      offsets[0]);
+  for (const auto b : c10::irange(num_segments)) {
+    TORCH_CHECK(
+        offsets[b] <= offsets[b + 1],
+        "Jagged offsets must be non-decreasing, offsets[",
+        b,
+        "]=",
+        offsets[b],
+        " offsets[",
+        b + 1,
+        "]=",
+        offsets[b + 1]);
+  }
+  TORCH_CHECK(
+      offsets[num_segments] <= total,
+      "Jagged offsets exceed the ",
+      total,
+      " rows of the values");
+}
+
+template <typename scalar_t>
+static inline void jagged_copy(
+    scalar_t* dst,
+    const scalar_t* src,
+    int64_t size) {
+  using Vec = Vectorized<scalar_t>;
+  int64_t d = 0;
+  for (; d < size - (size % Vec::size()); d += Vec::size()) {
+    Vec::loadu(src + d).store(dst + d);
+  }
+  for (; d < size; ++d) {
+    dst[d] = src[d];
+  }
+}
+
+template <typename scalar_t>
+static inline void jagged_fill(scalar_t* dst, scalar_t value, int64_t size) {
+  using Vec = Vectorized<scalar_t>;
+  const Vec value_vec(value);
+  int64_t d = 0;
+  for (; d < size - (size % Vec::size()); d += Vec::size()) {
+    value_vec.store(dst + d);
+  }
+  for (; d < size; ++d) {
+    dst[d] = value;
+  }
+}
+
+// acc[d] += src[d]
+template <typename scalar_t>
+static inline void jagged_accumulate(
+    scalar_t* acc,
+    const scalar_t* src,
+    int64_t size) {
+  using Vec = Vectorized<scalar_t>;
+  int64_t d = 0;
+  for (; d < size - (size % Vec::size()); d += Vec::size()) {
+    (Vec::loadu(acc + d) + Vec::loadu(src + d)).store(acc + d);
+  }
+  for (; d < size; ++d) {
+    acc[d] += src[d];
+  }
+}
+
+static inline void jagged_accumulate(
+    float* acc,
+    const at::BFloat16* src,
+    int64_t size) {
+  using bVec = Vectorized<at::BFloat16>;
+  using fVec = Vectorized<float>;
+  int64_t d = 0;
+  for (; d < size - (size % bVec::size()); d += bVec::size()) {
+    fVec x0, x1;
+    std::tie(x0, x1) = convert_bfloat16_float(bVec::loadu(src + d));
+    (fVec::loadu(acc + d) + x0).store(acc + d);
+    (fVec::loadu(acc + d + fVec::size()) + x1).store(acc + d + fVec::size());
+  }
+  for (; d < size; ++d) {
+    acc[d] += static_cast<float>(src[d]);
+  }
+}
+
+static inline void jagged_copy(
+    at::BFloat16* dst,
+    const float* src,
+    int64_t size) {
+  using bVec = Vectorized<at::BFloat16>;
+  using fVec = Vectorized<float>;
+  int64_t d = 0;
+  for (; d < size - (size % bVec::size()); d += bVec::size()) {
+    convert_float_bfloat16(
+        fVec::loadu(src + d), fVec::loadu(src + d + fVec::size()))
+        .store(dst + d);
+  }
+  for (; d < size; ++d) {
+    dst[d] = static_cast<at::BFloat16>(src[d]);
+  }
+}
+
+// Sum of src[0, size)
+template <typename scalar_t>
+static inline scalar_t jagged_reduce(const scalar_t* src, int64_t size) {
+  if (size == 0) {
+    return scalar_t(0);
+  }
+  return reduce_all<scalar_t>(
+      [](Vectorized<scalar_t>& x, Vectorized<scalar_t>& y) { return x + y; },
+      src,
+      size);
+}
+
+static inline float jagged_reduce(const at::BFloat16* src, int64_t size) {
+  using bVec = Vectorized<at::BFloat16>;
+  using fVec = Vectorized<float>;
+  fVec acc0(0.f);
+  fVec acc1(0.f);
+  int64_t d = 0;
+  for (; d < size - (size % bVec::size()); d += bVec::size()) {
+    fVec x0, x1;
+    std::tie(x0, x1) = convert_bfloat16_float(bVec::loadu(src + d));
+    acc0 = acc0 + x0;
+    acc1 = acc1 + x1;
+  }
+  float sum = vec_reduce_all<float>(
+      [](fVec& x, fVec& y) { return x + y; }, acc0 + acc1);
+  for (; d < size; ++d) {
+    sum += static_cast<float>(src[d]);
+  }
+  return sum;
+}
+
+// Segments per task, so that a task moves about GRAIN_SIZE elements
+inline int64_t jagged_grain_size(int64_t num_segments, int64_t numel) {
+  int64_t avg = num_segments > 0 ? numel / num_segments : 0;
+  return std::max(
+      int64_t(1), at::internal::GRAIN_SIZE / std::max(avg, int64_t(1)));
+}
+
+template <typename scalar_t, typename index_t>
+void jagged_to_padded_dense_body(
+    const at::Tensor& values,
+    const at::Tensor& offsets,
+    double padding_value,
+    at::Tensor& dense) {
+  const int64_t B = dense.size(0);
+  const int64_t L = dense.size(1);
+  const int64_t D = dense.size(2);
+  const scalar_t* values_data = values.data_ptr<scalar_t>();
+  const index_t* offsets_data = offsets.data_ptr<index_t>();
+  scalar_t* dense_data = dense.data_ptr<scalar_t>();
+  check_jagged_offsets(offsets_data, B, values.size(0));
+  const scalar_t padding = static_cast<scalar_t>(padding_value);
+
+  // Both the rows of a segment and those of its dense slice are contiguous,
+  // each segment is one copy and one fill.
+  at::parallel_for(
+      0, B, jagged_grain_size(B, B * L * D), [&](int64_t begin, int64_t end) {
+        for (const auto b : c10::irange(begin, end)) {
+          int64_t len = std::min<int64_t>(
+              offsets_data[b + 1] - offsets_data[b], L);
+          scalar_t* dst = dense_data + b * L * D;
+          jagged_copy(dst, values_data + offsets_data[b] * D, len * D);
+          jagged_fill(dst + len * D, padding, (L - len) * D);
+        }
+      });
+}
+
+void jagged_to_padded_dense_kernel_impl(
+    const at::Tensor& values,
+    const at::Tensor& offsets,
+    double padding_value,
+    at::Tensor& dense) {
+  AT_DISPATCH_ALL_TYPES_AND(
+      at::ScalarType::BFloat16,
+      values.scalar_type(),
+      "jagged_to_padded_dense",
+      [&] {
+        AT_DISPATCH_INDEX_TYPES(
+            offsets.scalar_type(), "jagged_to_padded_dense_offsets", [&] {
+              jagged_to_padded_dense_body<scalar_t, index_t>(
+                  values, offsets, padding_value, dense);
+            });
+      });
+}
+
+template <typename scalar_t, typename index_t>
+void dense_to_jagged_body(
+    const at::Tensor& dense,
+    const at::Tensor& offsets,
+    at::Tensor& values) {
+  const int64_t B = dense.size(0);
+  const int64_t L = dense.size(1);
+  const int64_t D = dense.size(2);
+  const scalar_t* dense_data = dense.data_ptr<scalar_t>();
+  const index_t* offsets_data = offsets.data_ptr<index_t>();
+  scalar_t* values_data = values.data_ptr<scalar_t>();
+  check_jagged_offsets(offsets_data, B, values.size(0));
+
+  at::parallel_for(
+      0,
+      B,
+      jagged_grain_size(B, values.numel()),
+      [&](int64_t begin, int64_t end) {
+        for (const auto b : c10::irange(begin, end)) {
+          int64_t len = offsets_data[b + 1] - offsets_data[b];
+          int64_t valid = std::min(len, L);
+          scalar_t* dst = values_data + offsets_data[b] * D;
+          jagged_copy(dst, dense_data + b * L * D, valid * D);
+          jagged_fill(dst + valid * D, scalar_t(0), (len - valid) * D);
+        }
+      });
+}
+
+void dense_to_jagged_kernel_impl(
+    const at::Tensor& dense,
+    const at::Tensor& offsets,
+    at::Tensor& values) {
+  AT_DISPATCH_ALL_TYPES_AND(
+      at::ScalarType::BFloat16, dense.scalar_type(), "dense_to_jagged", [&] {
+        AT_DISPATCH_INDEX_TYPES(
+            offsets.scalar_type(), "dense_to_jagged_offsets", [&] {
+              dense_to_jagged_body<scalar_t, index_t>(dense, offsets, values);
+            });
+      });
+}
+
+template <typename scalar_t, typename index_t>
+void jagged_index_select_body(
+    const at::Tensor& values,
+    const at::Tensor& input_offsets,
+    const at::Tensor& indices,
+    const at::Tensor& output_offsets,
+    at::Tensor& output) {
+  const int64_t num_inputs = input_offsets.numel() - 1;
+  const int64_t num_indices = indices.numel();
+  const int64_t D = output.size(1);
+  const scalar_t* values_data = values.data_ptr<scalar_t>();
+  const index_t* in_offsets = input_offsets.data_ptr<index_t>();
+  const int64_t* indices_data = indices.data_ptr<int64_t>();
+  const index_t* out_offsets = output_offsets.data_ptr<index_t>();
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+  check_jagged_offsets(in_offsets, num_inputs, values.size(0));
+
+  at::parallel_for(
+      0,
+      num_indices,
+      jagged_grain_size(num_indices, output.numel()),
+      [&](int64_t begin, int64_t end) {
+        for (const auto i : c10::irange(begin, end)) {
+          int64_t idx = indices_data[i];
+#ifdef __GNUC__
+          if (i + 1 < num_indices) {
+            __builtin_prefetch(
+                values_data + in_offsets[indices_data[i + 1]] * D, 0, 1);
+          }
+#endif // __GNUC__
+          jagged_copy(
+              output_data + out_offsets[i] * D,
+              values_data + in_offsets[idx] * D,
+              (in_offsets[idx + 1] - in_offsets[idx]) * D);
+        }
+      });
+}
+
+void jagged_index_select_kernel_impl(
+    const at::Tensor& values,
+    const at::Tensor& input_offsets,
+    const at::Tensor& indices,
+    const at::Tensor& output_offsets,
+    at::Tensor& output) {
+  AT_DISPATCH_ALL_TYPES_AND(
+      at::ScalarType::BFloat16,
+      values.scalar_type(),
+      "jagged_index_select",
+      [&] {
+        AT_DISPATCH_INDEX_TYPES(
+            input_offsets.scalar_type(), "jagged_index_select_offsets", [&] {
+              jagged_index_select_body<scalar_t, index_t>(
+                  values, input_offsets, indices, output_offsets, output);
+            });
+      });
+}
+
+template <typename scalar_t, typename index_t>
+void jagged_index_add_body(
+    const at::Tensor& grad,
+    const at::Tensor& grad_offsets,
+    const at::Tensor& indices,
+    const at::Tensor& input_offsets,
+    at::Tensor& grad_input) {
+  using acc_t = typename JaggedAccType<scalar_t>::type;
+  constexpr bool same_acc = std::is_same<acc_t, scalar_t>::value;
+  const int64_t num_inputs = input_offsets.numel() - 1;
+  const int64_t num_indices = indices.numel();
+  const int64_t D = grad_input.size(1);
+  const scalar_t* grad_data = grad.data_ptr<scalar_t>();
+  const index_t* g_offsets = grad_offsets.data_ptr<index_t>();
+  const int64_t* indices_data = indices.data_ptr<int64_t>();
+  const index_t* in_offsets = input_offsets.data_ptr<index_t>();
+  scalar_t* grad_input_data = grad_input.data_ptr<scalar_t>();
+
+  // indices may repeat, so the grad segments are grouped by the input
+  // segment they are added to with a counting sort. Each input segment is
+  // then summed by one thread, without atomics and in a deterministic order.
+  std::vector<int64_t> group_offsets(num_inputs + 1, 0);
+  for (const auto i : c10::irange(num_indices)) {
+    group_offsets[indices_data[i] + 1]++;
+  }
+  for (const auto b : c10::irange(num_inputs)) {
+    group_offsets[b + 1] += group_offsets[b];
+  }
+  std::vector<int64_t> groups(num_indices);
+  {
+    std::vector<int64_t> pos(group_offsets.begin(), group_offsets.end() - 1);
+    for (const auto i : c10::irange(num_indices)) {
+      groups[pos[indices_data[i]]++] = i;
+    }
+  }
+
+  at::parallel_for(
+      0,
+      num_inputs,
+      jagged_grain_size(num_inputs, grad.numel()),
+      [&](int64_t begin, int64_t end) {
+        std::vector<acc_t> buffer;
+        for (const auto b : c10::irange(begin, end)) {
+          int64_t size = (in_offsets[b + 1] - in_offsets[b]) * D;
+          int64_t g_begin = group_offsets[b];
+          int64_t g_end = group_offsets[b + 1];
+          if (size == 0 || g_begin == g_end) {
+            continue;
+          }
+          scalar_t* dst = grad_input_data + in_offsets[b] * D;
+          // grad_input is zero initialized, the segments are summed in place
+          // unless they need a wider accumulation type
+          acc_t* acc = reinterpret_cast<acc_t*>(dst);
+          if (!same_acc) {
+            buffer.assign(size, acc_t(0));
+            acc = buffer.data();
+          }
+          for (int64_t g = g_begin; g < g_end; g++) {
+            jagged_accumulate(acc, grad_data + g_offsets[groups[g]] * D, size);
+          }
+          if (!same_acc) {
+            jagged_copy(dst, acc, size);
+          }
+        }
+      });
+}
+
+void jagged_index_add_kernel_impl(
+    const at::Tensor& grad,
+    const at::Tensor& grad_offsets,
+    const at::Tensor& indices,
+    const at::Tensor& input_offsets,
+    at::Tensor& grad_input) {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, grad.scalar_type(), "jagged_index_add", [&] {
+        AT_DISPATCH_INDEX_TYPES(
+            input_offsets.scalar_type(), "jagged_index_add_offsets", [&] {
+              jagged_index_add_body<scalar_t, index_t>(
+                  grad, grad_offsets, indices, input_offsets, grad_input);
+            });
+      });
+}
+
+template <typename scalar_t, typename index_t>
+void segment_sum_body(
+    const at::Tensor& values,
+    const at::Tensor& offsets,
+    at::Tensor& output) {
+  using acc_t = typename JaggedAccType<scalar_t>::type;
+  constexpr bool same_acc = std::is_same<acc_t, scalar_t>::value;
+  const int64_t B = output.size(0);
+  const int64_t D = output.size(1);
+  const scalar_t* values_data = values.data_ptr<scalar_t>();
+  const index_t* offsets_data = offsets.data_ptr<index_t>();
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+  check_jagged_offsets(offsets_data, B, values.size(0));
+
+  at::parallel_for(
+      0,
+      B,
+      jagged_grain_size(B, values.numel()),
+      [&](int64_t begin, int64_t end) {
+        std::vector<acc_t> buffer(same_acc ? 0 : D);
+        for (const auto b : c10::irange(begin, end)) {
+          const scalar_t* src = values_data + offsets_data[b] * D;
+          int64_t len = offsets_data[b + 1] - offsets_data[b];
+          scalar_t* dst = output_data + b * D;
+          if (D == 1) {
+            // one contiguous reduction over the segment
+            dst[0] = static_cast<scalar_t>(jagged_reduce(src, len));
+            continue;
+          }
+          acc_t* acc = same_acc ? reinterpret_cast<acc_t*>(dst) : buffer.data();
+          std::fill(acc, acc + D, acc_t(0));
+          for (int64_t r = 0; r < len; r++) {
+            jagged_accumulate(acc, src + r * D, D);
+          }
+          if (!same_acc) {
+            jagged_copy(dst, acc, D);
+          }
+        }
+      });
+}
+
+void segment_sum_kernel_impl(
+    const at::Tensor& values,
+    const at::Tensor& offsets,
+    at::Tensor& output) {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16, values.scalar_type(), "segment_sum", [&] {
+        AT_DISPATCH_INDEX_TYPES(
+            offsets.scalar_type(), "segment_sum_offsets", [&] {
+              segment_sum_body<scalar_t, index_t>(values, offsets, output);
+            });
+      });
+}
+
+template <typename scalar_t, typename index_t>
+void segment_sum_backward_body(
+    const at::Tensor& grad,
+    const at::Tensor& offsets,
+    at::Tensor& grad_values) {
+  const int64_t B = grad.size(0);
+  const int64_t D = grad.size(1);
+  const scalar_t* grad_data = grad.data_ptr<scalar_t>();
+  const index_t* offsets_data = offsets.data_ptr<index_t>();
+  scalar_t* grad_values_data = grad_values.data_ptr<scalar_t>();
+
+  at::parallel_for(
+      0,
+      B,
+      jagged_grain_size(B, grad_values.numel()),
+      [&](int64_t begin, int64_t end) {
+        for (const auto b : c10::irange(begin, end)) {
+          int64_t len = offsets_data[b + 1] - offsets_data[b];
+          scalar_t* dst = grad_values_data + offsets_data[b] * D;
+          if (D == 1) {
+            jagged_fill(dst, grad_data[b], len);
+            continue;
+          }
+          for (int64_t r = 0; r < len; r++) {
+            jagged_copy(dst + r * D, grad_data + b * D, D);
+          }
+        }
+      });
+}
+
+void segment_sum_backward_kernel_impl(
+    const at::Tensor& grad,
+    const at::Tensor& offsets,
+    at::Tensor& grad_values) {
+  AT_DISPATCH_FLOATING_TYPES_AND(
+      at::ScalarType::BFloat16,
+      grad.scalar_type(),
+      "segment_sum_backward",
+      [&] {
+        AT_DISPATCH_INDEX_TYPES(
+            offsets.scalar_type(), "segment_sum_backward_offsets", [&] {
+              segment_sum_backward_body<scalar_t, index_t>(
+                  grad, offsets, grad_values);
+            });
+      });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(
+    jagged_to_padded_dense_kernel_stub,
+    &jagged_to_padded_dense_kernel_impl);
+REGISTER_DISPATCH(dense_to_jagged_kernel_stub, &dense_to_jagged_kernel_impl);
+REGISTER_DISPATCH(
+    jagged_index_select_kernel_stub,
+    &jagged_index_select_kernel_impl);
+REGISTER_DISPATCH(jagged_index_add_kernel_stub, &jagged_index_add_kernel_impl);
+REGISTER_DISPATCH(segment_sum_kernel_stub, &segment_sum_kernel_impl);
+REGISTER_DISPATCH(
+    segment_sum_backward_kernel_stub,
+    &segment_sum_backward_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,207 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec/functional.h>
+#include <ATen/cpu/vec/vec.h>
+
+#include <aten/Mean.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+using namespace at::vec;
+using fVec = Vectorized<float>;
+
+inline int64_t divup(int64_t x, int64_t y) {
+  return (x + y - 1) / y;
+}
+
+// Minimum number of input elements reduced by one task, the spatial dims of
+// an image are only split into chunks when there are fewer images than
+// threads
+constexpr int64_t kSpatialMinChunkElements = 16 * 1024;
+
+// Loads 2 * fVec::size() channels as FP32
+inline void spatial_load(const float* ptr, fVec& first, fVec& second) {
+  first = fVec::loadu(ptr);
+  second = fVec::loadu(ptr + fVec::size());
+}
+
+inline void spatial_load(const at::BFloat16* ptr, fVec& first, fVec& second) {
+  at::vec::load_fp32_from_bf16(ptr, first, second);
+}
+
+// sum[c] = sum of the rows of the [rows, C] data, the channels are
+// contiguous so the rows are accumulated with full vectors
+template <typename scalar_t>
+void spatial_sum_rows(
+    const scalar_t* data,
+    int64_t rows,
+    int64_t C,
+    float* sum) {
+  constexpr int64_t kVecSize = 2 * fVec::size();
+  std::fill(sum, sum + C, 0.f);
+  for (int64_t r = 0; r < rows; r++) {
+    const scalar_t* row = data + r * C;
+    int64_t c = 0;
+    for (; c < C - (C % kVecSize); c += kVecSize) {
+      fVec x0, x1;
+      spatial_load(row + c, x0, x1);
+      (fVec::loadu(sum + c) + x0).store(sum + c);
+      (fVec::loadu(sum + c + fVec::size()) + x1).store(sum + c + fVec::size());
+    }
+    for (; c < C; c++) {
+      sum[c] += static_cast<float>(row[c]);
+    }
+  }
+}
+
+// Welford mean and sum of squared differences from the mean of the rows of
+// the [rows, C] data. All the channels see the same number of rows, so the
+// reciprocal of the count is shared by the whole row.
+template <typename scalar_t>
+void spatial_welford_rows(
+    const scalar_t* data,
+    int64_t rows,
+    int64_t C,
+    float* mean,
+    float* m2) {
+  constexpr int64_t kVecSize = 2 * fVec::size();
+  std::fill(mean, mean + C, 0.f);
+  std::fill(m2, m2 + C, 0.f);
+  for (int64_t r = 0; r < rows; r++) {
+    const scalar_t* row = data + r * C;
+    float inv_count = 1.f / (r + 1);
+    fVec inv_count_vec(inv_count);
+    int64_t c = 0;
+    for (; c < C - (C % kVecSize); c += kVecSize) {
+      fVec x[2];
+      spatial_load(row + c, x[0], x[1]);
+      for (int64_t i = 0; i < 2; i++) {
+        auto offset = c + i * fVec::size();
+        auto mean_vec = fVec::loadu(mean + offset);
+        auto delta = x[i] - mean_vec;
+        mean_vec = mean_vec + delta * inv_count_vec;
+        mean_vec.store(mean + offset);
+        (fVec::loadu(m2 + offset) + delta * (x[i] - mean_vec))
+            .store(m2 + offset);
+      }
+    }
+    for (; c < C; c++) {
+      float x = static_cast<float>(row[c]);
+      float delta = x - mean[c];
+      mean[c] += delta * inv_count;
+      m2[c] += delta * (x - mean[c]);
+    }
+  }
+}
+
+template <typename scalar_t>
+void spatial_reduce_kernel(
+    const at::Tensor& input,
+    SpatialReduceOp op,
+    double correction,
+    at::Tensor& output,
+    at::Tensor& mean) {
+  auto N = input.size(0);
+  auto C = input.size(1);
+  auto HW = input.numel() / (N * C);
+  bool moments =
+      op == SpatialReduceOp::VarMean || op == SpatialReduceOp::StdMean;
+
+  // Each image is reduced by one task, or by several tasks over chunks of
+  // its rows which are merged afterwards when the batch is too small to
+  // keep all the threads busy (e.g. inference with N == 1)
+  int64_t chunks = std::min(
+      divup(at::get_num_threads(), N),
+      divup(HW * C, kSpatialMinChunkElements));
+  int64_t chunk_rows = divup(HW, std::max(chunks, int64_t(1)));
+  chunks = divup(HW, chunk_rows);
+
+  auto buffer = at::empty({N * chunks, C}, input.options().dtype(at::kFloat));
+  at::Tensor m2_buffer;
+  if (moments) {
+    m2_buffer = at::empty({N * chunks, C}, buffer.options());
+  }
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+  float* buffer_data = buffer.data_ptr<float>();
+  float* m2_data = moments ? m2_buffer.data_ptr<float>() : nullptr;
+
+  at::parallel_for(0, N * chunks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t task = begin; task < end; task++) {
+      int64_t n = task / chunks;
+      int64_t row_begin = (task % chunks) * chunk_rows;
+      int64_t rows = std::min(chunk_rows, HW - row_begin);
+      const scalar_t* data = input_data + (n * HW + row_begin) * C;
+      if (moments) {
+        spatial_welford_rows(
+            data, rows, C, buffer_data + task * C, m2_data + task * C);
+      } else {
+        spatial_sum_rows(data, rows, C, buffer_data + task * C);
+      }
+    }
+  });
+
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+  scalar_t* mean_data = moments ? mean.data_ptr<scalar_t>() : nullptr;
+  float scale = op == SpatialReduceOp::Mean ? 1.f / HW : 1.f;
+  // torch clamps the degrees of freedom at 0, i.e. var is inf or nan
+  float var_scale = 1.f / std::max(0., HW - correction);
+  at::parallel_for(0, N, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t n = begin; n < end; n++) {
+      const float* partial = buffer_data + n * chunks * C;
+      const float* partial_m2 = moments ? m2_data + n * chunks * C : nullptr;
+      for (int64_t c = 0; c < C; c++) {
+        if (!moments) {
+          float sum = 0.f;
+          for (int64_t k = 0; k < chunks; k++) {
+            sum += partial[k * C + c];
+          }
+          output_data[n * C + c] = static_cast<scalar_t>(sum * scale);
+          continue;
+        }
+        // Chan et al. merge of the chunk statistics
+        float count = std::min(chunk_rows, HW);
+        float mean_val = partial[c];
+        float m2_val = partial_m2[c];
+        for (int64_t k = 1; k < chunks; k++) {
+          float rows = std::min(chunk_rows, HW - k * chunk_rows);
+          float total = count + rows;
+          float delta = partial[k * C + c] - mean_val;
+          mean_val += delta * rows / total;
+          m2_val +=
+              partial_m2[k * C + c] + delta * delta * count * rows / total;
+          count = total;
+        }
+        float var = m2_val * var_scale;
+        output_data[n * C + c] = static_cast<scalar_t>(
+            op == SpatialReduceOp::StdMean ? std::sqrt(var) : var);
+        mean_data[n * C + c] = static_cast<scalar_t>(mean_val);
+      }
+    }
+  });
+}
+
+void spatial_reduce_kernel_impl(
+    const at::Tensor& input,
+    SpatialReduceOp op,
+    double correction,
+    at::Tensor& output,
+    at::Tensor& mean) {
+  if (input.scalar_type() == at::kBFloat16) {
+    spatial_reduce_kernel<at::BFloat16>(input, op, correction, output, mean);
+  } else {
+    spatial_reduce_kernel<float>(input, op, correction, output, mean);
+  }
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(spatial_reduce_kernel_stub, &spatial_reduce_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,117 @@
+#include <ATen/Parallel.h>
+#include <ATen/Tensor.h>
+#include <ATen/cpu/vec/vec.h>
+#include <aten/RnntGreedyDecode.h>
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+using fVec = at::vec::Vectorized<float>;
+
+inline fVec sigmoid_vec(fVec x) {
+  return fVec(1.f) / (fVec(1.f) + x.neg().exp());
+}
+
+/*
+  One step of the LSTM cell for one batch row, with the gates already
+  computed as gates = x * W_ih^T + h * W_hh^T + b, in the i, f, g, o order
+  of torch.nn.LSTM:
+    cy = sigmoid(f) * cx + sigmoid(i) * tanh(g)
+    hy = sigmoid(o) * tanh(cy)
+  The math is done in FP32, gates_buf is a FP32 scratch of 4 * hidden_size.
+*/
+template <typename T>
+inline void lstm_cell_row(
+    const T* gates,
+    const T* cx,
+    T* hy,
+    T* cy,
+    float* gates_buf,
+    int64_t hidden_size) {
+  at::vec::convert(gates, gates_buf, 4 * hidden_size);
+  // cx/hy/cy share the tail of gates_buf after the converted gates
+  float* cx_buf = gates_buf + 4 * hidden_size;
+  float* hy_buf = cx_buf + hidden_size;
+  float* cy_buf = hy_buf + hidden_size;
+  at::vec::convert(cx, cx_buf, hidden_size);
+
+  const float* i_ptr = gates_buf;
+  const float* f_ptr = gates_buf + hidden_size;
+  const float* g_ptr = gates_buf + 2 * hidden_size;
+  const float* o_ptr = gates_buf + 3 * hidden_size;
+  int64_t d = 0;
+  for (; d < hidden_size; d += fVec::size()) {
+    auto count = std::min<int64_t>(fVec::size(), hidden_size - d);
+    auto i = sigmoid_vec(fVec::loadu(i_ptr + d, count));
+    auto f = sigmoid_vec(fVec::loadu(f_ptr + d, count));
+    auto g = fVec::loadu(g_ptr + d, count).tanh();
+    auto o = sigmoid_vec(fVec::loadu(o_ptr + d, count));
+    auto c = f * fVec::loadu(cx_buf + d, count) + i * g;
+    c.store(cy_buf + d, count);
+    (o * c.tanh()).store(hy_buf + d, count);
+  }
+  at::vec::convert(hy_buf, hy, hidden_size);
+  at::vec::convert(cy_buf, cy, hidden_size);
+}
+
+template <typename T>
+void rnnt_lstm_cell_kernel_body(
+    const at::Tensor& gates,
+    const at::Tensor& cx,
+    at::Tensor hy,
+    at::Tensor cy) {
+  const int64_t batch_size = cx.size(0);
+  const int64_t hidden_size = cx.size(1);
+  const T* gates_ptr = gates.data_ptr<T>();
+  const T* cx_ptr = cx.data_ptr<T>();
+  T* hy_ptr = hy.data_ptr<T>();
+  T* cy_ptr = cy.data_ptr<T>();
+
+  at::parallel_for(0, batch_size, 1, [&](int64_t start, int64_t end) {
+    std::vector<float> buf(7 * hidden_size);
+    for (int64_t b = start; b < end; b++) {
+      lstm_cell_row<T>(
+          gates_ptr + b * 4 * hidden_size,
+          cx_ptr + b * hidden_size,
+          hy_ptr + b * hidden_size,
+          cy_ptr + b * hidden_size,
+          buf.data(),
+          hidden_size);
+    }
+  });
+}
+
+void rnnt_lstm_cell_kernel_impl(
+    const at::Tensor& gates,
+    const at::Tensor& cx,
+    at::Tensor hy,
+    at::Tensor cy) {
+  TORCH_CHECK(
+      gates.is_contiguous() && cx.is_contiguous() && hy.is_contiguous() &&
+          cy.is_contiguous(),
+      "rnnt_lstm_cell: expects contiguous gates and states");
+  TORCH_CHECK(
+      gates.size(1) == 4 * cx.size(1),
+      "rnnt_lstm_cell: gates should be 4 times the hidden size");
+  if (cx.scalar_type() == at::kBFloat16) {
+    rnnt_lstm_cell_kernel_body<at::BFloat16>(gates, cx, hy, cy);
+  } else {
+    TORCH_CHECK(
+        cx.scalar_type() == at::kFloat,
+        "rnnt_lstm_cell: only supports float and bf16 states");
+    rnnt_lstm_cell_kernel_body<float>(gates, cx, hy, cy);
+  }
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(rnnt_lstm_cell_kernel_stub, &rnnt_lstm_cell_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
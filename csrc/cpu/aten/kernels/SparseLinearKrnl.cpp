@@ -0,0 +1,230 @@
+#include <ATen/cpu/vec/vec.h>
+#include <torch/csrc/autograd/function.h>
+#include <algorithm>
+#include "aten/SparseLinear.h"
+#include "aten/utils/row_tile.h"
+#include "vec/vec.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+// Activation rows sharing each loaded weight vector, and activation rows
+// per task, see parallel_row_tiles. Only the non-zero blocks of a block row
+// are read, so a chunk of FP32 rows stays in L1/L2 across the block rows.
+constexpr int64_t kSparseMTile = 4;
+constexpr int64_t kSparseMChunk = 64;
+
+#if defined(CPU_CAPABILITY_AVX512)
+inline __m512 sparse_load_weight(const float* w) {
+  return _mm512_loadu_ps(w);
+}
+
+inline __m512 sparse_load_weight(const at::BFloat16* w) {
+  auto values = _mm512_cvtepu16_epi32(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w)));
+  return _mm512_castsi512_ps(_mm512_slli_epi32(values, 16));
+}
+
+// Computes rows x 16 outputs for one block of output channels, skipping the
+// zero blocks: only the blocks in [begin, end) of the block row are read.
+template <int64_t rows, typename scalar_t>
+void sparse_gemm_block(
+    const float* x,
+    int64_t ldx,
+    const scalar_t* values,
+    const int32_t* col_index,
+    int64_t begin,
+    int64_t end,
+    const float* bias,
+    bool relu,
+    float* out,
+    int64_t ldc,
+    int64_t n_valid) {
+  __m512 acc[rows];
+  for (int64_t r = 0; r < rows; r++) {
+    acc[r] = _mm512_setzero_ps();
+  }
+  for (int64_t b = begin; b < end; b++) {
+    const float* x_block = x + col_index[b] * kSparseKBlock;
+    const scalar_t* w = values + b * kSparseKBlock * kSparseNBlock;
+    for (int64_t k = 0; k < kSparseKBlock; k++) {
+      auto weight = sparse_load_weight(w + k * kSparseNBlock);
+      for (int64_t r = 0; r < rows; r++) {
+        acc[r] = _mm512_fmadd_ps(
+            _mm512_set1_ps(x_block[r * ldx + k]), weight, acc[r]);
+      }
+    }
+  }
+  __mmask16 mask = (1 << n_valid) - 1;
+  if (bias != nullptr) {
+    auto bias_vec = _mm512_maskz_loadu_ps(mask, bias);
+    for (int64_t r = 0; r < rows; r++) {
+      acc[r] = _mm512_add_ps(acc[r], bias_vec);
+    }
+  }
+  if (relu) {
+    for (int64_t r = 0; r < rows; r++) {
+      acc[r] = _mm512_max_ps(acc[r], _mm512_setzero_ps());
+    }
+  }
+  for (int64_t r = 0; r < rows; r++) {
+    _mm512_mask_storeu_ps(out + r * ldc, mask, acc[r]);
+  }
+}
+#else
+template <int64_t rows, typename scalar_t>
+void sparse_gemm_block(
+    const float* x,
+    int64_t ldx,
+    const scalar_t* values,
+    const int32_t* col_index,
+    int64_t begin,
+    int64_t end,
+    const float* bias,
+    bool relu,
+    float* out,
+    int64_t ldc,
+    int64_t n_valid) {
+  float acc[rows][kSparseNBlock] = {};
+  for (int64_t b = begin; b < end; b++) {
+    const float* x_block = x + col_index[b] * kSparseKBlock;
+    const scalar_t* w = values + b * kSparseKBlock * kSparseNBlock;
+    for (int64_t k = 0; k < kSparseKBlock; k++) {
+      for (int64_t r = 0; r < rows; r++) {
+        auto x_val = x_block[r * ldx + k];
+        for (int64_t j = 0; j < kSparseNBlock; j++) {
+          acc[r][j] += x_val * static_cast<float>(w[k * kSparseNBlock + j]);
+        }
+      }
+    }
+  }
+  for (int64_t r = 0; r < rows; r++) {
+    for (int64_t j = 0; j < n_valid; j++) {
+      auto value = acc[r][j] + (bias != nullptr ? bias[j] : 0.f);
+      out[r * ldc + j] = relu ? std::max(value, 0.f) : value;
+    }
+  }
+}
+#endif
+
+template <typename scalar_t>
+void sparse_linear_gemm(
+    const float* x_ptr,
+    int64_t M,
+    int64_t Kp,
+    const scalar_t* w_ptr,
+    const int32_t* col_ptr,
+    const int32_t* row_ptr,
+    const float* b_ptr,
+    int64_t N,
+    SparseLinearPostOp post_op,
+    float* out_ptr) {
+  const bool relu = post_op == SparseLinearPostOp::ReLU;
+  const bool gelu = post_op == SparseLinearPostOp::GELU;
+  parallel_row_tiles<kSparseMTile>(
+      M,
+      N,
+      kSparseNBlock,
+      kSparseMChunk,
+      [&](int64_t m,
+          int64_t rows,
+          int64_t nb,
+          int64_t n_start,
+          int64_t n_valid) {
+        float* out = out_ptr + m * N + n_start;
+        dispatch_row_tile<kSparseMTile>(rows, [&](auto tile) {
+          sparse_gemm_block<decltype(tile)::value>(
+              x_ptr + m * Kp,
+              Kp,
+              w_ptr,
+              col_ptr,
+              row_ptr[nb],
+              row_ptr[nb + 1],
+              b_ptr != nullptr ? b_ptr + n_start : nullptr,
+              relu,
+              out,
+              N,
+              n_valid);
+        });
+        if (gelu) {
+          gelu_erf_rows(out, rows, N, n_valid);
+        }
+      });
+}
+
+void sparse_linear_kernel_impl(
+    const at::Tensor& self,
+    const at::Tensor& values,
+    const at::Tensor& col_index,
+    const at::Tensor& row_ptr,
+    const at::Tensor& bias,
+    int64_t out_features,
+    SparseLinearPostOp post_op,
+    at::Tensor& output) {
+  const int64_t K = self.size(-1);
+  const int64_t M = self.numel() / K;
+  const int64_t N = out_features;
+  if (M == 0 || N == 0) {
+    return;
+  }
+  const int64_t Kp = (K + kSparseKBlock - 1) / kSparseKBlock * kSparseKBlock;
+
+  // The activation is converted to FP32 once. Its rows are padded to whole
+  // blocks of input channels, so that the last block of the weight does not
+  // read past the end of a row.
+  auto input = self.to(at::kFloat).contiguous();
+  if (Kp != K) {
+    auto padded = at::zeros({M, Kp}, input.options());
+    padded.narrow(1, 0, K).copy_(input.view({M, K}));
+    input = padded;
+  }
+  auto bias_ = bias.defined() ? bias.to(at::kFloat).contiguous() : bias;
+  auto out_fp32 = output.scalar_type() == at::kFloat && output.is_contiguous()
+      ? output
+      : at::empty(output.sizes(), output.options().dtype(at::kFloat));
+
+  const float* x_ptr = input.data_ptr<float>();
+  const int32_t* col_ptr = col_index.data_ptr<int32_t>();
+  const int32_t* row_ptr_ = row_ptr.data_ptr<int32_t>();
+  const float* b_ptr = bias_.defined() ? bias_.data_ptr<float>() : nullptr;
+  float* out_ptr = out_fp32.data_ptr<float>();
+
+  if (values.scalar_type() == at::kBFloat16) {
+    sparse_linear_gemm(
+        x_ptr,
+        M,
+        Kp,
+        values.data_ptr<at::BFloat16>(),
+        col_ptr,
+        row_ptr_,
+        b_ptr,
+        N,
+        post_op,
+        out_ptr);
+  } else {
+    sparse_linear_gemm(
+        x_ptr,
+        M,
+        Kp,
+        values.data_ptr<float>(),
+        col_ptr,
+        row_ptr_,
+        b_ptr,
+        N,
+        post_op,
+        out_ptr);
+  }
+
+  if (!out_fp32.is_same(output)) {
+    output.copy_(out_fp32);
+  }
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(sparse_linear_kernel_stub, &sparse_linear_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
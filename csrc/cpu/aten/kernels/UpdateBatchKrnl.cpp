@@ -22,7 +22,7 @@ using namespace torch_ipex::cpu::kernel;
 
 template <typename T>
 inline void update_hidden_kernel(
-    std::vector<int64_t> idx,
+    const std::vector<int64_t>& idx,
     at::Tensor hidden,
     at::Tensor hidden_prime) {
   auto* hidden_ptr = hidden.data_ptr<T>();
@@ -32,13 +32,15 @@ inline void update_hidden_kernel(
   int64_t ld = hidden.size(0);
   int64_t bs = hidden.size(1);
   int64_t feature_size = hidden.size(2);
-  // TODO: at::parallel_for
-  for (int64_t i = 0; i < ld; i++) {
-    for (int64_t j = 0; j < idx_len; j++) {
+  // every (layer, batch idx) row is copied independently
+  at::parallel_for(0, ld * idx_len, 16, [&](int64_t start, int64_t end) {
+    for (int64_t n = start; n < end; n++) {
+      int64_t i = n / idx_len;
+      int64_t j = n % idx_len;
       auto pos = i * bs * feature_size + idx[j] * feature_size;
       move_ker(&hidden_ptr[pos], &hidden_prime_ptr[pos], feature_size);
     }
-  }
+  });
 }
 
 template <typename T>
@@ -89,10 +91,12 @@ inline void label_index_put_kernel(
       static_cast<int64_t*>(label_to_put_out.data_ptr());
 
   int32_t* label_col_ptr = static_cast<int32_t*>(label_col.data_ptr());
+  // usually max_len * max_symbols, callers may reserve extra columns
+  int64_t ld = label_tensor_out.stride(0);
 
   at::parallel_for(0, batch_size, 16, [&](int64_t start, int64_t end) {
     for (int64_t i = start; i < end; i++) {
-      label_tensor_out_ptr[i * max_len * max_symbols + label_col_ptr[i]] +=
+      label_tensor_out_ptr[i * ld + label_col_ptr[i]] +=
           label_to_put_out_ptr[i];
     }
   });
@@ -104,7 +108,7 @@ inline void label_index_put_kernel(
   at::parallel_for(0, batch_size, 16, [&](int64_t start, int64_t end) {
     for (int64_t i = start; i < end; i++) {
       label_for_next_loop_out_ptr[i] =
-          label_tensor_out_ptr[i * max_len * max_symbols + label_col_ptr[i]];
+          label_tensor_out_ptr[i * ld + label_col_ptr[i]];
     }
   });
 }
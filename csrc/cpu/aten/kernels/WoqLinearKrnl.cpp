@@ -0,0 +1,246 @@
+#include <ATen/Parallel.h>
+#include <c10/util/irange.h>
+#include <torch/csrc/autograd/function.h>
+#include "aten/WoqLinear.h"
+#include "vec/vec.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+// Rows of the activation computed together, so that each dequantized
+// weight column is reused from registers for all of them.
+constexpr int64_t kWoqMTile = 4;
+
+#if defined(CPU_CAPABILITY_AVX512)
+template <bool is_int4>
+inline __m512 woq_load_weight(const uint8_t* w, int64_t k) {
+  if (is_int4) {
+    auto packed = _mm_loadl_epi64(
+        reinterpret_cast<const __m128i*>(w + k * kWoqNBlock / 2));
+    auto mask = _mm_set1_epi8(0xF);
+    auto lo = _mm_and_si128(packed, mask);
+    auto hi = _mm_and_si128(_mm_srli_epi16(packed, 4), mask);
+    auto values = _mm512_cvtepu8_epi32(_mm_unpacklo_epi64(lo, hi));
+    return _mm512_cvtepi32_ps(_mm512_sub_epi32(values, _mm512_set1_epi32(8)));
+  }
+  auto values = _mm512_cvtepi8_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + k * kWoqNBlock)));
+  return _mm512_cvtepi32_ps(values);
+}
+
+// Computes rows x 16 outputs for one block of output channels. The int
+// weights of a group are accumulated unscaled and the group scale is applied
+// once at the end of the group.
+template <int64_t rows, bool is_int4>
+void woq_gemm_block(
+    const float* x,
+    int64_t K,
+    const uint8_t* w,
+    const float* scales,
+    int64_t group_size,
+    const float* bias,
+    float* out,
+    int64_t ldc,
+    int64_t n_valid) {
+  __m512 out_vec[rows];
+  for (int64_t r = 0; r < rows; r++) {
+    out_vec[r] = _mm512_setzero_ps();
+  }
+  for (int64_t k0 = 0, g = 0; k0 < K; k0 += group_size, g++) {
+    auto k1 = std::min(K, k0 + group_size);
+    __m512 acc[rows];
+    for (int64_t r = 0; r < rows; r++) {
+      acc[r] = _mm512_setzero_ps();
+    }
+    for (int64_t k = k0; k < k1; k++) {
+      auto weight = woq_load_weight<is_int4>(w, k);
+      for (int64_t r = 0; r < rows; r++) {
+        acc[r] = _mm512_fmadd_ps(_mm512_set1_ps(x[r * K + k]), weight, acc[r]);
+      }
+    }
+    auto scale = _mm512_loadu_ps(scales + g * kWoqNBlock);
+    for (int64_t r = 0; r < rows; r++) {
+      out_vec[r] = _mm512_fmadd_ps(acc[r], scale, out_vec[r]);
+    }
+  }
+  __mmask16 mask = (1 << n_valid) - 1;
+  if (bias != nullptr) {
+    auto bias_vec = _mm512_maskz_loadu_ps(mask, bias);
+    for (int64_t r = 0; r < rows; r++) {
+      out_vec[r] = _mm512_add_ps(out_vec[r], bias_vec);
+    }
+  }
+  for (int64_t r = 0; r < rows; r++) {
+    _mm512_mask_storeu_ps(out + r * ldc, mask, out_vec[r]);
+  }
+}
+#else
+template <int64_t rows, bool is_int4>
+void woq_gemm_block(
+    const float* x,
+    int64_t K,
+    const uint8_t* w,
+    const float* scales,
+    int64_t group_size,
+    const float* bias,
+    float* out,
+    int64_t ldc,
+    int64_t n_valid) {
+  float out_buf[rows][kWoqNBlock] = {};
+  float weight[kWoqNBlock];
+  for (int64_t k0 = 0, g = 0; k0 < K; k0 += group_size, g++) {
+    auto k1 = std::min(K, k0 + group_size);
+    float acc[rows][kWoqNBlock] = {};
+    for (int64_t k = k0; k < k1; k++) {
+      if (is_int4) {
+        auto packed = w + k * kWoqNBlock / 2;
+        for (int64_t j = 0; j < kWoqNBlock / 2; j++) {
+          weight[j] = static_cast<float>(packed[j] & 0xF) - 8;
+          weight[j + kWoqNBlock / 2] = static_cast<float>(packed[j] >> 4) - 8;
+        }
+      } else {
+        auto packed = reinterpret_cast<const int8_t*>(w + k * kWoqNBlock);
+        for (int64_t j = 0; j < kWoqNBlock; j++) {
+          weight[j] = static_cast<float>(packed[j]);
+        }
+      }
+      for (int64_t r = 0; r < rows; r++) {
+        auto x_val = x[r * K + k];
+        for (int64_t j = 0; j < kWoqNBlock; j++) {
+          acc[r][j] += x_val * weight[j];
+        }
+      }
+    }
+    auto scale = scales + g * kWoqNBlock;
+    for (int64_t r = 0; r < rows; r++) {
+      for (int64_t j = 0; j < kWoqNBlock; j++) {
+        out_buf[r][j] += acc[r][j] * scale[j];
+      }
+    }
+  }
+  for (int64_t r = 0; r < rows; r++) {
+    for (int64_t j = 0; j < n_valid; j++) {
+      out[r * ldc + j] = out_buf[r][j] + (bias != nullptr ? bias[j] : 0.f);
+    }
+  }
+}
+#endif
+
+template <bool is_int4>
+void woq_gemm_rows(
+    int64_t rows,
+    const float* x,
+    int64_t K,
+    const uint8_t* w,
+    const float* scales,
+    int64_t group_size,
+    const float* bias,
+    float* out,
+    int64_t ldc,
+    int64_t n_valid) {
+  switch (rows) {
+    case 1:
+      woq_gemm_block<1, is_int4>(
+          x, K, w, scales, group_size, bias, out, ldc, n_valid);
+      break;
+    case 2:
+      woq_gemm_block<2, is_int4>(
+          x, K, w, scales, group_size, bias, out, ldc, n_valid);
+      break;
+    case 3:
+      woq_gemm_block<3, is_int4>(
+          x, K, w, scales, group_size, bias, out, ldc, n_valid);
+      break;
+    default:
+      woq_gemm_block<kWoqMTile, is_int4>(
+          x, K, w, scales, group_size, bias, out, ldc, n_valid);
+  }
+}
+
+void woq_linear_kernel_impl(
+    const at::Tensor& self,
+    const at::Tensor& qweight,
+    const at::Tensor& scales,
+    const at::Tensor& bias,
+    at::ScalarType weight_dtype,
+    int64_t out_features,
+    int64_t group_size,
+    at::Tensor& output) {
+  const int64_t K = self.size(-1);
+  const int64_t M = self.numel() / K;
+  const int64_t N = out_features;
+  if (M == 0 || N == 0) {
+    return;
+  }
+  const bool is_int4 = weight_dtype == at::kQUInt4x2;
+  const int64_t gs = group_size <= 0 || group_size > K ? K : group_size;
+  const int64_t groups = (K + gs - 1) / gs;
+  const int64_t blocks = (N + kWoqNBlock - 1) / kWoqNBlock;
+  const int64_t block_bytes = is_int4 ? K * kWoqNBlock / 2 : K * kWoqNBlock;
+
+  // Small-batch inference is bound by reading the weight, so the activation
+  // is converted to FP32 once and the work is split over output channels:
+  // each packed weight block is read by exactly one thread.
+  auto input = self.to(at::kFloat).contiguous();
+  auto bias_ = bias.defined() ? bias.to(at::kFloat).contiguous() : bias;
+  auto out_fp32 = output.scalar_type() == at::kFloat && output.is_contiguous()
+      ? output
+      : at::empty(output.sizes(), output.options().dtype(at::kFloat));
+
+  const float* x_ptr = input.data_ptr<float>();
+  const uint8_t* w_ptr = reinterpret_cast<const uint8_t*>(qweight.data_ptr());
+  const float* s_ptr = scales.data_ptr<float>();
+  const float* b_ptr = bias_.defined() ? bias_.data_ptr<float>() : nullptr;
+  float* out_ptr = out_fp32.data_ptr<float>();
+
+  at::parallel_for(0, blocks, 1, [&](int64_t begin, int64_t end) {
+    for (const auto nb : c10::irange(begin, end)) {
+      const int64_t n_start = nb * kWoqNBlock;
+      const int64_t n_valid = std::min(kWoqNBlock, N - n_start);
+      const uint8_t* w = w_ptr + nb * block_bytes;
+      const float* s = s_ptr + nb * groups * kWoqNBlock;
+      const float* b = b_ptr != nullptr ? b_ptr + n_start : nullptr;
+      for (int64_t m = 0; m < M; m += kWoqMTile) {
+        const int64_t rows = std::min(kWoqMTile, M - m);
+        if (is_int4) {
+          woq_gemm_rows<true>(
+              rows,
+              x_ptr + m * K,
+              K,
+              w,
+              s,
+              gs,
+              b,
+              out_ptr + m * N + n_start,
+              N,
+              n_valid);
+        } else {
+          woq_gemm_rows<false>(
+              rows,
+              x_ptr + m * K,
+              K,
+              w,
+              s,
+              gs,
+              b,
+              out_ptr + m * N + n_start,
+              N,
+              n_valid);
+        }
+      }
+    }
+  });
+
+  if (!out_fp32.is_same(output)) {
+    output.copy_(out_fp32);
+  }
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(woq_linear_kernel_stub, &woq_linear_kernel_impl);
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec/vec.h>
+#include <c10/util/irange.h>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace torch_ipex {
+namespace cpu {
+// The helpers are compiled into the kernels of every ISA, see Note
+// [CPU_CAPABILITY namespace] in PyTorch.
+inline namespace CPU_CAPABILITY {
+
+// erf based GELU on rows x n outputs with leading dimension ld, applied
+// right after a tile is written, while it is still in L1
+inline void gelu_erf_rows(float* out, int64_t rows, int64_t ld, int64_t n) {
+  using Vec = at::vec::Vectorized<float>;
+  const Vec half(0.5f);
+  const Vec one(1.f);
+  const Vec sqrt1_2(static_cast<float>(M_SQRT1_2));
+  for (int64_t r = 0; r < rows; r++) {
+    float* row = out + r * ld;
+    int64_t j = 0;
+    for (; j + Vec::size() <= n; j += Vec::size()) {
+      auto x = Vec::loadu(row + j);
+      (x * half * (one + (x * sqrt1_2).erf())).store(row + j);
+    }
+    if (j < n) {
+      auto x = Vec::loadu(row + j, n - j);
+      (x * half * (one + (x * sqrt1_2).erf())).store(row + j, n - j);
+    }
+  }
+}
+
+template <int64_t rows, int64_t max_rows>
+struct RowTileDispatch {
+  template <typename F>
+  static void call(int64_t n, const F& f) {
+    if (n == rows) {
+      f(std::integral_constant<int64_t, rows>());
+    } else {
+      RowTileDispatch<rows + 1, max_rows>::call(n, f);
+    }
+  }
+};
+
+template <int64_t max_rows>
+struct RowTileDispatch<max_rows, max_rows> {
+  template <typename F>
+  static void call(int64_t n, const F& f) {
+    f(std::integral_constant<int64_t, max_rows>());
+  }
+};
+
+// Calls f(std::integral_constant<int64_t, n>()) for n in [1, max_rows], so
+// that the rows of a tail tile are a compile time constant as well.
+template <int64_t max_rows, typename F>
+inline void dispatch_row_tile(int64_t n, const F& f) {
+  RowTileDispatch<1, max_rows>::call(n, f);
+}
+
+// Walks over the output tiles of an [M, N] GEMM whose weight is stored in
+// blocks of n_block output channels, calling
+// f(m, rows, nb, n_start, n_valid) for rows <= m_tile activation rows
+// starting at m and the n_valid channels of block nb starting at n_start.
+//
+// Small batches are bound by reading the weight, so each weight block is
+// read by one thread. Larger batches are also split into chunks of m_chunk
+// rows, neighbouring tasks share the chunk and walk over the weight blocks.
+template <int64_t m_tile, typename F>
+inline void parallel_row_tiles(
+    int64_t M,
+    int64_t N,
+    int64_t n_block,
+    int64_t m_chunk,
+    const F& f) {
+  const int64_t blocks = (N + n_block - 1) / n_block;
+  const int64_t chunks = (M + m_chunk - 1) / m_chunk;
+  at::parallel_for(0, chunks * blocks, 1, [&](int64_t begin, int64_t end) {
+    for (const auto task : c10::irange(begin, end)) {
+      const int64_t m_start = task / blocks * m_chunk;
+      const int64_t m_end = std::min(M, m_start + m_chunk);
+      const int64_t nb = task % blocks;
+      const int64_t n_start = nb * n_block;
+      const int64_t n_valid = std::min(n_block, N - n_start);
+      for (int64_t m = m_start; m < m_end; m += m_tile) {
+        f(m, std::min(m_tile, m_end - m), nb, n_start, n_valid);
+      }
+    }
+  });
+}
+
+} // namespace CPU_CAPABILITY
+} // namespace cpu
+} // namespace torch_ipex
@@ -7,8 +7,12 @@
 #include <dnnl.hpp>
 
 #include <algorithm>
+#include <cctype>
 #include <cstdlib>
 #include <cstring>
+#include <map>
+#include <mutex>
+#include <sstream>
 
 namespace torch_ipex {
 namespace cpu {
@@ -39,6 +43,19 @@ const char* CPUCapabilityToString(CPUCapability isa) {
   }
 }
 
+bool parse_cpu_capability(const std::string& isa_str, CPUCapability& isa) {
+  std::string upper(isa_str);
+  std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+  for (int i = 0; i < static_cast<int>(CPUCapability::NUM_OPTIONS); i++) {
+    auto cap = static_cast<CPUCapability>(i);
+    if (upper == CPUCapabilityToString(cap)) {
+      isa = cap;
+      return true;
+    }
+  }
+  return false;
+}
+
 CPUCapability _get_highest_cpu_support_isa_level() {
   /*
   reference to FindAVX.cmake
@@ -198,8 +215,147 @@ CPUCapability get_cpu_capability() {
   return g_cpu_capability;
 }
 
+static bool _load_dispatch_stub_profiling_setting() {
+  auto envar = std::getenv("IPEX_STUB_PROFILE");
+  if (envar) {
+    if (strcmp(envar, "1") == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::atomic<bool> g_dispatch_stub_profiling{
+    _load_dispatch_stub_profiling_setting()};
+
+void set_dispatch_stub_profiling(bool enabled) {
+  g_dispatch_stub_profiling.store(enabled, std::memory_order_relaxed);
+}
+
+namespace {
+
+// Stubs that have selected a kernel at least once, and the per-stub ISA
+// overrides. Only touched on the slow path of DispatchStubImpl::get_call_ptr
+// and by the query/override APIs.
+struct DispatchStubRegistry {
+  std::mutex mutex;
+  std::map<std::string, DispatchStubImpl*> stubs;
+  std::map<std::string, CPUCapability> isa_overrides;
+
+  DispatchStubRegistry() {
+    // IPEX_STUB_ISA=<stub name>:<isa>[,<stub name>:<isa>...]
+    auto envar = std::getenv("IPEX_STUB_ISA");
+    if (!envar) {
+      return;
+    }
+    std::stringstream ss(envar);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      auto pos = item.rfind(':');
+      CPUCapability isa;
+      if (pos == std::string::npos ||
+          !parse_cpu_capability(item.substr(pos + 1), isa)) {
+        TORCH_WARN("ignoring invalid item for IPEX_STUB_ISA: ", item);
+        continue;
+      }
+      isa_overrides[item.substr(0, pos)] = isa;
+    }
+  }
+};
+
+DispatchStubRegistry& dispatch_stub_registry() {
+  static DispatchStubRegistry registry;
+  return registry;
+}
+
+CPUCapability get_stub_cpu_capability(const char* name) {
+  auto capability = get_cpu_capability();
+  auto& registry = dispatch_stub_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto it = registry.isa_overrides.find(name);
+  if (it == registry.isa_overrides.end()) {
+    return capability;
+  }
+  if (it->second > capability) {
+    TORCH_WARN(
+        "DispatchStub: ",
+        name,
+        " is forced to ",
+        CPUCapabilityToString(it->second),
+        " but only ",
+        CPUCapabilityToString(capability),
+        " is available, fall back to ",
+        CPUCapabilityToString(capability));
+    return capability;
+  }
+  return it->second;
+}
+
+void register_dispatch_stub(const char* name, DispatchStubImpl* impl) {
+  auto& registry = dispatch_stub_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.stubs[name] = impl;
+}
+
+void reset_dispatch_stub_ptr(const std::string& name) {
+  // Callers hold the registry lock. The next call of the stub selects the
+  // kernel again.
+  auto& registry = dispatch_stub_registry();
+  auto it = registry.stubs.find(name);
+  if (it != registry.stubs.end()) {
+    it->second->cpu_dispatch_ptr.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+} // anonymous namespace
+
+std::vector<DispatchStubStats> get_dispatch_stub_stats() {
+  std::vector<DispatchStubStats> stats;
+  auto& registry = dispatch_stub_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto& stub : registry.stubs) {
+    auto impl = stub.second;
+    auto isa = static_cast<CPUCapability>(
+        impl->cpu_dispatch_isa.load(std::memory_order_relaxed));
+    stats.push_back(
+        {stub.first,
+         CPUCapabilityToString(isa),
+         impl->calls.load(std::memory_order_relaxed),
+         impl->total_ns.load(std::memory_order_relaxed)});
+  }
+  return stats;
+}
+
+void reset_dispatch_stub_stats() {
+  auto& registry = dispatch_stub_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto& stub : registry.stubs) {
+    stub.second->calls.store(0, std::memory_order_relaxed);
+    stub.second->total_ns.store(0, std::memory_order_relaxed);
+  }
+}
+
+void set_dispatch_stub_isa(const std::string& name, CPUCapability isa) {
+  TORCH_CHECK(
+      isa < CPUCapability::NUM_OPTIONS,
+      "DispatchStub: invalid ISA level for ",
+      name);
+  auto& registry = dispatch_stub_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.isa_overrides[name] = isa;
+  reset_dispatch_stub_ptr(name);
+}
+
+void clear_dispatch_stub_isa(const std::string& name) {
+  auto& registry = dispatch_stub_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.isa_overrides.erase(name);
+  reset_dispatch_stub_ptr(name);
+}
+
 void* DispatchStubImpl::get_call_ptr(
     DeviceType device_type,
+    const char* name,
     void* DEFAULT
 #ifdef HAVE_AMX_CPU_DEFINITION
     ,
@@ -233,6 +389,7 @@ void* DispatchStubImpl::get_call_ptr(
       auto fptr = cpu_dispatch_ptr.load(std::memory_order_relaxed);
       if (!fptr) {
         fptr = choose_cpu_impl(
+            name,
             DEFAULT
 #ifdef HAVE_AMX_CPU_DEFINITION
             ,
@@ -260,6 +417,7 @@ void* DispatchStubImpl::get_call_ptr(
 #endif
         );
         cpu_dispatch_ptr.store(fptr, std::memory_order_relaxed);
+        register_dispatch_stub(name, this);
       }
       return fptr;
     }
@@ -277,6 +435,7 @@ void* DispatchStubImpl::get_call_ptr(
 }
 
 void* DispatchStubImpl::choose_cpu_impl(
+    const char* name,
     void* DEFAULT
 #ifdef HAVE_AMX_CPU_DEFINITION
     ,
@@ -303,8 +462,12 @@ void* DispatchStubImpl::choose_cpu_impl(
     void* AVX2
 #endif
 ) {
-  auto capability = static_cast<int>(get_cpu_capability());
+  auto capability = static_cast<int>(get_stub_cpu_capability(name));
   (void)capability;
+  auto select = [this](void* fptr, CPUCapability isa) {
+    cpu_dispatch_isa.store(static_cast<int>(isa), std::memory_order_relaxed);
+    return fptr;
+  };
 #ifdef HAVE_AMX_CPU_DEFINITION
   if (capability >= static_cast<int>(CPUCapability::AMX)) {
     // Quantization kernels have also been disabled on Windows
@@ -313,9 +476,9 @@ void* DispatchStubImpl::choose_cpu_impl(
     if (C10_UNLIKELY(!AMX)) {
       // dispatch to AVX2, since the AVX512 kernel is missing
       TORCH_INTERNAL_ASSERT(AVX2, "DispatchStub: missing AVX2 kernel");
-      return AVX2;
+      return select(AVX2, CPUCapability::AVX2);
     } else {
-      return AMX;
+      return select(AMX, CPUCapability::AMX);
     }
   }
 #endif
@@ -327,9 +490,9 @@ void* DispatchStubImpl::choose_cpu_impl(
     if (C10_UNLIKELY(!AVX512_BF16)) {
       // dispatch to AVX2, since the AVX512 kernel is missing
       TORCH_INTERNAL_ASSERT(AVX2, "DispatchStub: missing AVX2 kernel");
-      return AVX2;
+      return select(AVX2, CPUCapability::AVX2);
     } else {
-      return AVX512_BF16;
+      return select(AVX512_BF16, CPUCapability::AVX512_BF16);
     }
   }
 #endif
@@ -341,9 +504,9 @@ void* DispatchStubImpl::choose_cpu_impl(
     if (C10_UNLIKELY(!AVX512_VNNI)) {
       // dispatch to AVX2, since the AVX512 kernel is missing
       TORCH_INTERNAL_ASSERT(AVX2, "DispatchStub: missing AVX2 kernel");
-      return AVX2;
+      return select(AVX2, CPUCapability::AVX2);
     } else {
-      return AVX512_VNNI;
+      return select(AVX512_VNNI, CPUCapability::AVX512_VNNI);
     }
   }
 #endif
@@ -355,27 +518,27 @@ void* DispatchStubImpl::choose_cpu_impl(
     if (C10_UNLIKELY(!AVX512)) {
       // dispatch to AVX2, since the AVX512 kernel is missing
       TORCH_INTERNAL_ASSERT(AVX2, "DispatchStub: missing AVX2 kernel");
-      return AVX2;
+      return select(AVX2, CPUCapability::AVX2);
     } else {
-      return AVX512;
+      return select(AVX512, CPUCapability::AVX512);
     }
   }
 #endif
 #ifdef HAVE_AVX2_VNNI_CPU_DEFINITION
   if (capability >= static_cast<int>(CPUCapability::AVX2_VNNI)) {
     TORCH_INTERNAL_ASSERT(AVX2_VNNI, "DispatchStub: missing AVX2_VNNI kernel");
-    return AVX2_VNNI;
+    return select(AVX2_VNNI, CPUCapability::AVX2_VNNI);
   }
 #endif
 #ifdef HAVE_AVX2_CPU_DEFINITION
   if (capability >= static_cast<int>(CPUCapability::AVX2)) {
     TORCH_INTERNAL_ASSERT(AVX2, "DispatchStub: missing AVX2 kernel");
-    return AVX2;
+    return select(AVX2, CPUCapability::AVX2);
   }
 #endif
 
   TORCH_INTERNAL_ASSERT(DEFAULT, "DispatchStub: missing default kernel");
-  return DEFAULT;
+  return select(DEFAULT, CPUCapability::DEFAULT);
 }
 
 } // namespace cpu
@@ -5,7 +5,10 @@
 #include <c10/util/Exception.h>
 
 #include <atomic>
+#include <chrono>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 using namespace c10;
 
@@ -36,6 +39,12 @@ using namespace c10;
 // To call:
 //   stub(kCPU, tensor);
 //
+// Per-stub call counters (calls, cumulative time, chosen CPUCapability) are
+// collected when profiling is turned on by set_dispatch_stub_profiling() or
+// IPEX_STUB_PROFILE=1, and the ISA of a single stub can be overridden by
+// set_dispatch_stub_isa() or e.g.
+// IPEX_STUB_ISA=merged_embeddingbag_forward_cpu_kernel_stub:AVX512.
+//
 // TODO: CPU instruction set selection should be folded into whatever
 // the main dispatch mechanism is.
 
@@ -67,6 +76,39 @@ bool check_not_sync_onednn_isa_level();
 
 CPUCapability get_cpu_capability();
 
+// Parses the names returned by CPUCapabilityToString, case insensitive.
+bool parse_cpu_capability(const std::string& isa_str, CPUCapability& isa);
+
+// Instrumentation of the DispatchStub calls. Disabled by default, in which
+// case the only cost per call is one relaxed load of the flag below.
+extern TORCH_API std::atomic<bool> g_dispatch_stub_profiling;
+
+inline bool is_dispatch_stub_profiling_enabled() {
+  return g_dispatch_stub_profiling.load(std::memory_order_relaxed);
+}
+
+TORCH_API void set_dispatch_stub_profiling(bool enabled);
+
+struct DispatchStubStats {
+  std::string name;
+  std::string isa;
+  uint64_t calls;
+  uint64_t total_ns;
+};
+
+// Stubs only show up once they have been called at least once.
+TORCH_API std::vector<DispatchStubStats> get_dispatch_stub_stats();
+TORCH_API void reset_dispatch_stub_stats();
+
+// Forces the stub with the given name (the DECLARE_DISPATCH name, e.g.
+// "cumsum_kernel_stub") onto an ISA level. The level is capped by
+// get_cpu_capability() and falls back like the global selection does if the
+// variant is missing.
+TORCH_API void set_dispatch_stub_isa(
+    const std::string& name,
+    CPUCapability isa);
+TORCH_API void clear_dispatch_stub_isa(const std::string& name);
+
 template <typename FnPtr, typename T>
 struct DispatchStub;
 
@@ -79,6 +121,7 @@ struct DispatchStub;
 struct TORCH_API DispatchStubImpl {
   void* get_call_ptr(
       DeviceType device_type,
+      const char* name,
       void* DEFAULT
 #ifdef HAVE_AMX_CPU_DEFINITION
       ,
@@ -112,6 +155,7 @@ struct TORCH_API DispatchStubImpl {
    * DispatchStubImpl::get_call_ptr() in cpu_dispatch_ptr.
    */
   void* choose_cpu_impl(
+      const char* name,
       void* DEFAULT
 #ifdef HAVE_AMX_CPU_DEFINITION
       ,
@@ -139,6 +183,11 @@ struct TORCH_API DispatchStubImpl {
 #endif
   );
 
+  void record_call(uint64_t ns) {
+    calls.fetch_add(1, std::memory_order_relaxed);
+    total_ns.fetch_add(ns, std::memory_order_relaxed);
+  }
+
 // Fixing dispatch error in Windows debug builds.
 // See https://github.com/pytorch/pytorch/issues/22681 for more details.
 #if defined(_MSC_VER) && defined(_DEBUG)
@@ -148,6 +197,26 @@ struct TORCH_API DispatchStubImpl {
   std::atomic<void*> cpu_dispatch_ptr{nullptr};
   void* xpu_dispatch_ptr = nullptr;
 #endif
+  // Instrumentation, see get_dispatch_stub_stats().
+  std::atomic<int> cpu_dispatch_isa{
+      static_cast<int>(CPUCapability::NUM_OPTIONS)};
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> total_ns{0};
+};
+
+// Times one stub call when profiling is enabled.
+struct DispatchStubCallTimer {
+  explicit DispatchStubCallTimer(DispatchStubImpl& impl)
+      : impl_(impl), start_(std::chrono::steady_clock::now()) {}
+  ~DispatchStubCallTimer() {
+    impl_.record_call(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - start_)
+                          .count());
+  }
+
+ private:
+  DispatchStubImpl& impl_;
+  std::chrono::steady_clock::time_point start_;
 };
 
 template <typename rT, typename T, typename... Args>
@@ -162,6 +231,7 @@ struct DispatchStub<rT (*)(Args...), T> {
   FnPtr get_call_ptr(DeviceType device_type) {
     return reinterpret_cast<FnPtr>(impl.get_call_ptr(
         device_type,
+        T::stub_name(),
         reinterpret_cast<void*>(DEFAULT)
 #ifdef HAVE_AMX_CPU_DEFINITION
             ,
@@ -194,6 +264,10 @@ struct DispatchStub<rT (*)(Args...), T> {
   template <typename... ArgTypes>
   rT operator()(DeviceType device_type, ArgTypes&&... args) {
     FnPtr call_ptr = get_call_ptr(device_type);
+    if (C10_UNLIKELY(is_dispatch_stub_profiling_enabled())) {
+      DispatchStubCallTimer timer(impl);
+      return (*call_ptr)(std::forward<ArgTypes>(args)...);
+    }
     return (*call_ptr)(std::forward<ArgTypes>(args)...);
   }
 
@@ -201,6 +275,49 @@ struct DispatchStub<rT (*)(Args...), T> {
     impl.xpu_dispatch_ptr = reinterpret_cast<void*>(fn_ptr);
   }
 
+  // Overrides the cached CPU call pointer, e.g. to force a specific ISA
+  // variant in benchmarks. Passing nullptr restores the default selection on
+  // the next call.
+  void set_cpu_dispatch_ptr(FnPtr fn_ptr) {
+    impl.cpu_dispatch_ptr.store(
+        reinterpret_cast<void*>(fn_ptr), std::memory_order_relaxed);
+  }
+
+  // Returns the kernel registered for the given ISA level, or nullptr if the
+  // binary does not carry a variant for it.
+  FnPtr get_cpu_isa_ptr(CPUCapability isa) {
+    switch (isa) {
+      case CPUCapability::DEFAULT:
+        return DEFAULT;
+#ifdef HAVE_AMX_CPU_DEFINITION
+      case CPUCapability::AMX:
+        return AMX;
+#endif
+#ifdef HAVE_AVX512_BF16_CPU_DEFINITION
+      case CPUCapability::AVX512_BF16:
+        return AVX512_BF16;
+#endif
+#ifdef HAVE_AVX512_VNNI_CPU_DEFINITION
+      case CPUCapability::AVX512_VNNI:
+        return AVX512_VNNI;
+#endif
+#ifdef HAVE_AVX512_CPU_DEFINITION
+      case CPUCapability::AVX512:
+        return AVX512;
+#endif
+#ifdef HAVE_AVX2_VNNI_CPU_DEFINITION
+      case CPUCapability::AVX2_VNNI:
+        return AVX2_VNNI;
+#endif
+#ifdef HAVE_AVX2_CPU_DEFINITION
+      case CPUCapability::AVX2:
+        return AVX2;
+#endif
+      default:
+        return nullptr;
+    }
+  }
+
   static FnPtr DEFAULT;
 #ifdef HAVE_AMX_CPU_DEFINITION
   static FnPtr AMX;
@@ -252,6 +369,9 @@ struct RegisterHIPDispatch {
     name() = default;                      \
     name(const name&) = delete;            \
     name& operator=(const name&) = delete; \
+    static const char* stub_name() {       \
+      return #name;                        \
+    }                                      \
   };                                       \
   extern TORCH_API struct name name
 
@@ -1,6 +1,7 @@
 #include "IDeepConversions.h"
 #include <ATen/OpaqueTensorImpl.h>
 #include <c10/core/Allocator.h>
+#include "runtime/NumaAllocator.h"
 
 namespace torch_ipex {
 
@@ -221,7 +222,8 @@ at::Tensor mkldnn_to_dense(
 // Init a aten tensor according to ideep tensor's desc.
 at::Tensor empty_aten_tensor_from_desc(
     const ideep::tensor::desc& desc,
-    const at::TensorOptions& options) {
+    const at::TensorOptions& options,
+    bool numa_local) {
   auto ndims = desc.data.ndims;
   auto nblks = desc.blocking_desc().inner_nblks;
   std::vector<int64_t> at_sizes(ndims + nblks);
@@ -236,6 +238,9 @@ at::Tensor empty_aten_tensor_from_desc(
   for (auto i = 0; i < ndims; i++) {
     at_sizes[i] = padded_dims[i] / blk_size_per_dim[i];
   }
+  if (numa_local) {
+    return torch_ipex::runtime::numa_empty(at_sizes, options);
+  }
   return at::empty(at_sizes, options);
 }
 
@@ -35,9 +35,12 @@ at::Tensor mkldnn_to_dense(
     const at::Tensor& self,
     c10::optional<at::ScalarType> dtype = c10::nullopt);
 
+// Allocate from the NUMA-local allocator when `numa_local` is set, see
+// runtime::NumaAllocator
 at::Tensor empty_aten_tensor_from_desc(
     const ideep::tensor::desc& desc,
-    const at::TensorOptions& options);
+    const at::TensorOptions& options,
+    bool numa_local = false);
 
 // ##Background##
 // This function returns the input tensor's stride with a workaround that checks
@@ -0,0 +1,356 @@
+#include "NumaAllocator.h"
+
+#include <ATen/EmptyTensor.h>
+#include <c10/util/Exception.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+
+namespace torch_ipex {
+namespace runtime {
+
+namespace {
+
+constexpr size_t k2M = 2UL << 20;
+constexpr size_t k1G = 1UL << 30;
+constexpr int kMaxNumaNodes = 1024;
+
+enum class BlockKind : uint8_t { Normal, Huge2M, Huge1G };
+
+struct Block {
+  void* ptr;
+  size_t size;
+  int node;
+  BlockKind kind;
+};
+
+size_t round_up(size_t n, size_t alignment) {
+  return (n + alignment - 1) / alignment * alignment;
+}
+
+int current_numa_node() {
+  unsigned cpu = 0, node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+    return -1;
+  }
+  return static_cast<int>(node);
+}
+
+bool huge_1g_pages_available() {
+  std::ifstream f(
+      "/sys/kernel/mm/hugepages/hugepages-1048576kB/free_hugepages");
+  size_t free_pages = 0;
+  return f && (f >> free_pages) && free_pages > 0;
+}
+
+// Prefer the pages of [ptr, ptr + size) on `node`. Only pages not faulted
+// yet are affected, so this is done right after mmap.
+bool bind_to_node(void* ptr, size_t size, int node) {
+  if (node < 0) {
+    return true;
+  }
+  if (node >= kMaxNumaNodes) {
+    return false;
+  }
+  constexpr int kBitsPerLong = 8 * sizeof(unsigned long);
+  unsigned long mask[kMaxNumaNodes / kBitsPerLong] = {};
+  mask[node / kBitsPerLong] |= 1UL << (node % kBitsPerLong);
+  // MPOL_PREFERRED instead of MPOL_BIND: fall back to other nodes rather
+  // than failing when the local node is full
+  return syscall(
+             SYS_mbind,
+             ptr,
+             size,
+             MPOL_PREFERRED,
+             mask,
+             kMaxNumaNodes + 1,
+             0) == 0;
+}
+
+size_t max_cached_bytes_from_env() {
+  const char* env = std::getenv("IPEX_NUMA_ALLOCATOR_MAX_CACHE_MB");
+  size_t mb = env != nullptr ? std::strtoull(env, nullptr, 10) : 4096;
+  return mb << 20;
+}
+
+class NumaAllocatorImpl {
+ public:
+  static NumaAllocatorImpl& get() {
+    static NumaAllocatorImpl impl;
+    return impl;
+  }
+
+  void* acquire(size_t nbytes) {
+    const int node = current_numa_node();
+    const size_t size = size_class(nbytes);
+    std::lock_guard<std::mutex> guard(mutex_);
+    stats_.allocations++;
+    Block block;
+    auto it = free_blocks_.find({node, size});
+    if (it != free_blocks_.end() && !it->second.empty()) {
+      block = it->second.back();
+      it->second.pop_back();
+      stats_.cache_hits++;
+      stats_.bytes_cached -= block.size;
+    } else {
+      stats_.cache_misses++;
+      block = map_block(size, node);
+    }
+    in_use_[block.ptr] = block;
+    stats_.bytes_in_use += block.size;
+    stats_.node_bytes_in_use[block.node] += block.size;
+    stats_.peak_bytes_in_use =
+        std::max(stats_.peak_bytes_in_use, stats_.bytes_in_use);
+    return block.ptr;
+  }
+
+  // Returns false if ptr is not owned by the NUMA allocator
+  bool release(void* ptr) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = in_use_.find(ptr);
+    if (it == in_use_.end()) {
+      return false;
+    }
+    Block block = it->second;
+    in_use_.erase(it);
+    stats_.frees++;
+    stats_.bytes_in_use -= block.size;
+    stats_.node_bytes_in_use[block.node] -= block.size;
+    if (stats_.bytes_cached + block.size <= max_cached_bytes_) {
+      free_blocks_[{block.node, block.size}].push_back(block);
+      stats_.bytes_cached += block.size;
+    } else {
+      unmap_block(block);
+    }
+    return true;
+  }
+
+  void empty_cache() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (auto& entry : free_blocks_) {
+      for (auto& block : entry.second) {
+        unmap_block(block);
+      }
+    }
+    free_blocks_.clear();
+    stats_.bytes_cached = 0;
+  }
+
+  NumaAllocatorStats get_stats() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return stats_;
+  }
+
+  void reset_peak_stats() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stats_.peak_bytes_in_use = stats_.bytes_in_use;
+  }
+
+ private:
+  NumaAllocatorImpl() : max_cached_bytes_(max_cached_bytes_from_env()) {}
+
+  static size_t size_class(size_t nbytes) {
+    if (nbytes < k2M) {
+      size_t size = kNumaMinBlockSize;
+      while (size < nbytes) {
+        size <<= 1;
+      }
+      return size;
+    }
+    if (nbytes >= k1G && huge_1g_pages_available()) {
+      return round_up(nbytes, k1G);
+    }
+    return round_up(nbytes, k2M);
+  }
+
+  Block map_block(size_t size, int node) {
+    Block block{nullptr, size, node, BlockKind::Normal};
+    if (size >= k1G && size % k1G == 0) {
+      void* ptr = mmap(
+          nullptr,
+          size,
+          PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_1GB,
+          -1,
+          0);
+      if (ptr != MAP_FAILED) {
+        block.ptr = ptr;
+        block.kind = BlockKind::Huge1G;
+      }
+    }
+    if (block.ptr == nullptr && size >= k2M) {
+      // over-map by 2 MB and trim, so that the block starts on a 2 MB
+      // boundary and can be backed by transparent huge pages
+      void* raw = mmap(
+          nullptr,
+          size + k2M,
+          PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | MAP_ANONYMOUS,
+          -1,
+          0);
+      TORCH_CHECK(
+          raw != MAP_FAILED, "NumaAllocator: failed to map ", size, " bytes");
+      auto begin = reinterpret_cast<uintptr_t>(raw);
+      auto aligned = round_up(begin, k2M);
+      if (aligned > begin) {
+        munmap(raw, aligned - begin);
+      }
+      auto tail = begin + size + k2M - (aligned + size);
+      if (tail > 0) {
+        munmap(reinterpret_cast<void*>(aligned + size), tail);
+      }
+      block.ptr = reinterpret_cast<void*>(aligned);
+      block.kind = BlockKind::Huge2M;
+      madvise(block.ptr, size, MADV_HUGEPAGE);
+    }
+    if (block.ptr == nullptr) {
+      void* ptr = mmap(
+          nullptr,
+          size,
+          PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | MAP_ANONYMOUS,
+          -1,
+          0);
+      TORCH_CHECK(
+          ptr != MAP_FAILED, "NumaAllocator: failed to map ", size, " bytes");
+      block.ptr = ptr;
+    }
+    if (!bind_to_node(block.ptr, size, node)) {
+      stats_.mbind_failures++;
+    }
+    if (block.kind == BlockKind::Huge1G) {
+      stats_.huge_1g_bytes += size;
+    } else if (block.kind == BlockKind::Huge2M) {
+      stats_.huge_2m_bytes += size;
+    }
+    return block;
+  }
+
+  void unmap_block(const Block& block) {
+    munmap(block.ptr, block.size);
+    if (block.kind == BlockKind::Huge1G) {
+      stats_.huge_1g_bytes -= block.size;
+    } else if (block.kind == BlockKind::Huge2M) {
+      stats_.huge_2m_bytes -= block.size;
+    }
+  }
+
+  std::mutex mutex_;
+  const size_t max_cached_bytes_;
+  std::map<std::pair<int, size_t>, std::vector<Block>> free_blocks_;
+  std::unordered_map<void*, Block> in_use_;
+  NumaAllocatorStats stats_;
+};
+
+// Small allocations are forwarded to the default CPU allocator. Their raw
+// pointers can still come back here through raw_deallocate when the NUMA
+// allocator is the registered CPU allocator, so they are freed by the
+// default one.
+void numa_free(void* ptr) {
+  if (!NumaAllocatorImpl::get().release(ptr)) {
+    c10::GetDefaultCPUAllocator()->raw_deleter()(ptr);
+  }
+}
+
+NumaAllocator numa_allocator;
+std::atomic<bool> numa_weight_allocation{false};
+std::mutex default_allocator_mutex;
+c10::Allocator* previous_cpu_allocator = nullptr;
+
+} // namespace
+
+c10::DataPtr NumaAllocator::allocate(size_t nbytes) const {
+  if (nbytes < kNumaMinBlockSize) {
+    return c10::GetDefaultCPUAllocator()->allocate(nbytes);
+  }
+  void* ptr = NumaAllocatorImpl::get().acquire(nbytes);
+  return {ptr, ptr, &numa_free, c10::Device(c10::DeviceType::CPU)};
+}
+
+c10::DeleterFnPtr NumaAllocator::raw_deleter() const {
+  return &numa_free;
+}
+
+void NumaAllocator::empty_cache() {
+  NumaAllocatorImpl::get().empty_cache();
+}
+
+NumaAllocatorStats NumaAllocator::get_stats() {
+  return NumaAllocatorImpl::get().get_stats();
+}
+
+void NumaAllocator::reset_peak_stats() {
+  NumaAllocatorImpl::get().reset_peak_stats();
+}
+
+NumaAllocator* get_numa_allocator() {
+  return &numa_allocator;
+}
+
+void set_numa_allocator_as_default(bool enabled) {
+  std::lock_guard<std::mutex> guard(default_allocator_mutex);
+  if (enabled == (previous_cpu_allocator != nullptr)) {
+    return;
+  }
+  // The default CPU allocator is registered with priority 0, the same
+  // priority is used so that the previous one can be restored.
+  if (enabled) {
+    previous_cpu_allocator = c10::GetAllocator(c10::DeviceType::CPU);
+    c10::SetAllocator(c10::DeviceType::CPU, &numa_allocator);
+  } else {
+    c10::SetAllocator(c10::DeviceType::CPU, previous_cpu_allocator);
+    previous_cpu_allocator = nullptr;
+  }
+}
+
+bool is_numa_allocator_default() {
+  return c10::GetAllocator(c10::DeviceType::CPU) == &numa_allocator;
+}
+
+void set_numa_weight_allocation(bool enabled) {
+  numa_weight_allocation = enabled;
+}
+
+bool is_numa_weight_allocation_enabled() {
+  return numa_weight_allocation;
+}
+
+at::Tensor numa_empty(
+    at::IntArrayRef sizes,
+    const at::TensorOptions& options) {
+  TORCH_CHECK(
+      options.device().is_cpu(), "numa_empty only supports CPU tensors");
+  return at::detail::empty_generic(
+      sizes,
+      &numa_allocator,
+      c10::DispatchKeySet(c10::DispatchKey::CPU),
+      c10::typeMetaToScalarType(options.dtype()),
+      c10::nullopt);
+}
+
+at::Tensor to_numa_local(const at::Tensor& tensor) {
+  auto output = numa_empty(tensor.sizes(), tensor.options());
+  output.copy_(tensor);
+  return output;
+}
+
+} // namespace runtime
+} // namespace torch_ipex
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <c10/core/Allocator.h>
+
+#include <cstdint>
+#include <map>
+
+namespace torch_ipex {
+namespace runtime {
+
+struct NumaAllocatorStats {
+  uint64_t allocations = 0;
+  uint64_t frees = 0;
+  uint64_t cache_hits = 0;
+  uint64_t cache_misses = 0;
+  uint64_t bytes_in_use = 0;
+  uint64_t peak_bytes_in_use = 0;
+  uint64_t bytes_cached = 0;
+  // bytes mapped (in use or cached) with transparent 2 MB pages requested
+  uint64_t huge_2m_bytes = 0;
+  // bytes mapped (in use or cached) from the 1 GB hugetlb pool
+  uint64_t huge_1g_bytes = 0;
+  uint64_t mbind_failures = 0;
+  // bytes in use per NUMA node, -1 for memory not bound to a node
+  std::map<int, uint64_t> node_bytes_in_use;
+};
+
+/**
+ * NUMA-local CPU allocator.
+ *
+ * Blocks are bound with mbind to the NUMA node of the CPU the allocating
+ * thread runs on, which is the node of its CPUPool once the thread is pinned.
+ * Freed blocks are cached per (node, size class) and reused only on the same
+ * node:
+ *   [kNumaMinBlockSize, 2 MB): power of two size classes, normal pages
+ *   [2 MB, 1 GB): multiples of 2 MB, 2 MB aligned with transparent huge
+ *     pages requested
+ *   >= 1 GB: multiples of 1 GB from the hugetlb 1 GB pool if reserved,
+ *     otherwise like the 2 MB class
+ * Smaller allocations go to the default CPU allocator, they are first touched
+ * by the allocating thread anyway.
+ *
+ * The cache is bounded by IPEX_NUMA_ALLOCATOR_MAX_CACHE_MB (default 4096).
+ */
+class TORCH_API NumaAllocator final : public c10::Allocator {
+ public:
+  c10::DataPtr allocate(size_t nbytes) const override;
+  c10::DeleterFnPtr raw_deleter() const override;
+
+  // Unmap all the cached blocks
+  void empty_cache();
+  NumaAllocatorStats get_stats();
+  void reset_peak_stats();
+};
+
+constexpr size_t kNumaMinBlockSize = 256 * 1024;
+
+TORCH_API NumaAllocator* get_numa_allocator();
+
+// Register the NUMA allocator as the c10 CPU allocator, so that all the
+// following CPU tensors (activations included) use it, or restore the
+// previous one.
+TORCH_API void set_numa_allocator_as_default(bool enabled);
+TORCH_API bool is_numa_allocator_default();
+
+// Opt-in for the packed weights of ContextLinear and ContextConvolution
+// created from now on.
+TORCH_API void set_numa_weight_allocation(bool enabled);
+TORCH_API bool is_numa_weight_allocation_enabled();
+
+TORCH_API at::Tensor numa_empty(
+    at::IntArrayRef sizes,
+    const at::TensorOptions& options);
+
+// Contiguous copy of `tensor` in NUMA-local memory
+TORCH_API at::Tensor to_numa_local(const at::Tensor& tensor);
+
+} // namespace runtime
+} // namespace torch_ipex
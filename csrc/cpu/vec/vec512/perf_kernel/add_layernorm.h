@@ -101,6 +101,75 @@ void _normalize_kernel(
   }
 }
 
+// Quantize 16 floats to u8 (is_signed = false) or s8 with round to nearest
+// even, as aten::quantize_per_tensor does
+inline __m128i _quantize_ps(
+    __m512 x,
+    __m512 vec_inv_scale,
+    __m512i vec_zero_point,
+    __m512i vec_qmin,
+    __m512i vec_qmax,
+    bool is_signed) {
+  auto vec_q = _mm512_add_epi32(
+      _mm512_cvtps_epi32(_mm512_mul_ps(x, vec_inv_scale)), vec_zero_point);
+  vec_q = _mm512_min_epi32(_mm512_max_epi32(vec_q, vec_qmin), vec_qmax);
+  return is_signed ? _mm512_cvtsepi32_epi8(vec_q)
+                   : _mm512_cvtusepi32_epi8(vec_q);
+}
+
+// Same as _normalize_kernel and quantizes the result to q_ptr in the same
+// pass. out_ptr can be nullptr if only the quantized output is needed.
+template <typename T, typename T1>
+void _normalize_quantize_kernel(
+    T* out_ptr,
+    void* q_ptr,
+    const float* input_ptr,
+    const int& size,
+    float scale,
+    float bias,
+    const T1* gamma_ptr,
+    const T1* beta_ptr,
+    float q_scale,
+    int64_t q_zero_point,
+    bool is_signed) {
+  auto vec_one = _mm512_set1_ps(1.0);
+  auto vec_zero = _mm512_set1_ps(0.0);
+  auto vec_scale = _mm512_set1_ps(scale);
+  auto vec_bias = _mm512_set1_ps(bias);
+  auto vec_inv_scale = _mm512_set1_ps(1.0f / q_scale);
+  auto vec_zero_point = _mm512_set1_epi32(q_zero_point);
+  auto vec_qmin = _mm512_set1_epi32(is_signed ? -128 : 0);
+  auto vec_qmax = _mm512_set1_epi32(is_signed ? 127 : 255);
+  auto q_data = static_cast<int8_t*>(q_ptr);
+  int i = 0;
+  for (; i < size; i += 16) {
+    __mmask16 mask = size - i >= 16 ? 0xFFFF : (1 << (size - i)) - 1;
+    auto vec_input = _maskz_loadu(input_ptr + i, mask);
+    auto vec_gamma = vec_one;
+    auto vec_beta = vec_zero;
+    if (gamma_ptr) {
+      vec_gamma = _maskz_loadu(gamma_ptr + i, mask);
+    }
+    if (beta_ptr) {
+      vec_beta = _maskz_loadu(beta_ptr + i, mask);
+    }
+    //(a_ptr[i] * scale + bias) * gamma + beta;
+    auto vec_norm = _mm512_fmadd_ps(vec_input, vec_scale, vec_bias);
+    auto vec_res = _mm512_fmadd_ps(vec_norm, vec_gamma, vec_beta);
+    if (out_ptr) {
+      _mask_storeu(out_ptr + i, vec_res, mask);
+    }
+    auto vec_q = _quantize_ps(
+        vec_res,
+        vec_inv_scale,
+        vec_zero_point,
+        vec_qmin,
+        vec_qmax,
+        is_signed);
+    _mm_mask_storeu_epi8(q_data + i, mask, vec_q);
+  }
+}
+
 } // namespace kernel
 } // namespace cpu
 } // namespace torch_ipex
@@ -91,6 +91,8 @@ data_type LlgaTensorDesc::getLlgaDataType(at::ScalarType dt) const {
       return data_type::bf16;
     case at::kInt:
       return data_type::s32;
+    case at::kBool:
+      return data_type::boolean;
     case at::ScalarType::QInt8:
       return data_type::s8;
     case at::ScalarType::QUInt8:
@@ -124,6 +126,8 @@ at::ScalarType LlgaTensorDesc::aten_scalar_type() const {
       return at::ScalarType::BFloat16;
     case data_type::s32:
       return at::kInt;
+    case data_type::boolean:
+      return at::kBool;
     case data_type::s8:
       return at::ScalarType::QInt8;
     case data_type::u8:
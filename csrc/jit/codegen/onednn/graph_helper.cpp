@@ -9,6 +9,8 @@
 #include <torch/csrc/jit/jit_log.h>
 #include <torch/csrc/jit/passes/utils/subgraph_utils.h>
 
+#include <numeric>
+
 namespace torch_ipex {
 namespace jit {
 namespace fuser {
@@ -68,6 +70,17 @@ Operator makeWildcardOp(Node* node) {
     return makeWildcardOp(node);                      \
   }
 
+// Non-tensor inputs of a fused op must be constants, the fusion group only
+// takes tensors from the stack.
+bool hasConstantInputs(Node* node, size_t begin) {
+  for (size_t i = begin; i < node->inputs().size(); i++) {
+    if (node->input(i)->node()->kind() != prim::Constant) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Operator makeEltwiseOp(Node* node, opkind kind) {
   return Operator(node, kind).setInput(0).setOutput(0);
 }
@@ -216,6 +229,8 @@ Operator LlgaGraphHelper::createOperator(Node* node) const {
         .setAttr("keep_stats", false);
   } else if (nodeKind == Symbol::aten("add")) {
     return makeBinaryOp(node, opkind::Add);
+  } else if (nodeKind == Symbol::aten("sub")) {
+    return makeBinaryOp(node, opkind::Subtract);
   } else if (nodeKind == Symbol::aten("mul")) {
     return makeBinaryOp(node, opkind::Multiply);
   } else if (nodeKind == Symbol::aten("div")) {
@@ -230,7 +245,12 @@ Operator LlgaGraphHelper::createOperator(Node* node) const {
   } else if (nodeKind == Symbol::aten("sigmoid")) {
     return makeEltwiseOp(node, opkind::Sigmoid);
   } else if (nodeKind == Symbol::aten("gelu")) {
+    // GELU of oneDNN Graph is the erf formulation
+    REQ(node->inputs().size() == 1 ||
+        toIValue(node->input(1))->toStringRef() == "none");
     return makeEltwiseOp(node, opkind::GELU);
+  } else if (nodeKind == Symbol::aten("erf")) {
+    return makeEltwiseOp(node, opkind::Erf);
   } else if (nodeKind == Symbol::aten("mish")) {
     return makeEltwiseOp(node, opkind::Mish);
   } else if (nodeKind == Symbol::aten("round")) {
@@ -414,6 +434,137 @@ Operator LlgaGraphHelper::createOperator(Node* node) const {
           .setOutput(0)
           .setAttr("order", toIValue(node->input(1))->toIntVector());
     }
+  } else if (nodeKind == Symbol::aten("transpose")) {
+    REQ(hasConstantInputs(node, 1));
+    REQ(aliasDb_->hasInputWriters(node) == false);
+    auto dim = getDimensions(node->input(0));
+    REQ(dim.has_value());
+    int64_t rank = dim.value();
+    auto dim0 = Operator::Int(node, 1);
+    auto dim1 = Operator::Int(node, 2);
+    std::vector<int64_t> order(rank);
+    std::iota(order.begin(), order.end(), 0);
+    std::swap(
+        order.at(dim0 < 0 ? dim0 + rank : dim0),
+        order.at(dim1 < 0 ? dim1 + rank : dim1));
+    return Operator(node, opkind::StaticTranspose)
+        .setInput(0)
+        .setOutput(0)
+        .setAttr("order", order);
+  } else if (
+      nodeKind == Symbol::aten("view") || nodeKind == Symbol::aten("reshape") ||
+      nodeKind == Symbol::aten("flatten")) {
+    REQ(hasConstantInputs(node, 1));
+    REQ(aliasDb_->hasInputWriters(node) == false);
+    // The shapes are specialized by the profiling executor and guarded, so the
+    // target shape is taken from the output without any -1 to resolve
+    auto outputType = node->output(0)->type()->cast<TensorType>();
+    REQ(outputType && outputType->sizes().concrete_sizes().has_value());
+    return Operator(node, opkind::StaticReshape)
+        .setInput(0)
+        .setOutput(0)
+        .setAttr("shape", outputType->sizes().concrete_sizes().value())
+        .setAttr("special_zero", false);
+  } else if (
+      nodeKind == Symbol::aten("mean") || nodeKind == Symbol::aten("sum")) {
+    // mean.dim(self, dim, keepdim, dtype) and sum.dim_IntList(...) only
+    REQ(node->inputs().size() == 4);
+    REQ(hasConstantInputs(node, 1));
+    auto axes = toIValue(node->input(1));
+    REQ(axes->isIntList() && !axes->toIntVector().empty());
+    REQ(toIValue(node->input(3))->isNone());
+    auto kind = nodeKind == Symbol::aten("mean") ? opkind::ReduceMean
+                                                 : opkind::ReduceSum;
+    return Operator(node, kind)
+        .setInput(0)
+        .setOutput(0)
+        .setAttr("axes", axes->toIntVector())
+        .setAttr("keep_dims", Operator::Bool(node, 2));
+  } else if (
+      nodeKind == Symbol::aten("upsample_nearest2d") ||
+      nodeKind == Symbol::aten("upsample_bilinear2d")) {
+    REQ(hasConstantInputs(node, 1));
+    auto inputType = node->input(0)->type()->cast<TensorType>();
+    auto outputType = node->output(0)->type()->cast<TensorType>();
+    REQ(inputType && inputType->sizes().concrete_sizes().has_value());
+    REQ(outputType && outputType->sizes().concrete_sizes().has_value());
+    auto inputSizes = inputType->sizes().concrete_sizes().value();
+    auto outputSizes = outputType->sizes().concrete_sizes().value();
+    REQ(inputSizes.size() == 4 && outputSizes.size() == 4);
+    // Integer upscales are computed alike by PyTorch and oneDNN, otherwise a
+    // given scale factor and the ratio of the sizes differ in the last digits
+    for (size_t i = 2; i < 4; i++) {
+      REQ(inputSizes[i] > 0 && outputSizes[i] % inputSizes[i] == 0);
+    }
+    bool nearest = nodeKind == Symbol::aten("upsample_nearest2d");
+    // PyTorch samples with the given scales, oneDNN with the ratio of the
+    // sizes, e.g. scale_factor=2.1 gives 4 -> 8 sampled with 2.1, so the
+    // scales must be None or that ratio. They follow output_size, and
+    // align_corners for bilinear: float[]? scale_factors in the .vec
+    // overloads, float? scales_h, float? scales_w otherwise.
+    size_t scalesOffset = nearest ? 2 : 3;
+    auto scaleMatches = [&](const c10::IValue& scale, size_t dim) {
+      return scale.isNone() ||
+          scale.toDouble() ==
+          static_cast<double>(outputSizes[dim]) / inputSizes[dim];
+    };
+    if (node->inputs().size() == scalesOffset + 1) {
+      auto scaleFactors = toIValue(node->input(scalesOffset));
+      REQ(scaleFactors.has_value());
+      if (!scaleFactors->isNone()) {
+        auto factors = scaleFactors->toDoubleVector();
+        REQ(factors.size() == 2);
+        for (size_t i = 0; i < 2; i++) {
+          REQ(scaleMatches(factors[i], i + 2));
+        }
+      }
+    } else {
+      REQ(node->inputs().size() == scalesOffset + 2);
+      for (size_t i = 0; i < 2; i++) {
+        auto scale = toIValue(node->input(scalesOffset + i));
+        REQ(scale.has_value() && scaleMatches(scale.value(), i + 2));
+      }
+    }
+    std::vector<int64_t> sizes{outputSizes[2], outputSizes[3]};
+    // upsample_bilinear2d(input, output_size, align_corners, ...)
+    bool alignCorners = !nearest && Operator::Bool(node, 2);
+    return Operator(node, opkind::Interpolate)
+        .setInput(0)
+        .setOutput(0)
+        .setAttr("mode", std::string(nearest ? "nearest" : "bilinear"))
+        .setAttr("sizes", sizes)
+        .setAttr(
+            "coordinate_transformation_mode",
+            std::string(alignCorners ? "align_corners" : "half_pixel"))
+        .setAttr("data_format", std::string("NCX"));
+  } else if (nodeKind == Symbol::aten("pow")) {
+    if (node->input(1)->type()->isSubtypeOf(TensorType::get())) {
+      return makeBinaryOp(node, opkind::Pow);
+    }
+    REQ(node->input(0)->type()->isSubtypeOf(TensorType::get()));
+    auto exponent = toIValue(node->input(1));
+    REQ(exponent.has_value() && (exponent->isDouble() || exponent->isInt()));
+    auto value = exponent->toScalar().to<double>();
+    if (value == 2.0) {
+      return makeEltwiseOp(node, opkind::Square);
+    }
+    REQ(value == 0.5);
+    return makeEltwiseOp(node, opkind::Sqrt);
+  } else if (nodeKind == Symbol::aten("where")) {
+    // where.self(condition, self, other)
+    for (size_t i = 0; i < 3; i++) {
+      REQ(node->input(i)->type()->isSubtypeOf(TensorType::get()));
+    }
+    return Operator(node, opkind::Select).setInput(0, 1, 2).setOutput(0);
+  } else if (nodeKind == Symbol::aten("masked_fill")) {
+    // The scalar value has been converted to a tensor by PrepareBinaryForLLGA
+    for (size_t i = 0; i < 3; i++) {
+      REQ(node->input(i)->type()->isSubtypeOf(TensorType::get()));
+    }
+    auto selfType = node->input(0)->type()->cast<TensorType>();
+    auto valueType = node->input(2)->type()->cast<TensorType>();
+    REQ(selfType->scalarType() == valueType->scalarType());
+    return Operator(node, opkind::Select).setInput(1, 2, 0).setOutput(0);
   } else if (nodeKind == Symbol::aten("contiguous")) {
     // Contiguous should only be mapped to oneDNN Graph if the destination
     // memory-layout is different than the source memory-format
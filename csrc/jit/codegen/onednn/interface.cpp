@@ -9,7 +9,9 @@
 #include "lift_up_quant.h"
 #include "prepare_binary.h"
 #include "prepare_dequant.h"
+#include "prepare_pad.h"
 #include "prepare_silu.h"
+#include "profiler.h"
 #include "quantization_patterns.h"
 #include "remove_mutation.h"
 
@@ -65,7 +67,9 @@ void fuseGraph(std::shared_ptr<Graph>& g) {
     PrepareBinaryForLLGA(g);
     GRAPH_DUMP("After DecomposeOps. Before PrepareSiluForLLGA", g);
     PrepareSiluForLLGA(g);
-    GRAPH_DUMP("After PrepareSiluForLLGA. Before PrepareBinaryForLLGA", g);
+    GRAPH_DUMP("After PrepareSiluForLLGA. Before PreparePadForLLGA", g);
+    PreparePadForLLGA(g);
+    GRAPH_DUMP("After PreparePadForLLGA. Before PrepareBinaryForLLGA", g);
     GRAPH_DUMP(
         "After PrepareBinaryForLLGA. Before EliminateCommonSubexpression", g);
     EliminateCommonSubexpression(g);
@@ -79,7 +83,11 @@ void fuseGraph(std::shared_ptr<Graph>& g) {
     GRAPH_DUMP("After PrepareDequantForLLGA. Before LiftUpQuant", g);
     // LiftUpQuant must be place before DeferSizeCheck
     LiftUpQuant(g);
-    GRAPH_DUMP("After LiftUpQuant. Before DeferSizeCheck", g);
+    GRAPH_DUMP("After LiftUpQuant. Before FuseAddLayerNormQuant", g);
+    // FuseAddLayerNormQuant must be placed after LiftUpQuant so that the
+    // quantize lifted above view ops can be fused
+    FuseAddLayerNormQuant(g);
+    GRAPH_DUMP("After FuseAddLayerNormQuant. Before DeferSizeCheck", g);
     DeferSizeCheck(g);
     GRAPH_DUMP("After DeferSizeCheck. Before CreateLlgaSubgraphs", g);
     // CreateLlgaSubgraphs must be placed after all the preparation passes above
@@ -112,6 +120,26 @@ bool getLlgaWeightCacheEnabled() {
   return dnnl::graph::get_constant_tensor_cache();
 }
 
+void setLlgaProfilerEnabled(bool enabled) {
+  LlgaProfiler::setEnabled(enabled);
+}
+
+bool getLlgaProfilerEnabled() {
+  return LlgaProfiler::isEnabled();
+}
+
+void resetLlgaProfiler() {
+  LlgaProfiler::reset();
+}
+
+std::string getLlgaProfilerTable() {
+  return LlgaProfiler::table();
+}
+
+std::string getLlgaProfilerChromeTrace() {
+  return LlgaProfiler::chromeTrace();
+}
+
 } // namespace onednn
 } // namespace fuser
 
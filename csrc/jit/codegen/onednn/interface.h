@@ -24,6 +24,17 @@ TORCH_API void setLlgaWeightCacheEnabled(bool enabled);
 
 TORCH_API bool getLlgaWeightCacheEnabled();
 
+// Per partition compile and execute profiling, see profiler.h
+TORCH_API void setLlgaProfilerEnabled(bool enabled);
+
+TORCH_API bool getLlgaProfilerEnabled();
+
+TORCH_API void resetLlgaProfiler();
+
+TORCH_API std::string getLlgaProfilerTable();
+
+TORCH_API std::string getLlgaProfilerChromeTrace();
+
 } // namespace onednn
 } // namespace fuser
 
@@ -7,8 +7,12 @@
 
 #include <ATen/core/functional.h>
 #include <ATen/quantized/Quantizer.h>
+#include <torch/csrc/jit/ir/constants.h>
 #include <torch/csrc/jit/jit_log.h>
 
+#include <set>
+#include <sstream>
+
 namespace torch_ipex {
 namespace jit {
 namespace fuser {
@@ -19,6 +23,82 @@ using namespace dnnl::graph;
 
 using data_type = dnnl::graph::logical_tensor::data_type;
 
+namespace {
+
+double numel(const Value* v) {
+  auto type = v->type()->cast<TensorType>();
+  if (!type) {
+    return 0;
+  }
+  auto sizes = type->sizes().concrete_sizes();
+  if (!sizes) {
+    return 0;
+  }
+  double n = 1;
+  for (auto size : *sizes) {
+    n *= size;
+  }
+  return n;
+}
+
+double lastDim(const Value* v) {
+  auto type = v->type()->cast<TensorType>();
+  if (!type || !type->sizes().size() || *type->sizes().size() == 0) {
+    return 0;
+  }
+  return type->sizes()[*type->sizes().size() - 1].value_or(0);
+}
+
+double firstDim(const Value* v) {
+  auto type = v->type()->cast<TensorType>();
+  if (!type || !type->sizes().size() || *type->sizes().size() == 0) {
+    return 0;
+  }
+  return type->sizes()[0].value_or(0);
+}
+
+// Multiply-adds count as two FLOPs, any other op as one FLOP per output
+// element.
+double estimateFlops(const Node* node) {
+  if (node->outputs().empty()) {
+    return 0;
+  }
+  auto out = numel(node->output(0));
+  switch (node->kind()) {
+    case aten::_convolution:
+    case aten::conv1d:
+    case aten::conv2d:
+    case aten::conv3d: {
+      // weight is [OC, IC / groups, kernel...] and transposed weight is
+      // [IC, OC / groups, kernel...], every element of the larger activation
+      // is accumulated over the rest of the weight
+      auto weight = node->input(1);
+      double per_channel =
+          firstDim(weight) > 0 ? numel(weight) / firstDim(weight) : 0;
+      bool transposed = node->kind() == aten::_convolution &&
+          constant_as<bool>(node->input(6)).value_or(false);
+      return 2 * (transposed ? numel(node->input(0)) : out) * per_channel;
+    }
+    case aten::linear:
+      return 2 * out * lastDim(node->input(1));
+    case aten::matmul:
+    case aten::mm:
+    case aten::bmm:
+      return 2 * out * lastDim(node->input(0));
+    default:
+      return out;
+  }
+}
+
+std::string describe(const ArgSpec& spec) {
+  std::ostringstream ss;
+  ss << c10::toString(spec.aten_scalar_type())
+     << c10::IntArrayRef(spec.sizes());
+  return ss.str();
+}
+
+} // namespace
+
 LlgaKernel::LlgaKernel(const Node* fusionNode)
     : fusionNode_(fusionNode),
       graph_(fusionNode->g(attr::Subgraph)),
@@ -262,6 +342,8 @@ std::tuple<RunArgs, RunArgs> LlgaKernel::prepareRunArgs(
 }
 
 compiled_partition LlgaKernel::compile(const partition& partition) {
+  bool profiling = LlgaProfiler::isEnabled();
+  auto start = LlgaProfiler::Clock::now();
   auto inputs = fmap(inputSpecs_, toLogicalTensor);
   auto outputs = fmap(outputSpecs_, toLogicalTensor);
   auto compilation = partition.compile(inputs, outputs, Engine::getEngine());
@@ -288,9 +370,38 @@ compiled_partition LlgaKernel::compile(const partition& partition) {
     inplacePairs_[outputId] = inputOffset;
   }
 
+  if (profiling) {
+    LlgaProfiler::recordCompile(
+        debugName_, start, LlgaProfiler::Clock::now());
+  }
   return compilation;
 }
 
+const LlgaPartitionInfo& LlgaKernel::profileInfo() {
+  std::call_once(profile_info_initialized_flag_, [&]() {
+    profileInfo_.name = debugName_;
+    profileInfo_.ops = profileName_;
+    std::vector<std::string> inputs;
+    std::set<size_t> seen;
+    for (const auto& spec : inputSpecs_) {
+      if (seen.insert(spec.tid()).second) {
+        inputs.push_back(describe(spec));
+        profileInfo_.bytes += spec.storage_size();
+      }
+    }
+    for (const auto& spec : outputSpecs_) {
+      profileInfo_.bytes += spec.storage_size();
+    }
+    profileInfo_.inputs = c10::Join(", ", inputs);
+    for (auto* node : graph_->block()->nodes()) {
+      if (node->kind().is_aten()) {
+        profileInfo_.flops += estimateFlops(node);
+      }
+    }
+  });
+  return profileInfo_;
+}
+
 dnnl::graph::compiled_partition& LlgaKernel::compileAndCache(
     const dnnl::graph::partition& partition,
     int n_thread) {
@@ -352,7 +463,14 @@ void LlgaKernel::run(Stack& stack) {
 #ifdef GRAPH_DEBUG_ENABLED
   GRAPH_DEBUG("Executing partition");
 #endif
-  compilation.execute(Stream::getStream(), runInputs, runOutputs);
+  if (LlgaProfiler::isEnabled()) {
+    auto start = LlgaProfiler::Clock::now();
+    compilation.execute(Stream::getStream(), runInputs, runOutputs);
+    LlgaProfiler::recordExecute(
+        profileInfo(), start, LlgaProfiler::Clock::now());
+  } else {
+    compilation.execute(Stream::getStream(), runInputs, runOutputs);
+  }
 #ifdef GRAPH_DEBUG_ENABLED
   GRAPH_DEBUG("Partition executed");
 #endif
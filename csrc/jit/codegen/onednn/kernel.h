@@ -3,6 +3,7 @@
 #include <unordered_map>
 #include "codegen/LlgaTensorImpl.h"
 #include "graph_helper.h"
+#include "profiler.h"
 #include "utils/rw_lock.h"
 
 #include <oneapi/dnnl/dnnl_graph.hpp>
@@ -66,6 +67,10 @@ class LlgaKernel {
       const dnnl::graph::partition& partition,
       int n_thread);
 
+  // Partition info for LlgaProfiler, built from the logical tensors on the
+  // first profiled run
+  const LlgaPartitionInfo& profileInfo();
+
   std::tuple<RunArgs, RunArgs> prepareRunArgs(
       const TensorArgs& inputs,
       TensorArgs& outputs) const;
@@ -114,6 +119,8 @@ class LlgaKernel {
   std::string debugName_;
   std::string profileName_;
   std::once_flag spec_initialized_flag_;
+  LlgaPartitionInfo profileInfo_;
+  std::once_flag profile_info_initialized_flag_;
   std::vector<std::once_flag> compilation_initialized_flags_ =
       std::vector<std::once_flag>(MAX_COMPILATION_CACHE_SIZE);
 };
@@ -8,9 +8,14 @@ namespace onednn {
 
 using namespace torch::jit;
 
+// Ops reading only the metadata of a tensor, which an LLGA tensor carries
+// whatever its layout.
 bool couldSupportOpaqueLayout(Node* node) {
   switch (node->kind()) {
     case aten::size:
+    case aten::dim:
+    case prim::dtype:
+    case prim::device:
       return true;
     default:
       return false;
@@ -115,6 +115,74 @@ void LiftUpQuant(std::shared_ptr<Graph>& graph) {
   EliminateDeadCode(graph);
 }
 
+void FuseAddLayerNormQuant(std::shared_ptr<Graph>& graph) {
+  std::vector<Node*> quant_nodes;
+  for (Node* node : graph->block()->nodes()) {
+    if (node->matches(
+            "aten::quantize_per_tensor(Tensor self, float scale, "
+            "int zero_point, ScalarType dtype) -> Tensor")) {
+      quant_nodes.push_back(node);
+    }
+  }
+
+  for (auto quant : quant_nodes) {
+    auto layer_norm = quant->input(0)->node();
+    if (!layer_norm->matches(
+            "aten::layer_norm(Tensor input, int[] normalized_shape, "
+            "Tensor? weight=None, Tensor? bias=None, float eps=1e-05, "
+            "bool cudnn_enable=True) -> Tensor")) {
+      continue;
+    }
+    auto add = layer_norm->input(0)->node();
+    if (!add->matches(
+            "aten::add.Tensor(Tensor self, Tensor other, *, "
+            "Scalar alpha=1) -> Tensor") ||
+        !usedBySingleOp(add->output(0))) {
+      continue;
+    }
+    // the fused node replaces layer_norm, so the quantization params must
+    // be available there
+    bool params_before_layer_norm = true;
+    for (size_t i = 1; i < quant->inputs().size(); i++) {
+      params_before_layer_norm = params_before_layer_norm &&
+          quant->input(i)->node()->isBefore(layer_norm);
+    }
+    if (!params_before_layer_norm) {
+      continue;
+    }
+
+    // From:
+    // add -> layer_norm -> quantize_per_tensor -> dequant -> ...
+    //            | (other uses, if any)
+    // To:
+    // add_layernorm_quantize -> dequant -> ...
+    //            | (other uses, if any)
+    bool output_float = !usedBySingleOp(layer_norm->output(0));
+    WithInsertPoint guard(layer_norm);
+    auto output_float_value = graph->insertConstant(output_float);
+    std::vector<Value*> inputs = {add->input(0), add->input(1), add->input(2)};
+    for (size_t i = 1; i < layer_norm->inputs().size() - 1; i++) {
+      // cudnn_enable is dropped
+      inputs.push_back(layer_norm->input(i));
+    }
+    for (size_t i = 1; i < quant->inputs().size(); i++) {
+      inputs.push_back(quant->input(i));
+    }
+    inputs.push_back(output_float_value);
+    auto fused = graph->create(
+        Symbol::fromQualString("ipex::add_layernorm_quantize"), inputs, 2);
+    fused->insertAfter(layer_norm);
+    fused->output(0)->setType(layer_norm->output(0)->type());
+    fused->output(1)->setType(quant->output(0)->type());
+
+    quant->output(0)->replaceAllUsesWith(fused->output(1));
+    quant->destroy();
+    layer_norm->output(0)->replaceAllUsesWith(fused->output(0));
+    layer_norm->destroy();
+    add->destroy();
+  }
+}
+
 } // namespace onednn
 } // namespace fuser
 } // namespace jit
@@ -9,6 +9,13 @@ namespace onednn {
 
 void LiftUpQuant(std::shared_ptr<torch::jit::Graph>& graph);
 
+// Fuse add -> layer_norm -> quantize_per_tensor into
+// ipex::add_layernorm_quantize, which writes the quantized hidden state in the
+// same pass as the layer norm instead of reading it again for the quantize.
+// The layer_norm output is still produced if it has other users. Must be
+// placed after SaveDequantInformation and LiftUpQuant.
+void FuseAddLayerNormQuant(std::shared_ptr<torch::jit::Graph>& graph);
+
 } // namespace onednn
 } // namespace fuser
 } // namespace jit
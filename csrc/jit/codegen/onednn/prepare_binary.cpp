@@ -16,13 +16,28 @@ bool compareConstValue(Value* v, double d) {
        (ival->isDouble() && ival->toDouble() == d));
 }
 
-void mayConvertScalarInputToTensor(Node* node) {
+// The offset of the scalar input converted to a tensor, 0 if none.
+size_t scalarInputOffset(Node* node) {
+  switch (node->kind()) {
+    case aten::add:
+    case aten::sub:
+    case aten::mul:
+    case aten::div:
+      return 1;
+    case aten::masked_fill:
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+void mayConvertScalarInputToTensor(Node* node, size_t offset) {
   // We do not handle binary ops with two scalar inputs,
-  // and we assume scalar is always at the second place.
+  // and we assume scalar is always after the tensor.
   if (node->input(0)->type()->isSubtypeOf(TensorType::get()) &&
-      (node->input(1)->type()->isSubtypeOf(FloatType::get()) ||
-       node->input(1)->type()->isSubtypeOf(IntType::get()))) {
-    auto scalar = node->input(1);
+      (node->input(offset)->type()->isSubtypeOf(FloatType::get()) ||
+       node->input(offset)->type()->isSubtypeOf(IntType::get()))) {
+    auto scalar = node->input(offset);
     WithInsertPoint guard(node);
     auto g = node->owningGraph();
     // 42 : Scalar  -->  tensor(42.0) : Float([])
@@ -36,10 +51,10 @@ void mayConvertScalarInputToTensor(Node* node) {
     t->setType(target_type);
     auto unsqueezed = g->insert(aten::unsqueeze, {t, 0});
     unsqueezed->setType(target_type);
-    node->replaceInput(1, unsqueezed);
+    node->replaceInput(offset, unsqueezed);
     // Add a mark here and convert tensor back to scalar later on for unfused
-    // add/div
-    node->i_(Symbol::attr("scalar"), true);
+    // binary ops
+    node->i_(Symbol::attr("scalar"), offset);
   }
 }
 
@@ -49,12 +64,13 @@ void mayConvertTensorToScalarInput(Node* node) {
   }
   TORCH_CHECK(
       node->hasAttributeS("scalar"),
-      "add or div node with numAttributes != 0 must have attr: scalar");
+      "binary node with numAttributes != 0 must have attr: scalar");
 
-  auto unsqueeze_node = node->input(1)->node();
+  auto offset = node->i(Symbol::attr("scalar"));
+  auto unsqueeze_node = node->input(offset)->node();
   auto as_tensor_node = unsqueeze_node->input(0)->node();
   auto scalar_value = as_tensor_node->input(0);
-  node->replaceInput(1, scalar_value);
+  node->replaceInput(offset, scalar_value);
 
   node->removeAttributeS("scalar");
 }
@@ -65,8 +81,9 @@ static void ConvertScalarToTensor(Block* block) {
       ConvertScalarToTensor(sub);
     }
 
-    if (node->kind() == aten::add || node->kind() == aten::div) {
-      mayConvertScalarInputToTensor(node);
+    auto offset = scalarInputOffset(node);
+    if (offset > 0) {
+      mayConvertScalarInputToTensor(node, offset);
     }
   }
 }
@@ -77,7 +94,7 @@ static void ConvertTensorToScalar(Block* block) {
       ConvertTensorToScalar(sub);
     }
 
-    if (node->kind() == aten::add || node->kind() == aten::div) {
+    if (scalarInputOffset(node) > 0) {
       mayConvertTensorToScalarInput(node);
     }
   }
@@ -104,7 +121,7 @@ static void DecomposeFusedAdd(Block* block) {
       DecomposeFusedAdd(sub);
     }
 
-    if (node->kind() == aten::add) {
+    if (node->kind() == aten::add || node->kind() == aten::sub) {
       mayDecomposeAdd(node);
     }
   }
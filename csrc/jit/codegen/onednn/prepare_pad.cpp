@@ -0,0 +1,124 @@
+#include "prepare_pad.h"
+#include "operator.h"
+
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+
+namespace torch_ipex {
+namespace jit {
+namespace fuser {
+namespace onednn {
+
+using namespace torch::jit;
+
+// The offset of the padding of a non-transposed convolution, 0 otherwise.
+size_t convPaddingOffset(Node* node) {
+  if (node->kind() == aten::conv2d || node->kind() == aten::conv3d) {
+    return 4;
+  }
+  if (node->kind() == aten::_convolution && !Operator::Bool(node, 6)) {
+    return 4;
+  }
+  return 0;
+}
+
+bool isPad(Node* node) {
+  return node->kind() == aten::constant_pad_nd ||
+      node->kind() == Symbol::aten("pad");
+}
+
+bool isZeroPadValue(Node* pad) {
+  if (pad->kind() == aten::constant_pad_nd) {
+    auto value = toIValue(pad->input(2));
+    return value.has_value() && value->toScalar().to<double>() == 0.0;
+  }
+  // aten::pad(input, pad, mode, value), a None value is zero
+  auto mode = toIValue(pad->input(2));
+  auto value = toIValue(pad->input(3));
+  return mode.has_value() && mode->isString() &&
+      mode->toStringRef() == "constant" && value.has_value() &&
+      (value->isNone() || value->toScalar().to<double>() == 0.0);
+}
+
+// Returns the padding per spatial dim of a symmetric zero pad, or an empty
+// vector. The pad list starts with the last dim.
+std::vector<int64_t> symmetricZeroPadding(Node* pad) {
+  auto tensorType = pad->input(0)->type()->cast<TensorType>();
+  if (!tensorType || !isZeroPadValue(pad)) {
+    return {};
+  }
+  auto dims = tensorType->dim();
+  auto padList = toIValue(pad->input(1));
+  if (!dims.has_value() || !padList.has_value()) {
+    return {};
+  }
+  auto pads = padList->toIntVector();
+  int64_t spatial = static_cast<int64_t>(dims.value()) - 2;
+  if (spatial <= 0 || static_cast<int64_t>(pads.size()) != 2 * spatial) {
+    return {};
+  }
+  std::vector<int64_t> padding(spatial);
+  for (int64_t i = 0; i < spatial; i++) {
+    auto begin = pads[2 * (spatial - 1 - i)];
+    auto end = pads[2 * (spatial - 1 - i) + 1];
+    if (begin != end || begin < 0) {
+      return {};
+    }
+    padding[i] = begin;
+  }
+  return padding;
+}
+
+void mayFoldPadIntoConv(Node* pad) {
+  auto padding = symmetricZeroPadding(pad);
+  if (padding.empty()) {
+    return;
+  }
+  auto output = pad->output();
+  for (auto& use : output->uses()) {
+    auto offset = convPaddingOffset(use.user);
+    if (use.offset != 0 || offset == 0) {
+      return;
+    }
+    auto convPadding = toIValue(use.user->input(offset));
+    if (!convPadding.has_value() || !convPadding->isIntList() ||
+        convPadding->toIntVector().size() != padding.size()) {
+      return;
+    }
+  }
+  // the uses are modified in the loop
+  auto uses = output->uses();
+  for (auto& use : uses) {
+    auto conv = use.user;
+    auto offset = convPaddingOffset(conv);
+    auto convPadding = toIValue(conv->input(offset))->toIntVector();
+    for (size_t i = 0; i < padding.size(); i++) {
+      convPadding[i] += padding[i];
+    }
+    WithInsertPoint guard(conv);
+    auto newPadding = conv->owningGraph()->insertConstant(convPadding);
+    conv->replaceInput(offset, newPadding);
+    conv->replaceInput(0, pad->input(0));
+  }
+}
+
+static void FoldPadIntoConv(Block* block) {
+  for (auto node : block->nodes()) {
+    for (auto sub : node->blocks()) {
+      FoldPadIntoConv(sub);
+    }
+
+    if (isPad(node)) {
+      mayFoldPadIntoConv(node);
+    }
+  }
+}
+
+void PreparePadForLLGA(std::shared_ptr<Graph>& graph) {
+  FoldPadIntoConv(graph->block());
+  EliminateDeadCode(graph);
+}
+
+} // namespace onednn
+} // namespace fuser
+} // namespace jit
+} // namespace torch_ipex
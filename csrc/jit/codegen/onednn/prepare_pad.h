@@ -0,0 +1,18 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch_ipex {
+namespace jit {
+namespace fuser {
+namespace onednn {
+
+// oneDNN Graph has no pad op. Folds a symmetric zero padding of the spatial
+// dims into the padding of the convolutions consuming it, so that the pad does
+// not split the partition.
+void PreparePadForLLGA(std::shared_ptr<torch::jit::Graph>& graph);
+
+} // namespace onednn
+} // namespace fuser
+} // namespace jit
+} // namespace torch_ipex
@@ -0,0 +1,224 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace torch_ipex {
+namespace jit {
+namespace fuser {
+namespace onednn {
+
+namespace {
+
+using Clock = LlgaProfiler::Clock;
+
+// Bounds the memory of a long profiled run, the histograms keep counting.
+constexpr size_t kMaxTraceEvents = 1 << 20;
+
+struct PartitionRecord {
+  LlgaPartitionInfo info;
+  LlgaLatencyHistogram compile;
+  LlgaLatencyHistogram execute;
+};
+
+struct TraceEvent {
+  std::string name;
+  bool compile;
+  double ts_us;
+  double dur_us;
+  int tid;
+};
+
+struct ProfilerState {
+  std::mutex mutex;
+  std::unordered_map<std::string, PartitionRecord> partitions;
+  std::vector<TraceEvent> events;
+  int64_t dropped_events = 0;
+  Clock::time_point epoch = Clock::now();
+};
+
+ProfilerState& state() {
+  static ProfilerState state;
+  return state;
+}
+
+int threadIndex() {
+  static std::atomic<int> next_index{0};
+  thread_local int index = next_index++;
+  return index;
+}
+
+double toMicroseconds(Clock::duration d) {
+  return std::chrono::duration<double, std::micro>(d).count();
+}
+
+void recordLocked(
+    ProfilerState& s,
+    const std::string& name,
+    bool compile,
+    Clock::time_point start,
+    Clock::time_point end) {
+  if (s.events.size() < kMaxTraceEvents) {
+    s.events.push_back(
+        {name,
+         compile,
+         toMicroseconds(start - s.epoch),
+         toMicroseconds(end - start),
+         threadIndex()});
+  } else {
+    s.dropped_events++;
+  }
+}
+
+std::string jsonEscape(const std::string& str) {
+  std::string escaped;
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+    }
+    escaped.push_back(c);
+  }
+  return escaped;
+}
+
+} // namespace
+
+void LlgaLatencyHistogram::add(double us) {
+  int bucket = us < 1 ? 0 : static_cast<int>(std::log2(us)) + 1;
+  buckets[std::min(bucket, kBuckets - 1)]++;
+  count++;
+  total_us += us;
+  max_us = std::max(max_us, us);
+}
+
+double LlgaLatencyHistogram::percentile(double p) const {
+  int64_t rank = static_cast<int64_t>(std::ceil(p * count));
+  int64_t seen = 0;
+  for (int i = 0; i < kBuckets; i++) {
+    seen += buckets[i];
+    if (seen >= rank && seen > 0) {
+      return std::min(std::ldexp(1.0, i), max_us);
+    }
+  }
+  return max_us;
+}
+
+std::atomic<bool>& LlgaProfiler::enabled() {
+  static std::atomic<bool> enabled{false};
+  return enabled;
+}
+
+void LlgaProfiler::setEnabled(bool new_enabled) {
+  enabled() = new_enabled;
+}
+
+void LlgaProfiler::reset() {
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  s.partitions.clear();
+  s.events.clear();
+  s.dropped_events = 0;
+  s.epoch = Clock::now();
+}
+
+void LlgaProfiler::recordCompile(
+    const std::string& name,
+    Clock::time_point start,
+    Clock::time_point end) {
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto& record = s.partitions[name];
+  record.info.name = name;
+  record.compile.add(toMicroseconds(end - start));
+  recordLocked(s, name, /* compile */ true, start, end);
+}
+
+void LlgaProfiler::recordExecute(
+    const LlgaPartitionInfo& info,
+    Clock::time_point start,
+    Clock::time_point end) {
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  auto& record = s.partitions[info.name];
+  if (record.execute.count == 0) {
+    record.info = info;
+  }
+  record.execute.add(toMicroseconds(end - start));
+  recordLocked(s, info.name, /* compile */ false, start, end);
+}
+
+std::string LlgaProfiler::table() {
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  std::vector<const PartitionRecord*> records;
+  for (const auto& it : s.partitions) {
+    records.push_back(&it.second);
+  }
+  std::sort(records.begin(), records.end(), [](auto* a, auto* b) {
+    return a->execute.total_us > b->execute.total_us;
+  });
+
+  std::ostringstream ss;
+  ss << std::fixed << std::setprecision(2);
+  ss << std::left << std::setw(20) << "Partition" << std::right
+     << std::setw(10) << "Compiles" << std::setw(14) << "Compile(us)"
+     << std::setw(10) << "Runs" << std::setw(12) << "Avg(us)"
+     << std::setw(12) << "P50(us)" << std::setw(12) << "P99(us)"
+     << std::setw(12) << "Max(us)" << std::setw(12) << "Total(ms)"
+     << std::setw(10) << "GFLOP/s" << std::setw(10) << "GB/s"
+     << "  Ops / Inputs\n";
+  for (auto* record : records) {
+    const auto& compile = record->compile;
+    const auto& execute = record->execute;
+    double avg_us = execute.count ? execute.total_us / execute.count : 0;
+    double compile_us = compile.count ? compile.total_us / compile.count : 0;
+    // FLOP/us and byte/us are MFLOP/s and MB/s
+    double gflops = avg_us > 0 ? record->info.flops / avg_us / 1e3 : 0;
+    double gbytes = avg_us > 0 ? record->info.bytes / avg_us / 1e3 : 0;
+    ss << std::left << std::setw(20) << record->info.name << std::right
+       << std::setw(10) << compile.count << std::setw(14) << compile_us
+       << std::setw(10) << execute.count << std::setw(12) << avg_us
+       << std::setw(12) << execute.percentile(0.5) << std::setw(12)
+       << execute.percentile(0.99) << std::setw(12) << execute.max_us
+       << std::setw(12) << execute.total_us / 1e3 << std::setw(10) << gflops
+       << std::setw(10) << gbytes << "  " << record->info.ops << " / "
+       << record->info.inputs << "\n";
+  }
+  if (s.dropped_events) {
+    ss << s.dropped_events << " trace events were dropped\n";
+  }
+  return ss.str();
+}
+
+std::string LlgaProfiler::chromeTrace() {
+  auto& s = state();
+  std::lock_guard<std::mutex> lock(s.mutex);
+  std::ostringstream ss;
+  ss << std::fixed << std::setprecision(3);
+  ss << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  for (size_t i = 0; i < s.events.size(); i++) {
+    const auto& event = s.events[i];
+    const auto& info = s.partitions[event.name].info;
+    ss << (i ? ",\n" : "\n") << "{\"name\": \""
+       << jsonEscape(info.ops.empty() ? event.name : info.ops)
+       << "\", \"cat\": \"" << (event.compile ? "compile" : "execute")
+       << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << event.tid
+       << ", \"ts\": " << event.ts_us << ", \"dur\": " << event.dur_us
+       << ", \"args\": {\"partition\": \"" << jsonEscape(event.name)
+       << "\", \"inputs\": \"" << jsonEscape(info.inputs)
+       << "\", \"flops\": " << info.flops << ", \"bytes\": " << info.bytes
+       << "}}";
+  }
+  ss << "\n]}";
+  return ss.str();
+}
+
+} // namespace onednn
+} // namespace fuser
+} // namespace jit
+} // namespace torch_ipex
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include <c10/macros/Export.h>
+
+namespace torch_ipex {
+namespace jit {
+namespace fuser {
+namespace onednn {
+
+// What is known about a fused partition from its logical tensors. The FLOPs
+// are estimated from the aten ops of the partition, the bytes are the memory
+// sizes of the distinct input and output logical tensors.
+struct LlgaPartitionInfo {
+  std::string name;
+  std::string ops;
+  std::string inputs;
+  double flops = 0;
+  double bytes = 0;
+};
+
+// Latencies in power of two buckets of microseconds: bucket i counts
+// [2^(i-1), 2^i) us, bucket 0 everything below 1 us.
+struct LlgaLatencyHistogram {
+  static constexpr int kBuckets = 32;
+
+  void add(double us);
+  // the upper bound of the bucket holding the p-th fraction of the samples
+  double percentile(double p) const;
+
+  std::array<int64_t, kBuckets> buckets{};
+  int64_t count = 0;
+  double total_us = 0;
+  double max_us = 0;
+};
+
+// Opt-in profiler of the LLGA fusion groups. When enabled, LlgaKernel records
+// the compile and execute latency of every partition, which can be exported
+// as a table or as a Chrome trace (chrome://tracing, Perfetto).
+class LlgaProfiler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static bool isEnabled() {
+    return enabled().load(std::memory_order_relaxed);
+  }
+
+  static void setEnabled(bool enabled);
+
+  // Drops everything recorded so far and restarts the trace clock.
+  static void reset();
+
+  // A compilation is a miss of the per thread-count compilation cache.
+  static void recordCompile(
+      const std::string& name,
+      Clock::time_point start,
+      Clock::time_point end);
+
+  static void recordExecute(
+      const LlgaPartitionInfo& info,
+      Clock::time_point start,
+      Clock::time_point end);
+
+  // One row per partition, sorted by the total execute time.
+  static std::string table();
+
+  // Chrome trace event format, one complete event per compile and execute.
+  static std::string chromeTrace();
+
+ private:
+  static std::atomic<bool>& enabled();
+};
+
+} // namespace onednn
+} // namespace fuser
+} // namespace jit
+} // namespace torch_ipex
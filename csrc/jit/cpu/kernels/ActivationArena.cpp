@@ -0,0 +1,100 @@
+#include "ActivationArena.h"
+
+#include <ATen/ATen.h>
+#include <c10/core/CPUAllocator.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace arena {
+
+namespace {
+
+struct MemoryPlanRegistry {
+  std::mutex mutex;
+  std::vector<MemoryPlanStats> plans;
+};
+
+MemoryPlanRegistry& plan_registry() {
+  static MemoryPlanRegistry registry;
+  return registry;
+}
+
+// plan_id -> byte tensor backing the arena of the plan on this thread
+thread_local std::unordered_map<int64_t, at::Tensor> thread_arenas;
+
+int64_t get_arena_bytes(int64_t plan_id) {
+  auto& registry = plan_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  TORCH_CHECK(
+      plan_id >= 0 && plan_id < static_cast<int64_t>(registry.plans.size()),
+      "Unknown activation memory plan ",
+      plan_id);
+  return registry.plans[plan_id].arena_bytes;
+}
+
+} // namespace
+
+int64_t register_memory_plan(
+    int64_t num_values,
+    int64_t arena_bytes,
+    int64_t naive_bytes) {
+  auto& registry = plan_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  int64_t plan_id = registry.plans.size();
+  registry.plans.push_back(
+      {plan_id, num_values, arena_bytes, naive_bytes, /*fallbacks=*/0});
+  return plan_id;
+}
+
+std::vector<MemoryPlanStats> get_memory_plan_stats() {
+  auto& registry = plan_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.plans;
+}
+
+void record_memory_plan_fallback(int64_t plan_id) {
+  auto& registry = plan_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if (plan_id >= 0 && plan_id < static_cast<int64_t>(registry.plans.size())) {
+    registry.plans[plan_id].fallbacks++;
+  }
+}
+
+void release_thread_arenas() {
+  thread_arenas.clear();
+}
+
+at::Tensor arena_slice(
+    int64_t plan_id,
+    int64_t offset,
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides,
+    const at::TensorOptions& options) {
+  auto it = thread_arenas.find(plan_id);
+  if (it == thread_arenas.end()) {
+    // The default CPU allocator already returns 64B aligned memory, see
+    // c10::gAlignment.
+    static_assert(
+        c10::gAlignment % kArenaAlignment == 0,
+        "CPU allocator alignment is smaller than the arena alignment");
+    auto bytes = get_arena_bytes(plan_id);
+    it = thread_arenas
+             .emplace(plan_id, at::empty({bytes}, at::TensorOptions(at::kByte)))
+             .first;
+  }
+  const auto& buffer = it->second;
+  auto itemsize = static_cast<int64_t>(options.dtype().itemsize());
+  TORCH_INTERNAL_ASSERT(offset % itemsize == 0);
+  auto slice = at::empty({0}, options);
+  slice.set_(buffer.storage(), offset / itemsize, sizes, strides);
+  return slice;
+}
+
+} // namespace arena
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
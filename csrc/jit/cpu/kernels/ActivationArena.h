@@ -0,0 +1,61 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include <c10/util/ArrayRef.h>
+
+#include <vector>
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace arena {
+
+// Static activation memory planning support for frozen JIT graphs.
+//
+// The memory planner pass (csrc/jit/passes/memory_planner.cpp) assigns every
+// planned activation an offset inside one arena per graph and registers the
+// plan here. At runtime each thread owns its own arena per plan, so
+// TaskModule streams running the same graph concurrently never share
+// buffers. The arena is allocated on first use and reused by later calls.
+
+// Arena offsets and sizes are rounded up to this alignment.
+constexpr int64_t kArenaAlignment = 64;
+
+struct MemoryPlanStats {
+  int64_t plan_id;
+  int64_t num_values;
+  // Bytes of the arena, i.e. the peak activation memory of the plan.
+  int64_t arena_bytes;
+  // Bytes the planned values would take with one allocation each.
+  int64_t naive_bytes;
+  // Number of planned ops that fell back to a fresh allocation because the
+  // runtime shape did not match the planned one.
+  int64_t fallbacks;
+};
+
+TORCH_API int64_t register_memory_plan(
+    int64_t num_values,
+    int64_t arena_bytes,
+    int64_t naive_bytes);
+
+TORCH_API std::vector<MemoryPlanStats> get_memory_plan_stats();
+
+// Free all arenas held by the calling thread.
+TORCH_API void release_thread_arenas();
+
+// Return a tensor with given sizes and strides that lives in the calling
+// thread's arena of the plan at byte offset `offset`.
+at::Tensor arena_slice(
+    int64_t plan_id,
+    int64_t offset,
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides,
+    const at::TensorOptions& options);
+
+// Count a planned op that fell back to a fresh allocation.
+void record_memory_plan_fallback(int64_t plan_id);
+
+} // namespace arena
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,105 @@
+#include "ConcatBuffer.h"
+
+#include <torch/csrc/autograd/function.h>
+
+#include "aten/EmbeddingBag.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace concat {
+
+at::Tensor concat_buffer(
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides,
+    at::ScalarType dtype) {
+  return at::empty_strided(sizes, strides, at::TensorOptions().dtype(dtype));
+}
+
+at::Tensor concat_slice(
+    const at::Tensor& buffer,
+    int64_t dim,
+    int64_t start,
+    int64_t length,
+    at::IntArrayRef sizes,
+    at::ScalarType dtype) {
+  if (buffer.scalar_type() != dtype ||
+      buffer.dim() != static_cast<int64_t>(sizes.size()) ||
+      sizes[dim] != length || start + length > buffer.size(dim)) {
+    return at::Tensor();
+  }
+  for (int64_t d = 0; d < buffer.dim(); d++) {
+    if (d != dim && sizes[d] != buffer.size(d)) {
+      return at::Tensor();
+    }
+  }
+  return buffer.narrow(dim, start, length);
+}
+
+at::Tensor copy_to_concat_slice(const at::Tensor& result, at::Tensor& slice) {
+  if (result.data_ptr() != slice.data_ptr() ||
+      result.strides() != slice.strides()) {
+    slice.copy_(result);
+  }
+  return slice;
+}
+
+at::Tensor concat_from_buffer(
+    at::Tensor& buffer,
+    at::TensorList parts,
+    int64_t dim,
+    at::IntArrayRef lengths) {
+  RECORD_FUNCTION("ipex::concat_from_buffer", c10::ArrayRef<c10::IValue>({}));
+  // A part is written in place only at its planned slice, so the buffer can
+  // be used as long as every part has its planned length.
+  bool planned = parts.size() == lengths.size();
+  for (size_t i = 0; planned && i < parts.size(); i++) {
+    planned = parts[i].dim() == buffer.dim() &&
+        parts[i].scalar_type() == buffer.scalar_type() &&
+        parts[i].size(dim) == lengths[i];
+    for (int64_t d = 0; planned && d < buffer.dim(); d++) {
+      planned = d == dim || parts[i].size(d) == buffer.size(d);
+    }
+  }
+  if (!planned) {
+    return at::cat(parts, dim);
+  }
+  int64_t start = 0;
+  for (size_t i = 0; i < parts.size(); i++) {
+    auto slice = buffer.narrow(dim, start, lengths[i]);
+    copy_to_concat_slice(parts[i], slice);
+    start += lengths[i];
+  }
+  return buffer;
+}
+
+at::Tensor embedding_bag_into(
+    const at::Tensor& weight,
+    const at::Tensor& indices,
+    const at::Tensor& offsets,
+    bool include_last_offset,
+    at::Tensor& buffer,
+    int64_t dim,
+    int64_t start,
+    int64_t length) {
+  RECORD_FUNCTION("ipex::embedding_bag_into", c10::ArrayRef<c10::IValue>({}));
+  std::vector<int64_t> sizes = {
+      include_last_offset ? offsets.numel() - 1 : offsets.numel(),
+      weight.size(1)};
+  auto slice =
+      concat_slice(buffer, dim, start, length, sizes, weight.scalar_type());
+  if (!slice.defined() || slice.stride(1) != 1 ||
+      (weight.scalar_type() != at::kFloat &&
+       weight.scalar_type() != at::kBFloat16)) {
+    return torch_ipex::embedding_bag(
+        weight, indices, offsets, /* sparse */ false, include_last_offset);
+  }
+  embedding_bag_out_kernel_stub(
+      kCPU, weight, indices, offsets, include_last_offset, slice);
+  return slice;
+}
+
+} // namespace concat
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
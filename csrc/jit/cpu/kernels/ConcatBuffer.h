@@ -0,0 +1,79 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <c10/util/ArrayRef.h>
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace concat {
+
+// Support for the concat elimination pass (csrc/jit/passes/concat_elimination
+// .cpp). The output of an aten::cat is allocated up front by concat_buffer
+// and its producers are replaced by "_into" variants writing their result
+// into their slice [start, start + length) along dim of the buffer.
+// ipex::concat_from_buffer replaces the cat and only copies the inputs which
+// were not written in place.
+//
+// Every step falls back when the runtime shapes differ from the planned ones:
+// the producer returns a fresh tensor and the concat is done by at::cat.
+
+at::Tensor concat_buffer(
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides,
+    at::ScalarType dtype);
+
+// Returns the slice [start, start + length) along dim of buffer if a result
+// of `sizes` and `dtype` is planned there, otherwise an undefined tensor.
+at::Tensor concat_slice(
+    const at::Tensor& buffer,
+    int64_t dim,
+    int64_t start,
+    int64_t length,
+    at::IntArrayRef sizes,
+    at::ScalarType dtype);
+
+// Copies result into slice unless it has already been written there.
+at::Tensor copy_to_concat_slice(const at::Tensor& result, at::Tensor& slice);
+
+at::Tensor concat_from_buffer(
+    at::Tensor& buffer,
+    at::TensorList parts,
+    int64_t dim,
+    at::IntArrayRef lengths);
+
+at::Tensor embedding_bag_into(
+    const at::Tensor& weight,
+    const at::Tensor& indices,
+    const at::Tensor& offsets,
+    bool include_last_offset,
+    at::Tensor& buffer,
+    int64_t dim,
+    int64_t start,
+    int64_t length);
+
+// out_fn(output, self) is an ATen out-variant built on TensorIterator, which
+// writes strided slices directly.
+template <typename OutFn>
+at::Tensor eltwise_into(
+    const at::Tensor& self,
+    at::Tensor& buffer,
+    int64_t dim,
+    int64_t start,
+    int64_t length,
+    const OutFn& out_fn) {
+  auto slice =
+      concat_slice(buffer, dim, start, length, self.sizes(), self.scalar_type());
+  if (!slice.defined()) {
+    auto output = at::empty_like(self);
+    out_fn(output, self);
+    return output;
+  }
+  out_fn(slice, self);
+  return slice;
+}
+
+} // namespace concat
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
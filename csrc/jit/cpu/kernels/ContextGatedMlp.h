@@ -0,0 +1,35 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include "ContextLinear.h"
+#include "aten/GatedMlp.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+struct ContextGatedMlp final {
+  // linear of the interleaved gate and up weights and biases, see
+  // gated_mlp_interleave
+  ContextLinear linear_;
+  GatedMlpAct act_;
+  int64_t hidden_features_;
+
+  ContextGatedMlp() = delete;
+
+  ContextGatedMlp(
+      ContextLinear&& linear,
+      GatedMlpAct act,
+      int64_t hidden_features)
+      : linear_(std::move(linear)),
+        act_(act),
+        hidden_features_(hidden_features) {}
+
+  ContextGatedMlp(ContextGatedMlp&&) = default;
+  ContextGatedMlp& operator=(ContextGatedMlp&&) = default;
+
+  ~ContextGatedMlp() {}
+};
+
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
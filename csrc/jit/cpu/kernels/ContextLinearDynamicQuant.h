@@ -0,0 +1,48 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include "aten/DynamicQuantLinear.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+struct ContextLinearDynamicQuant final {
+  // blocked s8 weight, see dynamic_quant_linear_pack_weight
+  at::Tensor qweight_;
+  at::Tensor scales_;
+  at::Tensor compensation_;
+  c10::optional<at::Tensor> bias_;
+  bool per_channel_weight_;
+  bool per_token_;
+  int64_t in_features_;
+  int64_t out_features_;
+
+  ContextLinearDynamicQuant() = delete;
+
+  ContextLinearDynamicQuant(
+      at::Tensor&& qweight,
+      at::Tensor&& scales,
+      at::Tensor&& compensation,
+      c10::optional<at::Tensor>&& bias,
+      bool per_channel_weight,
+      bool per_token,
+      int64_t in_features,
+      int64_t out_features)
+      : qweight_(std::move(qweight)),
+        scales_(std::move(scales)),
+        compensation_(std::move(compensation)),
+        bias_(std::move(bias)),
+        per_channel_weight_(per_channel_weight),
+        per_token_(per_token),
+        in_features_(in_features),
+        out_features_(out_features) {}
+
+  ContextLinearDynamicQuant(ContextLinearDynamicQuant&&) = default;
+  ContextLinearDynamicQuant& operator=(ContextLinearDynamicQuant&&) = default;
+
+  ~ContextLinearDynamicQuant() {}
+};
+
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
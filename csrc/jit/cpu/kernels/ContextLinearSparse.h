@@ -0,0 +1,42 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include "aten/SparseLinear.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+struct ContextLinearSparse final {
+  // non-zero weight blocks in block-CSR format, see sparse_linear_pack_weight
+  at::Tensor values_;
+  at::Tensor col_index_;
+  at::Tensor row_ptr_;
+  c10::optional<at::Tensor> bias_;
+  int64_t in_features_;
+  int64_t out_features_;
+
+  ContextLinearSparse() = delete;
+
+  ContextLinearSparse(
+      at::Tensor&& values,
+      at::Tensor&& col_index,
+      at::Tensor&& row_ptr,
+      c10::optional<at::Tensor>&& bias,
+      int64_t in_features,
+      int64_t out_features)
+      : values_(std::move(values)),
+        col_index_(std::move(col_index)),
+        row_ptr_(std::move(row_ptr)),
+        bias_(std::move(bias)),
+        in_features_(in_features),
+        out_features_(out_features) {}
+
+  ContextLinearSparse(ContextLinearSparse&&) = default;
+  ContextLinearSparse& operator=(ContextLinearSparse&&) = default;
+
+  ~ContextLinearSparse() {}
+};
+
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
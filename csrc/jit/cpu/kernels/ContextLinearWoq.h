@@ -0,0 +1,44 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+struct ContextLinearWoq final {
+  // blocked int8 or packed int4 weight, see woq_linear_pack_weight
+  at::Tensor qweight_;
+  at::Tensor scales_;
+  c10::optional<at::Tensor> bias_;
+  at::ScalarType weight_dtype_;
+  int64_t group_size_;
+  int64_t in_features_;
+  int64_t out_features_;
+
+  ContextLinearWoq() = delete;
+
+  ContextLinearWoq(
+      at::Tensor&& qweight,
+      at::Tensor&& scales,
+      c10::optional<at::Tensor>&& bias,
+      at::ScalarType weight_dtype,
+      int64_t group_size,
+      int64_t in_features,
+      int64_t out_features)
+      : qweight_(std::move(qweight)),
+        scales_(std::move(scales)),
+        bias_(std::move(bias)),
+        weight_dtype_(weight_dtype),
+        group_size_(group_size),
+        in_features_(in_features),
+        out_features_(out_features) {}
+
+  ContextLinearWoq(ContextLinearWoq&&) = default;
+  ContextLinearWoq& operator=(ContextLinearWoq&&) = default;
+
+  ~ContextLinearWoq() {}
+};
+
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,653 @@
+#include "ConvChain.h"
+
+#include <ATen/Parallel.h>
+#include <ATen/native/Pool.h>
+#include <dnnl.hpp>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "aten/Conv.h"
+#include "ideep/IDeepConversions.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace conv_chain {
+
+namespace {
+
+// Rows [in_begin, in_begin + rows_in) of the input of a sliding window
+// operator which produce a range of its output rows, padded with pad_top and
+// pad_bottom rows at the borders of the image.
+struct InputRows {
+  int64_t in_begin;
+  int64_t rows_in;
+  int64_t pad_top;
+  int64_t pad_bottom;
+};
+
+InputRows input_rows(
+    int64_t row,
+    int64_t rows,
+    int64_t stride,
+    int64_t padding,
+    int64_t extent,
+    int64_t height) {
+  auto in_begin = row * stride - padding;
+  auto in_end = (row + rows - 1) * stride - padding + extent;
+  InputRows input;
+  input.pad_top = std::max<int64_t>(-in_begin, 0);
+  input.pad_bottom = std::max<int64_t>(in_end - height, 0);
+  input.in_begin = std::max<int64_t>(in_begin, 0);
+  input.rows_in = std::min(in_end, height) - input.in_begin;
+  return input;
+}
+
+// Output rows [row, row + rows) of one image and the rows of the input of
+// the tile.
+struct Tile {
+  int64_t row;
+  int64_t rows;
+  InputRows input;
+  // rows of the convolution output read by the pooling
+  InputRows pooled;
+};
+
+// The convolutions and the pooling of a tile, in execution order.
+struct TilePrimitives {
+  std::vector<dnnl::convolution_forward::primitive_desc> conv_pds;
+  std::vector<dnnl::convolution_forward> convs;
+  dnnl::pooling_forward::primitive_desc pool_pd;
+  dnnl::pooling_forward pool;
+};
+
+// The key holds the post ops and the geometry of the tile, the weights
+// descriptors of the prepacked contexts are compared on lookup.
+using TileKey = std::pair<std::string, std::vector<int64_t>>;
+
+std::mutex tile_cache_mutex;
+std::map<TileKey, std::vector<std::shared_ptr<TilePrimitives>>> tile_cache;
+
+std::shared_ptr<TilePrimitives> get_tile_primitives(
+    const TileKey& key,
+    const std::vector<const ContextConvolution*>& contexts,
+    const std::function<TilePrimitives()>& create) {
+  std::lock_guard<std::mutex> lock(tile_cache_mutex);
+  auto& entries = tile_cache[key];
+  for (auto& entry : entries) {
+    bool same_weights = true;
+    for (size_t i = 0; i < contexts.size(); i++) {
+      same_weights = same_weights &&
+          entry->conv_pds[i].weights_desc() ==
+              contexts[i]->conv_params_.pd.weights_desc();
+    }
+    if (same_weights) {
+      return entry;
+    }
+  }
+  entries.push_back(std::make_shared<TilePrimitives>(create()));
+  return entries.back();
+}
+
+// Appends what the tile primitives of a convolution depend on, besides its
+// weights descriptor.
+void append_conv_geometry(
+    std::vector<int64_t>& geometry,
+    const ContextConvolution& context) {
+  geometry.push_back(
+      context.bias_.is_empty()
+          ? int64_t(-1)
+          : static_cast<int64_t>(context.bias_.get_data_type()));
+  geometry.push_back(context.groups_);
+  auto dims = context.weight_packed_.get_dims();
+  geometry.insert(geometry.end(), dims.begin(), dims.end());
+  geometry.insert(
+      geometry.end(), context.stride_.begin(), context.stride_.end());
+  geometry.insert(
+      geometry.end(), context.padding_.begin(), context.padding_.end());
+  geometry.insert(
+      geometry.end(), context.dilation_.begin(), context.dilation_.end());
+}
+
+dnnl::convolution_forward::primitive_desc create_conv_pd(
+    const ContextConvolution& context,
+    const ideep::attr_t& attr,
+    ideep::data_type dtype,
+    const ideep::dims& src_dims,
+    const ideep::dims& dst_dims,
+    const ideep::dims& padding_l,
+    const ideep::dims& padding_r) {
+  ideep::tensor::desc src_desc(src_dims, dtype, ideep::format_tag::nhwc);
+  ideep::tensor::desc dst_desc(dst_dims, dtype, ideep::format_tag::nhwc);
+  // oneDNN counts the dilation from 0
+  ideep::dims dilates;
+  for (auto d : context.dilation_) {
+    dilates.push_back(d - 1);
+  }
+  // use the prepacked weights as they are, without any reorder
+  auto weights_desc = context.conv_params_.pd.weights_desc();
+  if (context.bias_.is_empty()) {
+    return dnnl::convolution_forward::primitive_desc(
+        {ideep::prop_kind::forward_inference,
+         ideep::algorithm::convolution_direct,
+         src_desc,
+         weights_desc,
+         dst_desc,
+         context.stride_,
+         dilates,
+         padding_l,
+         padding_r},
+        attr,
+        ideep::engine::cpu_engine());
+  }
+  return dnnl::convolution_forward::primitive_desc(
+      {ideep::prop_kind::forward_inference,
+       ideep::algorithm::convolution_direct,
+       src_desc,
+       weights_desc,
+       context.bias_.get_desc(),
+       dst_desc,
+       context.stride_,
+       dilates,
+       padding_l,
+       padding_r},
+      attr,
+      ideep::engine::cpu_engine());
+}
+
+void execute_conv(
+    const dnnl::convolution_forward& primitive,
+    const ContextConvolution& context,
+    const dnnl::memory& src,
+    const dnnl::memory& dst,
+    const dnnl::memory& scratchpad) {
+  std::unordered_map<int, dnnl::memory> args{
+      {DNNL_ARG_SRC, src},
+      {DNNL_ARG_WEIGHTS, context.weight_packed_},
+      {DNNL_ARG_DST, dst},
+      {DNNL_ARG_SCRATCHPAD, scratchpad}};
+  if (!context.bias_.is_empty()) {
+    args.insert({DNNL_ARG_BIAS, context.bias_});
+  }
+  primitive.execute(ideep::stream::default_stream(), args);
+}
+
+// Whether the input is a 4-D FP32 or BF16 tensor of the dtype of the weights
+// of the context, and the convolution is valid for it.
+bool can_tile(const ContextConvolution& context, const at::Tensor& input) {
+  auto scalar_type = input.scalar_type();
+  if (input.dim() != 4 ||
+      (scalar_type != at::kFloat && scalar_type != at::kBFloat16) ||
+      context.weight_packed_.get_data_type() != get_mkldnn_dtype(scalar_type)) {
+    return false;
+  }
+  auto dims = context.weight_packed_.get_dims();
+  if (dims.size() != 4 || input.size(1) != dims[1] * context.groups_) {
+    return false;
+  }
+  for (int64_t i = 0; i < 2; i++) {
+    if (input.size(i + 2) + 2 * context.padding_[i] <
+        (dims[i + 2] - 1) * context.dilation_[i] + 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Rows of output per tile, within the working set and giving every thread
+// at least one tile, or 0 if there are fewer rows than threads.
+int64_t tile_rows(
+    int64_t batch,
+    int64_t out_height,
+    int64_t row_bytes,
+    int64_t halo_bytes) {
+  auto num_threads = at::get_num_threads();
+  if (batch * out_height < num_threads) {
+    return 0;
+  }
+  int64_t rows = std::max<int64_t>((kTileBytes - halo_bytes) / row_bytes, 1);
+  rows =
+      std::min(rows, std::max<int64_t>(batch * out_height / num_threads, 1));
+  return std::min(rows, out_height);
+}
+
+dnnl::memory::desc max_scratchpad_desc(
+    const std::vector<std::shared_ptr<TilePrimitives>>& primitives) {
+  dnnl::memory::desc desc;
+  size_t size = 0;
+  for (const auto& tile_primitives : primitives) {
+    std::vector<dnnl::memory::desc> descs;
+    for (const auto& pd : tile_primitives->conv_pds) {
+      descs.push_back(pd.scratchpad_desc());
+    }
+    if (tile_primitives->pool) {
+      descs.push_back(tile_primitives->pool_pd.scratchpad_desc());
+    }
+    for (const auto& scratchpad_desc : descs) {
+      if (scratchpad_desc.get_size() > size) {
+        size = scratchpad_desc.get_size();
+        desc = scratchpad_desc;
+      }
+    }
+  }
+  return desc;
+}
+
+ideep::attr_t tile_attr(const std::string& post_op) {
+  auto attr = post_op_attr(post_op);
+  attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
+  return attr;
+}
+
+} // namespace
+
+ideep::attr_t post_op_attr(const std::string& post_op) {
+  ideep::attr_t attr;
+  if (post_op == "relu") {
+    attr = ideep::attr_t::fuse_relu();
+  } else if (post_op == "relu6") {
+    attr = ideep::attr_t::fuse_clamp(0.f, 6.f);
+  } else if (post_op == "swish") {
+    attr = ideep::attr_t::fuse_swish();
+  } else if (post_op == "hardswish") {
+    attr = ideep::attr_t::fuse_hardswish();
+  } else if (post_op == "sigmoid") {
+    attr = ideep::attr_t::fuse_sigmoid();
+  } else {
+    TORCH_CHECK(
+        post_op == "none",
+        "Convolution chains support \"none\", \"relu\", \"relu6\", "
+        "\"swish\", \"hardswish\" and \"sigmoid\" post ops, but got ",
+        post_op);
+  }
+  return attr.set_fpmath_mode(torch_ipex::fpmath_mode);
+}
+
+ideep::algorithm pool_algorithm(const std::string& pool) {
+  if (pool == "max") {
+    return ideep::algorithm::pooling_max;
+  } else if (pool == "avg") {
+    return ideep::algorithm::pooling_avg_include_padding;
+  }
+  TORCH_CHECK(
+      pool == "avg_exclude_pad",
+      "Convolution chains support \"max\", \"avg\" and \"avg_exclude_pad\" "
+      "pooling, but got ",
+      pool);
+  return ideep::algorithm::pooling_avg_exclude_padding;
+}
+
+at::Tensor run_depthwise_pointwise(
+    const ContextConvolution& dw_context,
+    const std::string& dw_post_op,
+    const ContextConvolution& pw_context,
+    const std::string& pw_post_op,
+    const at::Tensor& input) {
+  if (!can_tile(dw_context, input)) {
+    return at::Tensor();
+  }
+  auto batch = input.size(0);
+  auto channels = input.size(1);
+  auto height = input.size(2);
+  auto width = input.size(3);
+  auto dw_dims = dw_context.weight_packed_.get_dims();
+  auto pw_dims = pw_context.weight_packed_.get_dims();
+  if (dw_dims[0] != channels || dw_dims[1] != 1 ||
+      pw_context.weight_packed_.get_data_type() !=
+          dw_context.weight_packed_.get_data_type() ||
+      pw_dims.size() != 4 || pw_dims[1] != channels || pw_dims[2] != 1 ||
+      pw_dims[3] != 1 || pw_context.groups_ != 1 ||
+      pw_context.stride_ != ideep::dims{1, 1} ||
+      pw_context.padding_ != ideep::dims{0, 0}) {
+    return at::Tensor();
+  }
+  auto output_size = calc_conv_output_size(
+      input.sizes(),
+      dw_dims,
+      dw_context.padding_,
+      dw_context.stride_,
+      dw_context.dilation_);
+  auto out_height = output_size[2];
+  auto out_width = output_size[3];
+  auto out_channels = pw_dims[0];
+  auto itemsize = input.element_size();
+  if (batch * out_height * out_width * channels * itemsize <= kTileBytes) {
+    return at::Tensor();
+  }
+
+  auto kernel_extent = (dw_dims[2] - 1) * dw_context.dilation_[0] + 1;
+  auto stride = dw_context.stride_[0];
+  auto rows = tile_rows(
+      batch,
+      out_height,
+      (stride * width * channels + out_width * (channels + out_channels)) *
+          itemsize,
+      std::max<int64_t>(kernel_extent - stride, 0) * width * channels *
+          itemsize);
+  if (rows == 0) {
+    return at::Tensor();
+  }
+  auto tiles_per_image = (out_height + rows - 1) / rows;
+  auto num_tiles = batch * tiles_per_image;
+
+  auto dtype = get_mkldnn_dtype(input.scalar_type());
+  auto dw_attr = tile_attr(dw_post_op);
+  auto pw_attr = tile_attr(pw_post_op);
+  std::vector<int64_t> geometry = {
+      static_cast<int64_t>(dtype),
+      static_cast<int64_t>(torch_ipex::fpmath_mode),
+      width};
+  append_conv_geometry(geometry, dw_context);
+  append_conv_geometry(geometry, pw_context);
+
+  // every image has the same tiles
+  std::vector<Tile> tiles;
+  std::vector<std::shared_ptr<TilePrimitives>> primitives;
+  try {
+    for (int64_t row = 0; row < out_height; row += rows) {
+      Tile tile;
+      tile.row = row;
+      tile.rows = std::min(rows, out_height - row);
+      tile.input = input_rows(
+          row,
+          tile.rows,
+          stride,
+          dw_context.padding_[0],
+          kernel_extent,
+          height);
+      tiles.push_back(tile);
+      auto key = geometry;
+      key.insert(
+          key.end(),
+          {tile.rows,
+           tile.input.rows_in,
+           tile.input.pad_top,
+           tile.input.pad_bottom});
+      primitives.push_back(get_tile_primitives(
+          TileKey(dw_post_op + "," + pw_post_op, key),
+          {&dw_context, &pw_context},
+          [&]() {
+            TilePrimitives tile_primitives;
+            tile_primitives.conv_pds.push_back(create_conv_pd(
+                dw_context,
+                dw_attr,
+                dtype,
+                {1, channels, tile.input.rows_in, width},
+                {1, channels, tile.rows, out_width},
+                {tile.input.pad_top, dw_context.padding_[1]},
+                {tile.input.pad_bottom, dw_context.padding_[1]}));
+            tile_primitives.conv_pds.push_back(create_conv_pd(
+                pw_context,
+                pw_attr,
+                dtype,
+                {1, channels, tile.rows, out_width},
+                {1, out_channels, tile.rows, out_width},
+                {0, 0},
+                {0, 0}));
+            for (const auto& pd : tile_primitives.conv_pds) {
+              tile_primitives.convs.emplace_back(pd);
+            }
+            return tile_primitives;
+          }));
+    }
+  } catch (const dnnl::error&) {
+    return at::Tensor();
+  }
+  auto scratchpad_desc = max_scratchpad_desc(primitives);
+
+  auto input_ = input.contiguous(at::MemoryFormat::ChannelsLast);
+  auto output = at::empty(
+      {batch, out_channels, out_height, out_width},
+      input_.options().memory_format(at::MemoryFormat::ChannelsLast));
+  auto input_data = static_cast<char*>(input_.data_ptr());
+  auto output_data = static_cast<char*>(output.data_ptr());
+  auto engine = ideep::engine::cpu_engine();
+
+  // tiles are independent, each runs its primitives on one thread
+  at::parallel_for(0, num_tiles, 1, [&](int64_t begin, int64_t end) {
+    auto intermediate =
+        at::empty({rows * out_width * channels}, input_.options());
+    dnnl::memory scratchpad(scratchpad_desc, engine);
+    for (int64_t t = begin; t < end; t++) {
+      auto n = t / tiles_per_image;
+      const auto& tile = tiles[t % tiles_per_image];
+      const auto& tile_primitives = *primitives[t % tiles_per_image];
+      dnnl::memory src(
+          tile_primitives.conv_pds[0].src_desc(),
+          engine,
+          input_data +
+              (n * height + tile.input.in_begin) * width * channels *
+                  itemsize);
+      dnnl::memory mid(
+          tile_primitives.conv_pds[0].dst_desc(),
+          engine,
+          intermediate.data_ptr());
+      dnnl::memory dst(
+          tile_primitives.conv_pds[1].dst_desc(),
+          engine,
+          output_data +
+              (n * out_height + tile.row) * out_width * out_channels *
+                  itemsize);
+      execute_conv(tile_primitives.convs[0], dw_context, src, mid, scratchpad);
+      execute_conv(tile_primitives.convs[1], pw_context, mid, dst, scratchpad);
+    }
+  });
+  return output;
+}
+
+at::Tensor run_conv_pool(
+    const ContextConvolution& context,
+    const std::string& post_op,
+    const std::string& pool,
+    at::IntArrayRef kernel_size,
+    at::IntArrayRef stride,
+    at::IntArrayRef padding,
+    bool ceil_mode,
+    const at::Tensor& input) {
+  auto algorithm = pool_algorithm(pool);
+  // the extended right paddings of the ceil mode would count in averages
+  if (!can_tile(context, input) || kernel_size.size() != 2 ||
+      stride.size() != 2 || padding.size() != 2 ||
+      (ceil_mode && algorithm != ideep::algorithm::pooling_max)) {
+    return at::Tensor();
+  }
+  auto batch = input.size(0);
+  auto channels = input.size(1);
+  auto height = input.size(2);
+  auto width = input.size(3);
+  auto dims = context.weight_packed_.get_dims();
+  auto conv_size = calc_conv_output_size(
+      input.sizes(),
+      dims,
+      context.padding_,
+      context.stride_,
+      context.dilation_);
+  auto out_channels = conv_size[1];
+  auto conv_height = conv_size[2];
+  auto conv_width = conv_size[3];
+  auto itemsize = input.element_size();
+  if (batch * conv_height * conv_width * out_channels * itemsize <=
+      kTileBytes) {
+    return at::Tensor();
+  }
+
+  // oneDNN has no ceil mode, the right paddings are extended instead like
+  // in pooling_impl
+  std::vector<int64_t> pool_size(2);
+  std::vector<int64_t> padding_r(2);
+  for (int64_t i = 0; i < 2; i++) {
+    auto conv_extent = i == 0 ? conv_height : conv_width;
+    if (padding[i] * 2 > kernel_size[i]) {
+      return at::Tensor();
+    }
+    pool_size[i] = at::native::pooling_output_shape<int64_t>(
+        conv_extent, kernel_size[i], padding[i], stride[i], 1, ceil_mode);
+    padding_r[i] = std::max<int64_t>(
+        padding[i],
+        (pool_size[i] - 1) * stride[i] + kernel_size[i] - conv_extent -
+            padding[i]);
+  }
+  auto out_height = pool_size[0];
+  auto out_width = pool_size[1];
+
+  auto conv_extent = (dims[2] - 1) * context.dilation_[0] + 1;
+  auto rows = tile_rows(
+      batch,
+      out_height,
+      (stride[0] * context.stride_[0] * width * channels +
+       stride[0] * conv_width * out_channels + out_width * out_channels) *
+          itemsize,
+      (std::max<int64_t>(kernel_size[0] - stride[0], 0) * context.stride_[0] +
+       std::max<int64_t>(conv_extent - context.stride_[0], 0)) *
+              width * channels * itemsize +
+          std::max<int64_t>(kernel_size[0] - stride[0], 0) * conv_width *
+              out_channels * itemsize);
+  if (rows == 0) {
+    return at::Tensor();
+  }
+  auto tiles_per_image = (out_height + rows - 1) / rows;
+  auto num_tiles = batch * tiles_per_image;
+
+  auto dtype = get_mkldnn_dtype(input.scalar_type());
+  auto conv_attr = tile_attr(post_op);
+  dnnl::primitive_attr pool_attr;
+  pool_attr.set_scratchpad_mode(dnnl::scratchpad_mode::user);
+  std::vector<int64_t> geometry = {
+      static_cast<int64_t>(dtype),
+      static_cast<int64_t>(torch_ipex::fpmath_mode),
+      width,
+      conv_width,
+      out_width,
+      static_cast<int64_t>(algorithm)};
+  append_conv_geometry(geometry, context);
+  geometry.insert(geometry.end(), kernel_size.begin(), kernel_size.end());
+  geometry.insert(geometry.end(), stride.begin(), stride.end());
+  geometry.insert(geometry.end(), padding.begin(), padding.end());
+  geometry.push_back(padding_r[1]);
+
+  std::vector<Tile> tiles;
+  std::vector<std::shared_ptr<TilePrimitives>> primitives;
+  int64_t max_conv_rows = 0;
+  try {
+    for (int64_t row = 0; row < out_height; row += rows) {
+      Tile tile;
+      tile.row = row;
+      tile.rows = std::min(rows, out_height - row);
+      // the pooling pads the convolution output at its own borders only
+      tile.pooled = input_rows(
+          row, tile.rows, stride[0], padding[0], kernel_size[0], conv_height);
+      tile.input = input_rows(
+          tile.pooled.in_begin,
+          tile.pooled.rows_in,
+          context.stride_[0],
+          context.padding_[0],
+          conv_extent,
+          height);
+      tiles.push_back(tile);
+      max_conv_rows = std::max(max_conv_rows, tile.pooled.rows_in);
+      auto key = geometry;
+      key.insert(
+          key.end(),
+          {tile.rows,
+           tile.pooled.rows_in,
+           tile.pooled.pad_top,
+           tile.pooled.pad_bottom,
+           tile.input.rows_in,
+           tile.input.pad_top,
+           tile.input.pad_bottom});
+      primitives.push_back(get_tile_primitives(
+          TileKey(post_op, key), {&context}, [&]() {
+            TilePrimitives tile_primitives;
+            tile_primitives.conv_pds.push_back(create_conv_pd(
+                context,
+                conv_attr,
+                dtype,
+                {1, channels, tile.input.rows_in, width},
+                {1, out_channels, tile.pooled.rows_in, conv_width},
+                {tile.input.pad_top, context.padding_[1]},
+                {tile.input.pad_bottom, context.padding_[1]}));
+            tile_primitives.convs.emplace_back(tile_primitives.conv_pds[0]);
+            ideep::tensor::desc src_desc(
+                {1, out_channels, tile.pooled.rows_in, conv_width},
+                dtype,
+                ideep::format_tag::nhwc);
+            ideep::tensor::desc dst_desc(
+                {1, out_channels, tile.rows, out_width},
+                dtype,
+                ideep::format_tag::nhwc);
+            tile_primitives.pool_pd = dnnl::pooling_forward::primitive_desc(
+                {ideep::prop_kind::forward_inference,
+                 algorithm,
+                 src_desc,
+                 dst_desc,
+                 {stride[0], stride[1]},
+                 {kernel_size[0], kernel_size[1]},
+                 {tile.pooled.pad_top, padding[1]},
+                 {tile.pooled.pad_bottom, padding_r[1]}},
+                pool_attr,
+                ideep::engine::cpu_engine());
+            tile_primitives.pool =
+                dnnl::pooling_forward(tile_primitives.pool_pd);
+            return tile_primitives;
+          }));
+    }
+  } catch (const dnnl::error&) {
+    return at::Tensor();
+  }
+  auto scratchpad_desc = max_scratchpad_desc(primitives);
+
+  auto input_ = input.contiguous(at::MemoryFormat::ChannelsLast);
+  auto output = at::empty(
+      {batch, out_channels, out_height, out_width},
+      input_.options().memory_format(at::MemoryFormat::ChannelsLast));
+  auto input_data = static_cast<char*>(input_.data_ptr());
+  auto output_data = static_cast<char*>(output.data_ptr());
+  auto engine = ideep::engine::cpu_engine();
+
+  // the convolution rows of a tile are pooled while they are in cache, the
+  // rows shared by two tiles are computed by both
+  at::parallel_for(0, num_tiles, 1, [&](int64_t begin, int64_t end) {
+    auto intermediate = at::empty(
+        {max_conv_rows * conv_width * out_channels}, input_.options());
+    dnnl::memory scratchpad(scratchpad_desc, engine);
+    for (int64_t t = begin; t < end; t++) {
+      auto n = t / tiles_per_image;
+      const auto& tile = tiles[t % tiles_per_image];
+      const auto& tile_primitives = *primitives[t % tiles_per_image];
+      dnnl::memory src(
+          tile_primitives.conv_pds[0].src_desc(),
+          engine,
+          input_data +
+              (n * height + tile.input.in_begin) * width * channels *
+                  itemsize);
+      dnnl::memory mid(
+          tile_primitives.conv_pds[0].dst_desc(),
+          engine,
+          intermediate.data_ptr());
+      dnnl::memory dst(
+          tile_primitives.pool_pd.dst_desc(),
+          engine,
+          output_data +
+              (n * out_height + tile.row) * out_width * out_channels *
+                  itemsize);
+      execute_conv(tile_primitives.convs[0], context, src, mid, scratchpad);
+      tile_primitives.pool.execute(
+          ideep::stream::default_stream(),
+          {{DNNL_ARG_SRC, mid},
+           {DNNL_ARG_DST, dst},
+           {DNNL_ARG_SCRATCHPAD, scratchpad}});
+    }
+  });
+  return output;
+}
+
+} // namespace conv_chain
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
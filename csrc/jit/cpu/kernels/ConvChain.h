@@ -0,0 +1,76 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ideep.hpp>
+#include <string>
+#include "ContextConvolution.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace conv_chain {
+
+// Spatially tiled execution of chains of convolutions and pooling:
+//  - a depthwise convolution followed by a pointwise (1x1, stride 1, no
+//    padding) convolution, e.g. the depthwise and projection convolutions of
+//    MobileNet and EfficientNet blocks,
+//  - a convolution followed by a max or average pooling, e.g. the stem of
+//    ResNet (conv7x7 -> relu -> maxpool) and the blocks of VGG.
+//
+// The output is split into tiles of whole rows of one image. Each OpenMP
+// thread computes its tiles end to end: the first operator reads the input
+// rows of the tile plus the halo of its window and writes the intermediate
+// rows into a per-thread buffer, which the second operator consumes right
+// away. Tiles are sized so that the input rows, the intermediate rows and the
+// output rows fit into kTileBytes, the intermediate feature map is never
+// written to memory as a whole. Intermediate rows in the halo of two tiles
+// are computed by both.
+//
+// The tile operators are single-threaded oneDNN primitives using the
+// prepacked weights of the contexts. They only differ in the number of rows
+// and the paddings at the top and the bottom of the image, so a few of them
+// cover a whole feature map and they are cached by their geometry.
+
+// Working set of one tile, half of the 1.25MB-2MB L2 of recent Xeons so that
+// the weights and the scratchpad stay resident as well.
+constexpr int64_t kTileBytes = 512 * 1024;
+
+// Post ops fused into either convolution of the chain: "none", "relu",
+// "relu6", "swish", "hardswish" and "sigmoid".
+ideep::attr_t post_op_attr(const std::string& post_op);
+
+// Returns an undefined tensor if the chain is not worth tiling or cannot be
+// tiled, in which case the caller runs both convolutions one after the other:
+// the input is not a 4-D FP32 or BF16 tensor of the weight dtype, the first
+// context is not depthwise or the second one not pointwise, the whole
+// intermediate feature map already fits into kTileBytes, there are fewer
+// tiles than threads, or oneDNN has no implementation for the tile shapes.
+at::Tensor run_depthwise_pointwise(
+    const ContextConvolution& dw_context,
+    const std::string& dw_post_op,
+    const ContextConvolution& pw_context,
+    const std::string& pw_post_op,
+    const at::Tensor& input);
+
+// Pooling following a convolution: "max", "avg" (padding included in the
+// average) and "avg_exclude_pad".
+ideep::algorithm pool_algorithm(const std::string& pool);
+
+// Returns an undefined tensor if the convolution output is not worth tiling
+// or cannot be tiled, like run_depthwise_pointwise. kernel_size, stride and
+// padding are those of the pooling, with two values each. The ceil mode is
+// only supported by the max pooling.
+at::Tensor run_conv_pool(
+    const ContextConvolution& context,
+    const std::string& post_op,
+    const std::string& pool,
+    at::IntArrayRef kernel_size,
+    at::IntArrayRef stride,
+    at::IntArrayRef padding,
+    bool ceil_mode,
+    const at::Tensor& input);
+
+} // namespace conv_chain
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
@@ -7,6 +7,11 @@
 #include "aten/WeightPack.h"
 #include "aten/utils/utils.h"
 #include "ideep/IDeepConversions.h"
+#include "runtime/NumaAllocator.h"
+#include "ActivationArena.h"
+#include "ConcatBuffer.h"
+#include "ConvChain.h"
+#include "MaxPool2D.h"
 
 namespace torch_ipex {
 namespace cpu {
@@ -305,6 +310,76 @@ at::Tensor convolution_add_relu_run(
       ideep::attr_t::residual(scale).set_fpmath_mode(torch_ipex::fpmath_mode));
 }
 
+at::Tensor convolution_run_out(
+    const at::Tensor& input,
+    const ideep::attr_t& attr,
+    int64_t plan_id,
+    int64_t offset,
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides,
+    const c10::intrusive_ptr<ConvolutionOpContext>& op_context) {
+  RECORD_FUNCTION(
+      "ipex_prepack::convolution_run_out", c10::ArrayRef<c10::IValue>({}));
+  auto& context = op_context->get_context();
+  if (input.dim() != static_cast<int64_t>(sizes.size()) ||
+      calc_conv_output_size(
+          input.sizes(),
+          context.weight_packed_.get_dims(),
+          context.padding_,
+          context.stride_,
+          context.dilation_) != sizes) {
+    arena::record_memory_plan_fallback(plan_id);
+    return op_context->run(input, attr);
+  }
+  auto output =
+      arena::arena_slice(plan_id, offset, sizes, strides, input.options());
+  // run() aligns the output format with the input format. If the planned
+  // strides differ the result is written to a new tensor, which is still
+  // correct but not in the arena.
+  return op_context->run(input, output, attr);
+}
+
+at::Tensor convolution_run_into(
+    const at::Tensor& input,
+    const ideep::attr_t& attr,
+    at::Tensor& buffer,
+    int64_t dim,
+    int64_t start,
+    int64_t length,
+    const c10::intrusive_ptr<ConvolutionOpContext>& op_context) {
+  RECORD_FUNCTION(
+      "ipex_prepack::convolution_run_into", c10::ArrayRef<c10::IValue>({}));
+  auto& context = op_context->get_context();
+  auto output_sizes = calc_conv_output_size(
+      input.sizes(),
+      context.weight_packed_.get_dims(),
+      context.padding_,
+      context.stride_,
+      context.dilation_);
+  auto slice = concat::concat_slice(
+      buffer, dim, start, length, output_sizes, input.scalar_type());
+  if (!slice.defined()) {
+    return op_context->run(input, attr);
+  }
+  // run() writes in place only into an output dense in the format it picks
+  // for the input, e.g. a channel slice of a channels last concat is not
+  if (input.dim() == 4 || input.dim() == 5) {
+    bool use_channels_last =
+        input.suggest_memory_format() == at::MemoryFormat::ChannelsLast ||
+        input.suggest_memory_format() == at::MemoryFormat::ChannelsLast3d ||
+        context.weight_is_channels_last_;
+    auto memory_format = !use_channels_last ? at::MemoryFormat::Contiguous
+        : input.dim() == 4                  ? at::MemoryFormat::ChannelsLast
+                                            : at::MemoryFormat::ChannelsLast3d;
+    if (slice.is_contiguous(memory_format)) {
+      auto output = slice;
+      op_context->run(input, output, attr);
+      return concat::copy_to_concat_slice(output, slice);
+    }
+  }
+  return concat::copy_to_concat_slice(op_context->run(input, attr), slice);
+}
+
 at::Tensor& convolution_bottleneck_run(
     at::Tensor& input,
     const c10::intrusive_ptr<ConvolutionOpContext>& op_context1,
@@ -464,6 +539,78 @@ at::Tensor convolution_bottleneck_run(
   }
 }
 
+at::Tensor convolution_depthwise_pointwise_run(
+    const at::Tensor& input,
+    const std::string& dw_post_op,
+    const std::string& pw_post_op,
+    const c10::intrusive_ptr<ConvolutionOpContext>& dw_op_context,
+    const c10::intrusive_ptr<ConvolutionOpContext>& pw_op_context) {
+  RECORD_FUNCTION(
+      "ipex_prepack::convolution_depthwise_pointwise_run",
+      c10::ArrayRef<c10::IValue>({}));
+  auto output = conv_chain::run_depthwise_pointwise(
+      dw_op_context->get_context(),
+      dw_post_op,
+      pw_op_context->get_context(),
+      pw_post_op,
+      input);
+  if (output.defined()) {
+    return output;
+  }
+  auto intermediate =
+      dw_op_context->run(input, conv_chain::post_op_attr(dw_post_op));
+  return pw_op_context->run(intermediate, conv_chain::post_op_attr(pw_post_op));
+}
+
+at::Tensor convolution_pool_run(
+    const at::Tensor& input,
+    const std::string& post_op,
+    const std::string& pool,
+    at::IntArrayRef kernel_size,
+    at::IntArrayRef stride,
+    at::IntArrayRef padding,
+    bool ceil_mode,
+    const c10::intrusive_ptr<ConvolutionOpContext>& op_context) {
+  RECORD_FUNCTION(
+      "ipex_prepack::convolution_pool_run", c10::ArrayRef<c10::IValue>({}));
+  const auto kernel_size_expanded =
+      expand_param_if_needed(kernel_size, "kernel_size", 2);
+  const auto stride_expanded = expand_param_if_needed(
+      stride.empty() ? kernel_size : stride, "stride", 2);
+  const auto padding_expanded = expand_param_if_needed(padding, "padding", 2);
+  auto output = conv_chain::run_conv_pool(
+      op_context->get_context(),
+      post_op,
+      pool,
+      kernel_size_expanded,
+      stride_expanded,
+      padding_expanded,
+      ceil_mode,
+      input);
+  if (output.defined()) {
+    return output;
+  }
+  auto algorithm = conv_chain::pool_algorithm(pool);
+  auto intermediate =
+      op_context->run(input, conv_chain::post_op_attr(post_op));
+  if (algorithm == ideep::algorithm::pooling_max) {
+    return dil_max_pool2d(
+        intermediate,
+        kernel_size_expanded,
+        stride_expanded,
+        padding_expanded,
+        {1, 1},
+        ceil_mode);
+  }
+  return at::avg_pool2d(
+      intermediate,
+      kernel_size_expanded,
+      stride_expanded,
+      padding_expanded,
+      ceil_mode,
+      algorithm == ideep::algorithm::pooling_avg_include_padding);
+}
+
 ContextConvolution create(
     const at::Tensor& weight,
     const c10::optional<at::Tensor>& bias,
@@ -576,7 +723,10 @@ ContextConvolution create(
   ideep::data_type dtype = w.get_data_type();
   auto expected_desc =
       ideep::tensor::desc(conv_params.pd.weights_desc(), groups);
-  auto at_weight = empty_aten_tensor_from_desc(expected_desc, weight.options());
+  auto at_weight = empty_aten_tensor_from_desc(
+      expected_desc,
+      weight.options(),
+      torch_ipex::runtime::is_numa_weight_allocation_enabled());
   ideep::tensor packed_weight;
   if (ideep::data_type::f32 == dtype) {
     packed_weight.init(expected_desc, at_weight.template data_ptr<float>());
@@ -3,6 +3,7 @@
 #include <ATen/Tensor.h>
 #include <c10/util/ArrayRef.h>
 #include <array>
+#include <string>
 #include "ContextConvolution.h"
 #include "OpContext.h"
 
@@ -106,6 +107,55 @@ at::Tensor convolution_bottleneck_run(
     const c10::intrusive_ptr<ConvolutionOpContext>& op_context3,
     const c10::intrusive_ptr<ConvolutionOpContext>& op_context4);
 
+// Depthwise convolution followed by a pointwise convolution, computed tile by
+// tile of output rows so that the intermediate feature map stays in cache,
+// see ConvChain.h. Each post op is one of conv_chain::post_op_attr.
+at::Tensor convolution_depthwise_pointwise_run(
+    const at::Tensor& input,
+    const std::string& dw_post_op,
+    const std::string& pw_post_op,
+    const c10::intrusive_ptr<ConvolutionOpContext>& dw_op_context,
+    const c10::intrusive_ptr<ConvolutionOpContext>& pw_op_context);
+
+// Convolution followed by a max or average pooling, where the pooling reads
+// row tiles of the convolution output while they are in cache, see
+// ConvChain.h. pool is one of conv_chain::pool_algorithm.
+at::Tensor convolution_pool_run(
+    const at::Tensor& input,
+    const std::string& post_op,
+    const std::string& pool,
+    at::IntArrayRef kernel_size,
+    at::IntArrayRef stride,
+    at::IntArrayRef padding,
+    bool ceil_mode,
+    const c10::intrusive_ptr<ConvolutionOpContext>& op_context);
+
+// Out-variant used by the activation memory planner: writes the output into
+// the arena slice (plan_id, offset, sizes, strides). Falls back to a fresh
+// output if the runtime input does not produce the planned output size.
+at::Tensor convolution_run_out(
+    const at::Tensor& input,
+    const ideep::attr_t& attr,
+    int64_t plan_id,
+    int64_t offset,
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides,
+    const c10::intrusive_ptr<ConvolutionOpContext>& op_context);
+
+// Variant used by the concat elimination pass: writes the output into the
+// slice [start, start + length) along dim of the concat buffer, see
+// ConcatBuffer.h. The output is computed into a new tensor and copied if the
+// slice is not dense in the format of the output, and returned without being
+// copied if the runtime shape does not match the planned one.
+at::Tensor convolution_run_into(
+    const at::Tensor& input,
+    const ideep::attr_t& attr,
+    at::Tensor& buffer,
+    int64_t dim,
+    int64_t start,
+    int64_t length,
+    const c10::intrusive_ptr<ConvolutionOpContext>& op_context);
+
 ContextConvolution create(
     const at::Tensor& weight,
     const c10::optional<at::Tensor>& bias,
@@ -5,11 +5,17 @@
 #include <ATen/WrapDimUtilsMulti.h>
 #include <c10/util/Exception.h>
 #include <c10/util/Logging.h>
+#include <c10/util/hash.h>
 #include <torch/csrc/autograd/function.h>
 
+#include <array>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include <ideep.hpp>
+#include "Einsum.h"
 #include "Matmul.h"
 #include "ideep/IDeepConversions.h"
 
@@ -387,31 +393,136 @@ unsigned char einsum_index_to_label(uint8_t index) {
   return index < NUM_OF_LETTERS ? index + 'A' : index - NUM_OF_LETTERS + 'a';
 }
 
+// A view or reduction einsum_prepare applies to one operand. They only depend
+// on the equation and the operand sizes, so they are recorded once and
+// replayed by later calls.
+struct EinsumStep {
+  enum Kind { kUnsqueeze, kDiagonal, kPermute, kSqueeze, kSum };
+  Kind kind;
+  int64_t dim;
+  int64_t dim2 = 0;
+  std::vector<int64_t> perm = {};
+};
+
+Tensor apply_einsum_step(const Tensor& operand, const EinsumStep& step) {
+  switch (step.kind) {
+    case EinsumStep::kUnsqueeze:
+      return operand.unsqueeze(step.dim);
+    case EinsumStep::kDiagonal:
+      return operand.diagonal(0, step.dim, step.dim2).movedim(-1, step.dim);
+    case EinsumStep::kPermute:
+      return operand.permute(step.perm);
+    case EinsumStep::kSqueeze:
+      return operand.squeeze(step.dim);
+    case EinsumStep::kSum:
+      return operand.sum(step.dim);
+  }
+  return operand;
+}
+
+// Everything einsum_prepare derives from the equation for two operands.
+struct EinsumPairPlan {
+  std::vector<std::vector<EinsumStep>> steps;
+  bool has_zero_size_dim = false;
+  int64_t out_size = 0;
+  std::vector<std::size_t> dim_last_op;
+  std::vector<int64_t> sum_dims;
+  std::vector<std::vector<bool>> unsqueezed_dim_info;
+};
+
+// The pairwise contraction order for three or more operands. Each step
+// contracts operands i < j of the remaining ones with a two operand equation,
+// removes them and appends the result. An unsupported path is left to
+// at::einsum.
+struct EinsumPath {
+  struct Step {
+    std::size_t i;
+    std::size_t j;
+    std::string equation;
+  };
+  bool supported = false;
+  std::vector<Step> steps;
+};
+
+// Plans are keyed by the equation and the operand sizes. The strides are not
+// part of the key: every planned step is a view or a reduction, which is
+// valid for any strides, and the GEMM layout is decided per call.
+struct EinsumPlanKey {
+  std::string equation;
+  // the rank of every operand followed by its sizes
+  std::vector<int64_t> sizes;
+
+  bool operator==(const EinsumPlanKey& other) const {
+    return equation == other.equation && sizes == other.sizes;
+  }
+};
+
+struct EinsumPlanKeyHash {
+  std::size_t operator()(const EinsumPlanKey& key) const {
+    return c10::get_hash(key.equation, key.sizes);
+  }
+};
+
+EinsumPlanKey einsum_plan_key(
+    c10::string_view equation,
+    const c10::List<at::Tensor>& operands) {
+  EinsumPlanKey key{std::string(equation.data(), equation.size()), {}};
+  for (const at::Tensor& operand : operands) {
+    key.sizes.push_back(operand.dim());
+    key.sizes.insert(
+        key.sizes.end(), operand.sizes().begin(), operand.sizes().end());
+  }
+  return key;
+}
+
+template <typename Plan>
+class EinsumPlanCache {
+ public:
+  std::shared_ptr<const Plan> find(const EinsumPlanKey& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = plans_.find(key);
+    return it == plans_.end() ? nullptr : it->second;
+  }
+
+  void insert(EinsumPlanKey key, std::shared_ptr<const Plan> plan) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // dynamic shapes would grow the cache without bound, start over instead
+    if (plans_.size() >= kCapacity) {
+      plans_.clear();
+    }
+    plans_.emplace(std::move(key), std::move(plan));
+  }
+
+ private:
+  static constexpr std::size_t kCapacity = 1024;
+  std::mutex mutex_;
+  std::unordered_map<
+      EinsumPlanKey,
+      std::shared_ptr<const Plan>,
+      EinsumPlanKeyHash>
+      plans_;
+};
+
 } // namespace
 
-//! function: einsum_prepare
+//! function: einsum_plan_pair
 /*!
  *This function do the following preparation:
  *1) parse the einsum equation to get inputs/output info
  *2) unsqueeze and permute the inputs/output to have same dims. The dim order
  * of all inputs and output is same.
+ *Every view or reduction applied to the operands is recorded in the plan.
  *\param equation:  The subscripts for the Einstein summation.
  *more detials about equation can found:
  *https://pytorch.org/docs/stable/generated/torch.einsum.html
- *\param operands: The tensors to compute the Einstein summation of.
- *\return tuple<has_zero_size_dim, out_size, dim_last_op, sum_dims,
- *permuted_operands, unsqueezed_dim_info>
+ *\param operands: The two tensors to compute the Einstein summation of.
+ *\param permuted_operands: the operands after the recorded steps.
+ *\return the plan of the equation for the sizes of operands
  */
-std::tuple<
-    bool,
-    int64_t,
-    std::vector<std::size_t>,
-    std::vector<int64_t>,
-    std::vector<Tensor>,
-    std::vector<std::vector<bool>>>
-einsum_prepare(
+static std::shared_ptr<const EinsumPairPlan> einsum_plan_pair(
     c10::string_view equation,
-    const c10::List<at::Tensor>& operands) {
+    const c10::List<at::Tensor>& operands,
+    std::vector<Tensor>& permuted_operands) {
   // Code used to identify ELLIPSIS ("...")
   constexpr uint8_t ELLIPSIS = 52;
 
@@ -596,15 +707,24 @@ einsum_prepare(
     }
   }
 
+  auto plan = std::make_shared<EinsumPairPlan>();
+  plan->steps.resize(num_ops);
+  auto record = [&plan](
+                    std::size_t i, const Tensor& operand, EinsumStep step) {
+    plan->steps[i].push_back(std::move(step));
+    return apply_einsum_step(operand, plan->steps[i].back());
+  };
+
   // Here we unsqueeze missing dimensions to make all operands have the same
   // number of dimensions. We take diagonals for repeated labels within the
   // same operand. Finally we permute the operands to align dimensions as
   // per the perm_out_index we computed above.
-  std::vector<Tensor> permuted_operands;
+  permuted_operands.clear();
 
   // for the dim where size=1, should know whthere it is unsqueezed.
   // eg: (12,1,4,16) & (12,4,4,16)
-  auto unsqueezed_dim_info =
+  auto& unsqueezed_dim_info = plan->unsqueezed_dim_info;
+  unsqueezed_dim_info =
       std::vector<std::vector<bool>>(2, std::vector<bool>(perm_index, 0));
   for (const auto i : c10::irange(num_ops)) {
     std::vector<int64_t> perm_shape(perm_index, -1);
@@ -621,7 +741,7 @@ einsum_prepare(
             ell_num_dim - (original_sizes.size() - labels.size() + 1);
         for (const auto k : c10::irange(num_missing_dim)) {
           (void)k; // Suppress unused warning
-          operand = operand.unsqueeze(j);
+          operand = record(i, operand, {EinsumStep::kUnsqueeze, j});
         }
         for (const auto k : c10::irange(ell_num_dim)) {
           perm_shape[ell_index + k] = j++;
@@ -639,7 +759,7 @@ einsum_prepare(
             operand.size(j),
             " != ",
             operand.size(dim));
-        operand = operand.diagonal(0, dim, j).movedim(-1, dim);
+        operand = record(i, operand, {EinsumStep::kDiagonal, dim, j});
       } else {
         // Lookup output index for label
         label_dim[label] = j;
@@ -655,16 +775,18 @@ einsum_prepare(
     // Add dimensions for missing labels
     for (int64_t& index : perm_shape) {
       if (index == -1) {
-        operand = operand.unsqueeze(-1);
+        operand = record(i, operand, {EinsumStep::kUnsqueeze, -1});
         index = j++;
       }
     }
-    permuted_operands.push_back(operand.permute(perm_shape));
+    permuted_operands.push_back(
+        record(i, operand, {EinsumStep::kPermute, 0, 0, perm_shape}));
   }
 
   // Check if operands broadcast and keep track of last operand with
   // dimension size != 1 for optimizing reductions
-  std::vector<std::size_t> dim_last_op(perm_index, 0);
+  auto& dim_last_op = plan->dim_last_op;
+  dim_last_op.assign(perm_index, 0);
   bool has_zero_size_dim = false;
   for (const auto dim : c10::irange(perm_index)) {
     auto broadcast_size = permuted_operands[0].size(dim);
@@ -693,25 +815,30 @@ einsum_prepare(
   for (int64_t i = dim; i < perm_index; ++i, ++dim) {
     if (dim_last_op[i] == 0) {
       if (permuted_operands[0].size(dim) == 1) {
-        permuted_operands[0] = permuted_operands[0].squeeze(dim--);
+        permuted_operands[0] = record(
+            0, permuted_operands[0], {EinsumStep::kSqueeze, dim--});
       } else {
-        permuted_operands[0] = permuted_operands[0].sum(dim--);
+        permuted_operands[0] =
+            record(0, permuted_operands[0], {EinsumStep::kSum, dim--});
       }
     }
   }
 
   // we only process two operands, so the operands index is from [0, 1]
-  std::vector<int64_t> sum_dims;
+  auto& sum_dims = plan->sum_dims;
   // Sum out or squeeze dimensions that are size 1 for all later operands
   dim = out_size;
   for (int64_t j = dim; j < perm_index; ++j, ++dim) {
     if (dim_last_op[j] < 1) {
-      permuted_operands[1] = permuted_operands[1].squeeze(dim);
+      permuted_operands[1] =
+          record(1, permuted_operands[1], {EinsumStep::kSqueeze, dim});
       --dim;
     } else if (dim_last_op[j] == 1) {
       if (permuted_operands[0].size(dim) == 1) {
-        permuted_operands[1] = permuted_operands[1].sum(dim);
-        permuted_operands[0] = permuted_operands[0].squeeze(dim);
+        permuted_operands[1] =
+            record(1, permuted_operands[1], {EinsumStep::kSum, dim});
+        permuted_operands[0] =
+            record(0, permuted_operands[0], {EinsumStep::kSqueeze, dim});
         --dim;
       } else {
         sum_dims.push_back(dim);
@@ -719,13 +846,288 @@ einsum_prepare(
     }
   }
 
+  plan->has_zero_size_dim = has_zero_size_dim;
+  plan->out_size = out_size;
+  return plan;
+}
+
+//! function: einsum_prepare
+/*!
+ *Applies the plan of einsum_plan_pair to the operands. The plan is cached
+ *per equation and operand sizes, so repeated calls skip the parsing and only
+ *replay the recorded views.
+ *\param equation:  The subscripts for the Einstein summation.
+ *\param operands: The tensors to compute the Einstein summation of.
+ *\return tuple<has_zero_size_dim, out_size, dim_last_op, sum_dims,
+ *permuted_operands, unsqueezed_dim_info>
+ */
+std::tuple<
+    bool,
+    int64_t,
+    std::vector<std::size_t>,
+    std::vector<int64_t>,
+    std::vector<Tensor>,
+    std::vector<std::vector<bool>>>
+einsum_prepare(
+    c10::string_view equation,
+    const c10::List<at::Tensor>& operands) {
+  static EinsumPlanCache<EinsumPairPlan> plan_cache;
+  auto key = einsum_plan_key(equation, operands);
+  std::vector<Tensor> permuted_operands;
+  auto plan = plan_cache.find(key);
+  if (plan) {
+    for (const auto i : c10::irange(operands.size())) {
+      Tensor operand = operands[i];
+      for (const auto& step : plan->steps[i]) {
+        operand = apply_einsum_step(operand, step);
+      }
+      permuted_operands.push_back(operand);
+    }
+  } else {
+    plan = einsum_plan_pair(equation, operands, permuted_operands);
+    plan_cache.insert(std::move(key), plan);
+  }
   return std::make_tuple(
-      has_zero_size_dim,
-      out_size,
-      dim_last_op,
-      sum_dims,
+      plan->has_zero_size_dim,
+      plan->out_size,
+      plan->dim_last_op,
+      plan->sum_dims,
       permuted_operands,
-      unsqueezed_dim_info);
+      plan->unsqueezed_dim_info);
+}
+
+namespace {
+
+constexpr std::size_t kMaxExhaustiveOperands = 5;
+
+using LabelSizes = std::array<int64_t, 128>;
+
+double einsum_pair_cost(
+    const std::string& left,
+    const std::string& right,
+    const LabelSizes& label_size) {
+  double cost = 1;
+  for (const unsigned char label : left) {
+    cost *= label_size[label];
+  }
+  for (const unsigned char label : right) {
+    if (left.find(label) == std::string::npos) {
+      cost *= label_size[label];
+    }
+  }
+  return cost;
+}
+
+std::string einsum_pair_result(
+    const std::vector<std::string>& remaining,
+    std::size_t i,
+    std::size_t j,
+    const std::string& output) {
+  if (remaining.size() == 2) {
+    return output;
+  }
+  std::string result;
+  for (const char label : remaining[i] + remaining[j]) {
+    if (result.find(label) != std::string::npos) {
+      continue;
+    }
+    bool needed = output.find(label) != std::string::npos;
+    for (std::size_t k = 0; !needed && k < remaining.size(); k++) {
+      needed = k != i && k != j &&
+          remaining[k].find(label) != std::string::npos;
+    }
+    if (needed) {
+      result.push_back(label);
+    }
+  }
+  return result;
+}
+
+void einsum_contract_pair(
+    std::vector<std::string>& remaining,
+    std::size_t i,
+    std::size_t j,
+    const std::string& output,
+    std::vector<EinsumPath::Step>& steps) {
+  auto result = einsum_pair_result(remaining, i, j, output);
+  steps.push_back({i, j, remaining[i] + "," + remaining[j] + "->" + result});
+  remaining.erase(remaining.begin() + j);
+  remaining.erase(remaining.begin() + i);
+  remaining.push_back(result);
+}
+
+void einsum_search_path(
+    const std::vector<std::string>& remaining,
+    const std::string& output,
+    const LabelSizes& label_size,
+    double cost,
+    std::vector<EinsumPath::Step>& steps,
+    double& best_cost,
+    std::vector<EinsumPath::Step>& best_steps) {
+  if (cost >= best_cost) {
+    return;
+  }
+  if (remaining.size() == 1) {
+    best_cost = cost;
+    best_steps = steps;
+    return;
+  }
+  for (std::size_t i = 0; i < remaining.size(); i++) {
+    for (std::size_t j = i + 1; j < remaining.size(); j++) {
+      auto step_cost = einsum_pair_cost(remaining[i], remaining[j], label_size);
+      auto next = remaining;
+      einsum_contract_pair(next, i, j, output, steps);
+      einsum_search_path(
+          next,
+          output,
+          label_size,
+          cost + step_cost,
+          steps,
+          best_cost,
+          best_steps);
+      steps.pop_back();
+    }
+  }
+}
+
+//! function: einsum_plan_path
+/*!
+ * Picks the pairwise contraction order of three or more operands with the
+ * least multiply-adds, the product of the sizes of all labels of the two
+ * contracted operands. Up to kMaxExhaustiveOperands operands every order is
+ * tried, beyond that the cheapest pair is contracted greedily. A label is
+ * kept in an intermediate result only if the output or another remaining
+ * operand has it.
+ *
+ * Ellipses, implicit outputs, repeated labels within an operand and labels
+ * broadcast between operands are left to at::einsum.
+ */
+std::shared_ptr<const EinsumPath> einsum_plan_path(
+    c10::string_view equation,
+    const c10::List<at::Tensor>& operands) {
+  auto path = std::make_shared<EinsumPath>();
+  const auto arrow_pos = equation.find("->");
+  if (arrow_pos == std::string::npos) {
+    return path;
+  }
+  std::vector<std::string> inputs(1);
+  for (const unsigned char label : equation.substr(0, arrow_pos)) {
+    if (label == ',') {
+      inputs.emplace_back();
+    } else if (einsum_check_label(label)) {
+      inputs.back().push_back(label);
+    } else if (label != ' ') {
+      return path;
+    }
+  }
+  std::string output;
+  for (const unsigned char label : equation.substr(arrow_pos + 2)) {
+    if (einsum_check_label(label)) {
+      output.push_back(label);
+    } else if (label != ' ') {
+      return path;
+    }
+  }
+  if (inputs.size() != operands.size()) {
+    return path;
+  }
+
+  LabelSizes label_size;
+  label_size.fill(-1);
+  for (const auto i : c10::irange(inputs.size())) {
+    const at::Tensor& operand = operands[i];
+    if (static_cast<int64_t>(inputs[i].size()) != operand.dim()) {
+      return path;
+    }
+    for (const auto k : c10::irange(inputs[i].size())) {
+      const unsigned char label = inputs[i][k];
+      if (inputs[i].find(label) != k ||
+          (label_size[label] != -1 && label_size[label] != operand.size(k))) {
+        return path;
+      }
+      label_size[label] = operand.size(k);
+    }
+  }
+  for (const auto k : c10::irange(output.size())) {
+    const unsigned char label = output[k];
+    if (label_size[label] == -1 || output.find(label) != k) {
+      return path;
+    }
+  }
+
+  if (inputs.size() <= kMaxExhaustiveOperands) {
+    std::vector<EinsumPath::Step> steps;
+    double best_cost = std::numeric_limits<double>::infinity();
+    einsum_search_path(
+        inputs, output, label_size, 0, steps, best_cost, path->steps);
+  } else {
+    auto remaining = inputs;
+    while (remaining.size() > 1) {
+      std::size_t best_i = 0, best_j = 1;
+      double best_cost = std::numeric_limits<double>::infinity();
+      for (std::size_t i = 0; i < remaining.size(); i++) {
+        for (std::size_t j = i + 1; j < remaining.size(); j++) {
+          auto cost = einsum_pair_cost(remaining[i], remaining[j], label_size);
+          if (cost < best_cost) {
+            best_cost = cost;
+            best_i = i;
+            best_j = j;
+          }
+        }
+      }
+      einsum_contract_pair(remaining, best_i, best_j, output, path->steps);
+    }
+  }
+  path->supported = !path->steps.empty();
+  return path;
+}
+
+} // namespace
+
+//! function: einsum_contract
+/*!
+ * Contracts three or more operands pairwise in the order of einsum_plan_path,
+ * cached per equation and operand sizes. Every step is a two operand einsum,
+ * which runs as a batched GEMM, and the add of einsum_binary is fused into
+ * the last one.
+ *\param equation:  The subscripts for the Einstein summation.
+ *\param operands: The tensors to compute the Einstein summation of.
+ *\param add_arg: the other input of the binary add, may be undefined.
+ *\param alpha: the multiplier for add_arg.
+ */
+static at::Tensor einsum_contract(
+    c10::string_view equation,
+    const c10::List<at::Tensor>& operands,
+    const at::Tensor& add_arg,
+    const c10::Scalar& alpha) {
+  static EinsumPlanCache<EinsumPath> path_cache;
+  auto key = einsum_plan_key(equation, operands);
+  auto path = path_cache.find(key);
+  if (!path) {
+    path = einsum_plan_path(equation, operands);
+    path_cache.insert(std::move(key), path);
+  }
+
+  if (!path->supported) {
+    auto result = at::einsum(equation, operands.vec());
+    return add_arg.defined() ? result + alpha.to<float>() * add_arg : result;
+  }
+
+  std::vector<Tensor> remaining = operands.vec();
+  for (const auto k : c10::irange(path->steps.size())) {
+    const auto& step = path->steps[k];
+    Tensor left = remaining[step.i];
+    Tensor right = remaining[step.j];
+    remaining.erase(remaining.begin() + step.j);
+    remaining.erase(remaining.begin() + step.i);
+    if (k + 1 == path->steps.size() && add_arg.defined()) {
+      remaining.push_back(einsum_binary(
+          step.equation, c10::List<Tensor>({left, right}), add_arg, alpha));
+    } else {
+      remaining.push_back(at::einsum(step.equation, {left, right}));
+    }
+  }
+  return remaining[0];
 }
 
 //! function: einsum_binary
@@ -744,6 +1146,9 @@ at::Tensor einsum_binary(
     const at::Tensor& add_arg,
     const c10::Scalar& alpha) {
   RECORD_FUNCTION("dil_einsum_binary", c10::ArrayRef<c10::IValue>({}));
+  if (operands.size() > 2) {
+    return einsum_contract(equation, operands, add_arg, alpha);
+  }
   auto prepare_res = einsum_prepare(equation, operands);
   bool has_zero_size_dim = std::get<0>(prepare_res);
   auto out_size = std::get<1>(prepare_res);
@@ -788,5 +1193,16 @@ at::Tensor einsum_binary(
   return result;
 }
 
+//! function: einsum_pairwise
+/*!
+ * einsum of three or more operands contracted in a cost-optimal order.
+ */
+at::Tensor einsum_pairwise(
+    c10::string_view equation,
+    const c10::List<at::Tensor>& operands) {
+  RECORD_FUNCTION("dil_einsum_pairwise", c10::ArrayRef<c10::IValue>({}));
+  return einsum_contract(equation, operands, at::Tensor(), 1);
+}
+
 } // namespace cpu
 } // namespace torch_ipex
@@ -0,0 +1,111 @@
+#include "GatedMlpPacked.h"
+#include <ATen/record_function.h>
+#include "LinearPacked.h"
+#include "aten/GatedMlp.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace gated_mlp {
+
+namespace {
+
+// Rows of the input per GEMM, so that the [rows, 2 * hidden] intermediate is
+// consumed by the epilogue while it is still in cache, but with at least
+// kGatedMlpMinRows rows to keep the GEMM efficient
+constexpr int64_t kGatedMlpChunkBytes = 1024 * 1024;
+constexpr int64_t kGatedMlpMinRows = 64;
+
+} // namespace
+
+c10::intrusive_ptr<GatedMlpOpContext> createGatedMlpPrePackOpContext(
+    at::Tensor&& gate_weight,
+    c10::optional<at::Tensor>&& gate_bias,
+    at::Tensor&& up_weight,
+    c10::optional<at::Tensor>&& up_bias,
+    std::string&& act) {
+  RECORD_FUNCTION(
+      "ipex_prepack::createGatedMlpPrePackOpContext",
+      c10::ArrayRef<c10::IValue>({}));
+
+  return IpexGatedMlpOpContext::create_context(
+      std::move(gate_weight),
+      std::move(gate_bias),
+      std::move(up_weight),
+      std::move(up_bias),
+      std::move(act));
+}
+
+at::Tensor gated_mlp_run(
+    const at::Tensor& input,
+    const c10::intrusive_ptr<GatedMlpOpContext>& op_context) {
+  RECORD_FUNCTION(
+      "ipex_prepack::gated_mlp_run", c10::ArrayRef<c10::IValue>({}));
+
+  return op_context->run(input);
+}
+
+ContextGatedMlp create(
+    const at::Tensor& gate_weight,
+    const c10::optional<at::Tensor>& gate_bias,
+    const at::Tensor& up_weight,
+    const c10::optional<at::Tensor>& up_bias,
+    const std::string& act) {
+  TORCH_CHECK(
+      gate_weight.dim() == 2 && gate_weight.sizes() == up_weight.sizes(),
+      "Gated MLP expects 2-D gate and up weights of the same shape");
+  auto hidden_features = gate_weight.size(0);
+  auto weight = gated_mlp_interleave(gate_weight, up_weight);
+  // a missing bias of one of the projections is a zero bias
+  bool has_gate_bias = gate_bias.has_value() && gate_bias.value().defined();
+  bool has_up_bias = up_bias.has_value() && up_bias.value().defined();
+  c10::optional<at::Tensor> bias = c10::nullopt;
+  if (has_gate_bias || has_up_bias) {
+    auto zeros = at::zeros({hidden_features}, gate_weight.options());
+    bias = gated_mlp_interleave(
+        has_gate_bias ? gate_bias.value() : zeros,
+        has_up_bias ? up_bias.value() : zeros);
+  }
+  return ContextGatedMlp{
+      linear::create(weight, bias, c10::nullopt),
+      gated_mlp_act(act),
+      hidden_features,
+  };
+}
+
+at::Tensor run(const ContextGatedMlp& context, const at::Tensor& input) {
+  TORCH_CHECK(
+      input.dim() >= 1, "Gated MLP expects an input with at least 1 dim");
+  auto hidden_features = context.hidden_features_;
+  auto input_ = input.contiguous();
+  auto input_2d = input_.view({-1, input_.size(-1)});
+  auto M = input_2d.size(0);
+  std::vector<int64_t> output_size(
+      input_.sizes().begin(), input_.sizes().end() - 1);
+  output_size.push_back(hidden_features);
+  auto output = at::empty(output_size, input_.options());
+  auto output_2d = output.view({M, hidden_features});
+
+  // one GEMM computes the interleaved gate and up projections of a chunk of
+  // rows, then the epilogue writes act(gate) * up
+  auto rows = std::max(
+      kGatedMlpMinRows,
+      kGatedMlpChunkBytes / (2 * hidden_features * input_.element_size()));
+  for (int64_t start = 0; start < M; start += rows) {
+    auto chunk = std::min(rows, M - start);
+    auto gate_up = linear::run(
+        context.linear_, input_2d.narrow(0, start, chunk), ideep::attr_t());
+    auto output_chunk = output_2d.narrow(0, start, chunk);
+    gated_mlp_epilogue(gate_up, context.act_, output_chunk);
+  }
+  return output;
+}
+
+at::Tensor unpack(ContextGatedMlp& context, const at::Tensor& tensor) {
+  return linear::unpack(context.linear_, tensor);
+}
+
+} // namespace gated_mlp
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
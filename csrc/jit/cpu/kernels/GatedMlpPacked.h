@@ -0,0 +1,38 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include "ContextGatedMlp.h"
+#include "OpContext.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace gated_mlp {
+
+c10::intrusive_ptr<GatedMlpOpContext> createGatedMlpPrePackOpContext(
+    at::Tensor&& gate_weight,
+    c10::optional<at::Tensor>&& gate_bias,
+    at::Tensor&& up_weight,
+    c10::optional<at::Tensor>&& up_bias,
+    std::string&& act);
+
+at::Tensor gated_mlp_run(
+    const at::Tensor& input,
+    const c10::intrusive_ptr<GatedMlpOpContext>& op_context);
+
+ContextGatedMlp create(
+    const at::Tensor& gate_weight,
+    const c10::optional<at::Tensor>& gate_bias,
+    const at::Tensor& up_weight,
+    const c10::optional<at::Tensor>& up_bias,
+    const std::string& act);
+
+at::Tensor run(const ContextGatedMlp& context, const at::Tensor& input);
+
+// Unpack the packed interleaved weight to the interleaved public weight
+at::Tensor unpack(ContextGatedMlp& context, const at::Tensor& tensor);
+
+} // namespace gated_mlp
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,272 @@
+#include "GroupedLinear.h"
+
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec/functional.h>
+#include <ATen/cpu/vec/vec.h>
+#include <ATen/record_function.h>
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "mkl.h"
+
+namespace torch_ipex {
+namespace cpu {
+
+namespace {
+
+enum class GroupPostOp { None, Relu, Sigmoid, Tanh, Gelu };
+
+GroupPostOp parse_post_op(const std::string& name) {
+  if (name.empty()) {
+    return GroupPostOp::None;
+  } else if (name == "relu") {
+    return GroupPostOp::Relu;
+  } else if (name == "sigmoid") {
+    return GroupPostOp::Sigmoid;
+  } else if (name == "tanh") {
+    return GroupPostOp::Tanh;
+  } else if (name == "gelu") {
+    return GroupPostOp::Gelu;
+  }
+  TORCH_CHECK(false, "ipex::grouped_linear: unsupported post op ", name);
+}
+
+at::Tensor apply_post_op(const at::Tensor& input, GroupPostOp op) {
+  switch (op) {
+    case GroupPostOp::Relu:
+      return at::relu(input);
+    case GroupPostOp::Sigmoid:
+      return at::sigmoid(input);
+    case GroupPostOp::Tanh:
+      return at::tanh(input);
+    case GroupPostOp::Gelu:
+      return at::gelu(input);
+    default:
+      return input;
+  }
+}
+
+template <GroupPostOp op>
+inline at::vec::Vectorized<float> post_op_vec(at::vec::Vectorized<float> x) {
+  using Vec = at::vec::Vectorized<float>;
+  if (op == GroupPostOp::Relu) {
+    return at::vec::maximum(x, Vec(0.f));
+  } else if (op == GroupPostOp::Sigmoid) {
+    return Vec(1.f) / (Vec(1.f) + x.neg().exp());
+  } else if (op == GroupPostOp::Tanh) {
+    return x.tanh();
+  } else if (op == GroupPostOp::Gelu) {
+    return x * Vec(0.5f) * (Vec(1.f) + (x * Vec(M_SQRT1_2)).erf());
+  }
+  return x;
+}
+
+template <GroupPostOp op>
+inline void bias_post_op_row(float* out, const float* bias, int64_t size) {
+  using Vec = at::vec::Vectorized<float>;
+  if (bias != nullptr) {
+    at::vec::map2(
+        [](Vec x, Vec b) { return post_op_vec<op>(x + b); },
+        out,
+        out,
+        bias,
+        size);
+  } else {
+    at::vec::map([](Vec x) { return post_op_vec<op>(x); }, out, out, size);
+  }
+}
+
+void apply_bias_post_op(
+    GroupPostOp op,
+    float* out,
+    const float* bias,
+    int64_t size) {
+  switch (op) {
+    case GroupPostOp::Relu:
+      bias_post_op_row<GroupPostOp::Relu>(out, bias, size);
+      break;
+    case GroupPostOp::Sigmoid:
+      bias_post_op_row<GroupPostOp::Sigmoid>(out, bias, size);
+      break;
+    case GroupPostOp::Tanh:
+      bias_post_op_row<GroupPostOp::Tanh>(out, bias, size);
+      break;
+    case GroupPostOp::Gelu:
+      bias_post_op_row<GroupPostOp::Gelu>(out, bias, size);
+      break;
+    default:
+      if (bias != nullptr) {
+        bias_post_op_row<GroupPostOp::None>(out, bias, size);
+      }
+  }
+}
+
+} // namespace
+
+/**
+ * Grouped linear kernel for independent linears.
+ *
+ * All the GEMMs are issued through one cblas_sgemm_batch call with one MKL
+ * group per linear, so that MKL can spread the small GEMMs over all cores
+ * instead of running them one after another. Bias and post ops are applied
+ * afterwards in one parallel region over the rows of all the groups.
+ *
+ * Falls back to at::linear per group for non-FP32 or empty (K == 0) inputs.
+ **/
+std::vector<at::Tensor> dil_grouped_linear(
+    const std::vector<at::Tensor>& inputs,
+    const std::vector<at::Tensor>& weights,
+    const std::vector<c10::optional<at::Tensor>>& biases,
+    const std::vector<std::string>& post_ops) {
+  RECORD_FUNCTION("dil_grouped_linear", c10::ArrayRef<c10::IValue>({}));
+
+  const auto group_count = inputs.size();
+  TORCH_CHECK(
+      weights.size() == group_count && biases.size() == group_count &&
+          post_ops.size() == group_count,
+      "ipex::grouped_linear: expected the same number of inputs, weights, "
+      "biases and post ops");
+
+  std::vector<GroupPostOp> ops;
+  bool use_mkl = true;
+  for (size_t g = 0; g < group_count; g++) {
+    ops.push_back(parse_post_op(post_ops[g]));
+    const auto& input = inputs[g];
+    const auto& weight = weights[g];
+    TORCH_CHECK(
+        input.dim() >= 1 && weight.dim() == 2 &&
+            input.size(-1) == weight.size(1),
+        "ipex::grouped_linear: shape mismatch in group ",
+        g);
+    use_mkl = use_mkl && input.scalar_type() == at::kFloat &&
+        weight.scalar_type() == at::kFloat && weight.size(1) > 0 &&
+        (!biases[g].has_value() ||
+         biases[g].value().scalar_type() == at::kFloat);
+  }
+
+  std::vector<at::Tensor> outputs;
+  if (!use_mkl) {
+    for (size_t g = 0; g < group_count; g++) {
+      outputs.push_back(apply_post_op(
+          at::linear(inputs[g], weights[g], biases[g]), ops[g]));
+    }
+    return outputs;
+  }
+
+  // per MKL group arguments, empty linears are not passed to MKL
+  std::vector<at::Tensor> inputs_, weights_, biases_;
+  std::vector<MKL_INT> m, n, k, lda, ldb, ldc, size_per_grp;
+  std::vector<CBLAS_TRANSPOSE> transA, transB;
+  std::vector<float> alpha, beta;
+  std::vector<const float*> a_array, b_array, bias_array;
+  std::vector<float*> c_array;
+  std::vector<GroupPostOp> group_ops;
+  // row_offsets[i] is the first epilogue row of MKL group i
+  std::vector<int64_t> row_offsets = {0};
+  bool need_epilogue = false;
+
+  for (size_t g = 0; g < group_count; g++) {
+    auto input = inputs[g].contiguous();
+    auto weight = weights[g].contiguous();
+    auto output_size = input.sizes().vec();
+    output_size.back() = weight.size(0);
+    auto output = at::empty(output_size, input.options());
+    outputs.push_back(output);
+    if (output.numel() == 0) {
+      continue;
+    }
+
+    const int64_t K = weight.size(1);
+    const int64_t N = weight.size(0);
+    const int64_t M = input.numel() / K;
+    m.push_back(M);
+    n.push_back(N);
+    k.push_back(K);
+    lda.push_back(K);
+    ldb.push_back(K);
+    ldc.push_back(N);
+    transA.push_back(CblasNoTrans);
+    // weight is [N, K], the GEMM computes input * weight^T
+    transB.push_back(CblasTrans);
+    alpha.push_back(1.f);
+    beta.push_back(0.f);
+    size_per_grp.push_back(1);
+    a_array.push_back(input.data_ptr<float>());
+    b_array.push_back(weight.data_ptr<float>());
+    c_array.push_back(output.data_ptr<float>());
+
+    const float* bias_ptr = nullptr;
+    if (biases[g].has_value() && biases[g].value().defined()) {
+      auto bias = biases[g].value().contiguous();
+      TORCH_CHECK(
+          bias.numel() == N,
+          "ipex::grouped_linear: bias size mismatch in group ",
+          g);
+      bias_ptr = bias.data_ptr<float>();
+      biases_.push_back(bias);
+    }
+    bias_array.push_back(bias_ptr);
+    group_ops.push_back(ops[g]);
+    need_epilogue =
+        need_epilogue || bias_ptr != nullptr || ops[g] != GroupPostOp::None;
+    row_offsets.push_back(row_offsets.back() + M);
+    // keep the contiguous copies alive until the GEMMs are done
+    inputs_.push_back(input);
+    weights_.push_back(weight);
+  }
+
+  const auto mkl_group_count = m.size();
+  if (mkl_group_count == 0) {
+    return outputs;
+  }
+
+  cblas_sgemm_batch(
+      CblasRowMajor,
+      transA.data(),
+      transB.data(),
+      m.data(),
+      n.data(),
+      k.data(),
+      alpha.data(),
+      a_array.data(),
+      lda.data(),
+      b_array.data(),
+      ldb.data(),
+      beta.data(),
+      c_array.data(),
+      ldc.data(),
+      static_cast<MKL_INT>(mkl_group_count),
+      size_per_grp.data());
+
+  if (!need_epilogue) {
+    return outputs;
+  }
+
+  const int64_t total_rows = row_offsets.back();
+  const int64_t max_n = *std::max_element(n.begin(), n.end());
+  const int64_t grain_size =
+      std::max<int64_t>(1, at::internal::GRAIN_SIZE / max_n);
+  at::parallel_for(0, total_rows, grain_size, [&](int64_t begin, int64_t end) {
+    // find the group of the first row, the following rows walk forward
+    int64_t grp =
+        std::upper_bound(row_offsets.begin(), row_offsets.end(), begin) -
+        row_offsets.begin() - 1;
+    for (int64_t row = begin; row < end; row++) {
+      while (row >= row_offsets[grp + 1]) {
+        grp++;
+      }
+      if (bias_array[grp] == nullptr && group_ops[grp] == GroupPostOp::None) {
+        continue;
+      }
+      float* out = c_array[grp] + (row - row_offsets[grp]) * n[grp];
+      apply_bias_post_op(group_ops[grp], out, bias_array[grp], n[grp]);
+    }
+  });
+  return outputs;
+}
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+
+#include <torch/csrc/jit/runtime/custom_operator.h>
+
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace jit {
+
+// XXX: PyTorch does not support nesting namespace
+// And the alias analysis is not working for namespace other than aten ...
+// So we fake some op namespaces to workaround that.
+namespace ipex {
+static auto grouped_linear = Symbol::fromQualString("ipex::grouped_linear");
+
+} // namespace ipex
+
+} // namespace jit
+} // namespace torch
+
+namespace torch_ipex {
+namespace cpu {
+
+// Runs N independent linears, each with its own input, weight and optional
+// bias, as one grouped GEMM followed by a parallel epilogue that adds the
+// bias and applies the per-group post op ("", "relu", "sigmoid", "tanh" or
+// "gelu").
+std::vector<at::Tensor> dil_grouped_linear(
+    const std::vector<at::Tensor>& inputs,
+    const std::vector<at::Tensor>& weights,
+    const std::vector<c10::optional<at::Tensor>>& biases,
+    const std::vector<std::string>& post_ops);
+
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,91 @@
+#include "LinearDynamicQuantPacked.h"
+#include <ATen/record_function.h>
+#include "aten/DynamicQuantLinear.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace dynamic_quant_linear {
+
+c10::intrusive_ptr<DynamicQuantLinearOpContext>
+createDynamicQuantLinearPrePackOpContext(
+    at::Tensor&& weight,
+    c10::optional<at::Tensor>&& bias,
+    bool per_channel_weight,
+    bool per_token) {
+  RECORD_FUNCTION(
+      "ipex_prepack::createDynamicQuantLinearPrePackOpContext",
+      c10::ArrayRef<c10::IValue>({}));
+
+  return IpexDynamicQuantLinearOpContext::create_context(
+      std::move(weight), std::move(bias), per_channel_weight, per_token);
+}
+
+at::Tensor dynamic_quant_linear_run(
+    const at::Tensor& input,
+    const std::string& post_op,
+    c10::intrusive_ptr<DynamicQuantLinearOpContext> op_context) {
+  RECORD_FUNCTION(
+      "ipex_prepack::dynamic_quant_linear_run",
+      c10::ArrayRef<c10::IValue>({}));
+
+  return op_context->run(input, dynamic_quant_post_op(post_op));
+}
+
+ContextLinearDynamicQuant create(
+    at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias,
+    bool per_channel_weight,
+    bool per_token) {
+  auto out_features = weight.size(0);
+  auto in_features = weight.size(1);
+  auto packed = dynamic_quant_linear_pack_weight(weight, per_channel_weight);
+  // the bias is applied in FP32 by the kernel epilogue
+  c10::optional<at::Tensor> bias_ = c10::nullopt;
+  if (bias.has_value() && bias.value().defined()) {
+    bias_ = bias.value().to(at::kFloat).contiguous();
+  }
+  return ContextLinearDynamicQuant{
+      std::move(std::get<0>(packed)),
+      std::move(std::get<1>(packed)),
+      std::move(std::get<2>(packed)),
+      std::move(bias_),
+      per_channel_weight,
+      per_token,
+      in_features,
+      out_features,
+  };
+}
+
+at::Tensor run(
+    ContextLinearDynamicQuant& context,
+    const at::Tensor& input,
+    DynamicQuantPostOp post_op) {
+  TORCH_CHECK(
+      input.dim() >= 1 && input.size(-1) == context.in_features_,
+      "Check the shapes of mat1 and mat2, they cannot be multiplied!");
+  c10::MaybeOwned<at::Tensor> bias_maybe_owned =
+      at::borrow_from_optional_tensor(context.bias_);
+  const at::Tensor& bias = *bias_maybe_owned;
+  return dynamic_quant_linear_kernel(
+      input,
+      context.qweight_,
+      context.scales_,
+      context.compensation_,
+      bias,
+      context.out_features_,
+      context.per_token_,
+      post_op);
+}
+
+at::Tensor unpack(
+    ContextLinearDynamicQuant& context,
+    const at::Tensor& tensor) {
+  return dynamic_quant_linear_unpack_weight(
+      tensor, context.scales_, context.out_features_, context.in_features_);
+}
+
+} // namespace dynamic_quant_linear
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include "ContextLinearDynamicQuant.h"
+#include "OpContext.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace dynamic_quant_linear {
+
+c10::intrusive_ptr<DynamicQuantLinearOpContext>
+createDynamicQuantLinearPrePackOpContext(
+    at::Tensor&& weight,
+    c10::optional<at::Tensor>&& bias,
+    bool per_channel_weight,
+    bool per_token);
+
+at::Tensor dynamic_quant_linear_run(
+    const at::Tensor& input,
+    const std::string& post_op,
+    c10::intrusive_ptr<DynamicQuantLinearOpContext> op_context);
+
+ContextLinearDynamicQuant create(
+    at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias,
+    bool per_channel_weight,
+    bool per_token);
+
+at::Tensor run(
+    ContextLinearDynamicQuant& context,
+    const at::Tensor& input,
+    DynamicQuantPostOp post_op);
+
+at::Tensor unpack(ContextLinearDynamicQuant& context, const at::Tensor& tensor);
+
+} // namespace dynamic_quant_linear
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
@@ -1,8 +1,11 @@
 #include "LinearPacked.h"
 #include <ideep.hpp>
+#include "ActivationArena.h"
+#include "ConcatBuffer.h"
 #include "aten/Linear.h"
 #include "aten/WeightPack.h"
 #include "ideep/IDeepConversions.h"
+#include "runtime/NumaAllocator.h"
 
 namespace torch_ipex {
 namespace cpu {
@@ -169,6 +172,54 @@ at::Tensor linear_add_relu_run(
       ideep::attr_t::residual(scale).set_fpmath_mode(torch_ipex::fpmath_mode));
 }
 
+at::Tensor linear_run_out(
+    const at::Tensor& input,
+    const ideep::attr_t& attr,
+    int64_t plan_id,
+    int64_t offset,
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides,
+    const c10::intrusive_ptr<LinearOpContext>& op_context) {
+  RECORD_FUNCTION(
+      "ipex_prepack::linear_run_out", c10::ArrayRef<c10::IValue>({}));
+  auto output_size = input.sizes().vec();
+  output_size.back() = op_context->get_context().weight_packed_.get_dim(0);
+  if (output_size != sizes) {
+    arena::record_memory_plan_fallback(plan_id);
+    return op_context->run(input, attr);
+  }
+  auto output =
+      arena::arena_slice(plan_id, offset, sizes, strides, input.options());
+  return op_context->run(input, output, attr);
+}
+
+at::Tensor linear_run_into(
+    const at::Tensor& input,
+    const ideep::attr_t& attr,
+    at::Tensor& buffer,
+    int64_t dim,
+    int64_t start,
+    int64_t length,
+    const c10::intrusive_ptr<LinearOpContext>& op_context) {
+  RECORD_FUNCTION(
+      "ipex_prepack::linear_run_into", c10::ArrayRef<c10::IValue>({}));
+  auto output_sizes = input.sizes().vec();
+  output_sizes.back() = op_context->get_context().weight_packed_.get_dim(0);
+  auto slice = concat::concat_slice(
+      buffer, dim, start, length, output_sizes, input.scalar_type());
+  if (!slice.defined()) {
+    return op_context->run(input, attr);
+  }
+  // the output of inner product is written in place only if it is
+  // contiguous, i.e. a row slice or a slice of a single row
+  if (slice.is_contiguous()) {
+    auto output = slice;
+    op_context->run(input, output, attr);
+    return concat::copy_to_concat_slice(output, slice);
+  }
+  return concat::copy_to_concat_slice(op_context->run(input, attr), slice);
+}
+
 ContextLinear create(
     const at::Tensor& weight,
     const c10::optional<at::Tensor>& bias,
@@ -188,7 +239,10 @@ ContextLinear create(
       input_size,
       /* weight dtype */ dtype,
       /* src dtype */ dtype);
-  auto at_weight = empty_aten_tensor_from_desc(packed_desc, weight.options());
+  auto at_weight = empty_aten_tensor_from_desc(
+      packed_desc,
+      weight.options(),
+      torch_ipex::runtime::is_numa_weight_allocation_enabled());
   if (ideep::data_type::f32 == dtype) {
     packed_weight.init(packed_desc, at_weight.template data_ptr<float>());
   } else if (ideep::data_type::bf16 == dtype) {
@@ -77,6 +77,27 @@ at::Tensor linear_add_relu_run(
     const c10::optional<at::Scalar>& alpha,
     const c10::intrusive_ptr<LinearOpContext>& op_context);
 
+// Out-variant used by the activation memory planner, see
+// convolution_run_out.
+at::Tensor linear_run_out(
+    const at::Tensor& input,
+    const ideep::attr_t& attr,
+    int64_t plan_id,
+    int64_t offset,
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides,
+    const c10::intrusive_ptr<LinearOpContext>& op_context);
+
+// Variant used by the concat elimination pass, see convolution_run_into.
+at::Tensor linear_run_into(
+    const at::Tensor& input,
+    const ideep::attr_t& attr,
+    at::Tensor& buffer,
+    int64_t dim,
+    int64_t start,
+    int64_t length,
+    const c10::intrusive_ptr<LinearOpContext>& op_context);
+
 ContextLinear create(
     const at::Tensor& weight,
     const c10::optional<at::Tensor>& bias,
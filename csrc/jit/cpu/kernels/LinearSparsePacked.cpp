@@ -0,0 +1,84 @@
+#include "LinearSparsePacked.h"
+#include <ATen/record_function.h>
+#include "aten/SparseLinear.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace sparse_linear {
+
+c10::intrusive_ptr<SparseLinearOpContext> createSparseLinearPrePackOpContext(
+    at::Tensor&& weight,
+    c10::optional<at::Tensor>&& bias) {
+  RECORD_FUNCTION(
+      "ipex_prepack::createSparseLinearPrePackOpContext",
+      c10::ArrayRef<c10::IValue>({}));
+
+  return IpexSparseLinearOpContext::create_context(
+      std::move(weight), std::move(bias));
+}
+
+at::Tensor sparse_linear_run(
+    const at::Tensor& input,
+    const std::string& post_op,
+    c10::intrusive_ptr<SparseLinearOpContext> op_context) {
+  RECORD_FUNCTION(
+      "ipex_prepack::sparse_linear_run", c10::ArrayRef<c10::IValue>({}));
+
+  return op_context->run(input, sparse_linear_post_op(post_op));
+}
+
+ContextLinearSparse create(
+    at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias) {
+  auto out_features = weight.size(0);
+  auto in_features = weight.size(1);
+  auto packed = sparse_linear_pack_weight(weight);
+  // the bias is applied in FP32 by the kernel epilogue
+  c10::optional<at::Tensor> bias_ = c10::nullopt;
+  if (bias.has_value() && bias.value().defined()) {
+    bias_ = bias.value().to(at::kFloat).contiguous();
+  }
+  return ContextLinearSparse{
+      std::move(std::get<0>(packed)),
+      std::move(std::get<1>(packed)),
+      std::move(std::get<2>(packed)),
+      std::move(bias_),
+      in_features,
+      out_features,
+  };
+}
+
+at::Tensor run(
+    ContextLinearSparse& context,
+    const at::Tensor& input,
+    SparseLinearPostOp post_op) {
+  TORCH_CHECK(
+      input.dim() >= 1 && input.size(-1) == context.in_features_,
+      "Check the shapes of mat1 and mat2, they cannot be multiplied!");
+  c10::MaybeOwned<at::Tensor> bias_maybe_owned =
+      at::borrow_from_optional_tensor(context.bias_);
+  const at::Tensor& bias = *bias_maybe_owned;
+  return sparse_linear_kernel(
+      input,
+      context.values_,
+      context.col_index_,
+      context.row_ptr_,
+      bias,
+      context.out_features_,
+      post_op);
+}
+
+at::Tensor unpack(ContextLinearSparse& context, const at::Tensor& tensor) {
+  return sparse_linear_unpack_weight(
+      tensor,
+      context.col_index_,
+      context.row_ptr_,
+      context.out_features_,
+      context.in_features_);
+}
+
+} // namespace sparse_linear
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include "ContextLinearSparse.h"
+#include "OpContext.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace sparse_linear {
+
+c10::intrusive_ptr<SparseLinearOpContext> createSparseLinearPrePackOpContext(
+    at::Tensor&& weight,
+    c10::optional<at::Tensor>&& bias);
+
+at::Tensor sparse_linear_run(
+    const at::Tensor& input,
+    const std::string& post_op,
+    c10::intrusive_ptr<SparseLinearOpContext> op_context);
+
+ContextLinearSparse create(
+    at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias);
+
+at::Tensor run(
+    ContextLinearSparse& context,
+    const at::Tensor& input,
+    SparseLinearPostOp post_op);
+
+at::Tensor unpack(ContextLinearSparse& context, const at::Tensor& tensor);
+
+} // namespace sparse_linear
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
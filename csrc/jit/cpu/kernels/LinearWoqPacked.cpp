@@ -0,0 +1,86 @@
+#include "LinearWoqPacked.h"
+#include <ATen/record_function.h>
+#include "aten/WoqLinear.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace woq_linear {
+
+c10::intrusive_ptr<WoqLinearOpContext> createWoqLinearPrePackOpContext(
+    at::Tensor&& weight,
+    c10::optional<at::Tensor>&& bias,
+    at::ScalarType weight_dtype,
+    int64_t group_size) {
+  RECORD_FUNCTION(
+      "ipex_prepack::createWoqLinearPrePackOpContext",
+      c10::ArrayRef<c10::IValue>({}));
+
+  return IpexWoqLinearOpContext::create_context(
+      std::move(weight), std::move(bias), weight_dtype, group_size);
+}
+
+at::Tensor woq_linear_run(
+    const at::Tensor& input,
+    c10::intrusive_ptr<WoqLinearOpContext> op_context) {
+  RECORD_FUNCTION(
+      "ipex_prepack::woq_linear_run", c10::ArrayRef<c10::IValue>({}));
+
+  return op_context->run(input);
+}
+
+ContextLinearWoq create(
+    at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias,
+    at::ScalarType weight_dtype,
+    int64_t group_size) {
+  auto out_features = weight.size(0);
+  auto in_features = weight.size(1);
+  auto packed = woq_linear_pack_weight(weight, weight_dtype, group_size);
+  // the bias is applied in FP32 by the kernel epilogue
+  c10::optional<at::Tensor> bias_ = c10::nullopt;
+  if (bias.has_value() && bias.value().defined()) {
+    bias_ = bias.value().to(at::kFloat).contiguous();
+  }
+  return ContextLinearWoq{
+      std::move(std::get<0>(packed)),
+      std::move(std::get<1>(packed)),
+      std::move(bias_),
+      weight_dtype,
+      group_size,
+      in_features,
+      out_features,
+  };
+}
+
+at::Tensor run(ContextLinearWoq& context, const at::Tensor& input) {
+  TORCH_CHECK(
+      input.dim() >= 1 && input.size(-1) == context.in_features_,
+      "Check the shapes of mat1 and mat2, they cannot be multiplied!");
+  c10::MaybeOwned<at::Tensor> bias_maybe_owned =
+      at::borrow_from_optional_tensor(context.bias_);
+  const at::Tensor& bias = *bias_maybe_owned;
+  return woq_linear_kernel(
+      input,
+      context.qweight_,
+      context.scales_,
+      bias,
+      context.weight_dtype_,
+      context.out_features_,
+      context.group_size_);
+}
+
+at::Tensor unpack(ContextLinearWoq& context, const at::Tensor& tensor) {
+  return woq_linear_unpack_weight(
+      tensor,
+      context.scales_,
+      context.weight_dtype_,
+      context.out_features_,
+      context.in_features_,
+      context.group_size_);
+}
+
+} // namespace woq_linear
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
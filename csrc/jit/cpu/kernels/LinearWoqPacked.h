@@ -0,0 +1,35 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include "ContextLinearWoq.h"
+#include "OpContext.h"
+
+namespace torch_ipex {
+namespace cpu {
+namespace detail {
+namespace woq_linear {
+
+c10::intrusive_ptr<WoqLinearOpContext> createWoqLinearPrePackOpContext(
+    at::Tensor&& weight,
+    c10::optional<at::Tensor>&& bias,
+    at::ScalarType weight_dtype,
+    int64_t group_size);
+
+at::Tensor woq_linear_run(
+    const at::Tensor& input,
+    c10::intrusive_ptr<WoqLinearOpContext> op_context);
+
+ContextLinearWoq create(
+    at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias,
+    at::ScalarType weight_dtype,
+    int64_t group_size);
+
+at::Tensor run(ContextLinearWoq& context, const at::Tensor& input);
+
+at::Tensor unpack(ContextLinearWoq& context, const at::Tensor& tensor);
+
+} // namespace woq_linear
+} // namespace detail
+} // namespace cpu
+} // namespace torch_ipex
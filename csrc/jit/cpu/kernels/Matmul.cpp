@@ -1,4 +1,5 @@
 #include "Matmul.h"
+#include "ActivationArena.h"
 
 #include <ATen/Context.h>
 #include <ATen/InferSize.h>
@@ -298,5 +299,28 @@ at::Tensor dil_bmm_add(
   }
 }
 
+at::Tensor dil_bmm_out(
+    const at::Tensor& batch1,
+    const at::Tensor& batch2,
+    int64_t plan_id,
+    int64_t offset,
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides) {
+#if defined(IPEX_PROFILE_OP)
+  RECORD_FUNCTION("dil_bmm_out", c10::ArrayRef<c10::IValue>({}));
+#endif
+  if (batch1.dim() != 3 || batch2.dim() != 3 ||
+      batch1.scalar_type() != batch2.scalar_type() ||
+      sizes !=
+          at::IntArrayRef({batch1.size(0), batch1.size(1), batch2.size(2)})) {
+    detail::arena::record_memory_plan_fallback(plan_id);
+    return at::bmm(batch1, batch2);
+  }
+  auto output = detail::arena::arena_slice(
+      plan_id, offset, sizes, strides, batch1.options());
+  at::bmm_out(output, batch1, batch2);
+  return output;
+}
+
 } // namespace cpu
 } // namespace torch_ipex
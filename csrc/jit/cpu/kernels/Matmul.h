@@ -59,5 +59,15 @@ at::Tensor dil_bmm_add(
     const at::Tensor& batch2,
     const c10::Scalar& alpha);
 
+// Out-variant of aten::bmm used by the activation memory planner, writes the
+// output into the arena slice (plan_id, offset, sizes, strides).
+at::Tensor dil_bmm_out(
+    const at::Tensor& batch1,
+    const at::Tensor& batch2,
+    int64_t plan_id,
+    int64_t offset,
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides);
+
 } // namespace cpu
 } // namespace torch_ipex
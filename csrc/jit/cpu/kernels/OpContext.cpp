@@ -2,8 +2,12 @@
 #include <torch/all.h>
 #include "ConvPacked.h"
 #include "ConvTransposePacked.h"
+#include "GatedMlpPacked.h"
+#include "LinearDynamicQuantPacked.h"
 #include "LinearMKLPacked.h"
 #include "LinearPacked.h"
+#include "LinearSparsePacked.h"
+#include "LinearWoqPacked.h"
 
 namespace torch_ipex {
 namespace cpu {
@@ -233,6 +237,143 @@ int64_t IpexLinearMKLOpContext::get_in_features() {
   return op_context_.sgemm_sizes_[1];
 }
 
+c10::intrusive_ptr<WoqLinearOpContext> IpexWoqLinearOpContext::create_context(
+    at::Tensor&& weight,
+    c10::optional<at::Tensor>&& bias,
+    at::ScalarType weight_dtype,
+    int64_t group_size) {
+  auto op_context = torch_ipex::cpu::detail::woq_linear::create(
+      weight, bias, weight_dtype, group_size);
+  return c10::make_intrusive<IpexWoqLinearOpContext>(std::move(op_context));
+}
+
+at::Tensor IpexWoqLinearOpContext::get_at_packed_weight() {
+  return op_context_.qweight_;
+}
+
+at::Tensor IpexWoqLinearOpContext::get_data_handle() {
+  at::Tensor ptr = at::empty(1, at::kLong);
+  ptr.data_ptr<int64_t>()[0] = reinterpret_cast<int64_t>(this);
+  return ptr;
+}
+
+at::Tensor IpexWoqLinearOpContext::run(const at::Tensor& input) {
+  return torch_ipex::cpu::detail::woq_linear::run(op_context_, input);
+}
+
+at::Tensor IpexWoqLinearOpContext::to_public(const at::Tensor& tensor) {
+  return torch_ipex::cpu::detail::woq_linear::unpack(op_context_, tensor);
+}
+
+detail::ContextLinearWoq& IpexWoqLinearOpContext::get_context() {
+  return op_context_;
+}
+
+c10::intrusive_ptr<DynamicQuantLinearOpContext>
+IpexDynamicQuantLinearOpContext::create_context(
+    at::Tensor&& weight,
+    c10::optional<at::Tensor>&& bias,
+    bool per_channel_weight,
+    bool per_token) {
+  auto op_context = torch_ipex::cpu::detail::dynamic_quant_linear::create(
+      weight, bias, per_channel_weight, per_token);
+  return c10::make_intrusive<IpexDynamicQuantLinearOpContext>(
+      std::move(op_context));
+}
+
+at::Tensor IpexDynamicQuantLinearOpContext::get_at_packed_weight() {
+  return op_context_.qweight_;
+}
+
+at::Tensor IpexDynamicQuantLinearOpContext::get_data_handle() {
+  at::Tensor ptr = at::empty(1, at::kLong);
+  ptr.data_ptr<int64_t>()[0] = reinterpret_cast<int64_t>(this);
+  return ptr;
+}
+
+at::Tensor IpexDynamicQuantLinearOpContext::run(
+    const at::Tensor& input,
+    DynamicQuantPostOp post_op) {
+  return torch_ipex::cpu::detail::dynamic_quant_linear::run(
+      op_context_, input, post_op);
+}
+
+at::Tensor IpexDynamicQuantLinearOpContext::to_public(
+    const at::Tensor& tensor) {
+  return torch_ipex::cpu::detail::dynamic_quant_linear::unpack(
+      op_context_, tensor);
+}
+
+detail::ContextLinearDynamicQuant& IpexDynamicQuantLinearOpContext::
+    get_context() {
+  return op_context_;
+}
+
+c10::intrusive_ptr<SparseLinearOpContext> IpexSparseLinearOpContext::
+    create_context(at::Tensor&& weight, c10::optional<at::Tensor>&& bias) {
+  auto op_context =
+      torch_ipex::cpu::detail::sparse_linear::create(weight, bias);
+  return c10::make_intrusive<IpexSparseLinearOpContext>(std::move(op_context));
+}
+
+at::Tensor IpexSparseLinearOpContext::get_at_packed_weight() {
+  return op_context_.values_;
+}
+
+at::Tensor IpexSparseLinearOpContext::get_data_handle() {
+  at::Tensor ptr = at::empty(1, at::kLong);
+  ptr.data_ptr<int64_t>()[0] = reinterpret_cast<int64_t>(this);
+  return ptr;
+}
+
+at::Tensor IpexSparseLinearOpContext::run(
+    const at::Tensor& input,
+    SparseLinearPostOp post_op) {
+  return torch_ipex::cpu::detail::sparse_linear::run(
+      op_context_, input, post_op);
+}
+
+at::Tensor IpexSparseLinearOpContext::to_public(const at::Tensor& tensor) {
+  return torch_ipex::cpu::detail::sparse_linear::unpack(op_context_, tensor);
+}
+
+detail::ContextLinearSparse& IpexSparseLinearOpContext::get_context() {
+  return op_context_;
+}
+
+c10::intrusive_ptr<GatedMlpOpContext> IpexGatedMlpOpContext::create_context(
+    at::Tensor&& gate_weight,
+    c10::optional<at::Tensor>&& gate_bias,
+    at::Tensor&& up_weight,
+    c10::optional<at::Tensor>&& up_bias,
+    std::string&& act) {
+  auto op_context = torch_ipex::cpu::detail::gated_mlp::create(
+      gate_weight, gate_bias, up_weight, up_bias, act);
+  return c10::make_intrusive<IpexGatedMlpOpContext>(std::move(op_context));
+}
+
+at::Tensor IpexGatedMlpOpContext::get_at_packed_weight() {
+  return op_context_.linear_.at_weight_;
+}
+
+at::Tensor IpexGatedMlpOpContext::get_data_handle() {
+  at::Tensor ptr = at::empty(1, at::kLong);
+  ptr.data_ptr<int64_t>()[0] = reinterpret_cast<int64_t>(this);
+  return ptr;
+}
+
+at::Tensor IpexGatedMlpOpContext::run(const at::Tensor& input) {
+  return torch_ipex::cpu::detail::gated_mlp::run(op_context_, input);
+}
+
+at::Tensor IpexGatedMlpOpContext::to_public(const at::Tensor& tensor) {
+  return torch_ipex::cpu::detail::gated_mlp::unpack(op_context_, tensor);
+}
+
+detail::ContextGatedMlp& IpexGatedMlpOpContext::get_context() {
+  return op_context_;
+}
+
 at::Tensor IpexConvTransposeOpContext::run(
     const at::Tensor& input,
     const ideep::attr_t& attr) {
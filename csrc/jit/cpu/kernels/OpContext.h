@@ -7,8 +7,12 @@
 #include <ideep.hpp>
 #include "ContextConvTranspose.h"
 #include "ContextConvolution.h"
+#include "ContextGatedMlp.h"
 #include "ContextLinear.h"
+#include "ContextLinearDynamicQuant.h"
 #include "ContextLinearMKL.h"
+#include "ContextLinearSparse.h"
+#include "ContextLinearWoq.h"
 
 namespace torch_ipex {
 namespace cpu {
@@ -299,6 +303,237 @@ class IpexLinearMKLOpContext final : public MKLOpContext {
       c10::optional<int64_t> batch_size);
 };
 
+using SerializationTypeWoqLinearPrePack =
+    std::tuple<at::Tensor, c10::optional<at::Tensor>, int64_t, int64_t>;
+
+class WoqLinearOpContext : public torch::jit::CustomClassHolder {
+ public:
+  SerializationTypeWoqLinearPrePack unpack() {
+    auto& context = this->get_context();
+    auto orig_weight = this->to_public(context.qweight_);
+    return std::make_tuple(
+        orig_weight,
+        context.bias_,
+        static_cast<int64_t>(context.weight_dtype_),
+        context.group_size_);
+  }
+
+  // Return the packed int8/int4 weight
+  virtual at::Tensor get_at_packed_weight() = 0;
+
+  virtual at::Tensor get_data_handle() = 0;
+
+  virtual at::Tensor run(const at::Tensor& input) = 0;
+
+  // Dequantize given packed weight to the original public FP32 format
+  virtual at::Tensor to_public(const at::Tensor& tensor) = 0;
+
+  virtual detail::ContextLinearWoq& get_context() = 0;
+};
+
+class IpexWoqLinearOpContext final : public WoqLinearOpContext {
+ private:
+  detail::ContextLinearWoq op_context_;
+
+ public:
+  IpexWoqLinearOpContext(detail::ContextLinearWoq&& op_context)
+      : op_context_(std::move(op_context)) {}
+
+  virtual at::Tensor get_at_packed_weight() override;
+
+  virtual at::Tensor get_data_handle() override;
+
+  virtual at::Tensor run(const at::Tensor& input) override;
+
+  virtual at::Tensor to_public(const at::Tensor& tensor) override;
+
+  virtual detail::ContextLinearWoq& get_context() override;
+
+  static c10::intrusive_ptr<WoqLinearOpContext> create_context(
+      at::Tensor&& weight,
+      c10::optional<at::Tensor>&& bias,
+      at::ScalarType weight_dtype,
+      int64_t group_size);
+};
+
+using SerializationTypeDynamicQuantLinearPrePack =
+    std::tuple<at::Tensor, c10::optional<at::Tensor>, bool, bool>;
+
+class DynamicQuantLinearOpContext : public torch::jit::CustomClassHolder {
+ public:
+  SerializationTypeDynamicQuantLinearPrePack unpack() {
+    auto& context = this->get_context();
+    auto orig_weight = this->to_public(context.qweight_);
+    return std::make_tuple(
+        orig_weight,
+        context.bias_,
+        context.per_channel_weight_,
+        context.per_token_);
+  }
+
+  // Return the packed s8 weight
+  virtual at::Tensor get_at_packed_weight() = 0;
+
+  virtual at::Tensor get_data_handle() = 0;
+
+  virtual at::Tensor run(
+      const at::Tensor& input,
+      DynamicQuantPostOp post_op) = 0;
+
+  // Dequantize given packed weight to the original public FP32 format
+  virtual at::Tensor to_public(const at::Tensor& tensor) = 0;
+
+  virtual detail::ContextLinearDynamicQuant& get_context() = 0;
+};
+
+class IpexDynamicQuantLinearOpContext final
+    : public DynamicQuantLinearOpContext {
+ private:
+  detail::ContextLinearDynamicQuant op_context_;
+
+ public:
+  IpexDynamicQuantLinearOpContext(
+      detail::ContextLinearDynamicQuant&& op_context)
+      : op_context_(std::move(op_context)) {}
+
+  virtual at::Tensor get_at_packed_weight() override;
+
+  virtual at::Tensor get_data_handle() override;
+
+  virtual at::Tensor run(const at::Tensor& input, DynamicQuantPostOp post_op)
+      override;
+
+  virtual at::Tensor to_public(const at::Tensor& tensor) override;
+
+  virtual detail::ContextLinearDynamicQuant& get_context() override;
+
+  static c10::intrusive_ptr<DynamicQuantLinearOpContext> create_context(
+      at::Tensor&& weight,
+      c10::optional<at::Tensor>&& bias,
+      bool per_channel_weight,
+      bool per_token);
+};
+
+using SerializationTypeSparseLinearPrePack =
+    std::tuple<at::Tensor, c10::optional<at::Tensor>>;
+
+class SparseLinearOpContext : public torch::jit::CustomClassHolder {
+ public:
+  SerializationTypeSparseLinearPrePack unpack() {
+    auto& context = this->get_context();
+    // keep the dtype of the packed values, so that a BF16 weight is packed
+    // to BF16 blocks again
+    auto orig_weight = this->to_public(context.values_)
+                           .to(context.values_.scalar_type());
+    return std::make_tuple(orig_weight, context.bias_);
+  }
+
+  // Return the packed non-zero weight blocks
+  virtual at::Tensor get_at_packed_weight() = 0;
+
+  virtual at::Tensor get_data_handle() = 0;
+
+  virtual at::Tensor run(
+      const at::Tensor& input,
+      SparseLinearPostOp post_op) = 0;
+
+  // Unpack given packed weight blocks to the original public FP32 format
+  virtual at::Tensor to_public(const at::Tensor& tensor) = 0;
+
+  virtual detail::ContextLinearSparse& get_context() = 0;
+};
+
+class IpexSparseLinearOpContext final : public SparseLinearOpContext {
+ private:
+  detail::ContextLinearSparse op_context_;
+
+ public:
+  IpexSparseLinearOpContext(detail::ContextLinearSparse&& op_context)
+      : op_context_(std::move(op_context)) {}
+
+  virtual at::Tensor get_at_packed_weight() override;
+
+  virtual at::Tensor get_data_handle() override;
+
+  virtual at::Tensor run(const at::Tensor& input, SparseLinearPostOp post_op)
+      override;
+
+  virtual at::Tensor to_public(const at::Tensor& tensor) override;
+
+  virtual detail::ContextLinearSparse& get_context() override;
+
+  static c10::intrusive_ptr<SparseLinearOpContext> create_context(
+      at::Tensor&& weight,
+      c10::optional<at::Tensor>&& bias);
+};
+
+using SerializationTypeGatedMlpPrePack = std::tuple<
+    at::Tensor,
+    c10::optional<at::Tensor>,
+    at::Tensor,
+    c10::optional<at::Tensor>,
+    std::string>;
+
+class GatedMlpOpContext : public torch::jit::CustomClassHolder {
+ public:
+  SerializationTypeGatedMlpPrePack unpack() {
+    auto& context = this->get_context();
+    auto weight = gated_mlp_deinterleave(
+        this->to_public(this->get_at_packed_weight()));
+    c10::optional<at::Tensor> gate_bias = c10::nullopt;
+    c10::optional<at::Tensor> up_bias = c10::nullopt;
+    if (context.linear_.bias_.has_value()) {
+      auto bias = gated_mlp_deinterleave(context.linear_.bias_.value());
+      gate_bias = std::get<0>(bias);
+      up_bias = std::get<1>(bias);
+    }
+    return std::make_tuple(
+        std::get<0>(weight),
+        gate_bias,
+        std::get<1>(weight),
+        up_bias,
+        gated_mlp_act_name(context.act_));
+  }
+
+  // Return the packed interleaved gate and up weight
+  virtual at::Tensor get_at_packed_weight() = 0;
+
+  virtual at::Tensor get_data_handle() = 0;
+
+  virtual at::Tensor run(const at::Tensor& input) = 0;
+
+  // Unpack given packed weight to the interleaved public format
+  virtual at::Tensor to_public(const at::Tensor& tensor) = 0;
+
+  virtual detail::ContextGatedMlp& get_context() = 0;
+};
+
+class IpexGatedMlpOpContext final : public GatedMlpOpContext {
+ private:
+  detail::ContextGatedMlp op_context_;
+
+ public:
+  IpexGatedMlpOpContext(detail::ContextGatedMlp&& op_context)
+      : op_context_(std::move(op_context)) {}
+
+  virtual at::Tensor get_at_packed_weight() override;
+
+  virtual at::Tensor get_data_handle() override;
+
+  virtual at::Tensor run(const at::Tensor& input) override;
+
+  virtual at::Tensor to_public(const at::Tensor& tensor) override;
+
+  virtual detail::ContextGatedMlp& get_context() override;
+
+  static c10::intrusive_ptr<GatedMlpOpContext> create_context(
+      at::Tensor&& gate_weight,
+      c10::optional<at::Tensor>&& gate_bias,
+      at::Tensor&& up_weight,
+      c10::optional<at::Tensor>&& up_bias,
+      std::string&& act);
+};
+
 // deconv op
 using SerializationTypeConvTransposePrePack = std::tuple<
     at::Tensor,
@@ -3,16 +3,24 @@
 
 #include "ConvPacked.h"
 #include "ConvTransposePacked.h"
+#include "GatedMlpPacked.h"
+#include "LinearDynamicQuantPacked.h"
 #include "LinearMKLPacked.h"
 #include "LinearPacked.h"
+#include "LinearSparsePacked.h"
+#include "LinearWoqPacked.h"
 #include "OpContext.h"
 
 namespace torch_ipex {
 namespace cpu {
 using detail::conv_transpose::createConvTransposePrePackOpContext;
 using detail::convolution::createConvolutionPrePackOpContext;
+using detail::dynamic_quant_linear::createDynamicQuantLinearPrePackOpContext;
+using detail::gated_mlp::createGatedMlpPrePackOpContext;
 using detail::linear::createLinearPrePackOpContext;
 using detail::mkl_sgemm::createLinearMKLPrePackOpContext;
+using detail::sparse_linear::createSparseLinearPrePackOpContext;
+using detail::woq_linear::createWoqLinearPrePackOpContext;
 
 TORCH_LIBRARY(ipex_prepack, m) {
   m.class_<ConvolutionOpContext>("ConvolutionOpContext")
@@ -78,6 +86,89 @@ TORCH_LIBRARY(ipex_prepack, m) {
       .def("pack", &torch_ipex::cpu::MKLOpContext::pack)
       .def("to_public", &torch_ipex::cpu::MKLOpContext::to_public)
       .def("get_data_handle", &torch_ipex::cpu::MKLOpContext::get_data_handle);
+  m.class_<WoqLinearOpContext>("WoqLinearOpContext")
+      .def_pickle(
+          [](const c10::intrusive_ptr<WoqLinearOpContext>& op_context)
+              -> SerializationTypeWoqLinearPrePack { // __getstate__
+            return op_context->unpack();
+          },
+          [](SerializationTypeWoqLinearPrePack state)
+              -> c10::intrusive_ptr<WoqLinearOpContext> { // __setstate__
+            return createWoqLinearPrePackOpContext(
+                std::move(std::get<0>(state)),
+                std::move(std::get<1>(state)),
+                static_cast<at::ScalarType>(std::get<2>(state)),
+                std::get<3>(state));
+          })
+      .def(
+          "get_weight",
+          &torch_ipex::cpu::WoqLinearOpContext::get_at_packed_weight)
+      .def("to_public", &torch_ipex::cpu::WoqLinearOpContext::to_public)
+      .def(
+          "get_data_handle",
+          &torch_ipex::cpu::WoqLinearOpContext::get_data_handle);
+  m.class_<DynamicQuantLinearOpContext>("DynamicQuantLinearOpContext")
+      .def_pickle(
+          [](const c10::intrusive_ptr<DynamicQuantLinearOpContext>& op_context)
+              -> SerializationTypeDynamicQuantLinearPrePack { // __getstate__
+            return op_context->unpack();
+          },
+          [](SerializationTypeDynamicQuantLinearPrePack state)
+              -> c10::intrusive_ptr<DynamicQuantLinearOpContext> { // __setstate__
+            return createDynamicQuantLinearPrePackOpContext(
+                std::move(std::get<0>(state)),
+                std::move(std::get<1>(state)),
+                std::get<2>(state),
+                std::get<3>(state));
+          })
+      .def(
+          "get_weight",
+          &torch_ipex::cpu::DynamicQuantLinearOpContext::get_at_packed_weight)
+      .def(
+          "to_public", &torch_ipex::cpu::DynamicQuantLinearOpContext::to_public)
+      .def(
+          "get_data_handle",
+          &torch_ipex::cpu::DynamicQuantLinearOpContext::get_data_handle);
+  m.class_<SparseLinearOpContext>("SparseLinearOpContext")
+      .def_pickle(
+          [](const c10::intrusive_ptr<SparseLinearOpContext>& op_context)
+              -> SerializationTypeSparseLinearPrePack { // __getstate__
+            return op_context->unpack();
+          },
+          [](SerializationTypeSparseLinearPrePack state)
+              -> c10::intrusive_ptr<SparseLinearOpContext> { // __setstate__
+            return createSparseLinearPrePackOpContext(
+                std::move(std::get<0>(state)), std::move(std::get<1>(state)));
+          })
+      .def(
+          "get_weight",
+          &torch_ipex::cpu::SparseLinearOpContext::get_at_packed_weight)
+      .def("to_public", &torch_ipex::cpu::SparseLinearOpContext::to_public)
+      .def(
+          "get_data_handle",
+          &torch_ipex::cpu::SparseLinearOpContext::get_data_handle);
+  m.class_<GatedMlpOpContext>("GatedMlpOpContext")
+      .def_pickle(
+          [](const c10::intrusive_ptr<GatedMlpOpContext>& op_context)
+              -> SerializationTypeGatedMlpPrePack { // __getstate__
+            return op_context->unpack();
+          },
+          [](SerializationTypeGatedMlpPrePack state)
+              -> c10::intrusive_ptr<GatedMlpOpContext> { // __setstate__
+            return createGatedMlpPrePackOpContext(
+                std::move(std::get<0>(state)),
+                std::move(std::get<1>(state)),
+                std::move(std::get<2>(state)),
+                std::move(std::get<3>(state)),
+                std::move(std::get<4>(state)));
+          })
+      .def(
+          "get_weight",
+          &torch_ipex::cpu::GatedMlpOpContext::get_at_packed_weight)
+      .def("to_public", &torch_ipex::cpu::GatedMlpOpContext::to_public)
+      .def(
+          "get_data_handle",
+          &torch_ipex::cpu::GatedMlpOpContext::get_data_handle);
   m.class_<ConvTransposeOpContext>("ConvTransposeOpContext")
       .def_pickle(
           [](const c10::intrusive_ptr<ConvTransposeOpContext>& op_context)
@@ -116,6 +207,21 @@ TORCH_LIBRARY(ipex_prepack, m) {
   m.def(
       "mkl_sgemm_prepack(Tensor W, Tensor? B, int? batch_size) "
       "-> __torch__.torch.classes.ipex_prepack.MKLOpContext");
+  m.def(
+      "woq_linear_prepack(Tensor W, Tensor? B, ScalarType weight_dtype, "
+      "int group_size) "
+      "-> __torch__.torch.classes.ipex_prepack.WoqLinearOpContext");
+  m.def(
+      "dynamic_quant_linear_prepack(Tensor W, Tensor? B, "
+      "bool per_channel_weight, bool per_token) "
+      "-> __torch__.torch.classes.ipex_prepack.DynamicQuantLinearOpContext");
+  m.def(
+      "sparse_linear_prepack(Tensor W, Tensor? B) "
+      "-> __torch__.torch.classes.ipex_prepack.SparseLinearOpContext");
+  m.def(
+      "gated_mlp_prepack(Tensor W_gate, Tensor? B_gate, Tensor W_up, "
+      "Tensor? B_up, str act) "
+      "-> __torch__.torch.classes.ipex_prepack.GatedMlpOpContext");
   m.def(
       "conv_transpose_prepack(Tensor W, Tensor? B, int[] stride, "
       "int[] padding, int[] output_padding, int groups, int[] dilation, "
@@ -127,6 +233,13 @@ TORCH_LIBRARY_IMPL(ipex_prepack, CPU, m) {
   m.impl("convolution_prepack", TORCH_FN(createConvolutionPrePackOpContext));
   m.impl("linear_prepack", TORCH_FN(createLinearPrePackOpContext));
   m.impl("mkl_sgemm_prepack", TORCH_FN(createLinearMKLPrePackOpContext));
+  m.impl("woq_linear_prepack", TORCH_FN(createWoqLinearPrePackOpContext));
+  m.impl(
+      "dynamic_quant_linear_prepack",
+      TORCH_FN(createDynamicQuantLinearPrePackOpContext));
+  m.impl(
+      "sparse_linear_prepack", TORCH_FN(createSparseLinearPrePackOpContext));
+  m.impl("gated_mlp_prepack", TORCH_FN(createGatedMlpPrePackOpContext));
   m.impl(
       "conv_transpose_prepack", TORCH_FN(createConvTransposePrePackOpContext));
 }
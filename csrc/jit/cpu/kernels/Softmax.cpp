@@ -1,4 +1,5 @@
 #include "Softmax.h"
+#include "ActivationArena.h"
 #include "aten/AddSoftmax.h"
 #include "ideep/IDeepConversions.h"
 
@@ -84,5 +85,28 @@ at::Tensor& dil_softmax_(
   return input;
 }
 
+at::Tensor dil_softmax_out(
+    const at::Tensor& input,
+    const int64_t dim,
+    int64_t plan_id,
+    int64_t offset,
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides) {
+  RECORD_FUNCTION("dil_softmax_out", c10::ArrayRef<c10::IValue>({}));
+
+  if (!input.is_contiguous() || input.sizes() != sizes ||
+      input.strides() != strides) {
+    detail::arena::record_memory_plan_fallback(plan_id);
+    return dil_softmax(input, dim);
+  }
+  const int64_t wrapped_dim = at::maybe_wrap_dim(dim, input.dim());
+  auto output = detail::arena::arena_slice(
+      plan_id, offset, sizes, strides, input.options());
+  ideep::tensor mkldnn_input = itensor_view_from_dense(input);
+  ideep::tensor mkldnn_output = itensor_view_from_dense(output);
+  ideep::softmax_forward::compute(mkldnn_input, mkldnn_output, wrapped_dim);
+  return output;
+}
+
 } // namespace cpu
 } // namespace torch_ipex
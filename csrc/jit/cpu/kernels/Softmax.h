@@ -35,5 +35,15 @@ at::Tensor& dil_softmax_(
     const int64_t dim,
     const at::IValue& dtype = at::IValue());
 
+// Out-variant used by the activation memory planner, writes the output into
+// the arena slice (plan_id, offset, sizes, strides).
+at::Tensor dil_softmax_out(
+    const at::Tensor& input,
+    const int64_t dim,
+    int64_t plan_id,
+    int64_t offset,
+    at::IntArrayRef sizes,
+    at::IntArrayRef strides);
+
 } // namespace cpu
 } // namespace torch_ipex
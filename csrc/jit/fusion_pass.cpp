@@ -2,11 +2,14 @@
 #include <string>
 #include "codegen/onednn/interface.h"
 #include "cpu/kernels/Matmul.h"
+#include "passes/concat_elimination.h"
 #include "passes/concat_linear.h"
 #include "passes/frozen_conv_folding.h"
 #include "passes/frozen_linear_folding.h"
 #include "passes/graph_rewrite.h"
 #include "passes/graph_rewrite_helper.h"
+#include "passes/grouped_linear.h"
+#include "passes/memory_planner.h"
 #include "passes/prepack_folding.h"
 #include "passes/remove_redundant_aliases.h"
 
@@ -113,7 +116,11 @@ void IPEXFusionPass(std::shared_ptr<Graph>& graph) {
   graph_rewrite::fuseConvAddRelu(graph);
   GRAPH_DUMP("After fuseConvAddRelu.Before fuseBottleneck", graph);
   graph_rewrite::fuseBottleneck(graph);
-  GRAPH_DUMP("After fuseBottleneck.", graph);
+  GRAPH_DUMP("After fuseBottleneck.Before fuseDepthwisePointwise", graph);
+  graph_rewrite::fuseDepthwisePointwise(graph);
+  GRAPH_DUMP("After fuseDepthwisePointwise.Before fuseConvWithPool", graph);
+  graph_rewrite::fuseConvWithPool(graph);
+  GRAPH_DUMP("After fuseConvWithPool.", graph);
 
   // TODO: Record original aten nodes, while convert aten linear-> ipex linear,
   // will ignore these aten linear (if they are fp32 dtype). For BF16 dtype,
@@ -123,10 +130,28 @@ void IPEXFusionPass(std::shared_ptr<Graph>& graph) {
   // linear folding
   graph_rewrite::replaceFrozenIPEXLinearWithAtenLinear(
       graph, aten_linear_recorder.use_mkl());
+  // gated MLP, before its gate and up linears are concatenated
+  if (graph_rewrite::getGatedMlpFusionEnabled()) {
+    graph_rewrite::fuseGatedMlp(graph, aten_linear_recorder.get_records());
+  }
   // concat multi-linear with same input
   torch_ipex::jit::FrozenConcatLinear(
       graph, aten_linear_recorder.get_records());
   graph_rewrite::FrozenLinearFolding(graph);
+  // weight-only quantized linear
+  graph_rewrite::insertPrePackedWoqLinearOp(
+      graph, aten_linear_recorder.get_records());
+  // dynamic int8 quantized linear
+  graph_rewrite::insertPrePackedDynamicQuantLinearOp(
+      graph, aten_linear_recorder.get_records());
+  // block-sparse linear
+  graph_rewrite::insertPrePackedSparseLinearOp(
+      graph, aten_linear_recorder.get_records());
+  // group independent small linears into one batched GEMM
+  if (torch_ipex::jit::getGroupedLinearEnabled()) {
+    torch_ipex::jit::FrozenGroupedLinear(
+        graph, aten_linear_recorder.get_records());
+  }
 
   // linear fusion
   GRAPH_DUMP("After FrozenLinearFolding.Before insertPrePackedLinearOp", graph);
@@ -144,6 +169,8 @@ void IPEXFusionPass(std::shared_ptr<Graph>& graph) {
 
   // fuse add+layernorm
   graph_rewrite::FuseAddLayerNorm(graph);
+  // fuse group_norm+silu(+add)
+  graph_rewrite::FuseGroupNormSiLU(graph);
 
   // deconvolution fusion
   GRAPH_DUMP(
@@ -195,6 +222,13 @@ void IPEXFusionPass(std::shared_ptr<Graph>& graph) {
   // folding prepacking ops.
   PrePackingOpsFolder(graph);
   GRAPH_DUMP("After PrePackingOpsFolder", graph);
+
+  // let the producers of a concat write into its output, it has to run after
+  // the prepacked ops are final
+  if (torch_ipex::jit::getConcatEliminationEnabled()) {
+    torch_ipex::jit::EliminateConcat(graph);
+    GRAPH_DUMP("After EliminateConcat", graph);
+  }
 }
 
 bool checkQuantization(Block* block) {
@@ -294,6 +328,13 @@ void FusionPass(std::shared_ptr<Graph>& graph) {
   // Note: Since TE is with priority and it has not supported inplace op yet,
   //       we make inplace optimization after TE.
   ApplyInplaceOptimization(graph);
+  // Plan the activations as the last step so that no later pass changes the
+  // lifetimes it relies on. It needs the specialized tensor types, so it has
+  // to run before RemoveTensorTypeSpecializations.
+  if (getActivationMemoryPlanningEnabled()) {
+    PlanActivationMemory(graph);
+    GRAPH_DUMP("After PlanActivationMemory.", graph);
+  }
   RemoveTensorTypeSpecializations(graph);
   GRAPH_DUMP(
       "After RemoveTensorTypeSpecializations. End of optimization pass", graph);
@@ -0,0 +1,180 @@
+#include "concat_elimination.h"
+
+#include <torch/csrc/jit/ir/constants.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/runtime/graph_iterator.h>
+#include <torch/csrc/jit/runtime/operator.h>
+
+#include <atomic>
+#include <vector>
+
+namespace torch_ipex {
+namespace jit {
+
+using namespace torch::jit;
+
+namespace {
+
+std::atomic<bool> concat_elimination_enabled{true};
+
+// Returns the "_into" variant of a producer, or a null symbol if there is
+// none. The prepacked runs have one registered for each unary post op.
+Symbol getIntoVariant(Node* n) {
+  if (n->kind() == Symbol::fromQualString("torch_ipex::embedding_bag")) {
+    return Symbol::fromQualString("ipex::embedding_bag_into");
+  }
+  static const std::vector<Symbol> eltwise_ops = {
+      aten::relu, aten::sigmoid, aten::tanh, aten::silu, aten::hardswish};
+  for (auto op : eltwise_ops) {
+    if (n->kind() == op && n->inputs().size() == 1) {
+      return Symbol::fromQualString(
+          std::string("ipex::") + op.toUnqualString() + "_into");
+    }
+  }
+  std::string kind = n->kind().toQualString();
+  if (kind.rfind("ipex_prepack::", 0) == 0) {
+    auto into = Symbol::fromQualString(kind + "_into");
+    if (!getAllOperatorsFor(into).empty()) {
+      return into;
+    }
+  }
+  return Symbol();
+}
+
+std::vector<Value*> getIntoInputs(Node* n) {
+  if (n->kind() == Symbol::fromQualString("torch_ipex::embedding_bag")) {
+    // sparse only matters for the backward
+    return {n->input(0), n->input(1), n->input(2), n->input(4)};
+  }
+  return {n->inputs().begin(), n->inputs().end()};
+}
+
+c10::optional<std::vector<int64_t>> getConcreteSizes(Value* v) {
+  auto type = v->type()->cast<TensorType>();
+  if (!type) {
+    return c10::nullopt;
+  }
+  return type->sizes().concrete_sizes();
+}
+
+bool eliminateConcat(std::shared_ptr<Graph>& graph, Node* cat) {
+  auto list = cat->input(0)->node();
+  auto dim_value = constant_as<int64_t>(cat->input(1));
+  if (list->kind() != prim::ListConstruct ||
+      list->output()->uses().size() != 1 || !dim_value.has_value()) {
+    return false;
+  }
+  auto type = cat->output()->type()->cast<TensorType>();
+  if (!type) {
+    return false;
+  }
+  auto sizes = type->sizes().concrete_sizes();
+  auto strides = type->strides().concrete_sizes();
+  auto dtype = type->scalarType();
+  auto device = type->device();
+  if (!sizes || !strides || !dtype || !device || !device->is_cpu() ||
+      type->requiresGrad().value_or(true)) {
+    return false;
+  }
+  int64_t dim = *dim_value < 0
+      ? *dim_value + static_cast<int64_t>(sizes->size())
+      : *dim_value;
+
+  std::vector<int64_t> lengths;
+  std::vector<Node*> producers;
+  for (auto part : list->inputs()) {
+    auto part_sizes = getConcreteSizes(part);
+    if (!part_sizes || part_sizes->size() != sizes->size()) {
+      return false;
+    }
+    lengths.push_back((*part_sizes)[dim]);
+    auto producer = part->node();
+    // the slice of the buffer must not be visible to any other user
+    bool eligible = producer->owningBlock() == cat->owningBlock() &&
+        producer->outputs().size() == 1 && part->uses().size() == 1 &&
+        getIntoVariant(producer) != Symbol();
+    producers.push_back(eligible ? producer : nullptr);
+  }
+
+  Node* first = nullptr;
+  for (auto producer : producers) {
+    if (producer && (!first || producer->isBefore(first))) {
+      first = producer;
+    }
+  }
+  if (!first) {
+    return false;
+  }
+
+  Value* buffer = nullptr;
+  {
+    WithInsertPoint guard(first);
+    auto buffer_node = graph->create(
+        Symbol::fromQualString("ipex::concat_buffer"),
+        {graph->insertConstant(*sizes),
+         graph->insertConstant(*strides),
+         graph->insertConstant(*dtype)});
+    buffer_node->insertBefore(first);
+    buffer = buffer_node->output()->setType(type);
+  }
+
+  int64_t start = 0;
+  for (size_t i = 0; i < producers.size(); i++) {
+    auto producer = producers[i];
+    if (producer) {
+      WithInsertPoint guard(producer);
+      auto inputs = getIntoInputs(producer);
+      inputs.push_back(buffer);
+      inputs.push_back(graph->insertConstant(dim));
+      inputs.push_back(graph->insertConstant(start));
+      inputs.push_back(graph->insertConstant(lengths[i]));
+      auto into = graph->create(getIntoVariant(producer), inputs);
+      into->insertBefore(producer);
+      into->output()->setType(producer->output()->type());
+      producer->output()->replaceAllUsesWith(into->output());
+      producer->destroy();
+    }
+    start += lengths[i];
+  }
+
+  WithInsertPoint guard(cat);
+  auto concat = graph->create(
+      Symbol::fromQualString("ipex::concat_from_buffer"),
+      {buffer,
+       list->output(),
+       graph->insertConstant(dim),
+       graph->insertConstant(lengths)});
+  concat->insertBefore(cat);
+  concat->output()->setType(type);
+  cat->output()->replaceAllUsesWith(concat->output());
+  cat->destroy();
+  return true;
+}
+
+} // namespace
+
+void setConcatEliminationEnabled(bool enabled) {
+  concat_elimination_enabled = enabled;
+}
+
+bool getConcatEliminationEnabled() {
+  return concat_elimination_enabled;
+}
+
+void EliminateConcat(std::shared_ptr<Graph>& graph) {
+  std::vector<Node*> cats;
+  DepthFirstGraphNodeIterator it(graph);
+  for (auto* node = it.next(); node != nullptr; node = it.next()) {
+    if (node->kind() == aten::cat) {
+      cats.push_back(node);
+    }
+  }
+  int64_t eliminated = 0;
+  for (auto cat : cats) {
+    eliminated += eliminateConcat(graph, cat);
+  }
+  GRAPH_DEBUG("Eliminated ", eliminated, " of ", cats.size(), " concats");
+}
+
+} // namespace jit
+} // namespace torch_ipex
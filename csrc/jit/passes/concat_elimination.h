@@ -0,0 +1,22 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch_ipex {
+namespace jit {
+
+// Concat elimination for frozen graphs with known shapes.
+//
+// The output of an aten::cat is allocated up front by ipex::concat_buffer and
+// every input of the cat produced by a prepacked convolution/linear run,
+// torch_ipex::embedding_bag or a supported unary eltwise op, and used only by
+// the cat, is replaced by an "_into" variant writing into its slice of the
+// buffer. The cat becomes ipex::concat_from_buffer, which only copies the
+// remaining inputs. See cpu/kernels/ConcatBuffer.h for the runtime fallbacks.
+TORCH_API void EliminateConcat(std::shared_ptr<torch::jit::Graph>& graph);
+
+TORCH_API void setConcatEliminationEnabled(bool enabled);
+TORCH_API bool getConcatEliminationEnabled();
+
+} // namespace jit
+} // namespace torch_ipex
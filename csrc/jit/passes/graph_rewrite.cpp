@@ -209,6 +209,61 @@ void FuseAddLayerNorm(std::shared_ptr<Graph>& graph) {
   rewriter_aten.runOnGraph(graph);
 }
 
+// GroupNorm followed by SiLU and optionally a residual add, as in the
+// ResNet blocks of diffusion UNets
+void FuseGroupNormSiLU(std::shared_ptr<Graph>& graph) {
+  auto aten_group_norm_silu_add = at::jit::CodeTemplate(R"(
+      graph(%input, %groups:int, %w, %b, %eps:float, %cudnn_enable:bool, %other, %alpha):
+        %x = aten::group_norm(%input, %groups, %w, %b, %eps, %cudnn_enable)
+        %y = aten::${silu}(%x)
+        %r = aten::add(${add_inputs}, %alpha)
+        return (%r) )");
+  std::string fused_group_norm_silu_add = R"(
+      graph(%input, %groups:int, %w, %b, %eps:float, %cudnn_enable:bool, %other, %alpha):
+        %r = ipex::group_norm_silu_add(%input, %groups, %w, %b, %eps, %other, %alpha)
+        return (%r) )";
+  auto aten_group_norm_silu = at::jit::CodeTemplate(R"(
+      graph(%input, %groups:int, %w, %b, %eps:float, %cudnn_enable:bool):
+        %x = aten::group_norm(%input, %groups, %w, %b, %eps, %cudnn_enable)
+        %r = aten::${silu}(%x)
+        return (%r) )");
+  std::string fused_group_norm_silu = R"(
+      graph(%input, %groups:int, %w, %b, %eps:float, %cudnn_enable:bool):
+        %r = ipex::group_norm_silu(%input, %groups, %w, %b, %eps)
+        return (%r) )";
+
+  // the add patterns go first, otherwise their group norm and silu are
+  // taken by the group_norm_silu pattern
+  SubgraphRewriter rewriter;
+  for (const auto& silu : {"silu", "silu_"}) {
+    for (const auto& add_inputs : {"%y, %other", "%other, %y"}) {
+      at::jit::TemplateEnv env;
+      env.s("silu", silu);
+      env.s("add_inputs", add_inputs);
+      rewriter.RegisterRewritePattern(
+          aten_group_norm_silu_add.format(env), fused_group_norm_silu_add);
+    }
+  }
+  // aten::add.Scalar matches the same pattern, only fuse a tensor %other
+  auto filter_tensor_other =
+      [](const Match& match,
+         const std::unordered_map<std::string, Value*>& vmap) {
+        auto other = torch_ipex::jit::graph_rewrite_helper::getValue(
+            "other", match.values_map, vmap);
+        return other->type()->cast<TensorType>() != nullptr;
+      };
+  rewriter.runOnGraph(graph, filter_tensor_other);
+
+  SubgraphRewriter rewriter_silu;
+  for (const auto& silu : {"silu", "silu_"}) {
+    at::jit::TemplateEnv env;
+    env.s("silu", silu);
+    rewriter_silu.RegisterRewritePattern(
+        aten_group_norm_silu.format(env), fused_group_norm_silu);
+  }
+  rewriter_silu.runOnGraph(graph);
+}
+
 void FuseMatmulDivOrMul(std::shared_ptr<Graph>& graph) {
   const std::string div_str = R"(div)";
   const std::string div_inplace_str = R"(div_)";
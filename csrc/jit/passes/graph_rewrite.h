@@ -47,6 +47,8 @@ void insertPrePackedConvOp(std::shared_ptr<torch::jit::Graph>& graph);
 void fuseConvWithEltwise(std::shared_ptr<torch::jit::Graph>& graph);
 void fuseConvAddRelu(std::shared_ptr<torch::jit::Graph>& graph);
 void fuseBottleneck(std::shared_ptr<torch::jit::Graph>& graph);
+void fuseDepthwisePointwise(std::shared_ptr<torch::jit::Graph>& graph);
+void fuseConvWithPool(std::shared_ptr<torch::jit::Graph>& graph);
 
 void RecordAtenLinearNodes(
     std::shared_ptr<torch::jit::Graph>& graph,
@@ -56,10 +58,51 @@ void insertPrePackedLinearOp(
     std::shared_ptr<torch::jit::Graph>& graph,
     std::unordered_set<torch::jit::Node*>& aten_linear,
     const bool& use_mkl_sgemm);
+// Weight-only quantization of frozen linears: weight_dtype is "int8" or
+// "int4" to also rewrite FP32/BF16 aten::linear with constant weights, or ""
+// to only lower the linears converted by ipex.optimize. group_size <= 0 means
+// per-channel scales.
+TORCH_API void setWoqLinearConfig(
+    const std::string& weight_dtype,
+    int64_t group_size);
+TORCH_API std::tuple<std::string, int64_t> getWoqLinearConfig();
+void insertPrePackedWoqLinearOp(
+    std::shared_ptr<torch::jit::Graph>& graph,
+    std::unordered_set<torch::jit::Node*>& aten_linear);
+// Dynamic int8 quantization of frozen linears: activation_granularity is
+// "per_tensor" or "per_token" to also rewrite FP32/BF16 aten::linear with
+// constant weights, or "" to only lower the linears converted by
+// ipex.quantization.convert. A following relu or gelu is fused into the
+// epilogue in both cases.
+TORCH_API void setDynamicQuantLinearConfig(
+    const std::string& activation_granularity,
+    bool per_channel_weight);
+TORCH_API std::tuple<std::string, bool> getDynamicQuantLinearConfig();
+void insertPrePackedDynamicQuantLinearOp(
+    std::shared_ptr<torch::jit::Graph>& graph,
+    std::unordered_set<torch::jit::Node*>& aten_linear);
+// Block-sparse linear: FP32/BF16 aten::linear with a constant weight whose
+// block density is below the threshold are rewritten as well as the linears
+// converted by ipex.optimize, 0 only lowers the latter. A following relu or
+// gelu is fused into the epilogue in both cases.
+TORCH_API void setSparseLinearDensityThreshold(double threshold);
+TORCH_API double getSparseLinearDensityThreshold();
+void insertPrePackedSparseLinearOp(
+    std::shared_ptr<torch::jit::Graph>& graph,
+    std::unordered_set<torch::jit::Node*>& aten_linear);
+// Gated MLP: act(linear(x, W_gate)) * linear(x, W_up) with act SiLU or GELU
+// and constant FP32/BF16 weights is rewritten to one GEMM on the interleaved
+// weights with act(gate) * up in its epilogue. Enabled by default.
+TORCH_API void setGatedMlpFusionEnabled(bool enabled);
+TORCH_API bool getGatedMlpFusionEnabled();
+void fuseGatedMlp(
+    std::shared_ptr<torch::jit::Graph>& graph,
+    std::unordered_set<torch::jit::Node*>& aten_linear);
 void fuseLinearWithEltwise(std::shared_ptr<torch::jit::Graph>& graph);
 void fuseLinearAddRelu(std::shared_ptr<torch::jit::Graph>& graph);
 
 void FuseAddLayerNorm(std::shared_ptr<torch::jit::Graph>& graph);
+void FuseGroupNormSiLU(std::shared_ptr<torch::jit::Graph>& graph);
 void FuseMatmulDivOrMul(std::shared_ptr<torch::jit::Graph>& graph);
 void FuseConcatBnRelu(std::shared_ptr<torch::jit::Graph>& graph);
 
@@ -456,6 +456,268 @@ void fuseBottleneck(std::shared_ptr<Graph>& graph) {
   rewriter_v2.runOnGraph(graph, filter_v2);
 }
 
+// Post ops of the convolutions of a chain, see conv_chain::post_op_attr
+struct ConvChainPostOp {
+  std::string name;
+  std::string run;
+  // scalar inputs of the run op
+  std::vector<std::string> inputs;
+};
+
+static const std::vector<ConvChainPostOp>& conv_chain_post_ops() {
+  static const std::vector<ConvChainPostOp> post_ops = {
+      {"none", "convolution_run", {}},
+      {"relu", "convolution_relu_run", {}},
+      {"relu6", "convolution_hardtanh_run", {"min", "max"}},
+      {"swish", "convolution_swish_run", {}},
+      {"hardswish", "convolution_hardswish_run", {}},
+      {"sigmoid", "convolution_sigmoid_run", {}},
+  };
+  return post_ops;
+}
+
+static std::string conv_chain_scalar_inputs(
+    const std::string& prefix,
+    const std::vector<std::string>& inputs) {
+  std::string str;
+  for (const auto& input : inputs) {
+    str += ", %" + prefix + input;
+  }
+  return str;
+}
+
+// Whether the hardtanh bounds %<prefix>min and %<prefix>max, if matched, are
+// those of ReLU6.
+static bool conv_chain_is_relu6(
+    const Match& match,
+    const std::unordered_map<std::string, Value*>& vmap,
+    const std::string& prefix) {
+  for (auto bound :
+       std::vector<std::pair<std::string, double>>{{"min", 0}, {"max", 6}}) {
+    auto it = vmap.find(prefix + bound.first);
+    if (it == vmap.end()) {
+      continue;
+    }
+    auto value = toIValue(match.values_map.at(it->second));
+    if (!value.has_value() || !(value->isDouble() || value->isInt()) ||
+        value->toScalar().to<double>() != bound.second) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether the prepack node has channels last weights, which the tiled
+// convolutions of a chain are computed in.
+static bool conv_chain_is_channels_last(Node* prepack) {
+  if (prepack->inputs().size() < 8) {
+    return false;
+  }
+  auto weight_is_channels_last = constant_as<bool>(prepack->inputs().at(6));
+  return weight_is_channels_last.has_value() &&
+      weight_is_channels_last.value();
+}
+
+void fuseDepthwisePointwise(std::shared_ptr<Graph>& graph) {
+  auto chain_rstring = CodeTemplate(R"(
+    graph(%input, %dw_weight, %pw_weight${graph_inputs}):
+        %x = ipex_prepack::${dw_run}(%input${dw_inputs}, %dw_weight)
+        %res = ipex_prepack::${pw_run}(%x${pw_inputs}, %pw_weight)
+        return (%res))");
+  auto chain_fused_rstring = CodeTemplate(R"(
+    graph(%input, %dw_weight, %pw_weight${graph_inputs}):
+        %dw_post_op : str = prim::Constant[value="${dw_post_op}"]()
+        %pw_post_op : str = prim::Constant[value="${pw_post_op}"]()
+        %res = ipex_prepack::convolution_depthwise_pointwise_run(%input, %dw_post_op, %pw_post_op, %dw_weight, %pw_weight)
+        return (%res))");
+
+  // Requires a depthwise convolution (one channel per group) followed by a
+  // pointwise one (1x1, stride 1, no padding), channels last weights, the
+  // intermediate only used by the pointwise convolution and hardtanh bounds
+  // of ReLU6.
+  auto filter = [](const Match& match,
+                   const std::unordered_map<std::string, Value*>& vmap) {
+    auto dw_prepack = match.values_map.at(vmap.at("dw_weight"))->node();
+    auto pw_prepack = match.values_map.at(vmap.at("pw_weight"))->node();
+    if (match.values_map.at(vmap.at("x"))->uses().size() != 1 ||
+        !conv_chain_is_channels_last(dw_prepack) ||
+        !conv_chain_is_channels_last(pw_prepack) ||
+        !conv_chain_is_relu6(match, vmap, "dw_") ||
+        !conv_chain_is_relu6(match, vmap, "pw_")) {
+      return false;
+    }
+
+    auto dw_weight = constant_as<at::Tensor>(dw_prepack->inputs().at(0));
+    auto dw_groups = constant_as<int64_t>(dw_prepack->inputs().at(5));
+    auto input_size =
+        constant_as<std::vector<int64_t>>(dw_prepack->inputs().at(7));
+    if (!dw_weight.has_value() || !dw_groups.has_value() ||
+        !input_size.has_value() || dw_weight->dim() != 4 ||
+        input_size->size() != 4 || dw_weight->size(1) != 1 ||
+        dw_weight->size(0) != dw_groups.value() ||
+        (*input_size)[1] != dw_groups.value()) {
+      return false;
+    }
+
+    auto pw_weight = constant_as<at::Tensor>(pw_prepack->inputs().at(0));
+    auto pw_stride =
+        constant_as<std::vector<int64_t>>(pw_prepack->inputs().at(2));
+    auto pw_padding =
+        constant_as<std::vector<int64_t>>(pw_prepack->inputs().at(3));
+    auto pw_groups = constant_as<int64_t>(pw_prepack->inputs().at(5));
+    if (!pw_weight.has_value() || !pw_stride.has_value() ||
+        !pw_padding.has_value() || !pw_groups.has_value() ||
+        pw_weight->dim() != 4 || pw_weight->size(1) != dw_weight->size(0) ||
+        pw_weight->size(2) != 1 || pw_weight->size(3) != 1 ||
+        pw_groups.value() != 1) {
+      return false;
+    }
+    for (auto s : pw_stride.value()) {
+      if (s != 1) {
+        return false;
+      }
+    }
+    for (auto p : pw_padding.value()) {
+      if (p != 0) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  for (const auto& dw : conv_chain_post_ops()) {
+    for (const auto& pw : conv_chain_post_ops()) {
+      TemplateEnv env;
+      env.s(
+          "graph_inputs",
+          conv_chain_scalar_inputs("dw_", dw.inputs) +
+              conv_chain_scalar_inputs("pw_", pw.inputs));
+      env.s("dw_run", dw.run);
+      env.s("dw_inputs", conv_chain_scalar_inputs("dw_", dw.inputs));
+      env.s("pw_run", pw.run);
+      env.s("pw_inputs", conv_chain_scalar_inputs("pw_", pw.inputs));
+      env.s("dw_post_op", dw.name);
+      env.s("pw_post_op", pw.name);
+
+      SubgraphRewriter rewriter;
+      rewriter.RegisterRewritePattern(
+          chain_rstring.format(env), chain_fused_rstring.format(env));
+      rewriter.runOnGraph(graph, filter);
+    }
+  }
+}
+
+void fuseConvWithPool(std::shared_ptr<Graph>& graph) {
+  auto conv_max_pool_rstring = CodeTemplate(R"(
+    graph(%input, %packed_weight, %kernel_size:int[], %stride:int[], %padding:int[], %dilation:int[], %ceil_mode:bool${graph_inputs}):
+        %x = ipex_prepack::${run}(%input${inputs}, %packed_weight)
+        %res = aten::max_pool2d(%x, %kernel_size, %stride, %padding, %dilation, %ceil_mode)
+        return (%res))");
+  auto conv_max_pool_fused_rstring = CodeTemplate(R"(
+    graph(%input, %packed_weight, %kernel_size:int[], %stride:int[], %padding:int[], %dilation:int[], %ceil_mode:bool${graph_inputs}):
+        %post_op : str = prim::Constant[value="${post_op}"]()
+        %pool : str = prim::Constant[value="max"]()
+        %res = ipex_prepack::convolution_pool_run(%input, %post_op, %pool, %kernel_size, %stride, %padding, %ceil_mode, %packed_weight)
+        return (%res))");
+
+  // aten::avg_pool2d is rewritten for count_include_pad = ${count_include_pad}
+  auto conv_avg_pool_rstring = CodeTemplate(R"(
+    graph(%input, %packed_weight, %kernel_size:int[], %stride:int[], %padding:int[], %ceil_mode:bool, %count_include_pad:bool, %divisor_override${graph_inputs}):
+        %x = ipex_prepack::${run}(%input${inputs}, %packed_weight)
+        %res = aten::avg_pool2d(%x, %kernel_size, %stride, %padding, %ceil_mode, %count_include_pad, %divisor_override)
+        return (%res))");
+  auto conv_avg_pool_fused_rstring = CodeTemplate(R"(
+    graph(%input, %packed_weight, %kernel_size:int[], %stride:int[], %padding:int[], %ceil_mode:bool, %count_include_pad:bool, %divisor_override${graph_inputs}):
+        %post_op : str = prim::Constant[value="${post_op}"]()
+        %pool : str = prim::Constant[value="${pool}"]()
+        %res = ipex_prepack::convolution_pool_run(%input, %post_op, %pool, %kernel_size, %stride, %padding, %ceil_mode, %packed_weight)
+        return (%res))");
+
+  // Requires a 2-D convolution with channels last weights whose output is
+  // only used by the pooling, constant pooling parameters, no dilation, no
+  // divisor override and no ceil mode for the average pooling, and hardtanh
+  // bounds of ReLU6.
+  auto filter = [](const Match& match,
+                   const std::unordered_map<std::string, Value*>& vmap,
+                   bool count_include_pad) {
+    auto prepack = match.values_map.at(vmap.at("packed_weight"))->node();
+    if (match.values_map.at(vmap.at("x"))->uses().size() != 1 ||
+        !conv_chain_is_channels_last(prepack) ||
+        !conv_chain_is_relu6(match, vmap, "")) {
+      return false;
+    }
+    auto input_size =
+        constant_as<std::vector<int64_t>>(prepack->inputs().at(7));
+    if (!input_size.has_value() || input_size->size() != 4) {
+      return false;
+    }
+    for (auto name : {"kernel_size", "stride", "padding"}) {
+      if (!constant_as<std::vector<int64_t>>(
+               match.values_map.at(vmap.at(name)))
+               .has_value()) {
+        return false;
+      }
+    }
+    auto ceil_mode =
+        constant_as<bool>(match.values_map.at(vmap.at("ceil_mode")));
+    if (!ceil_mode.has_value()) {
+      return false;
+    }
+    if (vmap.count("dilation")) {
+      auto dilation = constant_as<std::vector<int64_t>>(
+          match.values_map.at(vmap.at("dilation")));
+      if (!dilation.has_value()) {
+        return false;
+      }
+      for (auto d : dilation.value()) {
+        if (d != 1) {
+          return false;
+        }
+      }
+      return true;
+    }
+    auto include_pad =
+        constant_as<bool>(match.values_map.at(vmap.at("count_include_pad")));
+    return !ceil_mode.value() && include_pad.has_value() &&
+        include_pad.value() == count_include_pad &&
+        match.values_map.at(vmap.at("divisor_override"))->type() ==
+        NoneType::get();
+  };
+
+  for (const auto& conv : conv_chain_post_ops()) {
+    TemplateEnv env;
+    env.s("graph_inputs", conv_chain_scalar_inputs("", conv.inputs));
+    env.s("run", conv.run);
+    env.s("inputs", conv_chain_scalar_inputs("", conv.inputs));
+    env.s("post_op", conv.name);
+
+    SubgraphRewriter rewriter_max_pool;
+    rewriter_max_pool.RegisterRewritePattern(
+        conv_max_pool_rstring.format(env),
+        conv_max_pool_fused_rstring.format(env));
+    rewriter_max_pool.runOnGraph(
+        graph,
+        [&](const Match& match,
+            const std::unordered_map<std::string, Value*>& vmap) {
+          return filter(match, vmap, false);
+        });
+
+    for (bool count_include_pad : {true, false}) {
+      env.s("pool", count_include_pad ? "avg" : "avg_exclude_pad");
+      SubgraphRewriter rewriter_avg_pool;
+      rewriter_avg_pool.RegisterRewritePattern(
+          conv_avg_pool_rstring.format(env),
+          conv_avg_pool_fused_rstring.format(env));
+      rewriter_avg_pool.runOnGraph(
+          graph,
+          [&](const Match& match,
+              const std::unordered_map<std::string, Value*>& vmap) {
+            return filter(match, vmap, count_include_pad);
+          });
+    }
+  }
+}
+
 } // namespace graph_rewrite
 } // namespace jit
 } // namespace torch_ipex
@@ -20,10 +20,29 @@ auto ipex_einsum_filter =
                           .value()
                           .toStringView();
       int num_ops = std::count(equation.begin(), equation.end(), ',') + 1;
-      if (num_ops != 2) {
-        return false; // only process the 2 operands
+      if (num_ops < 2) {
+        return false;
       }
-      return true;
+      // more operands are contracted in the order picked by ipex, leave the
+      // ones with an explicit contraction path to aten
+      auto path = torch_ipex::jit::graph_rewrite_helper::getIValue(
+          "path", match_vmap, vmap);
+      return num_ops == 2 || (path.has_value() && path->isNone());
+    };
+
+auto ipex_einsum_pairwise_filter =
+    [](const Match& match,
+       const std::unordered_map<std::string, Value*>& vmap) {
+      const auto& match_vmap = match.values_map;
+      auto equation = torch_ipex::jit::graph_rewrite_helper::getIValue(
+                          "equation", match_vmap, vmap)
+                          .value()
+                          .toStringView();
+      int num_ops = std::count(equation.begin(), equation.end(), ',') + 1;
+      auto path = torch_ipex::jit::graph_rewrite_helper::getIValue(
+          "path", match_vmap, vmap);
+      // aten::einsum already maps two operands to a single bmm
+      return num_ops > 2 && path.has_value() && path->isNone();
     };
 
 void FusedEinsumPost(std::shared_ptr<Graph>& graph) {
@@ -46,6 +65,18 @@ void FusedEinsumPost(std::shared_ptr<Graph>& graph) {
         aten_einsum_binary.format(env), fused_einsum_binary);
   }
   rewriter_einsum_binary.runOnGraph(graph, ipex_einsum_filter);
+
+  SubgraphRewriter rewriter_einsum_pairwise;
+  std::string aten_einsum = R"(
+     graph(%equation, %inputs, %path):
+        %res = aten::einsum(%equation, %inputs, %path)
+        return (%res))";
+  std::string ipex_einsum = R"(
+     graph(%equation, %inputs, %path):
+        %res = ipex::einsum(%equation, %inputs)
+        return (%res))";
+  rewriter_einsum_pairwise.RegisterRewritePattern(aten_einsum, ipex_einsum);
+  rewriter_einsum_pairwise.runOnGraph(graph, ipex_einsum_pairwise_filter);
 }
 
 } // namespace graph_rewrite
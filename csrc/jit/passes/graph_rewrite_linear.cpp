@@ -1,5 +1,7 @@
 #include <ATen/code_template.h>
 #include <ideep.hpp>
+#include "aten/GatedMlp.h"
+#include "aten/SparseLinear.h"
 #include "passes/utils.h"
 
 #include "graph_rewrite.h"
@@ -184,6 +186,457 @@ void insertPrePackedLinearOp(
   insertPrePackedLinearOp(graph->block(), aten_linear, use_mkl_sgemm);
 }
 
+namespace {
+
+struct WoqLinearConfig {
+  // at::kQInt8 or at::kQUInt4x2, nullopt if aten::linear is not rewritten
+  c10::optional<at::ScalarType> weight_dtype;
+  int64_t group_size = -1;
+};
+
+WoqLinearConfig& woqLinearConfig() {
+  static WoqLinearConfig config;
+  return config;
+}
+
+} // namespace
+
+void setWoqLinearConfig(const std::string& weight_dtype, int64_t group_size) {
+  auto& config = woqLinearConfig();
+  if (weight_dtype.empty()) {
+    config.weight_dtype = c10::nullopt;
+  } else if (weight_dtype == "int8") {
+    config.weight_dtype = at::kQInt8;
+  } else if (weight_dtype == "int4") {
+    config.weight_dtype = at::kQUInt4x2;
+  } else {
+    TORCH_CHECK(
+        false,
+        "Weight-only quantization supports \"int8\" and \"int4\" weights, "
+        "but got ",
+        weight_dtype);
+  }
+  config.group_size = group_size;
+}
+
+std::tuple<std::string, int64_t> getWoqLinearConfig() {
+  auto& config = woqLinearConfig();
+  std::string weight_dtype;
+  if (config.weight_dtype.has_value()) {
+    weight_dtype = config.weight_dtype.value() == at::kQInt8 ? "int8" : "int4";
+  }
+  return std::make_tuple(weight_dtype, config.group_size);
+}
+
+void insertPrePackedWoqLinearOp(
+    Block* b,
+    std::unordered_set<Node*>& aten_linear,
+    std::vector<Node*>& get_data_handle_nodes) {
+  auto& config = woqLinearConfig();
+  for (Node* n : b->nodes()) {
+    for (Block* block : n->blocks()) {
+      insertPrePackedWoqLinearOp(block, aten_linear, get_data_handle_nodes);
+    }
+    WithInsertPoint guard(n);
+    auto graph = n->owningGraph();
+    Value* op_context = nullptr;
+    if (n->kind() == Symbol::fromQualString("torch_ipex::ipex_woq_linear")) {
+      // linear converted by ipex.optimize, reuse its frozen op context
+      op_context = n->inputs().at(3)->node()->inputs().at(0);
+      // For graph before "freeze", cannot get custom class to repack
+      if (!toIValue(op_context).has_value()) {
+        continue;
+      }
+      get_data_handle_nodes.emplace_back(n->inputs().at(3)->node());
+    } else if (n->kind() == aten::linear && config.weight_dtype.has_value()) {
+      auto weight = constant_as<at::Tensor>(n->namedInput("weight"));
+      if (!weight.has_value() || weight->dim() != 2 ||
+          weight->size(1) == 0 ||
+          (weight->scalar_type() != at::kFloat &&
+           weight->scalar_type() != at::kBFloat16)) {
+        continue;
+      }
+      auto prepack_node = graph->create(
+          Symbol::fromQualString("ipex_prepack::woq_linear_prepack"), 1);
+      prepack_node->addInput(n->namedInput("weight"));
+      prepack_node->addInput(n->namedInput("bias"));
+      prepack_node->addInput(
+          graph->insertConstant(IValue(config.weight_dtype.value())));
+      prepack_node->addInput(graph->insertConstant(config.group_size));
+      prepack_node->output()->setType(getCustomClass(
+          "__torch__.torch.classes.ipex_prepack.WoqLinearOpContext"));
+      graph->insertNode(prepack_node);
+      op_context = prepack_node->output();
+      aten_linear.erase(n);
+    } else {
+      continue;
+    }
+    auto woq_linear = graph->insertNode(graph->create(
+        Symbol::fromQualString("ipex_prepack::woq_linear_run"), 1));
+    woq_linear->addInput(n->inputs().at(0));
+    woq_linear->addInput(op_context);
+    woq_linear->output()->setType(n->output()->type()->cast<TensorType>());
+    n->output()->replaceAllUsesWith(woq_linear->output());
+  }
+  EliminateDeadCode(b);
+}
+
+void insertPrePackedWoqLinearOp(
+    std::shared_ptr<Graph>& graph,
+    std::unordered_set<Node*>& aten_linear) {
+  std::vector<Node*> get_data_handle_nodes;
+  insertPrePackedWoqLinearOp(
+      graph->block(), aten_linear, get_data_handle_nodes);
+  for (auto& n : get_data_handle_nodes) {
+    n->destroy();
+  }
+  EliminateDeadCode(graph);
+}
+
+namespace {
+
+struct DynamicQuantLinearConfig {
+  // whether the activation has per-token scales, nullopt if aten::linear is
+  // not rewritten
+  c10::optional<bool> per_token;
+  bool per_channel_weight = true;
+};
+
+DynamicQuantLinearConfig& dynamicQuantLinearConfig() {
+  static DynamicQuantLinearConfig config;
+  return config;
+}
+
+// The eltwise consuming the linear output that can be fused into the
+// epilogue of the dynamic quantized or sparse linear, with its post op name,
+// or nullptr
+std::pair<Node*, std::string> linearEpiloguePostOp(Node* linear) {
+  auto output = linear->output();
+  if (output->uses().size() != 1) {
+    return {nullptr, "none"};
+  }
+  auto user = output->uses()[0].user;
+  if (user->kind() == aten::relu) {
+    return {user, "relu"};
+  }
+  if (user->kind() == aten::gelu &&
+      (user->inputs().size() == 1 ||
+       constant_as<std::string>(user->input(1)).value_or("") == "none")) {
+    return {user, "gelu"};
+  }
+  return {nullptr, "none"};
+}
+
+// A linear run by a prepacked op context with the relu/gelu epilogue of
+// linearEpiloguePostOp, see insertPrePackedEpilogueLinearOp
+struct EpilogueLinearOp {
+  // op of the linears converted by the frontend, its frozen op context is
+  // reused
+  Symbol converted;
+  Symbol prepack;
+  Symbol run;
+  std::string context_class;
+  // whether aten::linear with this constant FP32/BF16 weight is rewritten
+  bool (*gate)(const at::Tensor& weight);
+  // constant inputs of the prepack op after the weight and bias
+  std::vector<IValue> prepack_args;
+};
+
+void insertPrePackedEpilogueLinearOp(
+    Block* b,
+    const EpilogueLinearOp& op,
+    std::unordered_set<Node*>& aten_linear,
+    std::vector<Node*>& get_data_handle_nodes) {
+  for (Node* n : b->nodes()) {
+    for (Block* block : n->blocks()) {
+      insertPrePackedEpilogueLinearOp(
+          block, op, aten_linear, get_data_handle_nodes);
+    }
+    WithInsertPoint guard(n);
+    auto graph = n->owningGraph();
+    Value* op_context = nullptr;
+    if (n->kind() == op.converted) {
+      op_context = n->inputs().at(3)->node()->inputs().at(0);
+      // For graph before "freeze", cannot get custom class to repack
+      if (!toIValue(op_context).has_value()) {
+        continue;
+      }
+      get_data_handle_nodes.emplace_back(n->inputs().at(3)->node());
+    } else if (n->kind() == aten::linear) {
+      auto weight = constant_as<at::Tensor>(n->namedInput("weight"));
+      if (!weight.has_value() || weight->dim() != 2 ||
+          weight->size(1) == 0 ||
+          (weight->scalar_type() != at::kFloat &&
+           weight->scalar_type() != at::kBFloat16) ||
+          !op.gate(weight.value())) {
+        continue;
+      }
+      auto prepack_node = graph->create(op.prepack, 1);
+      prepack_node->addInput(n->namedInput("weight"));
+      prepack_node->addInput(n->namedInput("bias"));
+      for (const auto& arg : op.prepack_args) {
+        prepack_node->addInput(graph->insertConstant(arg));
+      }
+      prepack_node->output()->setType(getCustomClass(op.context_class));
+      graph->insertNode(prepack_node);
+      op_context = prepack_node->output();
+      aten_linear.erase(n);
+    } else {
+      continue;
+    }
+    auto post_op = linearEpiloguePostOp(n);
+    auto output = post_op.first != nullptr ? post_op.first->output()
+                                           : n->output();
+    auto run_node = graph->insertNode(graph->create(op.run, 1));
+    run_node->addInput(n->inputs().at(0));
+    run_node->addInput(graph->insertConstant(post_op.second));
+    run_node->addInput(op_context);
+    run_node->output()->setType(output->type()->cast<TensorType>());
+    output->replaceAllUsesWith(run_node->output());
+  }
+  EliminateDeadCode(b);
+}
+
+void insertPrePackedEpilogueLinearOp(
+    std::shared_ptr<Graph>& graph,
+    const EpilogueLinearOp& op,
+    std::unordered_set<Node*>& aten_linear) {
+  std::vector<Node*> get_data_handle_nodes;
+  insertPrePackedEpilogueLinearOp(
+      graph->block(), op, aten_linear, get_data_handle_nodes);
+  for (auto& n : get_data_handle_nodes) {
+    n->destroy();
+  }
+  EliminateDeadCode(graph);
+}
+
+} // namespace
+
+void setDynamicQuantLinearConfig(
+    const std::string& activation_granularity,
+    bool per_channel_weight) {
+  auto& config = dynamicQuantLinearConfig();
+  if (activation_granularity.empty()) {
+    config.per_token = c10::nullopt;
+  } else if (activation_granularity == "per_tensor") {
+    config.per_token = false;
+  } else if (activation_granularity == "per_token") {
+    config.per_token = true;
+  } else {
+    TORCH_CHECK(
+        false,
+        "Dynamic quantized linear supports \"per_tensor\" and "
+        "\"per_token\" activation scales, but got ",
+        activation_granularity);
+  }
+  config.per_channel_weight = per_channel_weight;
+}
+
+std::tuple<std::string, bool> getDynamicQuantLinearConfig() {
+  auto& config = dynamicQuantLinearConfig();
+  std::string activation_granularity;
+  if (config.per_token.has_value()) {
+    activation_granularity =
+        config.per_token.value() ? "per_token" : "per_tensor";
+  }
+  return std::make_tuple(activation_granularity, config.per_channel_weight);
+}
+
+void insertPrePackedDynamicQuantLinearOp(
+    std::shared_ptr<Graph>& graph,
+    std::unordered_set<Node*>& aten_linear) {
+  auto& config = dynamicQuantLinearConfig();
+  EpilogueLinearOp op;
+  // linear converted by ipex.quantization.convert
+  op.converted =
+      Symbol::fromQualString("torch_ipex::ipex_dynamic_quant_linear");
+  op.prepack =
+      Symbol::fromQualString("ipex_prepack::dynamic_quant_linear_prepack");
+  op.run = Symbol::fromQualString("ipex_prepack::dynamic_quant_linear_run");
+  op.context_class =
+      "__torch__.torch.classes.ipex_prepack.DynamicQuantLinearOpContext";
+  op.gate = [](const at::Tensor&) {
+    return dynamicQuantLinearConfig().per_token.has_value();
+  };
+  if (config.per_token.has_value()) {
+    op.prepack_args = {config.per_channel_weight, config.per_token.value()};
+  }
+  insertPrePackedEpilogueLinearOp(graph, op, aten_linear);
+}
+
+namespace {
+
+// aten::linear with a constant weight whose block density is below the
+// threshold is rewritten, 0 disables the rewrite
+double& sparseLinearDensityThreshold() {
+  static double threshold = 0;
+  return threshold;
+}
+
+} // namespace
+
+void setSparseLinearDensityThreshold(double threshold) {
+  TORCH_CHECK(
+      threshold >= 0 && threshold <= 1,
+      "Sparse linear density threshold should be in [0, 1], but got ",
+      threshold);
+  sparseLinearDensityThreshold() = threshold;
+}
+
+double getSparseLinearDensityThreshold() {
+  return sparseLinearDensityThreshold();
+}
+
+void insertPrePackedSparseLinearOp(
+    std::shared_ptr<Graph>& graph,
+    std::unordered_set<Node*>& aten_linear) {
+  EpilogueLinearOp op;
+  // linear converted by ipex.optimize
+  op.converted = Symbol::fromQualString("torch_ipex::ipex_sparse_linear");
+  op.prepack = Symbol::fromQualString("ipex_prepack::sparse_linear_prepack");
+  op.run = Symbol::fromQualString("ipex_prepack::sparse_linear_run");
+  op.context_class =
+      "__torch__.torch.classes.ipex_prepack.SparseLinearOpContext";
+  op.gate = [](const at::Tensor& weight) {
+    auto threshold = sparseLinearDensityThreshold();
+    return threshold > 0 &&
+        torch_ipex::cpu::sparse_linear_block_density(weight) < threshold;
+  };
+  insertPrePackedEpilogueLinearOp(graph, op, aten_linear);
+}
+
+namespace {
+
+bool& gatedMlpFusionEnabled() {
+  static bool enabled = true;
+  return enabled;
+}
+
+// aten::linear of a gated MLP: a constant 2-D FP32/BF16 weight, a constant
+// bias of the same dtype or none, its output only used by the gated MLP, and
+// lowered to an IPEX linear, see insertPrePackedLinearOp
+bool isGatedMlpLinear(Node* n, std::unordered_set<Node*>& aten_linear) {
+  if (n->kind() != aten::linear || n->output()->uses().size() != 1) {
+    return false;
+  }
+  auto weight = constant_as<at::Tensor>(n->namedInput("weight"));
+  if (!weight.has_value() || weight->dim() != 2) {
+    return false;
+  }
+  auto bias = n->namedInput("bias");
+  if (bias->type() != NoneType::get()) {
+    auto bias_tensor = constant_as<at::Tensor>(bias);
+    if (!bias_tensor.has_value() ||
+        bias_tensor->scalar_type() != weight->scalar_type()) {
+      return false;
+    }
+  }
+  if (weight->scalar_type() == at::kBFloat16) {
+    return ideep::has_bf16_type_support();
+  }
+  return weight->scalar_type() == at::kFloat &&
+      aten_linear.find(n) == aten_linear.end();
+}
+
+// Activation of the gate whose output is only used by the gated MLP, "silu",
+// "gelu" or "gelu_tanh", or an empty string if it cannot be fused
+std::string gatedMlpAct(Node* n) {
+  if (n->outputs().size() != 1 || n->output()->uses().size() != 1) {
+    return "";
+  }
+  if (n->kind() == aten::silu) {
+    return "silu";
+  }
+  if (n->kind() == aten::gelu) {
+    auto approximate = constant_as<std::string>(n->namedInput("approximate"));
+    if (approximate.has_value() && approximate.value() == "none") {
+      return "gelu";
+    }
+    if (approximate.has_value() && approximate.value() == "tanh") {
+      return "gelu_tanh";
+    }
+  }
+  return "";
+}
+
+} // namespace
+
+void setGatedMlpFusionEnabled(bool enabled) {
+  gatedMlpFusionEnabled() = enabled;
+}
+
+bool getGatedMlpFusionEnabled() {
+  return gatedMlpFusionEnabled();
+}
+
+//       x ---------+
+//       |          |
+//  linear(gate) linear(up)
+//       |          |
+//      act         |
+//       +-- mul ---+
+// output = act(x W_gate^T + b_gate) * (x W_up^T + b_up)
+void fuseGatedMlp(Block* b, std::unordered_set<Node*>& aten_linear) {
+  for (Node* n : b->nodes()) {
+    for (Block* block : n->blocks()) {
+      fuseGatedMlp(block, aten_linear);
+    }
+    if (n->kind() != aten::mul || n->inputs().size() != 2) {
+      continue;
+    }
+    // the gate may be either operand of the mul
+    for (size_t i = 0; i < 2; i++) {
+      Node* act = n->inputs().at(i)->node();
+      Node* up = n->inputs().at(1 - i)->node();
+      auto act_name = gatedMlpAct(act);
+      if (act_name.empty()) {
+        continue;
+      }
+      Node* gate = act->inputs().at(0)->node();
+      if (gate == up || !isGatedMlpLinear(gate, aten_linear) ||
+          !isGatedMlpLinear(up, aten_linear) ||
+          gate->inputs().at(0) != up->inputs().at(0)) {
+        continue;
+      }
+      auto gate_weight = constant_as<at::Tensor>(gate->namedInput("weight"));
+      auto up_weight = constant_as<at::Tensor>(up->namedInput("weight"));
+      if (gate_weight->sizes() != up_weight->sizes() ||
+          gate_weight->scalar_type() != up_weight->scalar_type()) {
+        continue;
+      }
+      WithInsertPoint guard(n);
+      auto graph = n->owningGraph();
+      auto prepack_node = graph->create(
+          Symbol::fromQualString("ipex_prepack::gated_mlp_prepack"), 1);
+      prepack_node->addInput(gate->namedInput("weight"));
+      prepack_node->addInput(gate->namedInput("bias"));
+      prepack_node->addInput(up->namedInput("weight"));
+      prepack_node->addInput(up->namedInput("bias"));
+      prepack_node->addInput(graph->insertConstant(act_name));
+      prepack_node->output()->setType(getCustomClass(
+          "__torch__.torch.classes.ipex_prepack.GatedMlpOpContext"));
+      graph->insertNode(prepack_node);
+      auto gated_mlp = graph->insertNode(graph->create(
+          Symbol::fromQualString("ipex_prepack::gated_mlp_run"), 1));
+      gated_mlp->addInput(gate->inputs().at(0));
+      gated_mlp->addInput(prepack_node->output());
+      gated_mlp->output()->setType(n->output()->type()->cast<TensorType>());
+      n->output()->replaceAllUsesWith(gated_mlp->output());
+      aten_linear.erase(gate);
+      aten_linear.erase(up);
+      break;
+    }
+  }
+  EliminateDeadCode(b);
+}
+
+void fuseGatedMlp(
+    std::shared_ptr<Graph>& graph,
+    std::unordered_set<Node*>& aten_linear) {
+  fuseGatedMlp(graph->block(), aten_linear);
+  EliminateDeadCode(graph);
+}
+
 void RecordAtenLinearNodes(
     Block* b,
     std::unordered_set<Node*>& aten_linear,
@@ -0,0 +1,248 @@
+#include "grouped_linear.h"
+#include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/ir/ir.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <atomic>
+#include <unordered_set>
+#include <vector>
+
+#include "cpu/kernels/GroupedLinear.h"
+#include "folding_common_utils.h"
+
+namespace torch_ipex {
+namespace jit {
+namespace {
+
+using Tensor = at::Tensor;
+using namespace torch::jit;
+
+std::atomic<bool> grouped_linear_enabled{false};
+
+// Grouping pays off when each linear alone is too small to keep all cores
+// busy. Larger GEMMs already scale well on their own and are left to the
+// prepacked oneDNN linear.
+constexpr int64_t kMaxGroupedLinearRows = 256;
+
+class GroupLinearLayers {
+ public:
+  explicit GroupLinearLayers(std::shared_ptr<Graph> graph)
+      : graph_(std::move(graph)) {}
+
+  bool run(std::unordered_set<Node*>& aten_linear) {
+    handleBlockAndSubblocks(graph_->block(), aten_linear);
+    return graph_modified;
+  }
+
+  AliasDb* getAliasDb() {
+    if (!aliasDb_) {
+      aliasDb_ = std::make_unique<AliasDb>(graph_);
+    }
+    return aliasDb_.get();
+  }
+
+  bool isGroupableLinear(Node* n, std::unordered_set<Node*>& aten_linear) {
+    // Only linears owned by IPEX are grouped, fp32 aten linears recorded
+    // before the IPEX linears were unpacked are left as they are.
+    if (n->kind() != aten::linear || aten_linear.count(n) ||
+        nonConstantParameters(n)) {
+      return false;
+    }
+    auto weight = constant_as<Tensor>(n->namedInput("weight"));
+    if (!weight.has_value() || weight->dim() != 2 ||
+        weight->scalar_type() != at::kFloat || weight->size(1) == 0) {
+      return false;
+    }
+    auto bias = n->namedInput("bias");
+    if (bias->type() != NoneType::get()) {
+      auto bias_tensor = constant_as<Tensor>(bias);
+      if (!bias_tensor.has_value() ||
+          bias_tensor->scalar_type() != at::kFloat) {
+        return false;
+      }
+    }
+    auto input_type = n->inputs().at(0)->type()->cast<TensorType>();
+    if (!input_type || input_type->scalarType() != at::kFloat) {
+      return false;
+    }
+    auto input_sizes = input_type->sizes().concrete_sizes();
+    if (!input_sizes.has_value() || input_sizes->empty()) {
+      return false;
+    }
+    int64_t rows = 1;
+    for (size_t i = 0; i + 1 < input_sizes->size(); i++) {
+      rows *= (*input_sizes)[i];
+    }
+    return rows <= kMaxGroupedLinearRows;
+  }
+
+  // Returns the eltwise node that can be folded into the grouped linear as
+  // the post op of `linear` and sets `post_op` to its name, or returns
+  // nullptr if there is none.
+  Node* getFoldableEltwise(Node* linear, std::string& post_op) {
+    auto output = linear->output();
+    if (output->uses().size() != 1) {
+      return nullptr;
+    }
+    Node* user = output->uses()[0].user;
+    if (user->owningBlock() != linear->owningBlock() ||
+        user->inputs().at(0) != output) {
+      return nullptr;
+    }
+    if (user->kind() == aten::relu) {
+      post_op = "relu";
+    } else if (user->kind() == aten::sigmoid) {
+      post_op = "sigmoid";
+    } else if (user->kind() == aten::tanh) {
+      post_op = "tanh";
+    } else if (user->kind() == aten::gelu) {
+      auto approximate = constant_as<std::string>(user->input(1));
+      if (!approximate.has_value() || approximate.value() != "none") {
+        return nullptr;
+      }
+      post_op = "gelu";
+    } else {
+      return nullptr;
+    }
+    return user;
+  }
+
+  void groupLinearLayers(
+      std::vector<Node*>& group,
+      std::unordered_set<Node*>& aten_linear) {
+    graph_modified = true;
+    Node* earliest = group[0];
+    for (auto n : group) {
+      if (n->isBefore(earliest)) {
+        earliest = n;
+      }
+    }
+
+    WithInsertPoint guard(earliest);
+    std::vector<Value*> inputs, weights, biases, post_ops;
+    std::vector<Value*> replaced_values;
+    std::vector<Node*> nodes_to_destroy;
+    for (auto n : group) {
+      inputs.push_back(n->inputs().at(0));
+      weights.push_back(n->namedInput("weight"));
+      biases.push_back(n->namedInput("bias"));
+      std::string post_op;
+      Node* eltwise = getFoldableEltwise(n, post_op);
+      post_ops.push_back(graph_->insertConstant(post_op));
+      if (eltwise) {
+        replaced_values.push_back(eltwise->output());
+        nodes_to_destroy.push_back(eltwise);
+      } else {
+        replaced_values.push_back(n->output());
+      }
+      nodes_to_destroy.push_back(n);
+    }
+
+    auto input_list =
+        graph_->insertNode(graph_->createList(TensorType::get(), inputs));
+    auto weight_list =
+        graph_->insertNode(graph_->createList(TensorType::get(), weights));
+    auto bias_list = graph_->insertNode(
+        graph_->createList(OptionalType::ofTensor(), biases));
+    auto post_op_list =
+        graph_->insertNode(graph_->createList(StringType::get(), post_ops));
+    auto grouped_linear = graph_->insertNode(graph_->create(
+        ipex::grouped_linear,
+        {input_list->output(),
+         weight_list->output(),
+         bias_list->output(),
+         post_op_list->output()}));
+    grouped_linear->output()->setType(ListType::ofTensors());
+    auto unpack = graph_->insertNode(
+        graph_->createListUnpack(grouped_linear->output(), group.size()));
+
+    for (size_t i = 0; i < group.size(); i++) {
+      unpack->output(i)->setType(replaced_values[i]->type());
+      replaced_values[i]->replaceAllUsesWith(unpack->output(i));
+    }
+    for (auto n : nodes_to_destroy) {
+      aten_linear.erase(n);
+      n->destroy();
+    }
+  }
+
+  void handleBlockAndSubblocks(
+      Block* block,
+      std::unordered_set<Node*>& aten_linear) {
+    for (auto node : block->nodes()) {
+      for (Block* subblock : node->blocks()) {
+        handleBlockAndSubblocks(subblock, aten_linear);
+      }
+    }
+
+    std::vector<Node*> candidates;
+    for (auto node : block->nodes()) {
+      if (isGroupableLinear(node, aten_linear)) {
+        candidates.push_back(node);
+      }
+    }
+
+    // Greedily build groups in topological order. A linear joins the group
+    // if it can be moved right before the earliest member, which means it
+    // does not depend on any member and all inputs of the group are
+    // available at the earliest member.
+    std::unordered_set<Node*> grouped;
+    std::vector<std::vector<Node*>> groups;
+    for (size_t i = 0; i < candidates.size(); i++) {
+      if (grouped.count(candidates[i])) {
+        continue;
+      }
+      std::vector<Node*> group = {candidates[i]};
+      Node* earliest = candidates[i];
+      for (size_t j = i + 1; j < candidates.size(); j++) {
+        auto node = candidates[j];
+        if (grouped.count(node)) {
+          continue;
+        }
+        if (!getAliasDb()->moveBeforeTopologicallyValid(node, earliest)) {
+          continue;
+        }
+        earliest = node;
+        group.push_back(node);
+        grouped.insert(node);
+      }
+      if (group.size() > 1) {
+        grouped.insert(candidates[i]);
+        groups.push_back(std::move(group));
+      }
+    }
+
+    // The graph is only mutated after all moves that need the AliasDb
+    for (auto& group : groups) {
+      groupLinearLayers(group, aten_linear);
+    }
+  }
+
+ private:
+  std::shared_ptr<Graph> graph_;
+  bool graph_modified = false;
+  std::unique_ptr<AliasDb> aliasDb_ = nullptr;
+};
+} // namespace
+
+void setGroupedLinearEnabled(bool enabled) {
+  grouped_linear_enabled = enabled;
+}
+
+bool getGroupedLinearEnabled() {
+  return grouped_linear_enabled;
+}
+
+TORCH_API bool FrozenGroupedLinear(
+    std::shared_ptr<Graph>& graph,
+    std::unordered_set<Node*>& aten_linear) {
+  GroupLinearLayers groupLayers(graph);
+  GRAPH_DUMP("Before FrozenGroupedLinear", graph);
+  bool changed = groupLayers.run(aten_linear);
+  if (changed) {
+    GRAPH_DUMP("After FrozenGroupedLinear", graph);
+  }
+  return changed;
+}
+
+} // namespace jit
+} // namespace torch_ipex
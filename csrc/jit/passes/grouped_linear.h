@@ -0,0 +1,21 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch_ipex {
+namespace jit {
+
+// Groups independent FP32 linears with constant weights and small inputs,
+// which cannot be concatenated by FrozenConcatLinear because they have
+// different inputs, into one ipex::grouped_linear. A unary eltwise op that
+// is the only user of a grouped linear is folded in as the post op of its
+// group.
+TORCH_API bool FrozenGroupedLinear(
+    std::shared_ptr<torch::jit::Graph>& graph,
+    std::unordered_set<torch::jit::Node*>& aten_linear);
+
+TORCH_API void setGroupedLinearEnabled(bool enabled);
+TORCH_API bool getGroupedLinearEnabled();
+
+} // namespace jit
+} // namespace torch_ipex
@@ -0,0 +1,269 @@
+#include "memory_planner.h"
+#include "cpu/kernels/ActivationArena.h"
+
+#include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/runtime/graph_iterator.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <unordered_map>
+
+namespace torch_ipex {
+namespace jit {
+
+using namespace torch::jit;
+using namespace torch_ipex::cpu::detail::arena;
+
+namespace {
+
+std::atomic<bool> activation_memory_planning_enabled{false};
+
+struct PlannedValue {
+  Value* value;
+  std::vector<int64_t> sizes;
+  std::vector<int64_t> strides;
+  int64_t bytes;
+  // index of the first and the last top-level node that touches the value
+  size_t begin;
+  size_t end;
+  int64_t offset = -1;
+};
+
+int64_t alignUp(int64_t bytes) {
+  return (bytes + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment;
+}
+
+bool isUnaryPostOpRun(Symbol kind, const std::string& prefix) {
+  static const std::vector<std::string> unary_post_ops = {
+      "",
+      "relu_",
+      "sigmoid_",
+      "swish_",
+      "tanh_",
+      "mish_",
+      "abs_",
+      "exp_",
+      "hardswish_",
+      "square_",
+      "log_",
+      "round_",
+      "sqrt_",
+      "hardsigmoid_"};
+  for (const auto& op : unary_post_ops) {
+    if (kind == Symbol::fromQualString(prefix + op + "run")) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool hasOutVariant(Node* n) {
+  if (isUnaryPostOpRun(n->kind(), "ipex_prepack::convolution_") ||
+      isUnaryPostOpRun(n->kind(), "ipex_prepack::linear_") ||
+      n->kind() == aten::bmm) {
+    return true;
+  }
+  if (n->kind() == Symbol::fromQualString("ipex::softmax")) {
+    // the out-variant does not support dtype conversion
+    auto dtype = toIValue(n->input(2));
+    return dtype.has_value() && dtype->isNone();
+  }
+  return false;
+}
+
+Symbol getOutVariant(Symbol kind) {
+  if (kind == aten::bmm) {
+    return Symbol::fromQualString("ipex::bmm_out");
+  }
+  return Symbol::fromQualString(std::string(kind.toQualString()) + "_out");
+}
+
+// Returns the bytes spanned by a tensor value whose dtype, sizes and strides
+// are all known at compile time, otherwise c10::nullopt.
+c10::optional<int64_t> getStaticBytes(
+    Value* v,
+    std::vector<int64_t>& sizes,
+    std::vector<int64_t>& strides) {
+  auto type = v->type()->cast<TensorType>();
+  if (!type) {
+    return c10::nullopt;
+  }
+  auto concrete_sizes = type->sizes().concrete_sizes();
+  auto concrete_strides = type->strides().concrete_sizes();
+  auto dtype = type->scalarType();
+  auto device = type->device();
+  if (!concrete_sizes || !concrete_strides || !dtype || !device ||
+      !device->is_cpu() || type->requiresGrad().value_or(true)) {
+    return c10::nullopt;
+  }
+  int64_t span = 1;
+  for (size_t i = 0; i < concrete_sizes->size(); i++) {
+    auto size = (*concrete_sizes)[i];
+    auto stride = (*concrete_strides)[i];
+    if (size == 0 || stride < 0) {
+      return c10::nullopt;
+    }
+    span += (size - 1) * stride;
+  }
+  sizes = *concrete_sizes;
+  strides = *concrete_strides;
+  return span * static_cast<int64_t>(c10::elementSize(*dtype));
+}
+
+// Greedy-by-size offset assignment: place the largest values first, each at
+// the smallest gap between already placed values with overlapping lifetime
+// that can hold it. Returns the arena size.
+int64_t assignOffsets(std::vector<PlannedValue>& planned) {
+  std::vector<PlannedValue*> order;
+  for (auto& p : planned) {
+    order.push_back(&p);
+  }
+  std::stable_sort(
+      order.begin(), order.end(), [](PlannedValue* a, PlannedValue* b) {
+        return a->bytes > b->bytes;
+      });
+
+  int64_t arena_bytes = 0;
+  std::vector<PlannedValue*> placed;
+  for (auto p : order) {
+    std::vector<PlannedValue*> live;
+    for (auto q : placed) {
+      if (!(q->end < p->begin || p->end < q->begin)) {
+        live.push_back(q);
+      }
+    }
+    std::sort(live.begin(), live.end(), [](PlannedValue* a, PlannedValue* b) {
+      return a->offset < b->offset;
+    });
+    int64_t best_offset = -1;
+    int64_t best_gap = std::numeric_limits<int64_t>::max();
+    int64_t prev_end = 0;
+    for (auto q : live) {
+      auto gap = q->offset - prev_end;
+      if (gap >= p->bytes && gap < best_gap) {
+        best_gap = gap;
+        best_offset = prev_end;
+      }
+      prev_end = std::max(prev_end, q->offset + q->bytes);
+    }
+    p->offset = best_offset >= 0 ? best_offset : prev_end;
+    arena_bytes = std::max(arena_bytes, p->offset + p->bytes);
+    placed.push_back(p);
+  }
+  return arena_bytes;
+}
+
+} // namespace
+
+void setActivationMemoryPlanningEnabled(bool enabled) {
+  activation_memory_planning_enabled = enabled;
+}
+
+bool getActivationMemoryPlanningEnabled() {
+  return activation_memory_planning_enabled;
+}
+
+void PlanActivationMemory(std::shared_ptr<Graph>& graph) {
+  // Values used by a forked task may be alive beyond the lifetime we can
+  // see on this graph, don't plan such graphs at all.
+  std::vector<Value*> all_values(
+      graph->inputs().begin(), graph->inputs().end());
+  DepthFirstGraphNodeIterator it(graph);
+  for (auto* node = it.next(); node != nullptr; node = it.next()) {
+    if (node->kind() == prim::fork) {
+      return;
+    }
+    for (auto output : node->outputs()) {
+      all_values.push_back(output);
+    }
+  }
+
+  auto block = graph->block();
+  std::unordered_map<Node*, size_t> node_index;
+  size_t num_nodes = 0;
+  for (auto node : block->nodes()) {
+    node_index[node] = num_nodes++;
+  }
+  // A use inside a sub-block keeps the value alive until the top-level node
+  // owning that block finishes.
+  auto topLevelIndex = [&](Node* n) {
+    while (n->owningBlock() != block) {
+      n = n->owningBlock()->owningNode();
+    }
+    auto found = node_index.find(n);
+    return found == node_index.end() ? num_nodes : found->second;
+  };
+
+  AliasDb aliasDb(graph);
+  std::vector<PlannedValue> planned;
+  for (auto node : block->nodes()) {
+    if (!hasOutVariant(node)) {
+      continue;
+    }
+    auto v = node->output();
+    std::vector<int64_t> sizes, strides;
+    auto bytes = getStaticBytes(v, sizes, strides);
+    // The arena is reused by the next call, so nothing that may escape the
+    // graph can be placed in it.
+    if (!bytes || aliasDb.mayAliasWildcard(v) ||
+        aliasDb.mayContainAlias(v, graph->outputs())) {
+      continue;
+    }
+    auto begin = node_index[node];
+    auto end = begin;
+    for (auto u : all_values) {
+      if (u != v && !aliasDb.mayContainAlias(v, u)) {
+        continue;
+      }
+      for (const auto& use : u->uses()) {
+        end = std::max(end, topLevelIndex(use.user));
+      }
+    }
+    planned.push_back(
+        {v, std::move(sizes), std::move(strides), alignUp(*bytes), begin, end});
+  }
+  if (planned.empty()) {
+    return;
+  }
+
+  int64_t naive_bytes = 0;
+  for (const auto& p : planned) {
+    naive_bytes += p.bytes;
+  }
+  auto arena_bytes = assignOffsets(planned);
+  auto plan_id = register_memory_plan(planned.size(), arena_bytes, naive_bytes);
+  GRAPH_DEBUG(
+      "Activation memory plan ",
+      plan_id,
+      ": ",
+      planned.size(),
+      " values, peak ",
+      arena_bytes,
+      " bytes vs. naive ",
+      naive_bytes,
+      " bytes");
+
+  for (const auto& p : planned) {
+    auto node = p.value->node();
+    WithInsertPoint guard(node);
+    std::vector<Value*> inputs(node->inputs().begin(), node->inputs().end());
+    if (node->kind() == Symbol::fromQualString("ipex::softmax")) {
+      // drop the dtype which is always None here
+      inputs.pop_back();
+    }
+    inputs.push_back(graph->insertConstant(plan_id));
+    inputs.push_back(graph->insertConstant(p.offset));
+    inputs.push_back(graph->insertConstant(p.sizes));
+    inputs.push_back(graph->insertConstant(p.strides));
+    auto out_node = graph->create(getOutVariant(node->kind()), inputs);
+    out_node->output()->setType(p.value->type());
+    out_node->insertBefore(node);
+    node->output()->replaceAllUsesWith(out_node->output());
+    node->destroy();
+  }
+}
+
+} // namespace jit
+} // namespace torch_ipex
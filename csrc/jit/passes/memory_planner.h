@@ -0,0 +1,22 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch_ipex {
+namespace jit {
+
+// Static activation memory planning for frozen graphs with fixed shapes.
+//
+// Computes the lifetime of every output of the prepacked convolution/linear
+// runs, aten::bmm and ipex::softmax whose shape is fully known, assigns each
+// of them a 64B-aligned offset in a single arena so that values with
+// overlapping lifetimes never overlap in memory, and rewrites the producers
+// to out-variants writing into their arena slice. The arena is allocated per
+// thread at runtime, see cpu/kernels/ActivationArena.h.
+TORCH_API void PlanActivationMemory(std::shared_ptr<torch::jit::Graph>& graph);
+
+TORCH_API void setActivationMemoryPlanningEnabled(bool enabled);
+TORCH_API bool getActivationMemoryPlanningEnabled();
+
+} // namespace jit
+} // namespace torch_ipex
@@ -5,14 +5,21 @@
 
 #include "aten/AddLayerNorm.h"
 #include "aten/ConcatBnRelu.h"
+#include "aten/GroupNorm.h"
+#include "cpu/kernels/ConcatBuffer.h"
 #include "cpu/kernels/ConvPacked.h"
 #include "cpu/kernels/ConvTransposePacked.h"
 #include "cpu/kernels/Einsum.h"
 #include "cpu/kernels/Embeddingbag.h"
+#include "cpu/kernels/GatedMlpPacked.h"
+#include "cpu/kernels/GroupedLinear.h"
 #include "cpu/kernels/Interaction.h"
+#include "cpu/kernels/LinearDynamicQuantPacked.h"
 #include "cpu/kernels/LinearMKLPacked.h"
 #include "cpu/kernels/LinearPacked.h"
+#include "cpu/kernels/LinearSparsePacked.h"
 #include "cpu/kernels/LinearSwishCustomized.h"
+#include "cpu/kernels/LinearWoqPacked.h"
 #include "cpu/kernels/Matmul.h"
 #include "cpu/kernels/MaxPool2D.h"
 #include "cpu/kernels/Mha.h"
@@ -30,6 +37,11 @@ using namespace torch_ipex::cpu::detail::convolution;
 using namespace torch_ipex::cpu::detail::linear;
 using namespace torch_ipex::cpu::detail::conv_transpose;
 using namespace torch_ipex::cpu::detail::mkl_sgemm;
+using namespace torch_ipex::cpu::detail::woq_linear;
+using namespace torch_ipex::cpu::detail::dynamic_quant_linear;
+using namespace torch_ipex::cpu::detail::sparse_linear;
+using namespace torch_ipex::cpu::detail::gated_mlp;
+using namespace torch_ipex::cpu::detail::concat;
 
 c10::AliasAnalysisKind aliasAnalysisFromSchema() {
   return c10::AliasAnalysisKind::FROM_SCHEMA;
@@ -180,6 +192,137 @@ at::Tensor toOptionalTensor(const IValue& v) {
       },                                                             \
       aliasAnalysisFromSchema())
 
+// Out-variants inserted by the activation memory planner. They write into a
+// per-thread arena shared by many values, so they are registered with
+// conservative alias analysis to keep them away from CSE and DCE.
+#define PLANNED_OUT_ARGS "int plan_id, int offset, int[] sizes, int[] strides"
+
+#define CreateConvUnaryPostOpRunOut(FUSED_OP, ATTR)                    \
+  Operator(                                                            \
+      "ipex_prepack::convolution_" #FUSED_OP                           \
+      "_out(Tensor input, "                                            \
+      "__torch__.torch.classes.ipex_prepack.ConvolutionOpContext "     \
+      "W_prepack, " PLANNED_OUT_ARGS ") -> Tensor",                    \
+      [](const Node* node) -> Operation {                              \
+        return [](Stack* stack) {                                      \
+          auto result = convolution_run_out(                           \
+              (std::move(peek(stack, 0, 6))).toTensor(),               \
+              ATTR.set_fpmath_mode(torch_ipex::fpmath_mode),           \
+              (std::move(peek(stack, 2, 6))).toInt(),                  \
+              (std::move(peek(stack, 3, 6))).toInt(),                  \
+              (std::move(peek(stack, 4, 6))).toIntVector(),            \
+              (std::move(peek(stack, 5, 6))).toIntVector(),            \
+              (std::move(peek(stack, 1, 6)))                           \
+                  .toCustomClass<ConvolutionOpContext>());             \
+          drop(stack, 6);                                              \
+          torch::jit::pack(stack, std::move(result));                  \
+          return 0;                                                    \
+        };                                                             \
+      },                                                               \
+      c10::AliasAnalysisKind::CONSERVATIVE)
+
+#define CreateLinearUnaryPostOpRunOut(FUSED_OP, ATTR)           \
+  Operator(                                                     \
+      "ipex_prepack::linear_" #FUSED_OP                         \
+      "_out(Tensor input, "                                     \
+      "__torch__.torch.classes.ipex_prepack.LinearOpContext "   \
+      "W_prepack, " PLANNED_OUT_ARGS ") -> Tensor",             \
+      [](const Node* node) -> Operation {                       \
+        return [](Stack* stack) {                               \
+          auto result = linear_run_out(                         \
+              (std::move(peek(stack, 0, 6))).toTensor(),        \
+              ATTR.set_fpmath_mode(torch_ipex::fpmath_mode),    \
+              (std::move(peek(stack, 2, 6))).toInt(),           \
+              (std::move(peek(stack, 3, 6))).toInt(),           \
+              (std::move(peek(stack, 4, 6))).toIntVector(),     \
+              (std::move(peek(stack, 5, 6))).toIntVector(),     \
+              (std::move(peek(stack, 1, 6)))                    \
+                  .toCustomClass<LinearOpContext>());           \
+          drop(stack, 6);                                       \
+          torch::jit::pack(stack, std::move(result));           \
+          return 0;                                             \
+        };                                                      \
+      },                                                        \
+      c10::AliasAnalysisKind::CONSERVATIVE)
+
+// Variants inserted by the concat elimination pass, writing into their slice
+// of the concat buffer.
+#define CONCAT_SLICE_ARGS \
+  "Tensor(a!) buffer, int dim, int start, int length"
+
+#define CreateConvUnaryPostOpRunInto(FUSED_OP, ATTR)                   \
+  Operator(                                                            \
+      "ipex_prepack::convolution_" #FUSED_OP                           \
+      "_into(Tensor input, "                                           \
+      "__torch__.torch.classes.ipex_prepack.ConvolutionOpContext "     \
+      "W_prepack, " CONCAT_SLICE_ARGS ") -> Tensor(a!)",               \
+      [](const Node* node) -> Operation {                              \
+        return [](Stack* stack) {                                      \
+          auto buffer = (std::move(peek(stack, 2, 6))).toTensor();     \
+          auto result = convolution_run_into(                          \
+              (std::move(peek(stack, 0, 6))).toTensor(),               \
+              ATTR.set_fpmath_mode(torch_ipex::fpmath_mode),           \
+              buffer,                                                  \
+              (std::move(peek(stack, 3, 6))).toInt(),                  \
+              (std::move(peek(stack, 4, 6))).toInt(),                  \
+              (std::move(peek(stack, 5, 6))).toInt(),                  \
+              (std::move(peek(stack, 1, 6)))                           \
+                  .toCustomClass<ConvolutionOpContext>());             \
+          drop(stack, 6);                                              \
+          torch::jit::pack(stack, std::move(result));                  \
+          return 0;                                                    \
+        };                                                             \
+      },                                                               \
+      aliasAnalysisFromSchema())
+
+#define CreateLinearUnaryPostOpRunInto(FUSED_OP, ATTR)             \
+  Operator(                                                        \
+      "ipex_prepack::linear_" #FUSED_OP                            \
+      "_into(Tensor input, "                                       \
+      "__torch__.torch.classes.ipex_prepack.LinearOpContext "      \
+      "W_prepack, " CONCAT_SLICE_ARGS ") -> Tensor(a!)",           \
+      [](const Node* node) -> Operation {                          \
+        return [](Stack* stack) {                                  \
+          auto buffer = (std::move(peek(stack, 2, 6))).toTensor(); \
+          auto result = linear_run_into(                           \
+              (std::move(peek(stack, 0, 6))).toTensor(),           \
+              ATTR.set_fpmath_mode(torch_ipex::fpmath_mode),       \
+              buffer,                                              \
+              (std::move(peek(stack, 3, 6))).toInt(),              \
+              (std::move(peek(stack, 4, 6))).toInt(),              \
+              (std::move(peek(stack, 5, 6))).toInt(),              \
+              (std::move(peek(stack, 1, 6)))                       \
+                  .toCustomClass<LinearOpContext>());              \
+          drop(stack, 6);                                          \
+          torch::jit::pack(stack, std::move(result));              \
+          return 0;                                                \
+        };                                                         \
+      },                                                           \
+      aliasAnalysisFromSchema())
+
+#define CreateEltwiseInto(OP, OUT_FN)                                     \
+  Operator(                                                               \
+      "ipex::" #OP "_into(Tensor self, " CONCAT_SLICE_ARGS                \
+      ") -> Tensor(a!)",                                                  \
+      [](const Node* node) -> Operation {                                 \
+        return [](Stack* stack) {                                         \
+          auto buffer = (std::move(peek(stack, 1, 5))).toTensor();        \
+          auto result = eltwise_into(                                     \
+              (std::move(peek(stack, 0, 5))).toTensor(),                  \
+              buffer,                                                     \
+              (std::move(peek(stack, 2, 5))).toInt(),                     \
+              (std::move(peek(stack, 3, 5))).toInt(),                     \
+              (std::move(peek(stack, 4, 5))).toInt(),                     \
+              [](at::Tensor& output, const at::Tensor& self) {            \
+                OUT_FN;                                                   \
+              });                                                         \
+          drop(stack, 5);                                                 \
+          torch::jit::pack(stack, std::move(result));                     \
+          return 0;                                                       \
+        };                                                                \
+      },                                                                  \
+      aliasAnalysisFromSchema())
+
 torch::jit::RegisterOperators op({
     CreateConvUnaryPostOpPrepack(relu),
     CreateConvUnaryPostOpPrepack(sigmoid),
@@ -210,6 +353,36 @@ torch::jit::RegisterOperators op({
     CreateConvUnaryPostOpRun(sqrt_run),
     CreateConvUnaryPostOpRun(hardsigmoid_run),
 
+    CreateConvUnaryPostOpRunOut(run, ideep::attr_t()),
+    CreateConvUnaryPostOpRunOut(relu_run, ideep::attr_t::fuse_relu()),
+    CreateConvUnaryPostOpRunOut(sigmoid_run, ideep::attr_t::fuse_sigmoid()),
+    CreateConvUnaryPostOpRunOut(swish_run, ideep::attr_t::fuse_swish()),
+    CreateConvUnaryPostOpRunOut(tanh_run, ideep::attr_t::fuse_tanh()),
+    CreateConvUnaryPostOpRunOut(mish_run, ideep::attr_t::fuse_mish()),
+    CreateConvUnaryPostOpRunOut(abs_run, ideep::attr_t::fuse_abs()),
+    CreateConvUnaryPostOpRunOut(exp_run, ideep::attr_t::fuse_exp()),
+    CreateConvUnaryPostOpRunOut(hardswish_run, ideep::attr_t::fuse_hardswish()),
+    CreateConvUnaryPostOpRunOut(square_run, ideep::attr_t::fuse_square()),
+    CreateConvUnaryPostOpRunOut(log_run, ideep::attr_t::fuse_log()),
+    CreateConvUnaryPostOpRunOut(round_run, ideep::attr_t::fuse_round()),
+    CreateConvUnaryPostOpRunOut(sqrt_run, ideep::attr_t::fuse_sqrt()),
+    CreateConvUnaryPostOpRunOut(hardsigmoid_run, ideep::attr_t::fuse_hardsigmoid()),
+
+    CreateConvUnaryPostOpRunInto(run, ideep::attr_t()),
+    CreateConvUnaryPostOpRunInto(relu_run, ideep::attr_t::fuse_relu()),
+    CreateConvUnaryPostOpRunInto(sigmoid_run, ideep::attr_t::fuse_sigmoid()),
+    CreateConvUnaryPostOpRunInto(swish_run, ideep::attr_t::fuse_swish()),
+    CreateConvUnaryPostOpRunInto(tanh_run, ideep::attr_t::fuse_tanh()),
+    CreateConvUnaryPostOpRunInto(mish_run, ideep::attr_t::fuse_mish()),
+    CreateConvUnaryPostOpRunInto(abs_run, ideep::attr_t::fuse_abs()),
+    CreateConvUnaryPostOpRunInto(exp_run, ideep::attr_t::fuse_exp()),
+    CreateConvUnaryPostOpRunInto(hardswish_run, ideep::attr_t::fuse_hardswish()),
+    CreateConvUnaryPostOpRunInto(square_run, ideep::attr_t::fuse_square()),
+    CreateConvUnaryPostOpRunInto(log_run, ideep::attr_t::fuse_log()),
+    CreateConvUnaryPostOpRunInto(round_run, ideep::attr_t::fuse_round()),
+    CreateConvUnaryPostOpRunInto(sqrt_run, ideep::attr_t::fuse_sqrt()),
+    CreateConvUnaryPostOpRunInto(hardsigmoid_run, ideep::attr_t::fuse_hardsigmoid()),
+
     CreateConvBinaryPostOpPrepack(add, fuse_sum),
     CreateConvBinaryPostOpPrepack(add_relu, residual),
     CreateConvBinaryPostOpRun(add_run),
@@ -479,6 +652,52 @@ torch::jit::RegisterOperators op({
           };
         },
         aliasAnalysisFromSchema()),
+    Operator(
+        "ipex_prepack::convolution_depthwise_pointwise_run(Tensor input, "
+        "str dw_post_op, str pw_post_op, "
+        "__torch__.torch.classes.ipex_prepack.ConvolutionOpContext W_prepack1, "
+        "__torch__.torch.classes.ipex_prepack.ConvolutionOpContext W_prepack2"
+        ") -> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = convolution_depthwise_pointwise_run(
+                (std::move(peek(stack, 0, 5))).toTensor(),
+                (std::move(peek(stack, 1, 5))).toStringRef(),
+                (std::move(peek(stack, 2, 5))).toStringRef(),
+                (std::move(peek(stack, 3, 5)))
+                    .toCustomClass<ConvolutionOpContext>(),
+                (std::move(peek(stack, 4, 5)))
+                    .toCustomClass<ConvolutionOpContext>());
+            drop(stack, 5);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
+    Operator(
+        "ipex_prepack::convolution_pool_run(Tensor input, str post_op, "
+        "str pool, int[2] kernel_size, int[2] stride, int[2] padding, "
+        "bool ceil_mode, "
+        "__torch__.torch.classes.ipex_prepack.ConvolutionOpContext W_prepack"
+        ") -> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = convolution_pool_run(
+                (std::move(peek(stack, 0, 8))).toTensor(),
+                (std::move(peek(stack, 1, 8))).toStringRef(),
+                (std::move(peek(stack, 2, 8))).toStringRef(),
+                (std::move(peek(stack, 3, 8))).toIntVector(),
+                (std::move(peek(stack, 4, 8))).toIntVector(),
+                (std::move(peek(stack, 5, 8))).toIntVector(),
+                (std::move(peek(stack, 6, 8))).toBool(),
+                (std::move(peek(stack, 7, 8)))
+                    .toCustomClass<ConvolutionOpContext>());
+            drop(stack, 8);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
     Operator(
         "ipex_prepack::convolution_gelu_run(Tensor input, str approximate, "
         "__torch__.torch.classes.ipex_prepack.ConvolutionOpContext "
@@ -512,6 +731,36 @@ torch::jit::RegisterOperators op({
     CreateLinearUnaryPostOpRun(sqrt_run),
     CreateLinearUnaryPostOpRun(hardsigmoid_run),
 
+    CreateLinearUnaryPostOpRunOut(run, ideep::attr_t()),
+    CreateLinearUnaryPostOpRunOut(relu_run, ideep::attr_t::fuse_relu()),
+    CreateLinearUnaryPostOpRunOut(sigmoid_run, ideep::attr_t::fuse_sigmoid()),
+    CreateLinearUnaryPostOpRunOut(swish_run, ideep::attr_t::fuse_swish()),
+    CreateLinearUnaryPostOpRunOut(tanh_run, ideep::attr_t::fuse_tanh()),
+    CreateLinearUnaryPostOpRunOut(mish_run, ideep::attr_t::fuse_mish()),
+    CreateLinearUnaryPostOpRunOut(abs_run, ideep::attr_t::fuse_abs()),
+    CreateLinearUnaryPostOpRunOut(exp_run, ideep::attr_t::fuse_exp()),
+    CreateLinearUnaryPostOpRunOut(hardswish_run, ideep::attr_t::fuse_hardswish()),
+    CreateLinearUnaryPostOpRunOut(square_run, ideep::attr_t::fuse_square()),
+    CreateLinearUnaryPostOpRunOut(log_run, ideep::attr_t::fuse_log()),
+    CreateLinearUnaryPostOpRunOut(round_run, ideep::attr_t::fuse_round()),
+    CreateLinearUnaryPostOpRunOut(sqrt_run, ideep::attr_t::fuse_sqrt()),
+    CreateLinearUnaryPostOpRunOut(hardsigmoid_run, ideep::attr_t::fuse_hardsigmoid()),
+
+    CreateLinearUnaryPostOpRunInto(run, ideep::attr_t()),
+    CreateLinearUnaryPostOpRunInto(relu_run, ideep::attr_t::fuse_relu()),
+    CreateLinearUnaryPostOpRunInto(sigmoid_run, ideep::attr_t::fuse_sigmoid()),
+    CreateLinearUnaryPostOpRunInto(swish_run, ideep::attr_t::fuse_swish()),
+    CreateLinearUnaryPostOpRunInto(tanh_run, ideep::attr_t::fuse_tanh()),
+    CreateLinearUnaryPostOpRunInto(mish_run, ideep::attr_t::fuse_mish()),
+    CreateLinearUnaryPostOpRunInto(abs_run, ideep::attr_t::fuse_abs()),
+    CreateLinearUnaryPostOpRunInto(exp_run, ideep::attr_t::fuse_exp()),
+    CreateLinearUnaryPostOpRunInto(hardswish_run, ideep::attr_t::fuse_hardswish()),
+    CreateLinearUnaryPostOpRunInto(square_run, ideep::attr_t::fuse_square()),
+    CreateLinearUnaryPostOpRunInto(log_run, ideep::attr_t::fuse_log()),
+    CreateLinearUnaryPostOpRunInto(round_run, ideep::attr_t::fuse_round()),
+    CreateLinearUnaryPostOpRunInto(sqrt_run, ideep::attr_t::fuse_sqrt()),
+    CreateLinearUnaryPostOpRunInto(hardsigmoid_run, ideep::attr_t::fuse_hardsigmoid()),
+
     Operator(
         "ipex_prepack::linear_leaky_relu_run(Tensor input, Scalar alpha, "
         "__torch__.torch.classes.ipex_prepack.LinearOpContext "
@@ -657,6 +906,72 @@ torch::jit::RegisterOperators op({
           };
         },
         aliasAnalysisFromSchema()),
+    Operator(
+        "ipex_prepack::woq_linear_run(Tensor input, "
+        "__torch__.torch.classes.ipex_prepack.WoqLinearOpContext "
+        "W_prepack) -> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = woq_linear_run(
+                (std::move(peek(stack, 0, 2))).toTensor(),
+                (std::move(peek(stack, 1, 2)))
+                    .toCustomClass<WoqLinearOpContext>());
+            drop(stack, 2);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
+    Operator(
+        "ipex_prepack::dynamic_quant_linear_run(Tensor input, str post_op, "
+        "__torch__.torch.classes.ipex_prepack.DynamicQuantLinearOpContext "
+        "W_prepack) -> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = dynamic_quant_linear_run(
+                (std::move(peek(stack, 0, 3))).toTensor(),
+                (std::move(peek(stack, 1, 3))).toStringRef(),
+                (std::move(peek(stack, 2, 3)))
+                    .toCustomClass<DynamicQuantLinearOpContext>());
+            drop(stack, 3);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
+    Operator(
+        "ipex_prepack::sparse_linear_run(Tensor input, str post_op, "
+        "__torch__.torch.classes.ipex_prepack.SparseLinearOpContext "
+        "W_prepack) -> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = sparse_linear_run(
+                (std::move(peek(stack, 0, 3))).toTensor(),
+                (std::move(peek(stack, 1, 3))).toStringRef(),
+                (std::move(peek(stack, 2, 3)))
+                    .toCustomClass<SparseLinearOpContext>());
+            drop(stack, 3);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
+    Operator(
+        "ipex_prepack::gated_mlp_run(Tensor input, "
+        "__torch__.torch.classes.ipex_prepack.GatedMlpOpContext W_prepack) "
+        "-> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = gated_mlp_run(
+                (std::move(peek(stack, 0, 2))).toTensor(),
+                (std::move(peek(stack, 1, 2)))
+                    .toCustomClass<GatedMlpOpContext>());
+            drop(stack, 2);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
 
     // ConvTranspose fusion run OP
     CreateConvTransposeUnaryPostOpRun(run),
@@ -1179,6 +1494,71 @@ torch::jit::RegisterOperators op({
         },
         aliasAnalysisFromSchema()),
 
+    Operator(
+        "ipex::softmax_out(Tensor self, int dim, " PLANNED_OUT_ARGS
+        ") -> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = dil_softmax_out(
+                (std::move(peek(stack, 0, 6))).toTensor(),
+                (std::move(peek(stack, 1, 6))).toInt(),
+                (std::move(peek(stack, 2, 6))).toInt(),
+                (std::move(peek(stack, 3, 6))).toInt(),
+                (std::move(peek(stack, 4, 6))).toIntVector(),
+                (std::move(peek(stack, 5, 6))).toIntVector());
+            drop(stack, 6);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        c10::AliasAnalysisKind::CONSERVATIVE),
+
+    Operator(
+        "ipex::bmm_out(Tensor batch1, Tensor batch2, " PLANNED_OUT_ARGS
+        ") -> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = dil_bmm_out(
+                (std::move(peek(stack, 0, 6))).toTensor(),
+                (std::move(peek(stack, 1, 6))).toTensor(),
+                (std::move(peek(stack, 2, 6))).toInt(),
+                (std::move(peek(stack, 3, 6))).toInt(),
+                (std::move(peek(stack, 4, 6))).toIntVector(),
+                (std::move(peek(stack, 5, 6))).toIntVector());
+            drop(stack, 6);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        c10::AliasAnalysisKind::CONSERVATIVE),
+
+    Operator(
+        "ipex::grouped_linear(Tensor[] inputs, Tensor[] weights, "
+        "Tensor?[] biases, str[] post_ops) -> Tensor[]",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            std::vector<c10::optional<at::Tensor>> biases;
+            for (const auto& bias : (peek(stack, 2, 4)).toListRef()) {
+              biases.push_back(
+                  bias.isNone() ? c10::nullopt
+                                : c10::optional<at::Tensor>(bias.toTensor()));
+            }
+            std::vector<std::string> post_ops;
+            for (const auto& post_op : (peek(stack, 3, 4)).toListRef()) {
+              post_ops.push_back(post_op.toStringRef());
+            }
+            auto result = dil_grouped_linear(
+                (std::move(peek(stack, 0, 4))).toTensorVector(),
+                (std::move(peek(stack, 1, 4))).toTensorVector(),
+                biases,
+                post_ops);
+            drop(stack, 4);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
+
     Operator(
         "ipex::softmax_(Tensor(a!) self, int dim, ScalarType ? dtype) -> Tensor(a!)",
         [](const Node* node) -> Operation {
@@ -1215,6 +1595,72 @@ torch::jit::RegisterOperators op({
         },
         aliasAnalysisFromSchema()),
 
+    CreateEltwiseInto(relu, at::clamp_min_out(output, self, 0)),
+    CreateEltwiseInto(sigmoid, at::sigmoid_out(output, self)),
+    CreateEltwiseInto(tanh, at::tanh_out(output, self)),
+    CreateEltwiseInto(silu, at::silu_out(output, self)),
+    CreateEltwiseInto(hardswish, at::hardswish_out(output, self)),
+
+    Operator(
+        "ipex::embedding_bag_into(Tensor weight, Tensor indices, "
+        "Tensor offsets, bool include_last_offset, " CONCAT_SLICE_ARGS
+        ") -> Tensor(a!)",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto buffer = (std::move(peek(stack, 4, 8))).toTensor();
+            auto result = embedding_bag_into(
+                (std::move(peek(stack, 0, 8))).toTensor(),
+                (std::move(peek(stack, 1, 8))).toTensor(),
+                (std::move(peek(stack, 2, 8))).toTensor(),
+                (std::move(peek(stack, 3, 8))).toBool(),
+                buffer,
+                (std::move(peek(stack, 5, 8))).toInt(),
+                (std::move(peek(stack, 6, 8))).toInt(),
+                (std::move(peek(stack, 7, 8))).toInt());
+            drop(stack, 8);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
+
+    // The buffer is written by the _into ops, so it is registered with
+    // conservative alias analysis to keep it away from CSE and constant
+    // propagation.
+    Operator(
+        "ipex::concat_buffer(int[] sizes, int[] strides, ScalarType dtype) "
+        "-> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = concat_buffer(
+                (std::move(peek(stack, 0, 3))).toIntVector(),
+                (std::move(peek(stack, 1, 3))).toIntVector(),
+                (std::move(peek(stack, 2, 3))).toScalarType());
+            drop(stack, 3);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        c10::AliasAnalysisKind::CONSERVATIVE),
+
+    Operator(
+        "ipex::concat_from_buffer(Tensor(a!) buffer, Tensor[] parts, int dim, "
+        "int[] lengths) -> Tensor(a!)",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto buffer = (std::move(peek(stack, 0, 4))).toTensor();
+            auto result = concat_from_buffer(
+                buffer,
+                (std::move(peek(stack, 1, 4))).toTensorVector(),
+                (std::move(peek(stack, 2, 4))).toInt(),
+                (std::move(peek(stack, 3, 4))).toIntVector());
+            drop(stack, 4);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
+
     Operator(
         "ipex::qembedding_bag(Tensor weight, Tensor indices, Tensor offsets, "
         "bool sparse, bool include_last_offset, "
@@ -1322,6 +1768,68 @@ torch::jit::RegisterOperators op({
           };
         },
         aliasAnalysisFromSchema()),
+    Operator(
+        "ipex::add_layernorm_quantize(Tensor a, Tensor b, Scalar alpha, int[] "
+        "normalized_shape, Tensor? weight_opt, Tensor? bias_opt, float eps, "
+        "float scale, int zero_point, ScalarType dtype, bool output_float) -> "
+        "(Tensor, Tensor)",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = dil_add_layernorm_quantize(
+                (std::move(peek(stack, 0, 11))).toTensor(),
+                (std::move(peek(stack, 1, 11))).toTensor(),
+                (std::move(peek(stack, 2, 11))).toScalar(),
+                (std::move(peek(stack, 3, 11))).toIntVector(),
+                toOptionalTensor(std::move(peek(stack, 4, 11))),
+                toOptionalTensor(std::move(peek(stack, 5, 11))),
+                (std::move(peek(stack, 6, 11))).toDouble(),
+                (std::move(peek(stack, 7, 11))).toDouble(),
+                (std::move(peek(stack, 8, 11))).toInt(),
+                (std::move(peek(stack, 9, 11))).toScalarType(),
+                (std::move(peek(stack, 10, 11))).toBool());
+            drop(stack, 11);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
+    Operator(
+        "ipex::group_norm_silu(Tensor input, int num_groups, Tensor? weight, "
+        "Tensor? bias, float eps) -> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = group_norm_silu(
+                (std::move(peek(stack, 0, 5))).toTensor(),
+                (std::move(peek(stack, 1, 5))).toInt(),
+                toOptionalTensor(std::move(peek(stack, 2, 5))),
+                toOptionalTensor(std::move(peek(stack, 3, 5))),
+                (std::move(peek(stack, 4, 5))).toDouble());
+            drop(stack, 5);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
+    Operator(
+        "ipex::group_norm_silu_add(Tensor input, int num_groups, Tensor? "
+        "weight, Tensor? bias, float eps, Tensor other, Scalar alpha) -> "
+        "Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = group_norm_silu_add(
+                (std::move(peek(stack, 0, 7))).toTensor(),
+                (std::move(peek(stack, 1, 7))).toInt(),
+                toOptionalTensor(std::move(peek(stack, 2, 7))),
+                toOptionalTensor(std::move(peek(stack, 3, 7))),
+                (std::move(peek(stack, 4, 7))).toDouble(),
+                (std::move(peek(stack, 5, 7))).toTensor(),
+                (std::move(peek(stack, 6, 7))).toScalar());
+            drop(stack, 7);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
     Operator(
         "ipex::concat_bn_relu(Tensor[] a, Tensor bn_scale, Tensor bn_beta, "
         "Tensor? weight, Tensor? bias, Tensor? running_mean, Tensor? running_var, bool training, float momentum, float eps, bool cudnn_enabled, int dim) -> "
@@ -1392,6 +1900,19 @@ torch::jit::RegisterOperators op({
           };
         },
         aliasAnalysisFromSchema()),
+    Operator(
+        "ipex::einsum(str equation, Tensor[] tensors) -> Tensor",
+        [](const Node* node) -> Operation {
+          return [](Stack* stack) {
+            auto result = einsum_pairwise(
+                (std::move(peek(stack, 0, 2))).toStringView(),
+                (std::move(peek(stack, 1, 2))).toTensorList());
+            drop(stack, 2);
+            torch::jit::pack(stack, std::move(result));
+            return 0;
+          };
+        },
+        aliasAnalysisFromSchema()),
     Operator(
         "ipex::max_pool2d(Tensor input, int[2] kernel_size, int[2] stride, "
         "int[2] padding, int[2] dilation, bool ceil_mode) -> Tensor",
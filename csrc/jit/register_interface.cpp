@@ -41,7 +41,12 @@ bool canFuseNode(const Node* node) {
           Symbol::fromQualString("torch_ipex::convolution_forward") ||
       node->kind() == Symbol::fromQualString("torch_ipex::ipex_linear") ||
       node->kind() == Symbol::fromQualString("torch_ipex::conv_transpose") ||
-      node->kind() == Symbol::fromQualString("torch_ipex::ipex_MKLSGEMM"));
+      node->kind() == Symbol::fromQualString("torch_ipex::ipex_MKLSGEMM") ||
+      node->kind() == Symbol::fromQualString("torch_ipex::ipex_woq_linear") ||
+      node->kind() ==
+          Symbol::fromQualString("torch_ipex::ipex_dynamic_quant_linear") ||
+      node->kind() ==
+          Symbol::fromQualString("torch_ipex::ipex_sparse_linear"));
 }
 
 namespace {
@@ -0,0 +1 @@
+from .inprocess import InProcessTuner, TrialResult, INPROCESS_STRATEGIES
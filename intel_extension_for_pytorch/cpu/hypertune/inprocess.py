@@ -0,0 +1,405 @@
+import csv
+import itertools
+import math
+import os
+import time
+import warnings
+from collections import OrderedDict
+
+import numpy as np
+import torch
+import intel_extension_for_pytorch as ipex
+from intel_extension_for_pytorch.cpu import runtime
+
+# knobs that can be changed in the running process, see InProcessTuner
+INPROCESS_HYPERPARAMS = ['ncore_per_instance', 'ninstances', 'omp_num_threads', 'fpmath_mode']
+
+# objectives to be minimized, 'throughput' is the only one to be maximized
+LATENCY_OBJECTIVES = ['mean', 'p50', 'p90', 'p99']
+OBJECTIVES = LATENCY_OBJECTIVES + ['throughput']
+
+INPROCESS_STRATEGIES = {}
+
+def inprocess_strategy_registry(cls):
+    assert cls.__name__.endswith(
+        'InProcessStrategy'
+    ), "The name of subclass of InProcessStrategy should end with \'InProcessStrategy\' substring."
+    name = cls.__name__[:-len('InProcessStrategy')]
+    # SuccessiveHalving -> successive_halving
+    name = ''.join(['_' + c.lower() if c.isupper() and i > 0 else c.lower() for i, c in enumerate(name)])
+    if name in INPROCESS_STRATEGIES:
+        raise ValueError('Cannot have two strategies with the same name')
+    INPROCESS_STRATEGIES[name] = cls
+    return cls
+
+class TrialResult(object):
+    r"""
+    Latency statistics of one trial.
+
+    Args:
+        cfg (dict): The configuration of the trial.
+        latencies (list): Latency of each measured iteration in ms.
+        batch_size (int): Number of samples of one iteration, used for throughput.
+        early_stopped (bool): If the trial was cut off before its full budget.
+    """
+
+    def __init__(self, cfg, latencies, batch_size=1, early_stopped=False):
+        self.cfg = cfg
+        self.iters = len(latencies)
+        self.early_stopped = early_stopped
+        if self.iters == 0:
+            # infeasible configuration, never measured
+            self.mean = self.p50 = self.p90 = self.p99 = float('inf')
+            self.throughput = 0.0
+            return
+        lat = np.array(latencies)
+        self.mean = float(lat.mean())
+        self.p50, self.p90, self.p99 = [float(v) for v in np.percentile(lat, [50, 90, 99])]
+        self.throughput = batch_size * 1000.0 / self.mean
+
+    def score(self, objective):
+        # lower is better for every objective
+        if objective == 'throughput':
+            return -self.throughput
+        return getattr(self, objective)
+
+    def __repr__(self):
+        return "TrialResult(cfg={}, iters={}, mean={:.3f}ms, p50={:.3f}ms, p90={:.3f}ms, p99={:.3f}ms, " \
+               "throughput={:.3f}, early_stopped={})".format(self.cfg, self.iters, self.mean, self.p50,
+                                                            self.p90, self.p99, self.throughput, self.early_stopped)
+
+class InProcessTuner(object):
+    r"""
+    Tune the runtime knobs of a model inside the current process.
+
+    Unlike ``python -m intel_extension_for_pytorch.cpu.hypertune``, which
+    launches the program once per trial, every trial here reconfigures the
+    running process and measures the model directly:
+
+    * ``ninstances`` and ``ncore_per_instance``: the model is wrapped in a
+      ``MultiStreamModule`` with ``ninstances`` streams over a ``CPUPool`` of
+      ``ninstances * ncore_per_instance`` cores. A single instance runs the
+      model directly on ``ncore_per_instance`` threads.
+    * ``omp_num_threads``: ``torch.set_num_threads`` for a single instance,
+      -1 means ``ncore_per_instance``.
+    * ``fpmath_mode``: ``'FP32'`` or ``'BF32'``, see ``ipex.set_fp32_math_mode``.
+
+    Settings which can only be applied at process start, like the memory
+    allocator or ``KMP_*`` variables, still need the launcher based hypertune.
+
+    Bad configurations are cut off early: a trial stops as soon as the
+    ``objective`` of its measured iterations so far is ``early_stop_ratio``
+    times worse than the one of the best trial.
+    The ``successive_halving`` and ``bayesian`` strategies additionally spend
+    the full budget only on promising configurations.
+
+    Args:
+        model (torch.nn.Module or torch.jit.ScriptModule): The model to tune.
+        inputs (tuple): Positional inputs of the model.
+        search_space (dict): Hyperparameter name to a list of values. Names
+            must be in ``INPROCESS_HYPERPARAMS``, knobs not given keep the
+            current setting of the process.
+        strategy (str): One of ``grid``, ``random``, ``successive_halving``
+            and ``bayesian``. Default is ``successive_halving``.
+        objective (str): One of ``mean``, ``p50``, ``p90``, ``p99`` (latency
+            in ms, minimized) and ``throughput`` (maximized). Default is ``p50``.
+        max_trials (int): Max number of configurations to evaluate.
+        warmup (int): Iterations run before measuring each trial.
+        min_iters (int): Measured iterations before a trial can be cut off,
+            and the budget of the first rung of successive halving.
+        max_iters (int): Measured iterations of a full trial.
+        eta (int): Successive halving keeps the best ``1 / eta`` of the
+            configurations of a rung and multiplies their budget by ``eta``.
+        early_stop_ratio (float): See above, ``None`` disables early stopping.
+        batch_size (int): Samples per iteration, used to report throughput.
+        output_dir (str): If set, trials are saved to
+            ``output_dir/inprocess_record.csv``.
+        seed (int): Seed of the random and bayesian strategies.
+
+    Examples:
+
+        >>> from intel_extension_for_pytorch.cpu.hypertune import InProcessTuner
+        >>> tuner = InProcessTuner(
+        ...     traced_model, (x,),
+        ...     search_space={'ninstances': [1, 2, 4], 'ncore_per_instance': [4, 8],
+        ...                   'fpmath_mode': ['FP32', 'BF32']},
+        ...     strategy='successive_halving', objective='p99')
+        >>> best_cfg, best_result = tuner.tune()
+    """
+
+    def __init__(self, model, inputs, search_space, strategy='successive_halving', objective='p50',
+                 max_trials=100, warmup=10, min_iters=20, max_iters=100, eta=3,
+                 early_stop_ratio=1.5, batch_size=1, output_dir=None, seed=None):
+        for hp in search_space:
+            assert hp in INPROCESS_HYPERPARAMS, \
+                "Hyperparameter {} can not be tuned in process, must be one of {}".format(hp, INPROCESS_HYPERPARAMS)
+            assert isinstance(search_space[hp], (list, tuple)) and len(search_space[hp]) > 0, \
+                "Search space of {} must be a non-empty list".format(hp)
+        assert strategy in INPROCESS_STRATEGIES, "Tuning strategy {} is NOT supported".format(strategy)
+        assert objective in OBJECTIVES, "Objective {} is NOT supported, must be one of {}".format(objective, OBJECTIVES)
+        assert 0 < min_iters <= max_iters, "Expect 0 < min_iters <= max_iters"
+        assert eta >= 2, "eta must be at least 2"
+
+        self.model = model
+        self.inputs = inputs if isinstance(inputs, tuple) else (inputs,)
+        self.search_space = OrderedDict(search_space)
+        self.hyperparams = list(self.search_space.keys())
+        self.objective = objective
+        self.max_trials = max_trials
+        self.warmup = warmup
+        self.min_iters = min_iters
+        self.max_iters = max_iters
+        self.eta = eta
+        self.early_stop_ratio = early_stop_ratio
+        self.batch_size = batch_size
+        self.rng = np.random.RandomState(seed)
+
+        self.available_cores = ipex._C.get_process_available_cores()
+        self.results = []
+        self.best_result = None
+
+        self.output_dir = output_dir
+        self.record = None
+        if output_dir is not None:
+            os.makedirs(output_dir, exist_ok=True)
+
+        self.strategy = INPROCESS_STRATEGIES[strategy](self)
+
+    def candidates(self):
+        return [OrderedDict(zip(self.hyperparams, comb))
+                for comb in itertools.product(*(self.search_space[hp] for hp in self.hyperparams))]
+
+    def tune(self):
+        r"""
+        Run the search and restore the thread number and fpmath mode of the
+        process afterwards. Every call starts a new search and, with
+        ``output_dir`` set, rewrites ``inprocess_record.csv``.
+
+        Returns:
+            The best configuration (dict) and its ``TrialResult``.
+        """
+        self.results = []
+        self.best_result = None
+        if self.output_dir is None:
+            self._traverse()
+        else:
+            with open(os.path.join(self.output_dir, "inprocess_record.csv"), "w", newline='') as record_file:
+                self.record = csv.writer(record_file, delimiter=",")
+                self.record.writerow(self.hyperparams + ['iters', 'mean', 'p50', 'p90', 'p99',
+                                                        'throughput', 'early_stopped'])
+                try:
+                    self._traverse()
+                finally:
+                    self.record = None
+        if self.best_result is None:
+            return None, None
+        return self.best_result.cfg, self.best_result
+
+    def _traverse(self):
+        num_threads = torch.get_num_threads()
+        fpmath_mode = ipex.get_fp32_math_mode()
+        try:
+            self.strategy.traverse()
+        finally:
+            torch.set_num_threads(num_threads)
+            ipex.set_fp32_math_mode(ipex.FP32MathMode(int(fpmath_mode)))
+
+    def evaluate(self, cfg, iters):
+        r"""
+        Apply ``cfg`` and measure up to ``iters`` iterations.
+        """
+        runner = self._build_runner(cfg)
+        if runner is None:
+            result = TrialResult(cfg, [], self.batch_size)
+        else:
+            result = self._measure(cfg, runner, iters)
+        self.results.append(result)
+        if self.best_result is None or result.score(self.objective) < self.best_result.score(self.objective):
+            self.best_result = result
+        if self.record is not None:
+            self.record.writerow([cfg[hp] for hp in self.hyperparams] +
+                                 [result.iters, result.mean, result.p50, result.p90, result.p99,
+                                  result.throughput, result.early_stopped])
+        return result
+
+    def _build_runner(self, cfg):
+        # Returns the callable running one iteration with cfg applied, or None
+        # if the configuration can not run on this machine.
+        if 'fpmath_mode' in cfg:
+            ipex.set_fp32_math_mode(getattr(ipex.FP32MathMode, cfg['fpmath_mode']))
+
+        ninstances = cfg.get('ninstances', 1)
+        ncore_per_instance = cfg.get('ncore_per_instance', -1)
+        if ncore_per_instance == -1:
+            ncore_per_instance = len(self.available_cores) // ninstances
+        ncores = ninstances * ncore_per_instance
+        if ncore_per_instance <= 0 or ncores > len(self.available_cores):
+            warnings.warn("Skip configuration {}: it needs {} cores but only {} are available".format(
+                cfg, ncores, len(self.available_cores)))
+            return None
+
+        if ninstances == 1:
+            num_threads = cfg.get('omp_num_threads', -1)
+            torch.set_num_threads(ncore_per_instance if num_threads == -1 else num_threads)
+            if runtime.is_runtime_ext_enabled():
+                cpu_pool = runtime.CPUPool(self.available_cores[:ncores])
+                model = self.model
+
+                def run_pinned():
+                    with runtime.pin(cpu_pool):
+                        return model(*self.inputs)
+                return run_pinned
+            return lambda: self.model(*self.inputs)
+
+        if not runtime.is_runtime_ext_enabled():
+            warnings.warn("Skip configuration {}: multiple instances need the runtime extension, "
+                          "which requires Intel OpenMP".format(cfg))
+            return None
+        cpu_pool = runtime.CPUPool(self.available_cores[:ncores])
+        multi_stream_model = runtime.MultiStreamModule(self.model, num_streams=ninstances, cpu_pool=cpu_pool)
+        return lambda: multi_stream_model(*self.inputs)
+
+    def _measure(self, cfg, runner, iters):
+        with torch.no_grad():
+            for _ in range(self.warmup):
+                runner()
+            latencies = []
+            early_stopped = False
+            for i in range(iters):
+                start = time.perf_counter()
+                runner()
+                latencies.append((time.perf_counter() - start) * 1000)
+                if self._should_stop(latencies) and i + 1 < iters:
+                    early_stopped = True
+                    break
+        return TrialResult(cfg, latencies, self.batch_size, early_stopped)
+
+    def _should_stop(self, latencies):
+        if self.early_stop_ratio is None or self.best_result is None or self.best_result.iters == 0:
+            return False
+        if len(latencies) < self.min_iters or len(latencies) % self.min_iters != 0:
+            return False
+        # stopping rule on the same statistic as the objective
+        running = TrialResult(None, latencies, self.batch_size)
+        if self.objective == 'throughput':
+            return running.throughput * self.early_stop_ratio < self.best_result.throughput
+        return running.score(self.objective) > self.early_stop_ratio * self.best_result.score(self.objective)
+
+class InProcessStrategy(object):
+    def __init__(self, tuner):
+        self.tuner = tuner
+
+    def evaluate(self, cfg, iters):
+        return self.tuner.evaluate(cfg, iters)
+
+    def traverse(self):
+        raise NotImplementedError
+
+@inprocess_strategy_registry
+class GridInProcessStrategy(InProcessStrategy):
+    def traverse(self):
+        for cfg in self.tuner.candidates()[:self.tuner.max_trials]:
+            self.evaluate(cfg, self.tuner.max_iters)
+
+@inprocess_strategy_registry
+class RandomInProcessStrategy(InProcessStrategy):
+    def traverse(self):
+        candidates = self.tuner.candidates()
+        order = self.tuner.rng.permutation(len(candidates))
+        for idx in order[:self.tuner.max_trials]:
+            self.evaluate(candidates[idx], self.tuner.max_iters)
+
+@inprocess_strategy_registry
+class SuccessiveHalvingInProcessStrategy(InProcessStrategy):
+    r"""
+    Evaluate up to ``max_trials`` random configurations with ``min_iters``
+    iterations, keep the best ``1 / eta`` of them and evaluate them again with
+    ``eta`` times the budget, until one is left or ``max_iters`` is reached.
+    """
+
+    def traverse(self):
+        tuner = self.tuner
+        candidates = tuner.candidates()
+        order = tuner.rng.permutation(len(candidates))
+        rung = [candidates[idx] for idx in order[:tuner.max_trials]]
+        budget = tuner.min_iters
+        while True:
+            # the best result is kept from the largest budget only, so that
+            # short noisy trials of a lower rung do not shadow it
+            tuner.best_result = None
+            scored = [(self.evaluate(cfg, budget).score(tuner.objective), i) for i, cfg in enumerate(rung)]
+            if len(rung) == 1 or budget >= tuner.max_iters:
+                return
+            scored.sort()
+            keep = max(1, len(rung) // tuner.eta)
+            rung = [rung[i] for score, i in scored[:keep] if not math.isinf(score)]
+            if len(rung) == 0:
+                return
+            budget = min(budget * tuner.eta, tuner.max_iters)
+
+@inprocess_strategy_registry
+class BayesianInProcessStrategy(InProcessStrategy):
+    r"""
+    Gaussian process with an RBF kernel over the normalized configuration and
+    expected improvement as the acquisition function. The first ``n_init``
+    configurations are random.
+    """
+
+    n_init = 3
+    length_scale = 0.3
+    noise = 1e-6
+
+    def _encode(self, candidates):
+        # numeric values are scaled to [0, 1], other values by their index
+        columns = []
+        for hp in self.tuner.hyperparams:
+            values = self.tuner.search_space[hp]
+            numeric = all(isinstance(v, (int, float)) and not isinstance(v, bool) for v in values)
+            if numeric:
+                lo, hi = min(values), max(values)
+                col = [(cfg[hp] - lo) / (hi - lo) if hi > lo else 0.0 for cfg in candidates]
+            else:
+                col = [values.index(cfg[hp]) / max(1, len(values) - 1) for cfg in candidates]
+            columns.append(col)
+        return np.array(columns, dtype=np.float64).T
+
+    def _kernel(self, a, b):
+        dist = ((a[:, None, :] - b[None, :, :]) ** 2).sum(-1)
+        return np.exp(-0.5 * dist / self.length_scale ** 2)
+
+    def _expected_improvement(self, x_obs, y_obs, x_new):
+        mean, std = y_obs.mean(), y_obs.std() + 1e-12
+        y = (y_obs - mean) / std
+        k = self._kernel(x_obs, x_obs) + self.noise * np.eye(len(x_obs))
+        k_inv = np.linalg.inv(k)
+        k_s = self._kernel(x_new, x_obs)
+        mu = k_s @ k_inv @ y
+        var = np.clip(1.0 - (k_s @ k_inv * k_s).sum(-1), 1e-12, None)
+        sigma = np.sqrt(var)
+        # minimization: improvement over the best observed value
+        z = (y.min() - mu) / sigma
+        cdf = 0.5 * (1 + np.vectorize(math.erf)(z / math.sqrt(2)))
+        pdf = np.exp(-0.5 * z ** 2) / math.sqrt(2 * math.pi)
+        return (y.min() - mu) * cdf + sigma * pdf
+
+    def traverse(self):
+        tuner = self.tuner
+        candidates = tuner.candidates()
+        x_all = self._encode(candidates)
+        remaining = list(tuner.rng.permutation(len(candidates)))
+        observed, scores = [], []
+        for trial in range(min(tuner.max_trials, len(candidates))):
+            feasible = [i for i, s in enumerate(scores) if not math.isinf(s)]
+            if trial < self.n_init or len(feasible) < 2:
+                idx = remaining[0]
+            else:
+                x_obs = x_all[[observed[i] for i in feasible]]
+                # log latency is closer to the stationary GP assumption
+                y_obs = np.log(np.abs(np.array([scores[i] for i in feasible])))
+                if tuner.objective == 'throughput':
+                    y_obs = -y_obs
+                ei = self._expected_improvement(x_obs, y_obs, x_all[remaining])
+                idx = remaining[int(np.argmax(ei))]
+            remaining.remove(idx)
+            observed.append(idx)
+            scores.append(self.evaluate(candidates[idx], tuner.max_iters).score(tuner.objective))
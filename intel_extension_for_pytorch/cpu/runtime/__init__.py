@@ -3,3 +3,7 @@ from .cpupool import pin, CPUPool, is_runtime_ext_enabled
 from .multi_stream import MultiStreamModule, get_default_num_streams, \
                         MultiStreamModuleHint, _MultiStreamBenchmarkModule
 from .runtime_utils import get_core_list_of_node_id
+from .numa_allocator import enable_numa_allocator, disable_numa_allocator, \
+                        is_numa_allocator_enabled, numa_local_weights, \
+                        to_numa_local, numa_allocator_stats, \
+                        numa_allocator_empty_cache, numa_allocator_reset_peak_stats
@@ -0,0 +1,80 @@
+import functools
+import torch
+import intel_extension_for_pytorch as ipex
+
+def enable_numa_allocator():
+    r"""
+    Register the NUMA-local allocator as the CPU allocator, so that all the
+    following CPU tensors, activations included, are allocated on the NUMA node
+    of the core the allocating thread runs on. Blocks of 2 MB and above are
+    backed by transparent huge pages, or by 1 GB huge pages when the hugetlb
+    pool has them reserved. Freed blocks are cached per NUMA node and size
+    class, the cache is bounded by ``IPEX_NUMA_ALLOCATOR_MAX_CACHE_MB``.
+
+    Pin the threads first, e.g. with
+    :class:`intel_extension_for_pytorch.cpu.runtime.pin`, so that the node of
+    the allocating thread is the node of its CPU pool.
+    """
+    ipex._C._numa_allocator_set_default(True)
+
+def disable_numa_allocator():
+    r"""
+    Restore the CPU allocator registered before
+    :func:`enable_numa_allocator`. Tensors already allocated by the NUMA
+    allocator stay valid.
+    """
+    ipex._C._numa_allocator_set_default(False)
+
+def is_numa_allocator_enabled():
+    return ipex._C._numa_allocator_is_default()
+
+class numa_local_weights(object):
+    r"""
+    Allocate the packed weights of the linear and convolution op contexts
+    created in the scoped code region, e.g. by ``ipex.optimize`` or
+    ``torch.jit.freeze``, with the NUMA-local allocator. Only the weights are
+    affected, use :func:`enable_numa_allocator` for the activations.
+
+    Returns:
+        intel_extension_for_pytorch.cpu.runtime.numa_local_weights: Generated
+        object which can be used as a `with` context or a function decorator.
+    """
+
+    def __enter__(self):
+        self.previous = ipex._C._numa_weight_allocation_enabled()
+        ipex._C._numa_set_weight_allocation(True)
+
+    def __exit__(self, *args):
+        ipex._C._numa_set_weight_allocation(self.previous)
+
+    # Support decorator
+    def __call__(self, func):
+        @functools.wraps(func)
+        def decorate_numa_local_weights(*args, **kwargs):
+            with self:
+                return func(*args, **kwargs)
+        return decorate_numa_local_weights
+
+def to_numa_local(tensor: torch.Tensor) -> torch.Tensor:
+    r"""
+    Return a contiguous copy of a dense CPU tensor in memory allocated by the
+    NUMA-local allocator on the node of the calling thread.
+    """
+    return ipex._C._numa_to_local(tensor)
+
+def numa_allocator_stats() -> dict:
+    r"""
+    Statistics of the NUMA-local allocator: allocation and cache hit counts,
+    bytes in use (total, peak and per NUMA node), bytes cached, bytes backed
+    by 2 MB and 1 GB huge pages and the number of failed ``mbind`` calls.
+    """
+    return ipex._C._numa_allocator_stats()
+
+def numa_allocator_empty_cache():
+    r"""
+    Release all the blocks cached by the NUMA-local allocator to the OS.
+    """
+    ipex._C._numa_allocator_empty_cache()
+
+def numa_allocator_reset_peak_stats():
+    ipex._C._numa_allocator_reset_peak_stats()
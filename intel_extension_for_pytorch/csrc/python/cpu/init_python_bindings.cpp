@@ -14,7 +14,12 @@
 #include <torch/csrc/jit/python/pybind_utils.h>
 #include <torch/csrc/jit/runtime/custom_operator.h>
 #include <torch/csrc/jit/runtime/operator_options.h>
+#include "csrc/jit/cpu/kernels/ActivationArena.h"
 #include "csrc/jit/fusion_pass.h"
+#include "csrc/jit/passes/concat_elimination.h"
+#include "csrc/jit/passes/graph_rewrite.h"
+#include "csrc/jit/passes/grouped_linear.h"
+#include "csrc/jit/passes/memory_planner.h"
 
 #include <cstring>
 #include <sstream>
@@ -36,6 +41,7 @@
 #include "TaskModule.h"
 #include "csrc/cpu/aten/EmbeddingBag.h"
 #include "csrc/cpu/runtime/CPUPool.h"
+#include "csrc/cpu/runtime/NumaAllocator.h"
 #include "csrc/cpu/runtime/TaskExecutor.h"
 
 namespace torch_ipex {
@@ -81,6 +87,45 @@ void InitIpexModuleBindings(py::module m) {
     return get_highest_binary_support_isa_level();
   });
 
+  m.def("_set_dispatch_stub_profiling", [](bool enabled) {
+    torch_ipex::cpu::set_dispatch_stub_profiling(enabled);
+  });
+
+  m.def("_is_dispatch_stub_profiling_enabled", []() {
+    return torch_ipex::cpu::is_dispatch_stub_profiling_enabled();
+  });
+
+  m.def("_get_dispatch_stub_stats", []() {
+    py::list stats;
+    for (auto& stat : torch_ipex::cpu::get_dispatch_stub_stats()) {
+      py::dict item;
+      item["name"] = stat.name;
+      item["isa"] = stat.isa;
+      item["calls"] = stat.calls;
+      item["total_ns"] = stat.total_ns;
+      stats.append(item);
+    }
+    return stats;
+  });
+
+  m.def("_reset_dispatch_stub_stats", []() {
+    torch_ipex::cpu::reset_dispatch_stub_stats();
+  });
+
+  m.def(
+      "_set_dispatch_stub_isa",
+      [](const std::string& name, const std::string& isa_str) {
+        using namespace torch_ipex::cpu;
+        CPUCapability isa;
+        TORCH_CHECK(
+            parse_cpu_capability(isa_str, isa), "Unknown ISA level: ", isa_str);
+        set_dispatch_stub_isa(name, isa);
+      });
+
+  m.def("_clear_dispatch_stub_isa", [](const std::string& name) {
+    torch_ipex::cpu::clear_dispatch_stub_isa(name);
+  });
+
   m.def("mkldnn_set_verbose", &torch_ipex::utils::onednn_set_verbose);
   m.def("onednn_has_bf16_support", []() {
     return torch_ipex::utils::onednn_has_bf16_type_support();
@@ -127,6 +172,97 @@ void InitIpexModuleBindings(py::module m) {
   m.def(
       "_jit_llga_weight_cache_enabled",
       &torch_ipex::jit::fuser::onednn::getLlgaWeightCacheEnabled);
+  m.def(
+      "_jit_set_llga_profiler_enabled",
+      &torch_ipex::jit::fuser::onednn::setLlgaProfilerEnabled);
+  m.def(
+      "_jit_llga_profiler_enabled",
+      &torch_ipex::jit::fuser::onednn::getLlgaProfilerEnabled);
+  m.def(
+      "_jit_reset_llga_profiler",
+      &torch_ipex::jit::fuser::onednn::resetLlgaProfiler);
+  m.def(
+      "_jit_llga_profiler_table",
+      &torch_ipex::jit::fuser::onednn::getLlgaProfilerTable);
+  m.def(
+      "_jit_llga_profiler_chrome_trace",
+      &torch_ipex::jit::fuser::onednn::getLlgaProfilerChromeTrace);
+
+  // weight-only quantized linear
+  m.def(
+      "_jit_set_woq_linear_config",
+      &torch_ipex::jit::graph_rewrite::setWoqLinearConfig,
+      py::arg("weight_dtype"),
+      py::arg("group_size") = -1);
+  m.def(
+      "_jit_woq_linear_config",
+      &torch_ipex::jit::graph_rewrite::getWoqLinearConfig);
+
+  // dynamic int8 quantized linear
+  m.def(
+      "_jit_set_dynamic_quant_linear_config",
+      &torch_ipex::jit::graph_rewrite::setDynamicQuantLinearConfig,
+      py::arg("activation_granularity"),
+      py::arg("per_channel_weight") = true);
+  m.def(
+      "_jit_dynamic_quant_linear_config",
+      &torch_ipex::jit::graph_rewrite::getDynamicQuantLinearConfig);
+
+  // block-sparse linear
+  m.def(
+      "_jit_set_sparse_linear_density_threshold",
+      &torch_ipex::jit::graph_rewrite::setSparseLinearDensityThreshold);
+  m.def(
+      "_jit_sparse_linear_density_threshold",
+      &torch_ipex::jit::graph_rewrite::getSparseLinearDensityThreshold);
+
+  // gated MLP
+  m.def(
+      "_jit_set_gated_mlp_fusion_enabled",
+      &torch_ipex::jit::graph_rewrite::setGatedMlpFusionEnabled);
+  m.def(
+      "_jit_gated_mlp_fusion_enabled",
+      &torch_ipex::jit::graph_rewrite::getGatedMlpFusionEnabled);
+
+  // grouped linear
+  m.def(
+      "_jit_set_grouped_linear_enabled",
+      &torch_ipex::jit::setGroupedLinearEnabled);
+  m.def(
+      "_jit_grouped_linear_enabled", &torch_ipex::jit::getGroupedLinearEnabled);
+
+  // concat elimination
+  m.def(
+      "_jit_set_concat_elimination_enabled",
+      &torch_ipex::jit::setConcatEliminationEnabled);
+  m.def(
+      "_jit_concat_elimination_enabled",
+      &torch_ipex::jit::getConcatEliminationEnabled);
+
+  // activation memory planning
+  m.def(
+      "_jit_set_activation_memory_planning_enabled",
+      &torch_ipex::jit::setActivationMemoryPlanningEnabled);
+  m.def(
+      "_jit_activation_memory_planning_enabled",
+      &torch_ipex::jit::getActivationMemoryPlanningEnabled);
+  m.def("_jit_get_activation_memory_plans", []() {
+    py::list plans;
+    for (auto& stat :
+         torch_ipex::cpu::detail::arena::get_memory_plan_stats()) {
+      py::dict item;
+      item["plan_id"] = stat.plan_id;
+      item["num_values"] = stat.num_values;
+      item["arena_bytes"] = stat.arena_bytes;
+      item["naive_bytes"] = stat.naive_bytes;
+      item["fallbacks"] = stat.fallbacks;
+      plans.append(item);
+    }
+    return plans;
+  });
+  m.def("_jit_release_activation_arenas", []() {
+    torch_ipex::cpu::detail::arena::release_thread_arenas();
+  });
 
   m.def("enable_jit_opt", []() {
     AutoOptConfig::singleton().set_jit_fuse(true);
@@ -223,6 +359,43 @@ void InitIpexModuleBindings(py::module m) {
         torch_ipex::runtime::set_mask_affinity_from_cpu_pool((*cpu_pool));
         return;
       });
+
+  // NUMA-local allocator
+  m.def(
+      "_numa_allocator_set_default",
+      &torch_ipex::runtime::set_numa_allocator_as_default);
+  m.def(
+      "_numa_allocator_is_default",
+      &torch_ipex::runtime::is_numa_allocator_default);
+  m.def(
+      "_numa_set_weight_allocation",
+      &torch_ipex::runtime::set_numa_weight_allocation);
+  m.def(
+      "_numa_weight_allocation_enabled",
+      &torch_ipex::runtime::is_numa_weight_allocation_enabled);
+  m.def("_numa_to_local", &torch_ipex::runtime::to_numa_local);
+  m.def("_numa_allocator_stats", []() {
+    auto stats = torch_ipex::runtime::get_numa_allocator()->get_stats();
+    py::dict item;
+    item["allocations"] = stats.allocations;
+    item["frees"] = stats.frees;
+    item["cache_hits"] = stats.cache_hits;
+    item["cache_misses"] = stats.cache_misses;
+    item["bytes_in_use"] = stats.bytes_in_use;
+    item["peak_bytes_in_use"] = stats.peak_bytes_in_use;
+    item["bytes_cached"] = stats.bytes_cached;
+    item["huge_2m_bytes"] = stats.huge_2m_bytes;
+    item["huge_1g_bytes"] = stats.huge_1g_bytes;
+    item["mbind_failures"] = stats.mbind_failures;
+    item["node_bytes_in_use"] = stats.node_bytes_in_use;
+    return item;
+  });
+  m.def("_numa_allocator_empty_cache", []() {
+    torch_ipex::runtime::get_numa_allocator()->empty_cache();
+  });
+  m.def("_numa_allocator_reset_peak_stats", []() {
+    torch_ipex::runtime::get_numa_allocator()->reset_peak_stats();
+  });
 }
 } // namespace
 
@@ -55,6 +55,7 @@ class _Properties(object):
         self.conv_bn_folding = None
         self.weights_prepack = None
         self.remove_dropout = None
+        self.fuse_bn_relu = None
         # optimizer opt conig
         self.split_master_weight_for_bf16 = None
         self.fuse_update_step = None
@@ -70,6 +71,7 @@ class _O0:
         properties.weights_prepack = False
         properties.replace_dropout_with_identity = False
         properties.optimize_lstm = False
+        properties.fuse_bn_relu = False
         properties.split_master_weight_for_bf16 = False
         properties.fuse_update_step = False
         properties.auto_kernel_selection = False
@@ -86,6 +88,7 @@ class _O1:
         properties.weights_prepack = True
         properties.replace_dropout_with_identity = True
         properties.optimize_lstm = True
+        properties.fuse_bn_relu = False
         properties.split_master_weight_for_bf16 = True
         properties.fuse_update_step = True
         properties.auto_kernel_selection = False
@@ -198,11 +201,15 @@ def optimize(
     weights_prepack=None,
     replace_dropout_with_identity=None,
     optimize_lstm=None,
+    fuse_bn_relu=None,
     split_master_weight_for_bf16=None,
     fuse_update_step=None,
     auto_kernel_selection=None,
     sample_input=None,
-    graph_mode=None
+    graph_mode=None,
+    woq_weight_dtype=None,
+    woq_group_size=-1,
+    sparse_density_threshold=None
 ):
     r"""
     Apply optimizations at Python frontend to the given model (nn.Module), as
@@ -266,6 +273,16 @@ def optimize(
             which takes advantage of oneDNN kernels to get better performance.
             The default value is ``None``. Explicitly setting this knob
             overwrites the configuration set by ``level`` knob.
+        fuse_bn_relu (bool): Whether to swap ``BatchNorm2d/3d`` followed by
+            ``ReLU``, or by a residual add and ``ReLU``, with a fused module for
+            channels last training. Only the batch statistics and a ReLU mask
+            bitmap are saved for the backward. The model is traced with
+            ``torch.fx`` and, if a pattern is found, returned as a
+            ``torch.fx.GraphModule``, so custom methods and attributes of the
+            model class are not kept. It only works for training model and is
+            off at both ``O0`` and ``O1``. The default value is ``None``.
+            Explicitly setting this knob overwrites the configuration set by
+            ``level`` knob.
         split_master_weight_for_bf16 (bool): Whether to split master weights
             update for BF16 training. This saves memory comparing to master
             weight update solution. Split master weights update methodology
@@ -290,6 +307,22 @@ def optimize(
             configuration set by ``level`` knob.
         graph_mode: (bool) [experimental]: It will automatically apply a combination of methods
             to generate graph or multiple subgraphs if True. The default value is ``False``.
+        woq_weight_dtype (torch.dtype) [experimental]: ``torch.qint8`` or ``torch.quint4x2``.
+            If set, ``nn.Linear`` weights are quantized to int8 or int4 and dequantized on the
+            fly inside the GEMM kernel, while activations stay in float or bfloat16
+            (weight-only quantization). This reduces the memory traffic of small-batch
+            inference with large linears. It only works for inference model. The default
+            value is ``None``, meaning weights are not quantized.
+        woq_group_size (int) [experimental]: Number of input channels sharing one
+            quantization scale when ``woq_weight_dtype`` is set. The default value is ``-1``,
+            meaning one scale per output channel.
+        sparse_density_threshold (float) [experimental]: If set, the weight of each
+            ``nn.Linear`` is split into blocks of 16 output channels by 4 input channels,
+            and the linear runs a block-sparse kernel that skips the all-zero blocks when
+            the fraction of non-zero blocks is below this threshold, e.g. ``0.5`` for
+            pruned models with more than 50% block sparsity. The non-zero blocks are kept
+            in bfloat16 if ``dtype`` is ``torch.bfloat16``. It only works for inference
+            model. The default value is ``None``, meaning linears stay dense.
 
     Returns:
         Model and optimizer (if given) modified according to the ``level`` knob
@@ -365,6 +398,8 @@ def optimize(
         opt_properties.replace_dropout_with_identity = replace_dropout_with_identity
     if optimize_lstm is not None:
         opt_properties.optimize_lstm = optimize_lstm
+    if fuse_bn_relu is not None:
+        opt_properties.fuse_bn_relu = fuse_bn_relu
     if split_master_weight_for_bf16 is not None:
         opt_properties.split_master_weight_for_bf16 = split_master_weight_for_bf16
     if fuse_update_step is not None:
@@ -408,6 +443,12 @@ def optimize(
 
     if opt_properties.optimize_lstm:
         utils._model_convert.replace_lstm_with_ipex_lstm(optimized_model, optimized_optimizer)
+    if model.training and opt_properties.fuse_bn_relu:
+        try:
+            optimized_model = utils._model_convert.replace_batch_norm_relu_with_ipex_batch_norm_relu(
+                optimized_model)
+        except torch.fx.proxy.TraceError:
+            warnings.warn("BatchNorm ReLU fusion failed during the optimize process.")
     if model.training and opt_properties.split_master_weight_for_bf16 and dtype is torch.bfloat16:
         if not opt_properties.fuse_update_step:
             opt_properties.split_master_weight_for_bf16 = False
@@ -431,6 +472,18 @@ def optimize(
     if dtype == torch.half and model.training:
         optimized_model, optimized_optimizer, params_attr = utils._weight_cast.weight_dtype_convert_with_ipex(
             optimized_model, optimized_optimizer, params_attr, False, convert_dtype=torch.half)
+    if woq_weight_dtype is not None:
+        assert optimizer is None, "Weight-only quantization only works for inference model"
+        assert woq_weight_dtype in [torch.qint8, torch.quint4x2], \
+            "Weight-only quantization only supports torch.qint8 and torch.quint4x2 weights"
+        optimized_model = utils._weight_prepack.woq_linear_prepack_with_ipex(
+            optimized_model, woq_weight_dtype, woq_group_size)
+    if sparse_density_threshold is not None:
+        assert optimizer is None, "Sparse linear only works for inference model"
+        assert woq_weight_dtype is None, "Sparse linear cannot be combined with weight-only quantization"
+        assert 0 < sparse_density_threshold <= 1, "Sparse density threshold should be in (0, 1]"
+        optimized_model = utils._weight_prepack.sparse_linear_prepack_with_ipex(
+            optimized_model, sparse_density_threshold, dtype)
     # Since TorchDynamo cannot handle custom operations yet, for the case of inference graph mode,
     # the weights prepacking here is temporarily cancelled, and it will be completed on the graph.
     if opt_properties.weights_prepack and (opt_properties.graph_mode is not True or optimizer is not None):
@@ -4,6 +4,7 @@ from torch.autograd import Function
 from typing import List, Optional, NamedTuple
 from itertools import accumulate
 import enum
+from intel_extension_for_pytorch.cpu.runtime.numa_allocator import to_numa_local
 
 class PoolingMode(enum.IntEnum):
     SUM = 0
@@ -99,15 +100,20 @@ class MergedEmbeddingBag(nn.Module):
     in the future.
     For the introduction of MergedEmbeddingBagWith[Optimizer], please find the comments at
     MergedEmbeddingBagWithSGD.
+    With numa_local=True, the tables are copied into memory allocated by the NUMA-local allocator
+    (see intel_extension_for_pytorch.cpu.runtime.to_numa_local) on the NUMA node of the creating
+    thread, so the module should be created from a thread pinned to the CPU pool that runs it.
     """
     embedding_specs: List[EmbeddingSpec]
 
     def __init__(
         self,
         embedding_specs: List[EmbeddingSpec],
+        numa_local: bool = False
     ):
         super(MergedEmbeddingBag, self).__init__()
         self.n_tables = len(embedding_specs)
+        self.numa_local = numa_local
         self.weights = []
         row_offsets = []
         feature_sizes = []
@@ -126,6 +132,8 @@ class MergedEmbeddingBag(nn.Module):
                 assert False, r"MergedEmbeddingBag only support EmbeddingBag with model sum or mean"
             if weight is None:
                 weight = torch.empty((num_of_features, feature_size), dtype=dtype)
+            if numa_local:
+                weight = to_numa_local(weight)
             self.weights[i] = nn.Parameter(weight)
         self.register_buffer(
             "row_offsets",
@@ -247,9 +255,10 @@ class MergedEmbeddingBagWithSGD(MergedEmbeddingBag):
         self,
         embedding_specs: List[EmbeddingSpec],
         lr: float = 0.01,
-        weight_decay: float = 0
+        weight_decay: float = 0,
+        numa_local: bool = False
     ):
-        super(MergedEmbeddingBagWithSGD, self).__init__(embedding_specs)
+        super(MergedEmbeddingBagWithSGD, self).__init__(embedding_specs, numa_local)
         self.sgd_args = self.init_sgd_args(lr, weight_decay)
         for i in range(self.n_tables):
             weight = self.weights[i]
@@ -284,6 +293,8 @@ class MergedEmbeddingBagWithSGD(MergedEmbeddingBag):
                 bf16_w, trail = torch.ops.torch_ipex.split_float_bfloat16(self.weights[i].float())
             else:
                 assert False, r"MergedEmbeddingBag only support dtypes with bfloat, float and double"
+            if self.numa_local:
+                bf16_w, trail = to_numa_local(bf16_w), to_numa_local(trail)
             trails.append(trail)
             self.weights[i] = torch.nn.Parameter(bf16_w)
         self.sgd_args = self.sgd_args._replace(bf16_trail=trails)
@@ -311,7 +322,8 @@ class MergedEmbeddingBagWithSGD(MergedEmbeddingBag):
         cls,
         tables: List[torch.nn.EmbeddingBag],
         lr: float = 0.01,
-        weight_decay: float = 0
+        weight_decay: float = 0,
+        numa_local: bool = False
     ):
         embedding_specs = []
         for emb in tables:
@@ -324,4 +336,4 @@ class MergedEmbeddingBagWithSGD(MergedEmbeddingBag):
                     dtype=emb.weight.dtype,
                     weight=emb.weight.detach()
                 ))
-        return cls(embedding_specs, lr, weight_decay)
+        return cls(embedding_specs, lr, weight_decay, numa_local)
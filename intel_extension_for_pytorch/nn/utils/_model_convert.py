@@ -1,5 +1,6 @@
 import torch
 import copy
+import operator
 import warnings
 
 from torch.nn.utils.rnn import PackedSequence
@@ -128,3 +129,97 @@ def convert_module_data_type(module, dtype):
     for child in module.children():
         convert_module_data_type(child, dtype)
     return module
+
+class _BatchNormReLUMixin(object):
+    # Fused relu(batch_norm(input) (+ other)) sharing the __dict__ of the swapped
+    # batch norm, so the parameters, buffers and state_dict keys are unchanged.
+    # Port the running stats bookkeeping from torch/nn/modules/batchnorm.py
+    def forward(self, input, other=None):
+        self._check_input_dim(input)
+        exponential_average_factor = 0.0 if self.momentum is None else self.momentum
+        if self.training and self.track_running_stats:
+            if self.num_batches_tracked is not None:
+                self.num_batches_tracked.add_(1)
+                if self.momentum is None:
+                    exponential_average_factor = 1.0 / float(self.num_batches_tracked)
+        bn_training = self.training or (self.running_mean is None and self.running_var is None)
+        track_running_stats = not self.training or self.track_running_stats
+        running_mean = self.running_mean if track_running_stats else None
+        running_var = self.running_var if track_running_stats else None
+        if other is None:
+            return torch.ops.torch_ipex.batch_norm_relu(
+                input, self.weight, self.bias, running_mean, running_var,
+                bn_training, exponential_average_factor, self.eps)
+        return torch.ops.torch_ipex.batch_norm_add_relu(
+            input, other, self.weight, self.bias, running_mean, running_var,
+            bn_training, exponential_average_factor, self.eps)
+
+class _BatchNormReLU2d(_BatchNormReLUMixin, torch.nn.BatchNorm2d):
+    pass
+
+class _BatchNormReLU3d(_BatchNormReLUMixin, torch.nn.BatchNorm3d):
+    pass
+
+def _is_relu_node(node, modules):
+    if node.op == 'call_module':
+        return isinstance(modules.get(node.target), torch.nn.ReLU)
+    if node.op == 'call_function':
+        return node.target in [torch.relu, torch.relu_, torch.nn.functional.relu]
+    return node.op == 'call_method' and node.target in ['relu', 'relu_']
+
+def _is_add_node(node):
+    # torch.add with alpha is not a plain residual add
+    return node.op == 'call_function' and len(node.args) == 2 and not node.kwargs and \
+        node.target in [operator.add, operator.iadd, torch.add]
+
+def replace_batch_norm_relu_with_ipex_batch_norm_relu(model):
+    # swap batch_norm -> relu and batch_norm -> add -> relu for training, the
+    # fused kernels save a relu mask bitmap instead of the batch norm output.
+    # Returns the original model if no pattern is found.
+    import torch.fx as fx
+    fused_classes = {torch.nn.BatchNorm2d: _BatchNormReLU2d,
+                     torch.nn.BatchNorm3d: _BatchNormReLU3d}
+    fx_model = fx.symbolic_trace(model)
+    modules = dict(fx_model.named_modules())
+    bn_calls = {}
+    for node in fx_model.graph.nodes:
+        if node.op == 'call_module':
+            bn_calls[node.target] = bn_calls.get(node.target, 0) + 1
+    fused = False
+    for node in list(fx_model.graph.nodes):
+        if node.op != 'call_module' or type(modules[node.target]) not in fused_classes:
+            continue
+        # a shared module would change its other call sites too
+        if bn_calls[node.target] > 1 or len(node.users) != 1 or len(node.args) != 1 or node.kwargs:
+            continue
+        user = next(iter(node.users))
+        other = None
+        if _is_add_node(user) and len(user.users) == 1:
+            other = user.args[1] if user.args[0] is node else user.args[0]
+            if not isinstance(other, fx.Node) or other is node:
+                continue
+            relu = next(iter(user.users))
+        else:
+            relu = user
+        if not _is_relu_node(relu, modules):
+            continue
+        bn = modules[node.target]
+        fused_bn = fused_classes[type(bn)].__new__(fused_classes[type(bn)])
+        fused_bn.__dict__ = bn.__dict__
+        parent_name, name = node.target.rsplit('.', 1) if '.' in node.target else ('', node.target)
+        setattr(modules[parent_name], name, fused_bn)
+        modules[node.target] = fused_bn
+        if other is not None:
+            # the residual may be computed after the batch norm
+            relu.prepend(node)
+            node.args = (node.args[0], other)
+        relu.replace_all_uses_with(node)
+        fx_model.graph.erase_node(relu)
+        if other is not None:
+            fx_model.graph.erase_node(user)
+        fused = True
+    if not fused:
+        return model
+    fx_model.graph.lint()
+    fx_model.recompile()
+    return fx_model
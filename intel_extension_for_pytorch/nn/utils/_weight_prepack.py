@@ -169,6 +169,72 @@ class _IPEXLinear(torch.nn.Module):
                               missing_keys, unexpected_keys, error_msgs):
         assert False, "_IPEXLinear does not support _load_from_state_dict method"
 
+class _IPEXWoqLinear(torch.nn.Module):
+    def __init__(self, dense_module, weight_dtype, group_size):
+        super(_IPEXWoqLinear, self).__init__()
+        self.in_features = dense_module.in_features
+        self.out_features = dense_module.out_features
+        self.weight_dtype = weight_dtype
+        self.group_size = group_size
+
+        if dense_module.bias is not None:
+            self.bias = nn.Parameter(
+                dense_module.bias.detach().clone(), requires_grad = False)
+        else:
+            self.register_parameter('bias', None)
+
+        # create weight-only quantized linear op context, only the int8/int4
+        # packed weight is kept, the original weight is dropped
+        self.ctx = torch.ops.ipex_prepack.woq_linear_prepack(
+            dense_module.weight.detach(), self.bias, weight_dtype, group_size)
+        self.register_buffer('weight', self.ctx.get_weight())
+
+    def forward(self, x):
+        return torch.ops.torch_ipex.ipex_woq_linear(
+            x, self.weight, self.bias, self.ctx.get_data_handle())
+
+    def _save_to_state_dict(self, destination, prefix, keep_vars):
+        assert not keep_vars, "can not using keep_vars true when to save _IPEXWoqLinear's parameters"
+        if self.bias is not None:
+            destination[prefix + 'bias'] = self.bias.detach()
+        destination[prefix + 'weight'] = self.ctx.to_public(self.weight)
+
+    def _load_from_state_dict(self, state_dict, prefix, local_metadata, strict,
+                              missing_keys, unexpected_keys, error_msgs):
+        assert False, "_IPEXWoqLinear does not support _load_from_state_dict method"
+
+class _IPEXSparseLinear(torch.nn.Module):
+    def __init__(self, dense_module, dtype):
+        super(_IPEXSparseLinear, self).__init__()
+        self.in_features = dense_module.in_features
+        self.out_features = dense_module.out_features
+
+        if dense_module.bias is not None:
+            self.bias = nn.Parameter(
+                dense_module.bias.detach().clone(), requires_grad = False)
+        else:
+            self.register_parameter('bias', None)
+
+        # create block-sparse linear op context, only the non-zero blocks of
+        # the weight are kept, the original weight is dropped
+        self.ctx = torch.ops.ipex_prepack.sparse_linear_prepack(
+            dense_module.weight.detach().to(dtype), self.bias)
+        self.register_buffer('weight', self.ctx.get_weight())
+
+    def forward(self, x):
+        return torch.ops.torch_ipex.ipex_sparse_linear(
+            x, self.weight, self.bias, self.ctx.get_data_handle())
+
+    def _save_to_state_dict(self, destination, prefix, keep_vars):
+        assert not keep_vars, "can not using keep_vars true when to save _IPEXSparseLinear's parameters"
+        if self.bias is not None:
+            destination[prefix + 'bias'] = self.bias.detach()
+        destination[prefix + 'weight'] = self.ctx.to_public(self.weight)
+
+    def _load_from_state_dict(self, state_dict, prefix, local_metadata, strict,
+                              missing_keys, unexpected_keys, error_msgs):
+        assert False, "_IPEXSparseLinear does not support _load_from_state_dict method"
+
 class _IPEXConvTransposeNd(nn.Module):
     __constants__ = ['stride', 'padding', 'dilation', 'groups',
                      'out_channels', 'kernel_size', 'output_padding']
@@ -294,22 +360,56 @@ def _should_prepack(module):
         return False
     return True
 
-def weight_prepack_with_ipex(module, optimizer, params_attr):
+def _can_prepack(m):
+    return _should_prepack(m) and m.weight.dtype in [torch.float32, torch.bfloat16, torch.half]
+
+def _prepack_module(m, optimizer):
+    if type(m) is torch.nn.Linear:
+        if m.weight.dtype == torch.half:
+            return IPEX_WEIGHT_PREPACK_MODULE[type(m)](m, use_dnnl = True)
+        elif m.weight.dtype == torch.float32 and optimizer is None and frontend.get_fp32_math_mode(device="cpu") == frontend.FP32MathMode.FP32 and not _using_dnnl():
+            return IPEX_WEIGHT_PREPACK_MODULE[type(m)](m, use_dnnl = False)
+        else:
+            assert m.weight.dtype in [torch.float32, torch.bfloat16], "Only float, bf16 and fp16 are supported"
+            return IPEX_WEIGHT_PREPACK_MODULE[type(m)](m, use_dnnl = True)
+    return IPEX_WEIGHT_PREPACK_MODULE[type(m)](m)
+
+def _prepack_modules_in_parallel(module, num_workers, callback=None):
+    # The prepack ops release the GIL, so the weights of an inference model are
+    # reordered by num_workers threads, each with its share of the OpenMP
+    # threads. Returns the prepacked module of every prepackable submodule.
+    from concurrent.futures import ThreadPoolExecutor
+    modules = [m for m in module.modules() if _can_prepack(m)]
+    num_threads = torch.get_num_threads()
+    threads_per_worker = max(1, num_threads // num_workers)
+
+    def prepack(m):
+        torch.set_num_threads(threads_per_worker)
+        return _prepack_module(m, None)
+
+    prepacked = {}
+    try:
+        with ThreadPoolExecutor(max_workers=num_workers) as executor:
+            for i, (m, new_m) in enumerate(zip(modules, executor.map(prepack, modules))):
+                prepacked[m] = new_m
+                if callback is not None:
+                    callback(i + 1, len(modules))
+    finally:
+        # MKL keeps a process wide thread count
+        torch.set_num_threads(num_threads)
+    return prepacked
+
+def weight_prepack_with_ipex(module, optimizer, params_attr, num_workers=1, callback=None):
+    prepacked = {}
+    if optimizer is None and (num_workers > 1 or callback is not None):
+        prepacked = _prepack_modules_in_parallel(module, num_workers, callback)
+
     def convert(m, optimizer, params_attr):
-        if _should_prepack(m) and (m.weight.dtype == torch.float32 or m.weight.dtype == torch.bfloat16 or m.weight.dtype == torch.half):
+        if _can_prepack(m):
             weight = m.master_weight if hasattr(m, "master_weight") else m.weight
             if weight not in params_attr:
                 params_attr[weight] = {}
-            if type(m) is torch.nn.Linear:
-                if m.weight.dtype == torch.half:
-                    new_m = IPEX_WEIGHT_PREPACK_MODULE[type(m)](m, use_dnnl = True)
-                elif m.weight.dtype == torch.float32 and optimizer is None and frontend.get_fp32_math_mode(device="cpu") == frontend.FP32MathMode.FP32 and not _using_dnnl():
-                    new_m = IPEX_WEIGHT_PREPACK_MODULE[type(m)](m, use_dnnl = False)
-                else:
-                    assert m.weight.dtype in [torch.float32, torch.bfloat16], "Only float, bf16 and fp16 are supported"
-                    new_m = IPEX_WEIGHT_PREPACK_MODULE[type(m)](m, use_dnnl = True)
-            else:
-                new_m = IPEX_WEIGHT_PREPACK_MODULE[type(m)](m)
+            new_m = prepacked[m] if m in prepacked else _prepack_module(m, optimizer)
             params_attr[weight].update({
                 'op': type(m),
                 'ctx': new_m.ctx})
@@ -358,6 +458,37 @@ def weight_prepack_with_ipex(module, optimizer, params_attr):
         optim._optimizer_utils.patch_state_dict(opt_optmizer)
     return opt_model, opt_optmizer, params_attr
 
+def woq_linear_prepack_with_ipex(module, weight_dtype, group_size):
+    def convert(m):
+        if type(m) is torch.nn.Linear and _should_prepack(m) and \
+                m.weight.dtype in [torch.float32, torch.bfloat16]:
+            return _IPEXWoqLinear(m, weight_dtype, group_size)
+        return m
+
+    def convert_rec(m):
+        new_m = convert(m)
+        for name, sub_m in m.named_children():
+            setattr(new_m, name, convert_rec(sub_m))
+        return new_m
+
+    return convert_rec(module)
+
+def sparse_linear_prepack_with_ipex(module, density_threshold, dtype):
+    def convert(m):
+        if type(m) is torch.nn.Linear and _should_prepack(m) and \
+                m.weight.dtype in [torch.float32, torch.bfloat16] and \
+                torch.ops.torch_ipex.sparse_linear_block_density(m.weight.detach()) < density_threshold:
+            return _IPEXSparseLinear(m, torch.bfloat16 if dtype == torch.bfloat16 else m.weight.dtype)
+        return m
+
+    def convert_rec(m):
+        new_m = convert(m)
+        for name, sub_m in m.named_children():
+            setattr(new_m, name, convert_rec(sub_m))
+        return new_m
+
+    return convert_rec(module)
+
 def record_input_shape_for_prepack(module, sample_input):
 
     def hook_function(self, input):
@@ -1,3 +1,3 @@
 from ._quantize import prepare, convert
-from ._qconfig import default_static_qconfig, default_dynamic_qconfig
+from ._qconfig import default_static_qconfig, default_dynamic_qconfig, per_token_dynamic_qconfig
 from ._autotune import autotune
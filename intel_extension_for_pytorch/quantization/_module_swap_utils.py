@@ -7,9 +7,71 @@ from torch.ao.quantization import swap_module
 import torch.nn.quantized.dynamic as nnqd
 from torch.quantization.qconfig import QConfig
 
+from ._qconfig import PerTokenPlaceholderObserver
+
+class _IPEXDynamicQuantLinear(torch.nn.Module):
+    r"""
+    Linear with prepacked s8 weights whose activations are quantized to u8 at
+    run time, per tensor or per token, and multiplied in int8 with the
+    dequantization, the bias and a fused relu/gelu (under JIT) in the epilogue.
+    """
+    _FLOAT_MODULE = nn.Linear
+
+    def __init__(self, dense_module, per_channel_weight, per_token):
+        super(_IPEXDynamicQuantLinear, self).__init__()
+        self.in_features = dense_module.in_features
+        self.out_features = dense_module.out_features
+        self.per_channel_weight = per_channel_weight
+        self.per_token = per_token
+
+        if dense_module.bias is not None:
+            self.bias = nn.Parameter(
+                dense_module.bias.detach().clone(), requires_grad = False)
+        else:
+            self.register_parameter('bias', None)
+
+        # create dynamic quantized linear op context, only the s8 packed weight
+        # is kept, the original weight is dropped
+        self.ctx = torch.ops.ipex_prepack.dynamic_quant_linear_prepack(
+            dense_module.weight.detach(), self.bias, per_channel_weight, per_token)
+        self.register_buffer('weight', self.ctx.get_weight())
+
+    def forward(self, x):
+        return torch.ops.torch_ipex.ipex_dynamic_quant_linear(
+            x, self.weight, self.bias, self.ctx.get_data_handle())
+
+    def _save_to_state_dict(self, destination, prefix, keep_vars):
+        assert not keep_vars, "can not using keep_vars true when to save _IPEXDynamicQuantLinear's parameters"
+        if self.bias is not None:
+            destination[prefix + 'bias'] = self.bias.detach()
+        destination[prefix + 'weight'] = self.ctx.to_public(self.weight)
+
+    def _load_from_state_dict(self, state_dict, prefix, local_metadata, strict,
+                              missing_keys, unexpected_keys, error_msgs):
+        assert False, "_IPEXDynamicQuantLinear does not support _load_from_state_dict method"
+
+    @classmethod
+    def from_float(cls, mod):
+        r"""
+        Swaps a float linear with a dynamic qconfig, the qconfigs that need
+        what the IPEX kernel does not provide (qint8 activations or asymmetric
+        weights) keep using ``torch.nn.quantized.dynamic.Linear``.
+        """
+        activation = mod.qconfig.activation()
+        weight_observer = mod.qconfig.weight()
+        compute_dtype = activation.compute_dtype if hasattr(activation, 'compute_dtype') else None
+        if compute_dtype is not torch.quint8 or \
+                weight_observer.dtype is not torch.qint8 or \
+                weight_observer.qscheme not in [torch.per_tensor_symmetric, torch.per_channel_symmetric] or \
+                mod.weight.dtype not in [torch.float32, torch.bfloat16]:
+            return nnqd.Linear.from_float(mod)
+        return cls(mod,
+                   weight_observer.qscheme == torch.per_channel_symmetric,
+                   isinstance(activation, PerTokenPlaceholderObserver))
+
 # Default map for swapping dynamic modules
 DEFAULT_DYNAMIC_QUANT_MODULE_MAPPINGS : Dict[Callable, Any] = {
-    nn.Linear: nnqd.Linear,
+    nn.Linear: _IPEXDynamicQuantLinear,
     nn.LSTM: nnqd.LSTM,
     # TODO: support more RNN module
     #nn.GRUCell: nnqd.GRUCell,
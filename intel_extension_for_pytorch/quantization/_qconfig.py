@@ -15,3 +15,17 @@ default_dynamic_qconfig = QConfig(activation=PlaceholderObserver.with_args(dtype
 """
 Default qconfig configuration for dynamic quantization.
 """
+
+class PerTokenPlaceholderObserver(PlaceholderObserver):
+    r"""
+    Placeholder for the activation of dynamically quantized linears, which
+    are then quantized with one scale and zero point per token (row) instead
+    of one per tensor.
+    """
+    pass
+
+per_token_dynamic_qconfig = QConfig(activation=PerTokenPlaceholderObserver.with_args(dtype=torch.float, compute_dtype=torch.quint8),
+                                    weight=_default_weight_observer)
+"""
+Qconfig configuration for dynamic quantization with per-token activation scales.
+"""
@@ -6,6 +6,7 @@ import torch.nn.functional as F
 import torch.nn.quantized.dynamic as nnqd
 from intel_extension_for_pytorch.nn.functional import interaction
 import intel_extension_for_pytorch._C as core
+from ._module_swap_utils import _IPEXDynamicQuantLinear
 
 
 functions_supported_by_quantization =set([
@@ -68,6 +69,7 @@ module_types_supported_by_quantization = set([
     torch.nn.LSTM,
     # dynamic quantization module
     nnqd.Linear,
+    _IPEXDynamicQuantLinear,
     nnqd.LSTM,
     ])
 
@@ -81,6 +83,8 @@ a_related_to_b = (
     (str(torch.Tensor.add), str(torch.add)),
     (str(torch.nn.Linear), str(nnqd.Linear)),
     (str(nnqd.Linear), str(torch.nn.Linear)),
+    (str(torch.nn.Linear), str(_IPEXDynamicQuantLinear)),
+    (str(_IPEXDynamicQuantLinear), str(torch.nn.Linear)),
     (str(torch.nn.LSTM), str(nnqd.LSTM)),
     (str(nnqd.LSTM), str(torch.nn.LSTM)),
 )
@@ -9,6 +9,7 @@ import torch.fx.experimental.optimization as optimization
 import intel_extension_for_pytorch._C as core
 from intel_extension_for_pytorch.utils.linear_bn_folding import linear_bn_fuse
 from ._quantize_utils import auto_prepare, auto_convert, copy_prepared_model
+from ._module_swap_utils import _IPEXDynamicQuantLinear
 from .. import nn
 
 def prepare(
@@ -87,7 +88,12 @@ def convert(
             torch.nn.RNNCell : convert_model.q_config,
             torch.nn.GRUCell : convert_model.q_config,
         }
-        return torch.quantization.quantize_dynamic(convert_model, qconfig_spec=qconfig_spec, inplace=True)
+        # linears run the IPEX dynamic quantized linear, the RNNs keep the
+        # stock dynamic quantized modules
+        mapping = copy.copy(torch.ao.quantization.quantization_mappings.get_default_dynamic_quant_module_mappings())
+        mapping[torch.nn.Linear] = _IPEXDynamicQuantLinear
+        return torch.quantization.quantize_dynamic(
+            convert_model, qconfig_spec=qconfig_spec, mapping=mapping, inplace=True)
 
     # Convert linear, conv, and Embedding's weight dtype when use autocast,
     # which will reduce the dtype conversion.
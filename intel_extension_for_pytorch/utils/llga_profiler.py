@@ -0,0 +1,59 @@
+import intel_extension_for_pytorch._C as core
+
+class llga_profile(object):
+    """
+    Per partition profiler of the oneDNN Graph (LLGA) fusion groups
+
+    Inside the scope, every fused partition of a traced int8 (or LLGA fp32/
+    bf16) model records its compile latency, which is a miss of the
+    compilation cache, and its execute latency. The partitions are described
+    by their aten ops, their input shapes and dtypes, and the FLOPs and bytes
+    estimated from their logical tensors, so the achieved GFLOP/s and GB/s can
+    be compared without reading ``ONEDNN_VERBOSE`` dumps.
+
+    .. highlight:: python
+    .. code-block:: python
+
+        import intel_extension_for_pytorch as ipex
+        from intel_extension_for_pytorch.utils.llga_profiler import llga_profile
+        traced_model(data)
+        with llga_profile() as prof:
+            traced_model(data)
+        print(prof.table())
+        prof.export_chrome_trace("llga_trace.json")
+
+    Args:
+        reset (bool): Drop what was recorded by an earlier scope. Default: ``True``
+
+    :meta public:
+    """
+    def __init__(self, reset=True):
+        self.reset = reset
+
+    def __enter__(self):
+        if self.reset:
+            core._jit_reset_llga_profiler()
+        self.previous = core._jit_llga_profiler_enabled()
+        core._jit_set_llga_profiler_enabled(True)
+        return self
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        core._jit_set_llga_profiler_enabled(self.previous)
+        return False
+
+    def table(self):
+        r"""
+        One row per partition sorted by the total execute time, with the
+        compile count and average latency, the execute count, average, P50,
+        P99 and max latency, and the achieved GFLOP/s and GB/s. Percentiles
+        are the upper bounds of power of two microsecond buckets.
+        """
+        return core._jit_llga_profiler_table()
+
+    def export_chrome_trace(self, path):
+        r"""
+        Writes a trace in the Chrome trace event format, which can be opened
+        in ``chrome://tracing`` or Perfetto.
+        """
+        with open(path, "w") as f:
+            f.write(core._jit_llga_profiler_chrome_trace())
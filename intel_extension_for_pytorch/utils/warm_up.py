@@ -0,0 +1,187 @@
+import threading
+import warnings
+
+import torch
+
+class WarmUpHandle(object):
+    r"""
+    Progress and result of :func:`warm_up`. The serving process should report
+    itself ready only once :meth:`is_ready` returns ``True``.
+
+    :meta public:
+    """
+    def __init__(self, total):
+        self.model = None
+        self._lock = threading.Lock()
+        self._stage = "pending"
+        self._done = 0
+        self._total = total
+        self._error = None
+        self._ready = threading.Event()
+        self._thread = None
+
+    def _update(self, stage, done=None, total=None, advance=0, callback=None):
+        with self._lock:
+            self._stage = stage
+            if done is not None:
+                self._done = done
+            self._done += advance
+            if total is not None:
+                self._total = total
+            progress = (self._stage, self._done, self._total)
+        if callback is not None:
+            callback(*progress)
+
+    def progress(self):
+        r"""
+        Returns ``(stage, done, total)``. ``stage`` is one of ``"pending"``,
+        ``"prepack"``, ``"trace"``, ``"compile"``, ``"ready"`` and
+        ``"failed"``, ``done`` and ``total`` count the prepacked modules and the
+        warmed up (input, thread count) pairs.
+        """
+        with self._lock:
+            return (self._stage, self._done, self._total)
+
+    def is_ready(self):
+        return self._ready.is_set() and self._error is None
+
+    def wait(self, timeout=None):
+        r"""
+        Blocks until the warm-up finishes or ``timeout`` seconds elapse, and
+        returns :meth:`is_ready`. Raises what the warm-up raised.
+        """
+        self._ready.wait(timeout)
+        if self._error is not None:
+            raise self._error
+        return self.is_ready()
+
+def _num_prepack_workers(num_workers):
+    if num_workers is not None:
+        return num_workers
+    # a few threads are enough to hide the Python side of module creation,
+    # the reorders themselves run on the OpenMP threads of every worker
+    return max(1, min(8, torch.get_num_threads() // 4))
+
+def _as_tuple(sample_input):
+    return sample_input if isinstance(sample_input, tuple) else (sample_input,)
+
+def _run(handle, model, sample_inputs, num_threads, dtype, prepack_workers, jit, iterations, callback):
+    import intel_extension_for_pytorch as ipex
+    from intel_extension_for_pytorch.nn import utils
+
+    if not isinstance(model, torch.jit.ScriptModule):
+        assert not model.training, "warm_up only works for inference model"
+        # everything ipex.optimize does but the prepack, which is spread over
+        # the workers below
+        model = ipex.optimize(model, dtype=dtype, weights_prepack=False)
+        num_prepack = len([m for m in model.modules() if utils._weight_prepack._can_prepack(m)])
+        handle._update("prepack", 0, handle._total + num_prepack, callback=callback)
+        model, _, _ = utils._weight_prepack.weight_prepack_with_ipex(
+            model, None, {}, _num_prepack_workers(prepack_workers),
+            lambda done, total: handle._update("prepack", done, callback=callback))
+        if jit:
+            handle._update("trace", callback=callback)
+            example = _as_tuple(sample_inputs[0])
+            with torch.no_grad(), torch.cpu.amp.autocast(enabled=dtype == torch.bfloat16):
+                model = torch.jit.freeze(torch.jit.trace(model, example, check_trace=False))
+
+    # LLGA partitions are compiled on their first execution and cached per
+    # thread count, and the profiling executor needs two runs before it fuses.
+    # torch.set_num_threads also sets the MKL thread count, which is process
+    # wide, so other threads may run with the counts warmed up here until the
+    # previous count is restored.
+    previous_threads = torch.get_num_threads()
+    try:
+        for n in num_threads:
+            torch.set_num_threads(n)
+            for sample_input in sample_inputs:
+                with torch.no_grad(), torch.cpu.amp.autocast(enabled=dtype == torch.bfloat16):
+                    for _ in range(iterations):
+                        model(*_as_tuple(sample_input))
+                handle._update("compile", advance=1, callback=callback)
+    finally:
+        torch.set_num_threads(previous_threads)
+    handle.model = model
+    handle._update("ready", callback=callback)
+
+def warm_up(
+    model,
+    sample_inputs,
+    num_threads=None,
+    dtype=None,
+    jit=False,
+    prepack_workers=None,
+    iterations=3,
+    background=True,
+    callback=None
+):
+    r"""
+    Prepares an inference model for serving so that the first requests do not
+    pay for weight prepacking, JIT profiling and LLGA partition compilation.
+
+    An ``nn.Module`` is optimized like :func:`intel_extension_for_pytorch.optimize`
+    with its convolution and linear weights prepacked by ``prepack_workers``
+    threads, and traced and frozen with the first sample input if ``jit`` is
+    ``True``. A ``torch.jit.ScriptModule`` is taken as is, its weights were
+    prepacked when it was frozen. The model then runs every sample input with
+    every thread count, which compiles and caches the oneDNN Graph partitions
+    and the oneDNN primitives for these shapes.
+
+    .. highlight:: python
+    .. code-block:: python
+
+        import intel_extension_for_pytorch as ipex
+        from intel_extension_for_pytorch.utils.warm_up import warm_up
+        handle = warm_up(model.eval(), [torch.randn(1, 3, 224, 224), torch.randn(8, 3, 224, 224)],
+                         num_threads=[4, 56], dtype=torch.bfloat16, jit=True)
+        ...
+        handle.wait()
+        serving_model = handle.model
+
+    Args:
+        model (torch.nn.Module or torch.jit.ScriptModule): Inference model.
+        sample_inputs (list): One input (a tensor or a tuple of tensors) per
+            shape to be served.
+        num_threads (list of int): Thread counts the model will be run with.
+            The default value is ``None``, meaning the current thread count.
+        dtype (torch.dtype): Passed to ``optimize``, ``torch.bfloat16`` also
+            runs under ``torch.cpu.amp.autocast``. The default value is ``None``.
+        jit (bool): Whether to trace and freeze an ``nn.Module``. The default
+            value is ``False``.
+        prepack_workers (int): Number of threads prepacking the weights. The
+            default value is ``None``, meaning a quarter of the cores and at
+            most 8.
+        iterations (int): Runs per input and thread count. The default value
+            ``3`` covers the two profiling runs of the JIT.
+        background (bool): Whether to return immediately and warm up in a
+            daemon thread. The default value is ``True``.
+        callback (callable): Called with ``(stage, done, total)`` whenever the
+            progress changes. The default value is ``None``.
+
+    Returns:
+        :class:`WarmUpHandle`, whose ``model`` is the model to serve once it is
+        ready.
+    """
+    assert len(sample_inputs) > 0, "warm_up needs at least one sample input"
+    if num_threads is None:
+        num_threads = [torch.get_num_threads()]
+    handle = WarmUpHandle(len(num_threads) * len(sample_inputs))
+
+    def target():
+        try:
+            _run(handle, model, sample_inputs, num_threads, dtype, prepack_workers, jit, iterations, callback)
+        except Exception as e:  # noqa B902
+            handle._error = e
+            handle._update("failed", callback=callback)
+            if background:
+                warnings.warn("Warm-up failed: {}".format(e))
+        finally:
+            handle._ready.set()
+
+    if background:
+        handle._thread = threading.Thread(target=target, name="ipex_warm_up", daemon=True)
+        handle._thread.start()
+    else:
+        target()
+        handle.wait()
+    return handle
@@ -469,6 +469,13 @@ def get_cpp_test_dir():
 def get_cpp_test_build_dir():
     return os.path.join(get_build_type_dir(), 'tests', 'cpu', 'cpp')
 
+def get_cpp_bench_dir():
+    project_root_dir = os.path.abspath(os.path.dirname(__file__))
+    return os.path.join(project_root_dir, 'tests', 'cpu', 'bench', 'cpp')
+
+def get_cpp_bench_build_dir():
+    return os.path.join(get_build_type_dir(), 'tests', 'cpu', 'bench', 'cpp')
+
 def get_pybind11_abi_compiler_flags():
     try:
         import torch
@@ -587,6 +594,18 @@ class IPEXCPPLibBuild(build_clib, object):
         else:
             check_call(['make'] + build_args, cwd=cpp_test_build_dir, env=env)
 
+        # Build the CPP kernel benchmark
+        if _check_env_flag("IPEX_BUILD_CPP_BENCH"):
+            cpp_bench_dir = get_cpp_bench_dir()
+            cpp_bench_build_dir = get_cpp_bench_build_dir()
+            if not os.path.exists(cpp_bench_build_dir):
+                Path(cpp_bench_build_dir).mkdir(parents=True, exist_ok=True)
+            check_call([self.cmake, cpp_bench_dir] + cmake_args, cwd=cpp_bench_build_dir, env=env)
+            if use_ninja:
+                check_call(['ninja'] + build_args, cwd=cpp_bench_build_dir, env=env)
+            else:
+                check_call(['make'] + build_args, cwd=cpp_bench_build_dir, env=env)
+
 cmdclass = {
     'build_clib': IPEXCPPLibBuild,
     'clean': IPEXClean,
@@ -0,0 +1,418 @@
+#include <torch/torch.h>
+#include "bench_utils.h"
+
+#include "csrc/cpu/aten/AddLayerNorm.h"
+#include "csrc/cpu/aten/AddSoftmax.h"
+#include "csrc/cpu/aten/Converter.h"
+#include "csrc/cpu/aten/Cumsum.h"
+#include "csrc/cpu/aten/DivSoftmax.h"
+#include "csrc/cpu/aten/EmbeddingBag.h"
+#include "csrc/cpu/aten/Interaction.h"
+#include "csrc/cpu/aten/MergedEmbeddingBag.h"
+#include "csrc/cpu/aten/Nms.h"
+#include "csrc/cpu/aten/ROIAlign.h"
+#include "csrc/cpu/aten/optimizer/optimizer.h"
+
+// Per-kernel, per-ISA microbenchmarks. Every benchmark calls the
+// DECLARE_DISPATCH stub directly so that the measured time excludes the
+// Python/dispatcher overhead. Bytes and FLOPs are rough lower bounds computed
+// from the tensors touched by one call.
+
+using namespace torch_ipex::cpu;
+
+namespace {
+
+double nbytes(const at::Tensor& t) {
+  return static_cast<double>(t.numel() * t.element_size());
+}
+
+} // namespace
+
+// ---------------------------- Embedding bag ----------------------------
+
+template <at::ScalarType dtype>
+static void bench_embedding_bag(bench::BenchState& state) {
+  const int64_t num_rows = 1000000, dim = 128, batch = 2048, pooling = 32;
+  auto weight = at::rand({num_rows, dim}).to(dtype);
+  auto indices = at::randint(num_rows, {batch * pooling}, at::kLong);
+  auto offsets = at::arange(0, batch * pooling, pooling, at::kLong);
+  if (!state.force_isa(embedding_bag_kernel_stub))
+    return;
+  state.set_bytes_processed(
+      batch * pooling * dim * weight.element_size() + nbytes(indices) +
+      nbytes(offsets) + batch * dim * weight.element_size());
+  state.set_flops(batch * pooling * dim);
+  state.run([&] {
+    embedding_bag_kernel_stub(kCPU, weight, indices, offsets, false);
+  });
+}
+
+IPEX_KERNEL_BENCHMARK(embedding_bag_f32) {
+  bench_embedding_bag<at::kFloat>(state);
+}
+
+IPEX_KERNEL_BENCHMARK(embedding_bag_bf16) {
+  bench_embedding_bag<at::kBFloat16>(state);
+}
+
+IPEX_KERNEL_BENCHMARK(merged_embeddingbag_forward_f32) {
+  const int64_t n_tables = 26, num_rows = 100000, dim = 128, batch = 2048,
+                pooling = 1;
+  std::vector<at::Tensor> weights;
+  for (int64_t t = 0; t < n_tables; t++) {
+    weights.push_back(at::rand({num_rows, dim}));
+  }
+  auto indices = at::randint(num_rows, {n_tables * batch * pooling}, at::kLong);
+  auto offsets =
+      at::arange(0, n_tables * batch * pooling + 1, pooling, at::kLong);
+  std::vector<int64_t> pooling_modes(n_tables, /*SUM*/ 0);
+  if (!state.force_isa(merged_embeddingbag_forward_cpu_kernel_stub))
+    return;
+  state.set_bytes_processed(
+      2.0 * n_tables * batch * pooling * dim * sizeof(float) +
+      nbytes(indices) + nbytes(offsets));
+  state.set_flops(n_tables * batch * pooling * dim);
+  state.run([&] {
+    merged_embeddingbag_forward_cpu_kernel_stub(
+        kCPU, indices, offsets, weights, pooling_modes);
+  });
+}
+
+// ----------------------------- Interaction -----------------------------
+
+template <at::ScalarType dtype>
+static void bench_interaction(bench::BenchState& state) {
+  const int64_t batch = 2048, n_features = 27, dim = 128;
+  std::vector<at::Tensor> inputs;
+  for (int64_t i = 0; i < n_features; i++) {
+    inputs.push_back(at::rand({batch, dim}).to(dtype));
+  }
+  if (!state.force_isa(interaction_forward_kernel_stub))
+    return;
+  const double elem = inputs[0].element_size();
+  const double n_pairs = n_features * (n_features - 1) / 2;
+  state.set_bytes_processed(
+      batch * n_features * dim * elem + batch * (dim + n_pairs) * elem);
+  state.set_flops(2.0 * batch * n_pairs * dim);
+  state.run([&] { interaction_forward_kernel_stub(kCPU, inputs); });
+}
+
+IPEX_KERNEL_BENCHMARK(interaction_forward_f32) {
+  bench_interaction<at::kFloat>(state);
+}
+
+IPEX_KERNEL_BENCHMARK(interaction_forward_bf16) {
+  bench_interaction<at::kBFloat16>(state);
+}
+
+// ------------------------------- Softmax -------------------------------
+
+template <at::ScalarType dtype>
+static void bench_div_add_softmax(bench::BenchState& state) {
+  const int64_t batch = 64, heads = 16, seq = 384;
+  auto a = at::rand({batch, heads, seq, seq}).to(dtype);
+  auto b = at::rand({batch, 1, 1, seq}).to(dtype);
+  const float dim_per_head = 8.0f;
+  if (!state.force_isa(div_add_softmax_kernel_stub))
+    return;
+  state.set_bytes_processed(2 * nbytes(a) + nbytes(b));
+  state.set_flops(5.0 * a.numel());
+  state.run([&] { div_add_softmax_kernel_stub(kCPU, a, b, dim_per_head); });
+}
+
+IPEX_KERNEL_BENCHMARK(div_add_softmax_f32) {
+  bench_div_add_softmax<at::kFloat>(state);
+}
+
+IPEX_KERNEL_BENCHMARK(div_add_softmax_bf16) {
+  bench_div_add_softmax<at::kBFloat16>(state);
+}
+
+IPEX_KERNEL_BENCHMARK(add_softmax_inplace_f32) {
+  const int64_t batch = 64, heads = 16, seq = 384;
+  auto a = at::rand({batch, heads, seq, seq});
+  auto b = at::zeros({batch, 1, 1, seq});
+  if (!state.force_isa(add_softmax_inplace_kernel_stub))
+    return;
+  state.set_bytes_processed(2 * nbytes(a) + nbytes(b));
+  state.set_flops(4.0 * a.numel());
+  state.run([&] { add_softmax_inplace_kernel_stub(kCPU, a, b); });
+}
+
+IPEX_KERNEL_BENCHMARK(div_maskedfill_softmax_f32) {
+  const int64_t batch = 64, heads = 16, seq = 384;
+  auto a = at::rand({batch, heads, seq, seq});
+  auto mask = at::randint(2, {batch, seq}).to(at::kFloat);
+  std::vector<int64_t> mask_shape({batch, 1, 1, seq});
+  const float fill = -1e9f, dim_per_head = 8.0f;
+  if (!state.force_isa(div_maskedfill_softmax_kernel_stub))
+    return;
+  state.set_bytes_processed(2 * nbytes(a) + nbytes(mask));
+  state.set_flops(5.0 * a.numel());
+  state.run([&] {
+    div_maskedfill_softmax_kernel_stub(
+        kCPU, a, mask, mask_shape, fill, dim_per_head);
+  });
+}
+
+// ------------------------------ LayerNorm ------------------------------
+
+template <at::ScalarType dtype>
+static void bench_add_layer_norm(bench::BenchState& state) {
+  const int64_t tokens = 64 * 384, hidden = 1024;
+  auto a = at::rand({tokens, hidden}).to(dtype);
+  auto b = at::rand({tokens, hidden}).to(dtype);
+  c10::optional<at::Tensor> weight = at::rand({hidden});
+  c10::optional<at::Tensor> bias = at::rand({hidden});
+  std::vector<int64_t> normalized_shape({hidden});
+  if (!state.force_isa(add_layer_norm_kernel_stub))
+    return;
+  state.set_bytes_processed(3 * nbytes(a));
+  state.set_flops(8.0 * a.numel());
+  state.run([&] {
+    add_layer_norm_kernel_stub(
+        kCPU, a, b, 1, normalized_shape, weight, bias, 1e-5f);
+  });
+}
+
+IPEX_KERNEL_BENCHMARK(add_layer_norm_f32) {
+  bench_add_layer_norm<at::kFloat>(state);
+}
+
+IPEX_KERNEL_BENCHMARK(add_layer_norm_bf16) {
+  bench_add_layer_norm<at::kBFloat16>(state);
+}
+
+// --------------------------------- NMS ---------------------------------
+
+IPEX_KERNEL_BENCHMARK(nms_sorted_f32) {
+  const int64_t n_boxes = 15000;
+  auto xy = at::rand({n_boxes, 2}) * 1000;
+  auto wh = at::rand({n_boxes, 2}) * 100 + 1;
+  auto dets = at::cat({xy, xy + wh}, 1).contiguous();
+  auto scores = std::get<0>(at::rand({n_boxes}).sort(0, true));
+  if (!state.force_isa(nms_cpu_kernel_stub))
+    return;
+  state.set_bytes_processed(nbytes(dets) + nbytes(scores));
+  state.run([&] { nms_cpu_kernel_stub(kCPU, dets, scores, 0.5f, true); });
+}
+
+// ------------------------------- ROIAlign ------------------------------
+
+template <bool channels_last>
+static void bench_roi_align(bench::BenchState& state) {
+  const int64_t batch = 2, channels = 256, height = 200, width = 272,
+                n_rois = 1000, pooled = 7, sampling_ratio = 2;
+  auto input = at::rand({batch, channels, height, width});
+  if (channels_last) {
+    input = input.contiguous(at::MemoryFormat::ChannelsLast);
+  }
+  auto batch_idx = at::randint(batch, {n_rois, 1}).to(at::kFloat);
+  auto xy = at::rand({n_rois, 2}) * (width / 2);
+  auto wh = at::rand({n_rois, 2}) * (width / 2) + 1;
+  auto rois = at::cat({batch_idx, xy, xy + wh}, 1).contiguous();
+  if (!state.force_isa(roi_align_forward_kernel_stub))
+    return;
+  const double out_elems = n_rois * channels * pooled * pooled;
+  state.set_bytes_processed(
+      out_elems * sampling_ratio * sampling_ratio * 4 * sizeof(float) +
+      out_elems * sizeof(float));
+  state.set_flops(out_elems * sampling_ratio * sampling_ratio * 8);
+  state.run([&] {
+    roi_align_forward_kernel_stub(
+        kCPU, input, rois, 0.25, pooled, pooled, sampling_ratio, true);
+  });
+}
+
+IPEX_KERNEL_BENCHMARK(roi_align_forward_nchw_f32) {
+  bench_roi_align<false>(state);
+}
+
+IPEX_KERNEL_BENCHMARK(roi_align_forward_nhwc_f32) {
+  bench_roi_align<true>(state);
+}
+
+// -------------------------------- Cumsum -------------------------------
+
+template <at::ScalarType dtype>
+static void bench_cumsum_lastdim(bench::BenchState& state) {
+  auto self = at::rand({64, 1 << 18}).to(dtype);
+  auto result = at::empty_like(self);
+  if (!state.force_isa(cumsum_kernel_stub))
+    return;
+  state.set_bytes_processed(2 * nbytes(self));
+  state.set_flops(self.numel());
+  state.run([&] { cumsum_kernel_stub(kCPU, result, self, 1, c10::nullopt); });
+}
+
+IPEX_KERNEL_BENCHMARK(cumsum_lastdim_f32) {
+  bench_cumsum_lastdim<at::kFloat>(state);
+}
+
+IPEX_KERNEL_BENCHMARK(cumsum_lastdim_i64) {
+  bench_cumsum_lastdim<at::kLong>(state);
+}
+
+// One long row, e.g. lengths to offsets of a jagged batch: scanned by the
+// two-pass block scan.
+template <at::ScalarType dtype>
+static void bench_cumsum_1d(bench::BenchState& state) {
+  auto self = at::randint(0, 64, {100000000}).to(dtype);
+  auto result = at::empty_like(self);
+  if (!state.force_isa(cumsum_kernel_stub))
+    return;
+  state.set_bytes_processed(2 * nbytes(self));
+  state.set_flops(self.numel());
+  state.run([&] { cumsum_kernel_stub(kCPU, result, self, 0, c10::nullopt); });
+}
+
+IPEX_KERNEL_BENCHMARK(cumsum_1d_i64) {
+  bench_cumsum_1d<at::kLong>(state);
+}
+
+IPEX_KERNEL_BENCHMARK(cumsum_1d_f32) {
+  bench_cumsum_1d<at::kFloat>(state);
+}
+
+IPEX_KERNEL_BENCHMARK(cumsum_dim0_bf16) {
+  auto self = at::rand({1 << 16, 1024}).to(at::kBFloat16);
+  auto result = at::empty_like(self);
+  if (!state.force_isa(cumsum_kernel_stub))
+    return;
+  state.set_bytes_processed(2 * nbytes(self));
+  state.set_flops(self.numel());
+  state.run([&] { cumsum_kernel_stub(kCPU, result, self, 0, c10::nullopt); });
+}
+
+// ------------------------------ Optimizers -----------------------------
+
+namespace {
+
+constexpr int64_t kOptimNumel = 1 << 24;
+
+// fp32 params carry an empty bf16 trail, as the python frontend does.
+at::Tensor empty_trail() {
+  return at::empty({0}, at::kBFloat16);
+}
+
+} // namespace
+
+IPEX_KERNEL_BENCHMARK(sgd_fused_step_f32) {
+  auto param = at::rand({kOptimNumel});
+  auto grad = at::rand({kOptimNumel});
+  c10::optional<at::Tensor> momentum_buf = at::zeros({kOptimNumel});
+  auto param2 = empty_trail();
+  if (!state.force_isa(sgd_fused_step_kernel_stub))
+    return;
+  state.set_bytes_processed(5.0 * kOptimNumel * sizeof(float));
+  state.set_flops(5.0 * kOptimNumel);
+  state.run([&] {
+    sgd_fused_step_kernel_stub(
+        kCPU, param, grad, momentum_buf, param2, 0.9, 1e-3, 1e-4, 0.0, false);
+  });
+}
+
+IPEX_KERNEL_BENCHMARK(adam_fused_step_f32) {
+  auto param = at::rand({kOptimNumel});
+  auto exp_avg = at::zeros({kOptimNumel});
+  auto exp_avg_sq = at::zeros({kOptimNumel});
+  auto max_exp_avg_sq = at::zeros({0});
+  auto grad = at::rand({kOptimNumel});
+  auto param2 = empty_trail();
+  if (!state.force_isa(adam_fused_step_kernel_stub))
+    return;
+  state.set_bytes_processed(7.0 * kOptimNumel * sizeof(float));
+  state.set_flops(14.0 * kOptimNumel);
+  state.run([&] {
+    adam_fused_step_kernel_stub(
+        kCPU,
+        param,
+        exp_avg,
+        exp_avg_sq,
+        max_exp_avg_sq,
+        grad,
+        param2,
+        false,
+        1,
+        0.9,
+        0.999,
+        1e-3,
+        1e-4,
+        1e-8);
+  });
+}
+
+IPEX_KERNEL_BENCHMARK(adagrad_fused_step_f32) {
+  auto param = at::rand({kOptimNumel});
+  auto grad = at::rand({kOptimNumel});
+  auto state_sum = at::zeros({kOptimNumel});
+  auto param2 = empty_trail();
+  if (!state.force_isa(adagrad_fused_step_kernel_stub))
+    return;
+  state.set_bytes_processed(5.0 * kOptimNumel * sizeof(float));
+  state.set_flops(7.0 * kOptimNumel);
+  state.run([&] {
+    adagrad_fused_step_kernel_stub(
+        kCPU, param, grad, state_sum, param2, 1, 1e-2, 1e-4, 0.0, 1e-10);
+  });
+}
+
+IPEX_KERNEL_BENCHMARK(lamb_fused_step_f32) {
+  auto param = at::rand({kOptimNumel});
+  auto exp_avg = at::zeros({kOptimNumel});
+  auto exp_avg_sq = at::zeros({kOptimNumel});
+  auto grad = at::rand({kOptimNumel});
+  auto param2 = empty_trail();
+  if (!state.force_isa(lamb_fused_step_kernel_stub))
+    return;
+  state.set_bytes_processed(9.0 * kOptimNumel * sizeof(float));
+  state.set_flops(18.0 * kOptimNumel);
+  state.run([&] {
+    lamb_fused_step_kernel_stub(
+        kCPU,
+        param,
+        exp_avg,
+        exp_avg_sq,
+        grad,
+        param2,
+        1,
+        0.9,
+        0.999,
+        1e-3,
+        1e-4,
+        1e-6);
+  });
+}
+
+IPEX_KERNEL_BENCHMARK(packed_add_bf16) {
+  auto top_half = at::rand({kOptimNumel}).to(at::kBFloat16);
+  auto bot_half = at::zeros({kOptimNumel}, at::kBFloat16);
+  auto grad = at::rand({kOptimNumel}).to(at::kBFloat16);
+  if (!state.force_isa(packed_add_kernel_stub))
+    return;
+  state.set_bytes_processed(5.0 * kOptimNumel * sizeof(at::BFloat16));
+  state.set_flops(2.0 * kOptimNumel);
+  state.run(
+      [&] { packed_add_kernel_stub(kCPU, top_half, bot_half, grad, -1e-3); });
+}
+
+// ------------------------------ Converters -----------------------------
+
+IPEX_KERNEL_BENCHMARK(cat_bfloat16_float) {
+  auto top_half = at::rand({kOptimNumel}).to(at::kBFloat16);
+  auto bottom_half = at::rand({kOptimNumel}).to(at::kBFloat16);
+  if (!state.force_isa(cat_bfloat16_float_kernel_stub))
+    return;
+  state.set_bytes_processed(4.0 * kOptimNumel * sizeof(at::BFloat16));
+  state.run([&] {
+    cat_bfloat16_float_kernel_stub(kCPU, top_half, bottom_half);
+  });
+}
+
+IPEX_KERNEL_BENCHMARK(split_float_bfloat16) {
+  auto tensor = at::rand({kOptimNumel});
+  if (!state.force_isa(split_float_bfloat16_kernel_stub))
+    return;
+  state.set_bytes_processed(2.0 * kOptimNumel * sizeof(float));
+  state.run([&] { split_float_bfloat16_kernel_stub(kCPU, tensor); });
+}
@@ -0,0 +1,156 @@
+#include <torch/torch.h>
+#include "bench_utils.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace torch_ipex::cpu;
+using namespace torch_ipex::cpu::bench;
+
+namespace {
+
+struct BenchOptions {
+  std::string filter;
+  std::vector<CPUCapability> isas;
+  double min_time_s = 0.5;
+  int64_t warmup = 3;
+  std::string out;
+};
+
+void print_usage(const char* prog) {
+  std::cout
+      << "Usage: " << prog << " [options]\n"
+      << "  --filter=<substr>   only run benchmarks whose name contains substr\n"
+      << "  --isa=<a,b,...>     ISA levels to run (e.g. AVX2,AVX512,AMX),\n"
+      << "                      default: every level supported by host+binary\n"
+      << "  --min_time=<sec>    minimal measured time per benchmark (0.5)\n"
+      << "  --warmup=<n>        warm-up iterations before timing (3)\n"
+      << "  --out=<file>        write JSON results to file, default stdout\n"
+      << "  --list              list registered benchmarks\n";
+}
+
+bool parse_isa(const std::string& s, CPUCapability& isa) {
+  for (int i = 0; i < static_cast<int>(CPUCapability::NUM_OPTIONS); i++) {
+    auto cap = static_cast<CPUCapability>(i);
+    if (s == CPUCapabilityToString(cap)) {
+      isa = cap;
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<CPUCapability> default_isas() {
+  std::vector<CPUCapability> isas;
+  // get_cpu_capability() is already capped by both host and binary support.
+  auto max_isa = static_cast<int>(get_cpu_capability());
+  for (int i = 0; i <= max_isa; i++) {
+    isas.push_back(static_cast<CPUCapability>(i));
+  }
+  return isas;
+}
+
+void write_json(std::ostream& os, const std::vector<BenchResult>& results) {
+  os << "{\n  \"context\": {\n";
+  os << "    \"num_threads\": " << at::get_num_threads() << ",\n";
+  os << "    \"max_cpu_isa\": \"" << CPUCapabilityToString(get_cpu_capability())
+     << "\"\n  },\n";
+  os << "  \"benchmarks\": [\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto& r = results[i];
+    os << "    {\"name\": \"" << r.name << "/" << r.isa << "\", "
+       << "\"kernel\": \"" << r.name << "\", "
+       << "\"isa\": \"" << r.isa << "\", "
+       << "\"iterations\": " << r.iterations << ", "
+       << "\"real_time\": " << r.ns_per_iter << ", "
+       << "\"time_unit\": \"ns\", "
+       << "\"GB/s\": " << r.gbytes_per_sec << ", "
+       << "\"GFLOP/s\": " << r.gflops_per_sec << "}"
+       << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  os << "  ]\n}\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  BenchOptions opts;
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    auto value = [&](const char* key) -> std::string {
+      return arg.substr(strlen(key));
+    };
+    if (arg.rfind("--filter=", 0) == 0) {
+      opts.filter = value("--filter=");
+    } else if (arg.rfind("--isa=", 0) == 0) {
+      std::stringstream ss(value("--isa="));
+      std::string item;
+      while (std::getline(ss, item, ',')) {
+        CPUCapability isa;
+        if (!parse_isa(item, isa)) {
+          std::cerr << "Unknown ISA level: " << item << std::endl;
+          return 1;
+        }
+        opts.isas.push_back(isa);
+      }
+    } else if (arg.rfind("--min_time=", 0) == 0) {
+      opts.min_time_s = std::stod(value("--min_time="));
+    } else if (arg.rfind("--warmup=", 0) == 0) {
+      opts.warmup = std::stoll(value("--warmup="));
+    } else if (arg.rfind("--out=", 0) == 0) {
+      opts.out = value("--out=");
+    } else if (arg == "--list") {
+      for (auto& e : registry()) {
+        std::cout << e.name << std::endl;
+      }
+      return 0;
+    } else {
+      print_usage(argv[0]);
+      return arg == "--help" ? 0 : 1;
+    }
+  }
+  if (opts.isas.empty()) {
+    opts.isas = default_isas();
+  }
+
+  std::vector<BenchResult> results;
+  for (auto& e : registry()) {
+    if (!opts.filter.empty() &&
+        std::string(e.name).find(opts.filter) == std::string::npos) {
+      continue;
+    }
+    for (auto isa : opts.isas) {
+      if (isa > get_cpu_capability()) {
+        std::cerr << "Skip " << e.name << "/" << CPUCapabilityToString(isa)
+                  << ": not supported on this machine" << std::endl;
+        continue;
+      }
+      BenchState state(isa, opts.min_time_s, opts.warmup);
+      try {
+        e.fn(state);
+      } catch (const c10::Error& err) {
+        std::cerr << "Failed " << e.name << "/" << CPUCapabilityToString(isa)
+                  << ": " << err.what_without_backtrace() << std::endl;
+        state.skip();
+      }
+      state.restore();
+      if (state.skipped()) {
+        continue;
+      }
+      auto r = state.result(e.name);
+      std::cerr << r.name << "/" << r.isa << ": " << r.ns_per_iter << " ns, "
+                << r.gbytes_per_sec << " GB/s, " << r.gflops_per_sec
+                << " GFLOP/s" << std::endl;
+      results.push_back(r);
+    }
+  }
+
+  if (opts.out.empty()) {
+    write_json(std::cout, results);
+  } else {
+    std::ofstream ofs(opts.out);
+    write_json(ofs, results);
+  }
+  return 0;
+}
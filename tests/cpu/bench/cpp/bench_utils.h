@@ -0,0 +1,168 @@
+#pragma once
+
+#include <ATen/Parallel.h>
+#include <c10/util/Exception.h>
+#include "csrc/cpu/dyndisp/DispatchStub.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+// A minimal Google-Benchmark-style harness for IPEX kernels.
+//
+// Each benchmark is registered with IPEX_KERNEL_BENCHMARK and receives a
+// BenchState. The runner calls the benchmark once per CPUCapability that is
+// supported by both the binary and the host; the benchmark is expected to
+// force that ISA on the stubs it exercises via BenchState::force_isa().
+//
+// Example:
+//   IPEX_KERNEL_BENCHMARK(cumsum_lastdim_f32) {
+//     auto x = at::rand({64, 65536});
+//     if (!state.force_isa(cumsum_kernel_stub))
+//       return;
+//     state.set_bytes_processed(2 * x.nbytes());
+//     state.run([&] { cumsum_kernel_stub(kCPU, y, x, 1, c10::nullopt); });
+//   }
+
+namespace torch_ipex {
+namespace cpu {
+namespace bench {
+
+struct BenchResult {
+  std::string name;
+  std::string isa;
+  int64_t iterations = 0;
+  double ns_per_iter = 0;
+  double gbytes_per_sec = 0;
+  double gflops_per_sec = 0;
+};
+
+class BenchState {
+ public:
+  BenchState(CPUCapability isa, double min_time_s, int64_t warmup)
+      : isa_(isa), min_time_s_(min_time_s), warmup_(warmup) {}
+
+  CPUCapability isa() const {
+    return isa_;
+  }
+
+  // Force the stub onto the ISA variant under test. Returns false (and marks
+  // the run as skipped) if the binary carries no kernel for this ISA.
+  template <typename Stub>
+  bool force_isa(Stub& stub) {
+    auto fn = stub.get_cpu_isa_ptr(isa_);
+    if (!fn) {
+      skipped_ = true;
+      return false;
+    }
+    stub.set_cpu_dispatch_ptr(fn);
+    forced_.emplace_back([&stub]() { stub.set_cpu_dispatch_ptr(nullptr); });
+    return true;
+  }
+
+  // Bytes read plus bytes written by one iteration.
+  void set_bytes_processed(double bytes) {
+    bytes_ = bytes;
+  }
+
+  // Floating point operations performed by one iteration.
+  void set_flops(double flops) {
+    flops_ = flops;
+  }
+
+  void skip() {
+    skipped_ = true;
+  }
+
+  bool skipped() const {
+    return skipped_;
+  }
+
+  void run(const std::function<void()>& fn) {
+    for (int64_t i = 0; i < warmup_; i++) {
+      fn();
+    }
+    using clock = std::chrono::steady_clock;
+    int64_t iters = 1;
+    double elapsed_ns = 0;
+    while (true) {
+      auto start = clock::now();
+      for (int64_t i = 0; i < iters; i++) {
+        fn();
+      }
+      elapsed_ns = std::chrono::duration<double, std::nano>(clock::now() - start)
+                       .count();
+      if (elapsed_ns >= min_time_s_ * 1e9 || iters >= (int64_t(1) << 30)) {
+        break;
+      }
+      // Grow the iteration count towards the target time, as GB does.
+      double scale = elapsed_ns > 0 ? (min_time_s_ * 1e9 * 1.4) / elapsed_ns
+                                    : 10.0;
+      iters = std::max(iters + 1, (int64_t)(iters * std::min(scale, 10.0)));
+    }
+    iterations_ = iters;
+    ns_per_iter_ = elapsed_ns / iters;
+  }
+
+  void restore() {
+    for (auto& f : forced_) {
+      f();
+    }
+    forced_.clear();
+  }
+
+  BenchResult result(const std::string& name) const {
+    BenchResult r;
+    r.name = name;
+    r.isa = CPUCapabilityToString(isa_);
+    r.iterations = iterations_;
+    r.ns_per_iter = ns_per_iter_;
+    // bytes / ns == GB / s
+    r.gbytes_per_sec = ns_per_iter_ > 0 ? bytes_ / ns_per_iter_ : 0;
+    r.gflops_per_sec = ns_per_iter_ > 0 ? flops_ / ns_per_iter_ : 0;
+    return r;
+  }
+
+ private:
+  CPUCapability isa_;
+  double min_time_s_;
+  int64_t warmup_;
+  bool skipped_ = false;
+  double bytes_ = 0;
+  double flops_ = 0;
+  int64_t iterations_ = 0;
+  double ns_per_iter_ = 0;
+  std::vector<std::function<void()>> forced_;
+};
+
+using BenchFn = void (*)(BenchState&);
+
+struct BenchEntry {
+  const char* name;
+  BenchFn fn;
+};
+
+inline std::vector<BenchEntry>& registry() {
+  static std::vector<BenchEntry> entries;
+  return entries;
+}
+
+struct BenchRegisterer {
+  BenchRegisterer(const char* name, BenchFn fn) {
+    registry().push_back({name, fn});
+  }
+};
+
+} // namespace bench
+} // namespace cpu
+} // namespace torch_ipex
+
+#define IPEX_KERNEL_BENCHMARK(name)                                          \
+  static void ipex_bench_##name(torch_ipex::cpu::bench::BenchState& state); \
+  static torch_ipex::cpu::bench::BenchRegisterer ipex_bench_reg_##name(      \
+      #name, ipex_bench_##name);                                             \
+  static void ipex_bench_##name(torch_ipex::cpu::bench::BenchState& state)
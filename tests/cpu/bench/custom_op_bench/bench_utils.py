@@ -0,0 +1,42 @@
+import argparse
+import time
+import torch
+
+def make_parser(description, num_iters, bf16=True, no_ipex=False):
+    # options shared by the op benchmarks, the scripts add their own ones
+    parser = argparse.ArgumentParser(description=description)
+    parser.add_argument("--num-iters", type=int, default=num_iters)
+    if bf16:
+        parser.add_argument("--bf16", action="store_true", default=False)
+    if no_ipex:
+        # run once with and once without IPEX to compare with the ATen kernels
+        parser.add_argument("--no-ipex", action="store_true", default=False)
+    return parser
+
+def import_ipex(args):
+    if not getattr(args, "no_ipex", False):
+        import intel_extension_for_pytorch  # noqa: F401
+
+def autocast(dtype):
+    return torch.cpu.amp.autocast(enabled=dtype == torch.bfloat16)
+
+def measure(fn, num_iters):
+    # average latency of fn() in ms, after num_iters / 10 warm-up runs
+    for _ in range(max(num_iters // 10, 1)):
+        fn()
+    start = time.time()
+    for _ in range(num_iters):
+        fn()
+    end = time.time()
+    return (end - start) / num_iters * 1000
+
+def trace(module, x, dtype):
+    # ipex.optimize, trace and freeze a channels last module
+    import intel_extension_for_pytorch as ipex
+    module = ipex.optimize(module.eval().to(memory_format=torch.channels_last), dtype=dtype)
+    with torch.no_grad(), autocast(dtype):
+        module = torch.jit.freeze(torch.jit.trace(module, x))
+        # the profiling executor fuses on the second run
+        module(x)
+        module(x)
+    return module
@@ -0,0 +1,57 @@
+import torch
+import torch.nn as nn
+from bench_utils import autocast, make_parser, measure, trace
+
+# (in channels, input size, out channels, conv kernel, conv stride, conv
+# padding, pool kernel, pool stride, pool padding) of the ResNet stem and of
+# the last convolution of the VGG-16 blocks
+LAYERS = [
+    (3, 224, 64, 7, 2, 3, 3, 2, 1),
+    (64, 224, 64, 3, 1, 1, 2, 2, 0),
+    (128, 112, 128, 3, 1, 1, 2, 2, 0),
+    (256, 56, 256, 3, 1, 1, 2, 2, 0),
+    (512, 28, 512, 3, 1, 1, 2, 2, 0),
+]
+
+POOLS = {
+    "max": nn.MaxPool2d,
+    "avg": nn.AvgPool2d,
+}
+
+class ConvPool(nn.Module):
+    def __init__(self, in_channels, out_channels, kernel_size, stride, padding, pool):
+        super(ConvPool, self).__init__()
+        self.conv = nn.Sequential(
+            nn.Conv2d(in_channels, out_channels, kernel_size, stride, padding, bias=False),
+            nn.BatchNorm2d(out_channels),
+            nn.ReLU())
+        self.pool = pool
+
+    def forward(self, x):
+        return self.pool(self.conv(x))
+
+def run():
+    parser = make_parser("benchmark for the tiled convolution + pooling", num_iters=100)
+    parser.add_argument("--batch-size", type=int, default=1)
+    parser.add_argument("--pool", choices=POOLS.keys(), default="max")
+    args = parser.parse_args()
+    dtype = torch.bfloat16 if args.bf16 else torch.float32
+
+    for in_channels, size, out_channels, kernel, stride, padding, pool_kernel, pool_stride, pool_padding in LAYERS:
+        layer = ConvPool(in_channels, out_channels, kernel, stride, padding,
+                         POOLS[args.pool](pool_kernel, pool_stride, pool_padding))
+        x = torch.randn(args.batch_size, in_channels, size, size).to(memory_format=torch.channels_last)
+        # the pooling is fused when it is in the graph of the convolution,
+        # tracing them separately keeps the convolution output in memory
+        fused = trace(layer, x, dtype)
+        conv = trace(layer.conv, x, dtype)
+        with torch.no_grad(), autocast(dtype):
+            pool = torch.jit.freeze(torch.jit.trace(layer.pool, conv(x)))
+            fused_ms = measure(lambda: fused(x), args.num_iters)
+            unfused_ms = measure(lambda: pool(conv(x)), args.num_iters)
+        print("C={} H=W={} K={} conv {}x{}/{} pool {}x{}/{}: fused {:.3f} ms, unfused {:.3f} ms, speedup {:.2f}x".format(
+            in_channels, size, out_channels, kernel, kernel, stride, pool_kernel, pool_kernel, pool_stride,
+            fused_ms, unfused_ms, unfused_ms / fused_ms))
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,39 @@
+import torch
+import intel_extension_for_pytorch as ipex
+from bench_utils import make_parser, measure
+
+# (shape, dim): long rows scanned by the two-pass block scan, e.g. the
+# lengths to offsets of a jagged batch, and scans along a non-last dim
+SHAPES = [
+    ((1 << 20,), 0),
+    ((10000000,), 0),
+    ((100000000,), 0),
+    ((4, 1 << 24), 1),
+    ((1 << 16, 1024), 0),
+    ((64, 4096, 64), 1),
+]
+
+DTYPES = {
+    "int64": torch.int64,
+    "int32": torch.int32,
+    "fp32": torch.float32,
+    "bf16": torch.bfloat16,
+}
+
+def run():
+    parser = make_parser("benchmark for the parallel cumsum", num_iters=20, bf16=False)
+    parser.add_argument("--dtype", choices=DTYPES.keys(), default="int64")
+    args = parser.parse_args()
+    dtype = DTYPES[args.dtype]
+
+    for shape, dim in SHAPES:
+        x = torch.randint(0, 64, shape).to(dtype)
+        # dtype keeps the integer inputs from being upcast to int64
+        ipex_ms = measure(lambda: torch.ops.torch_ipex.cumsum(x, dim, dtype=dtype), args.num_iters)
+        torch_ms = measure(lambda: torch.cumsum(x, dim, dtype=dtype), args.num_iters)
+        gbps = 2 * x.numel() * x.element_size() / ipex_ms / 1e6
+        print("shape {} dim {} {}: ipex {:.3f} ms ({:.1f} GB/s), torch {:.3f} ms, speedup {:.2f}x".format(
+            list(shape), dim, args.dtype, ipex_ms, gbps, torch_ms, torch_ms / ipex_ms))
+
+if __name__ == "__main__":
+    run()
@@ -0,0 +1,36 @@
+import torch
+from bench_utils import import_ipex, make_parser, measure
+
+def run():
+    parser = make_parser(
+        "benchmark for the gather/index/scatter_add ops of graph neural networks", num_iters=10, no_ipex=True)
+    parser.add_argument("--num-nodes", type=int, default=1000000)
+    parser.add_argument("--num-edges", type=int, default=10000000)
+    parser.add_argument("--feature-size", type=int, default=64)
+    args = parser.parse_args()
+    import_ipex(args)
+    dtype = torch.bfloat16 if args.bf16 else torch.float32
+
+    x = torch.randn(args.num_nodes, args.feature_size).to(dtype)
+    # power-law degrees: a few nodes are the destination of many edges
+    src = torch.randint(0, args.num_nodes, (args.num_edges,))
+    dst = (torch.rand(args.num_edges) ** 3 * args.num_nodes).long()
+    messages = torch.randn(args.num_edges, args.feature_size).to(dtype)
+    x_3d = x.view(1000, -1, args.feature_size)
+    i0 = src % 1000
+    i1 = src % x_3d.size(1)
+
+    cases = [
+        ("index_select", lambda: x.index_select(0, src)),
+        ("gather rows", lambda: x.gather(0, src.view(-1, 1).expand(-1, args.feature_size))),
+        ("gather last dim", lambda: x.gather(1, torch.randint(0, args.feature_size, (args.num_nodes, 8)))),
+        ("index 2 tensors", lambda: x_3d[i0, i1]),
+        ("index_add", lambda: torch.zeros_like(x).index_add_(0, dst, messages)),
+        ("scatter_add rows", lambda: torch.zeros_like(x).scatter_add_(0, dst.view(-1, 1).expand(-1, args.feature_size), messages)),
+    ]
+    for name, fn in cases:
+        ms = measure(fn, args.num_iters)
+        print("{} ({}): {:.3f} ms".format(name, "aten" if args.no_ipex else "ipex", ms))
+
+if __name__ == "__main__":
+    run()
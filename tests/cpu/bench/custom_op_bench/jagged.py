@@ -0,0 +1,65 @@
+import torch
+import intel_extension_for_pytorch as ipex
+from bench_utils import make_parser, measure
+
+# the generic ATen compositions the input pipelines use for the same ops
+def torch_lengths_to_offsets(lengths):
+    return torch.cat([lengths.new_zeros(1), torch.cumsum(lengths, 0)])
+
+def torch_jagged_to_padded_dense(values, lengths, max_length):
+    segments = torch.split(values, lengths.tolist())
+    dense = torch.nn.utils.rnn.pad_sequence(segments, batch_first=True)
+    return dense[:, :max_length]
+
+def torch_dense_to_jagged(dense, lengths):
+    mask = torch.arange(dense.size(1)).unsqueeze(0) < lengths.unsqueeze(1)
+    return dense[mask]
+
+def torch_jagged_index_select(values, lengths, indices):
+    segments = torch.split(values, lengths.tolist())
+    return torch.cat([segments[i] for i in indices.tolist()]), lengths[indices]
+
+def torch_segment_sum(values, lengths):
+    segment_ids = torch.repeat_interleave(torch.arange(lengths.numel()), lengths)
+    output = values.new_zeros(lengths.numel(), values.size(1))
+    return output.index_add_(0, segment_ids, values)
+
+def run():
+    parser = make_parser("benchmark for the jagged tensor ops", num_iters=20)
+    parser.add_argument("--batch-size", type=int, default=16384)
+    parser.add_argument("--max-length", type=int, default=64)
+    parser.add_argument("--dim", type=int, default=128)
+    args = parser.parse_args()
+    dtype = torch.bfloat16 if args.bf16 else torch.float32
+
+    lengths = torch.randint(0, args.max_length + 1, (args.batch_size,))
+    offsets = torch.ops.torch_ipex.lengths_to_offsets(lengths)
+    values = torch.randn(int(lengths.sum()), args.dim).to(dtype)
+    dense = torch.ops.torch_ipex.jagged_to_padded_dense(values, offsets, args.max_length)
+    indices = torch.randint(0, args.batch_size, (args.batch_size // 2,))
+
+    cases = [
+        ("lengths_to_offsets",
+         lambda: torch.ops.torch_ipex.lengths_to_offsets(lengths),
+         lambda: torch_lengths_to_offsets(lengths)),
+        ("jagged_to_padded_dense",
+         lambda: torch.ops.torch_ipex.jagged_to_padded_dense(values, offsets, args.max_length),
+         lambda: torch_jagged_to_padded_dense(values, lengths, args.max_length)),
+        ("dense_to_jagged",
+         lambda: torch.ops.torch_ipex.dense_to_jagged(dense, offsets),
+         lambda: torch_dense_to_jagged(dense, lengths)),
+        ("jagged_index_select",
+         lambda: torch.ops.torch_ipex.jagged_index_select(values, lengths, indices),
+         lambda: torch_jagged_index_select(values, lengths, indices)),
+        ("segment_sum",
+         lambda: torch.ops.torch_ipex.segment_sum(values, offsets),
+         lambda: torch_segment_sum(values, lengths)),
+    ]
+    for name, ipex_fn, torch_fn in cases:
+        ipex_ms = measure(ipex_fn, args.num_iters)
+        torch_ms = measure(torch_fn, args.num_iters)
+        print("{}: ipex {:.3f} ms, torch {:.3f} ms, speedup {:.2f}x".format(
+            name, ipex_ms, torch_ms, torch_ms / ipex_ms))
+
+if __name__ == "__main__":
+    run()
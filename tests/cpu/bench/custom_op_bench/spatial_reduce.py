@@ -0,0 +1,36 @@
+import torch
+from bench_utils import import_ipex, make_parser, measure
+
+# (N, C, H, W) channels last activations reduced over H and W, e.g. the
+# global average pooling of a CNN or the statistics of a norm layer
+SHAPES = [
+    (1, 2048, 7, 7),
+    (1, 256, 56, 56),
+    (32, 2048, 7, 7),
+    (32, 256, 56, 56),
+    (1, 64, 224, 224),
+]
+
+def run():
+    parser = make_parser(
+        "benchmark for the reductions over the spatial dims of channels last tensors", num_iters=100, no_ipex=True)
+    args = parser.parse_args()
+    import_ipex(args)
+    dtype = torch.bfloat16 if args.bf16 else torch.float32
+
+    for shape in SHAPES:
+        x = torch.randn(shape).to(dtype).to(memory_format=torch.channels_last)
+        cases = [
+            ("sum", lambda: torch.sum(x, dim=(2, 3))),
+            ("mean", lambda: torch.mean(x, dim=(2, 3))),
+            ("var_mean", lambda: torch.var_mean(x, dim=(2, 3))),
+            ("std_mean", lambda: torch.std_mean(x, dim=(2, 3))),
+        ]
+        for name, fn in cases:
+            ms = measure(fn, args.num_iters)
+            gbps = x.numel() * x.element_size() / ms / 1e6
+            print("{} {} ({}): {:.3f} ms ({:.1f} GB/s)".format(
+                name, list(shape), "aten" if args.no_ipex else "ipex", ms, gbps))
+
+if __name__ == "__main__":
+    run()
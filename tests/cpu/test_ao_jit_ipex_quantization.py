@@ -454,7 +454,7 @@ class TestDynamicQuantization(JitLlgaTestCase):
         x = torch.randn(3, 3)
         for qconfig in dynamic_qconfig:
             graph = self.checkQuantizeTrace(m, [x], atol=2e-1, qconfig=qconfig)
-            FileCheck().check_not("aten:linear").check("quantized::linear_dynamic").run(graph)
+            FileCheck().check_not("aten:linear").check("ipex_prepack::dynamic_quant_linear_run").run(graph)
     
     def test_linear_dynamic_bf16(self):
         class M(nn.Module):
@@ -469,7 +469,7 @@ class TestDynamicQuantization(JitLlgaTestCase):
         x = torch.randn(3, 3)
         m = M().eval()
         graph, _, _ = self.prepareModel(m, [x], qconfig=dynamic_qconfig[0], int8_bf16=True)
-        FileCheck().check_not("aten:linear").check("quantized::linear_dynamic").run(graph)
+        FileCheck().check_not("aten:linear").check("ipex_prepack::dynamic_quant_linear_run").run(graph)
        
     def test_lstm_dynamic(self):
         class M(nn.Module):
@@ -1631,6 +1631,29 @@ class TestFusionPattern(JitLlgaTestCase):
         self.assertFused(graph, ['aten::linear', 'aten::add'])
         self.checkPatterns(graph, patterns)
 
+    def test_add_layernorm_quantize(self):
+        class M(nn.Module):
+            def __init__(self, hidden_size, reuse_layernorm):
+                super(M, self).__init__()
+                self.LayerNorm = nn.LayerNorm(hidden_size)
+                self.linear = nn.Linear(hidden_size, hidden_size)
+                self.reuse_layernorm = reuse_layernorm
+
+            def forward(self, x, y):
+                x1 = self.LayerNorm(x + y)
+                x2 = self.linear(x1)
+                if self.reuse_layernorm:
+                    x2 = x2 + x1
+                return x2
+
+        for reuse_layernorm in [False, True]:
+            m = M(768, reuse_layernorm).eval()
+            x = torch.rand(2, 128, 768)
+            y = torch.rand(2, 128, 768)
+            graph = self.checkQuantizeTrace(m, [x, y], atol=2e-1)
+            self.assertGraphContainsExactly(graph, 'ipex::add_layernorm_quantize', 1)
+            self.assertFused(graph, ['aten::layer_norm', 'aten::quantize_per_tensor'])
+
 class TestShapeFallback(JitLlgaTestCase):
     @unittest.skipIf(True, 'Size peephole optimization not enabled yet')
     def test_view_permute(self):
@@ -0,0 +1,123 @@
+import copy
+import unittest
+import torch
+import torch.nn as nn
+import intel_extension_for_pytorch as ipex
+from intel_extension_for_pytorch.nn.utils._model_convert import _BatchNormReLU2d
+from torch.testing._internal.common_utils import TestCase
+
+
+class BasicBlock(nn.Module):
+    def __init__(self, channels):
+        super(BasicBlock, self).__init__()
+        self.conv1 = nn.Conv2d(channels, channels, 3, padding=1, bias=False)
+        self.bn1 = nn.BatchNorm2d(channels)
+        self.relu = nn.ReLU(inplace=True)
+        self.conv2 = nn.Conv2d(channels, channels, 3, padding=1, bias=False)
+        self.bn2 = nn.BatchNorm2d(channels)
+
+    def forward(self, x):
+        identity = x
+        out = self.relu(self.bn1(self.conv1(x)))
+        out = self.bn2(self.conv2(out))
+        out += identity
+        return self.relu(out)
+
+
+class TestBatchNormReLU(TestCase):
+    def _check(self, bn, x, other, prec):
+        ref_bn = copy.deepcopy(bn)
+        x1 = x.clone().requires_grad_()
+        x2 = x.clone().requires_grad_()
+        if other is None:
+            y = torch.ops.torch_ipex.batch_norm_relu(
+                x1, bn.weight, bn.bias, bn.running_mean, bn.running_var,
+                True, bn.momentum, bn.eps)
+            ref = torch.relu(ref_bn(x2))
+        else:
+            o1 = other.clone().requires_grad_()
+            o2 = other.clone().requires_grad_()
+            y = torch.ops.torch_ipex.batch_norm_add_relu(
+                x1, o1, bn.weight, bn.bias, bn.running_mean, bn.running_var,
+                True, bn.momentum, bn.eps)
+            ref = torch.relu(ref_bn(x2) + o2)
+        self.assertEqual(y, ref, prec=prec)
+        self.assertTrue(y.is_contiguous(memory_format=torch.channels_last)
+                        if x.dim() == 4 else y.is_contiguous(memory_format=torch.channels_last_3d))
+        grad = torch.randn_like(ref)
+        y.backward(grad)
+        ref.backward(grad)
+        self.assertEqual(x1.grad, x2.grad, prec=prec)
+        self.assertEqual(bn.weight.grad, ref_bn.weight.grad, prec=prec)
+        self.assertEqual(bn.bias.grad, ref_bn.bias.grad, prec=prec)
+        if other is not None:
+            self.assertEqual(o1.grad, o2.grad, prec=prec)
+        self.assertEqual(bn.running_mean, ref_bn.running_mean, prec=1e-4)
+        self.assertEqual(bn.running_var, ref_bn.running_var, prec=1e-4)
+
+    def test_batch_norm_relu(self):
+        for dtype, prec in [(torch.float, 1e-4), (torch.bfloat16, 5e-2)]:
+            # C = 35 covers the vector tails and a partial mask byte
+            for C, shape, memory_format in [
+                    (35, (4, 35, 7, 9), torch.channels_last),
+                    (64, (2, 64, 8, 8), torch.channels_last),
+                    (16, (2, 16, 4, 5, 6), torch.channels_last_3d)]:
+                for with_add in [False, True]:
+                    bn = nn.BatchNorm2d(C) if len(shape) == 4 else nn.BatchNorm3d(C)
+                    with torch.no_grad():
+                        bn.weight.uniform_(0.5, 1.5)
+                        bn.bias.uniform_(-0.5, 0.5)
+                    x = torch.randn(shape).to(dtype=dtype, memory_format=memory_format)
+                    other = torch.randn(shape).to(dtype=dtype, memory_format=memory_format) \
+                        if with_add else None
+                    self._check(bn, x, other, prec)
+
+    def test_fallback(self):
+        # contiguous inputs and eval mode run the unfused ops
+        bn = nn.BatchNorm2d(8)
+        x = torch.randn(2, 8, 5, 5)
+        self._check(bn, x, None, 1e-4)
+        bn.eval()
+        y = torch.ops.torch_ipex.batch_norm_relu(
+            x, bn.weight, bn.bias, bn.running_mean, bn.running_var, False, 0.1, bn.eps)
+        self.assertEqual(y, torch.relu(bn(x)), prec=1e-5)
+
+    def test_optimize_swap(self):
+        model = BasicBlock(16).to(memory_format=torch.channels_last).train()
+        ref_model = copy.deepcopy(model)
+        optimizer = torch.optim.SGD(model.parameters(), lr=0.1)
+        ref_optimizer = torch.optim.SGD(ref_model.parameters(), lr=0.1)
+        ipex_model, ipex_optimizer = ipex.optimize(
+            model, optimizer=optimizer, fuse_bn_relu=True, weights_prepack=False)
+        fused = [m for m in ipex_model.modules() if isinstance(m, _BatchNormReLU2d)]
+        self.assertEqual(len(fused), 2)
+        self.assertEqual(
+            set(ipex_model.state_dict().keys()), set(ref_model.state_dict().keys()))
+        for _ in range(2):
+            x = torch.randn(4, 16, 8, 8).to(memory_format=torch.channels_last)
+            y = ipex_model(x)
+            ref = ref_model(x)
+            self.assertEqual(y, ref, prec=1e-4)
+            y.sum().backward()
+            ref.sum().backward()
+            ipex_optimizer.step()
+            ref_optimizer.step()
+            ipex_optimizer.zero_grad()
+            ref_optimizer.zero_grad()
+        ref_state = ref_model.state_dict()
+        for name, value in ipex_model.state_dict().items():
+            self.assertEqual(value, ref_state[name], prec=1e-4)
+
+    def test_optimize_disabled(self):
+        # the swap is opt-in, the default level keeps the model class
+        for kwargs in [{}, {"fuse_bn_relu": False}]:
+            model = BasicBlock(16).train()
+            optimizer = torch.optim.SGD(model.parameters(), lr=0.1)
+            ipex_model, _ = ipex.optimize(
+                model, optimizer=optimizer, weights_prepack=False, **kwargs)
+            self.assertTrue(isinstance(ipex_model, BasicBlock))
+            self.assertFalse(any(isinstance(m, _BatchNormReLU2d) for m in ipex_model.modules()))
+
+
+if __name__ == '__main__':
+    test = unittest.main()
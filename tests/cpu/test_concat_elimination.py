@@ -0,0 +1,106 @@
+import unittest
+import torch
+import torch.nn as nn
+import intel_extension_for_pytorch as ipex
+import intel_extension_for_pytorch._C as core
+from torch.testing._internal.common_utils import TestCase
+
+
+class ConvConcat(nn.Module):
+    def __init__(self):
+        super(ConvConcat, self).__init__()
+        self.conv1 = nn.Conv2d(16, 16, 3, padding=1)
+        self.conv2 = nn.Conv2d(16, 32, 1)
+        self.conv3 = nn.Conv2d(64, 16, 1)
+
+    def forward(self, x):
+        y = torch.cat([torch.relu(self.conv1(x)), self.conv2(x), x], dim=1)
+        return self.conv3(y)
+
+
+class DenseSparseConcat(nn.Module):
+    def __init__(self):
+        super(DenseSparseConcat, self).__init__()
+        self.bottom = nn.Linear(13, 16)
+        self.emb1 = nn.EmbeddingBag(100, 16, mode='sum')
+        self.emb2 = nn.EmbeddingBag(100, 16, mode='sum')
+        self.top = nn.Linear(48, 8)
+
+    def forward(self, dense, indices, offsets):
+        y = torch.cat(
+            [torch.relu(self.bottom(dense)),
+             self.emb1(indices, offsets),
+             self.emb2(indices, offsets)], dim=1)
+        return self.top(y)
+
+
+class TestConcatElimination(TestCase):
+    def setUp(self):
+        self.default_enabled = core._jit_concat_elimination_enabled()
+        core._jit_set_concat_elimination_enabled(True)
+
+    def tearDown(self):
+        core._jit_set_concat_elimination_enabled(self.default_enabled)
+
+    def _trace(self, model, inputs):
+        model = ipex.optimize(model.eval(), dtype=torch.float32)
+        with torch.no_grad():
+            traced = torch.jit.freeze(torch.jit.trace(model, inputs))
+            # the first two runs profile and optimize the graph
+            traced(*inputs)
+            traced(*inputs)
+        return traced
+
+    def _kinds(self, traced, inputs):
+        return [n.kind() for n in traced.graph_for(*inputs).nodes()]
+
+    def test_conv_concat(self):
+        model = ConvConcat()
+        for memory_format in [torch.contiguous_format, torch.channels_last]:
+            # with batch size 1 a channel slice of an NCHW concat is dense and
+            # written in place, with channels last it is copied
+            x = torch.randn(1, 16, 14, 14).to(memory_format=memory_format)
+            with torch.no_grad():
+                ref = model(x)
+            traced = self._trace(model, (x,))
+            with torch.no_grad():
+                for _ in range(2):
+                    self.assertEqual(traced(x), ref, prec=1e-4)
+            kinds = self._kinds(traced, (x,))
+            self.assertTrue("ipex::concat_from_buffer" in kinds)
+            self.assertTrue("ipex_prepack::convolution_relu_run_into" in kinds)
+            self.assertTrue("ipex_prepack::convolution_run_into" in kinds)
+            self.assertFalse("aten::cat" in kinds)
+
+    def test_dense_sparse_concat(self):
+        model = DenseSparseConcat()
+        dense = torch.randn(32, 13)
+        indices = torch.randint(0, 100, (64,))
+        offsets = torch.arange(0, 64, 2)
+        with torch.no_grad():
+            ref = model(dense, indices, offsets)
+        traced = self._trace(model, (dense, indices, offsets))
+        with torch.no_grad():
+            self.assertEqual(traced(dense, indices, offsets), ref, prec=1e-4)
+        self.assertTrue(
+            "ipex::concat_from_buffer" in self._kinds(traced, (dense, indices, offsets)))
+
+    def test_shape_change_fallback(self):
+        model = ConvConcat()
+        x = torch.randn(1, 16, 14, 14)
+        traced = self._trace(model, (x,))
+        y = torch.randn(2, 16, 10, 10)
+        with torch.no_grad():
+            self.assertEqual(traced(y), model(y), prec=1e-4)
+            self.assertEqual(traced(x), model(x), prec=1e-4)
+
+    def test_disabled(self):
+        core._jit_set_concat_elimination_enabled(False)
+        model = ConvConcat()
+        x = torch.randn(1, 16, 14, 14)
+        traced = self._trace(model, (x,))
+        self.assertFalse("ipex::concat_from_buffer" in self._kinds(traced, (x,)))
+
+
+if __name__ == '__main__':
+    test = unittest.main()
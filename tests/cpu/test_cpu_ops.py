@@ -812,6 +812,39 @@ class CPUOPsTester(TestCase):
         y6 = torch.arange(0, 0.5, 0.5).to(torch.float16).add(x6.unsqueeze(-1)).sum(-1).transpose(0, 1)
         self.assertEqual(y5, y6)
 
+    def test_spatial_reductions(self):
+        # single-pass reductions over the spatial dims of channels last inputs
+        shapes = [((2, 35, 7, 9), torch.channels_last), ((1, 64, 56, 56), torch.channels_last),
+                  ((3, 5, 4, 6, 7), torch.channels_last_3d), ((1, 1, 300, 300), torch.channels_last)]
+        for shape, memory_format in shapes:
+            dims = tuple(range(2, len(shape)))
+            for dtype in [torch.float32, torch.bfloat16]:
+                x = (torch.randn(shape) * 3 + 1).to(dtype).to(memory_format=memory_format)
+                x_ref = x.double().contiguous()
+                prec = 2e-2 if dtype == torch.bfloat16 else 1e-4
+                for keepdim in [True, False]:
+                    for dim in [dims, tuple(reversed(dims)), tuple(d - len(shape) for d in dims)]:
+                        y = torch.sum(x, dim=dim, keepdim=keepdim)
+                        self.assertEqual(y.dtype, dtype)
+                        self.assertEqual(y, torch.sum(x_ref, dim=dim, keepdim=keepdim).to(dtype), prec=prec * 10)
+                        y = torch.mean(x, dim=dim, keepdim=keepdim)
+                        self.assertEqual(y, torch.mean(x_ref, dim=dim, keepdim=keepdim).to(dtype), prec=prec)
+                    for unbiased in [True, False]:
+                        var, mean = torch.var_mean(x, dim=dims, unbiased=unbiased, keepdim=keepdim)
+                        var_ref, mean_ref = torch.var_mean(x_ref, dim=dims, unbiased=unbiased, keepdim=keepdim)
+                        self.assertEqual(var, var_ref.to(dtype), prec=prec * 10)
+                        self.assertEqual(mean, mean_ref.to(dtype), prec=prec)
+                        std, mean = torch.std_mean(x, dim=dims, unbiased=unbiased, keepdim=keepdim)
+                        std_ref, mean_ref = torch.std_mean(x_ref, dim=dims, unbiased=unbiased, keepdim=keepdim)
+                        self.assertEqual(std, std_ref.to(dtype), prec=prec)
+                        self.assertEqual(mean, mean_ref.to(dtype), prec=prec)
+
+        # a single spatial element has no unbiased variance
+        x = torch.randn(2, 8, 1, 1).to(memory_format=torch.channels_last)
+        var, mean = torch.var_mean(x, dim=(2, 3))
+        self.assertTrue(torch.isnan(var).all())
+        self.assertEqual(mean, x.view(2, 8))
+
     def test_matmul(self):
         def helper(a, b, c, op):
             dtypes = [torch.float32, torch.bfloat16]
@@ -922,6 +955,93 @@ class CPUOPsTester(TestCase):
                 y1_5 = torch.index_select(x1_5, dim, indices, out=torch.empty(0))
                 self.assertTrue(y1_5.dtype == torch.float32)
 
+    # a non-contiguous copy of x, which takes the ATen kernels of the ops
+    # that have an IPEX fast path for contiguous inputs
+    def _non_contiguous(self, x):
+        return x.transpose(0, -1).contiguous().transpose(0, -1)
+
+    def test_gather(self):
+        for datatype in [torch.float32, torch.bfloat16, torch.double]:
+            x = torch.randn(100, 3, 17).to(datatype)
+            for dim in [0, 1, 2, -1]:
+                size = list(x.shape)
+                size[dim] = 40
+                index = torch.randint(0, x.size(dim), size)
+                y = x.gather(dim, index)
+                self.assertEqual(y, self._non_contiguous(x).gather(dim, index))
+
+            # whole rows, e.g. the node features of the edges of a graph
+            x = torch.randn(1000, 64).to(datatype).requires_grad_()
+            x_ref = x.detach().double().requires_grad_()
+            index = torch.randint(0, 1000, (5000, 1)).expand(-1, 64)
+            y = x.gather(0, index)
+            y_ref = x_ref[index[:, 0]]
+            self.assertEqual(y, y_ref.to(datatype))
+            # the backward is a scatter_add of the rows
+            grad = torch.randn_like(y)
+            y.backward(grad)
+            y_ref.backward(grad.double())
+            self.assertEqual(x.grad, x_ref.grad.to(datatype), atol=1e-2, rtol=1e-2)
+
+        with self.assertRaises(RuntimeError):
+            torch.randn(10, 4).gather(1, torch.tensor([[4]] * 10))
+
+    def test_index_multi(self):
+        for datatype in [torch.float32, torch.bfloat16, torch.double]:
+            x = torch.randn(20, 30, 8).to(datatype)
+            x_ref = self._non_contiguous(x)
+            i0 = torch.randint(-20, 20, (50, 4))
+            i1 = torch.randint(-30, 30, (50, 4))
+            self.assertEqual(x[i0, i1], x_ref[i0, i1])
+            self.assertEqual(x[i0], x_ref[i0])
+            self.assertEqual(x[i0, i1, i1 % 8], x_ref[i0, i1, i1 % 8])
+            self.assertEqual(x[torch.tensor(3), torch.tensor(-1)], x_ref[3, -1])
+            # slices and masks take the ATen kernel
+            self.assertEqual(x[:, i1], x_ref[:, i1])
+            self.assertEqual(x[x > 0], x_ref[x_ref > 0])
+
+        with self.assertRaises(IndexError):
+            torch.randn(20, 30)[torch.tensor([20]), torch.tensor([0])]
+
+    def test_index_add_scatter_add(self):
+        # the rows of self are summed in fp32 for bf16 and rounded once
+        tolerance = {torch.float32: 1e-4, torch.bfloat16: 1e-2, torch.double: 1e-7}
+        for datatype in [torch.float32, torch.bfloat16, torch.double]:
+            prec = tolerance[datatype]
+            # many more rows than indices take the sorted path (rows > 4 * indices)
+            for num_rows, num_index in [(50, 10000), (10000, 100)]:
+                for F in [1, 64, 1000]:
+                    x = torch.randn(num_rows, F).to(datatype)
+                    # many repeated indices, like the edges of a power-law graph
+                    index = torch.randint(0, num_rows, (num_index,)) ** 2 % num_rows
+                    source = torch.randn(num_index, F).to(datatype)
+                    y_ref = x.double().index_put_((index,), 2 * source.double(), accumulate=True)
+
+                    y = x.clone().index_add_(0, index, source, alpha=2)
+                    self.assertEqual(y, y_ref.to(datatype), atol=prec, rtol=prec)
+                    y = x.index_add(0, index.int(), source, alpha=2)
+                    self.assertEqual(y, y_ref.to(datatype), atol=prec, rtol=prec)
+                    y = self._non_contiguous(x.clone()).index_add_(0, index, source, alpha=2)
+                    self.assertEqual(y, y_ref.to(datatype), atol=prec, rtol=prec)
+
+                    y_ref = x.double().index_put_((index,), source.double(), accumulate=True)
+                    scatter_index = index.view(-1, 1).expand(-1, F)
+                    y = x.clone().scatter_add_(0, scatter_index, source)
+                    self.assertEqual(y, y_ref.to(datatype), atol=prec, rtol=prec)
+                    y = x.scatter_add(0, scatter_index, source)
+                    self.assertEqual(y, y_ref.to(datatype), atol=prec, rtol=prec)
+                    y = x.scatter_add(0, scatter_index.contiguous(), source)
+                    self.assertEqual(y, y_ref.to(datatype), atol=prec, rtol=prec)
+
+            # index_select backward is an index_add
+            x = torch.randn(30, 7).to(datatype).requires_grad_()
+            index = torch.randint(0, 30, (100,))
+            x.index_select(0, index).sum().backward()
+            self.assertEqual(x.grad, torch.bincount(index, minlength=30).to(datatype).view(-1, 1).expand(-1, 7))
+
+        with self.assertRaises(IndexError):
+            torch.zeros(10, 4).index_add_(0, torch.tensor([10]), torch.ones(1, 4))
+
     def test_cat(self):
         for datatype in [torch.float32, torch.double, torch.bfloat16]:
             for dim, size in itertools.product([0, 1], [[2, 1], [2, 2], [5, 10]]):
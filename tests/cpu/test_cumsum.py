@@ -56,5 +56,31 @@ class TestCumSum(TestCase):
         # Check that output maintained correct shape
         self.assertEqual(raw_tensor.shape, raw_tensor.grad.shape)
 
+    def test_cumsum_dims_dtypes(self):
+        # the shapes cover the scan of independent lines and the block scan
+        # of a few long lines, along the last and the other dims
+        shapes = [[17, 4097], [4097, 17], [3, 1000, 7], [1 << 20], [2, 1 << 18], [1 << 18, 3]]
+        for dtype in [torch.float, torch.bfloat16, torch.long, torch.int]:
+            for shape in shapes:
+                x = torch.randint(-8, 8, shape).to(dtype)
+                for dim in range(-len(shape), len(shape)):
+                    ref = torch.cumsum(x.to(torch.double), dim)
+                    res = torch.ops.torch_ipex.cumsum(x, dim, dtype=dtype)
+                    self.assertEqual(res.dtype, x.dtype)
+                    if dtype == torch.bfloat16:
+                        # summed in fp32 and rounded once
+                        self.assertEqual(res, ref.to(torch.float).to(dtype))
+                    else:
+                        self.assertEqual(res, ref.to(dtype))
+                    y = x.clone()
+                    torch.ops.torch_ipex.cumsum_(y, dim)
+                    self.assertEqual(y, res)
+
+    def test_cumsum_lengths_to_offsets(self):
+        lengths = torch.randint(0, 64, (3 * (1 << 20) + 5,))
+        self.assertEqual(torch.ops.torch_ipex.cumsum(lengths, 0), torch.cumsum(lengths, 0))
+        lengths = lengths.to(torch.int)
+        self.assertEqual(torch.ops.torch_ipex.cumsum(lengths, 0, dtype=torch.int), torch.cumsum(lengths, 0, dtype=torch.int))
+
 if __name__ == '__main__':
     test = unittest.main()
@@ -0,0 +1,139 @@
+import unittest
+import copy
+import io
+import torch
+import torch.nn as nn
+import intel_extension_for_pytorch as ipex
+import intel_extension_for_pytorch._C as core
+from intel_extension_for_pytorch.quantization import prepare, convert
+from intel_extension_for_pytorch.quantization._module_swap_utils import _IPEXDynamicQuantLinear
+from torch.ao.quantization import MinMaxObserver, PlaceholderObserver, QConfig
+from torch.testing._internal.common_utils import TestCase
+
+
+class MLP(nn.Module):
+    def __init__(self, bias=True, act=None):
+        super(MLP, self).__init__()
+        self.fc1 = nn.Linear(250, 100, bias=bias)
+        self.fc2 = nn.Linear(100, 37, bias=bias)
+        self.act = act if act is not None else nn.ReLU()
+
+    def forward(self, x):
+        return self.fc2(self.act(self.fc1(x)))
+
+
+def _fake_quant_activation(x, per_token):
+    # asymmetric u8 over [min(x, 0), max(x, 0)], like the kernel
+    x_min = (x.amin(-1, keepdim=True) if per_token else x.min()).clamp(max=0)
+    x_max = (x.amax(-1, keepdim=True) if per_token else x.max()).clamp(min=0)
+    scale = (x_max - x_min) / 255
+    scale = torch.where(scale == 0, torch.ones_like(scale), scale)
+    zp = torch.round(-x_min / scale).clamp(0, 255)
+    return (torch.round(x / scale) + zp).clamp(0, 255).sub(zp).mul(scale)
+
+
+class TestDynamicQuantLinear(TestCase):
+    def _convert(self, model, qconfig, x):
+        prepared = prepare(copy.deepcopy(model), qconfig, example_inputs=x)
+        return convert(prepared)
+
+    def test_linear(self):
+        for per_token in [False, True]:
+            for per_channel in [False, True]:
+                for bias in [True, False]:
+                    linear = nn.Linear(250, 37, bias=bias)
+                    m = _IPEXDynamicQuantLinear(linear, per_channel, per_token)
+                    # dequantized weight, so only the activation quantization
+                    # and the GEMM are checked
+                    w = m.state_dict()['weight']
+                    # cover the row and column tails, K % 4 != 0 and 3-D input
+                    for x in [torch.randn(1, 250), torch.randn(7, 250), torch.randn(67, 250),
+                              torch.randn(2, 5, 250) * torch.arange(1, 6).view(1, 5, 1)]:
+                        with torch.no_grad():
+                            y = m(x)
+                            ref = nn.functional.linear(
+                                _fake_quant_activation(x, per_token), w, linear.bias)
+                            self.assertEqual(y, ref, prec=1e-2)
+                            self.assertEqual(y, linear(x), prec=0.1)
+
+    def test_per_token_accuracy(self):
+        linear = nn.Linear(64, 64)
+        # rows with very different ranges lose precision with one scale
+        x = torch.randn(8, 64) * torch.logspace(-2, 2, 8).unsqueeze(1)
+        with torch.no_grad():
+            ref = linear(x)
+            err_tensor = (_IPEXDynamicQuantLinear(linear, True, False)(x) - ref).abs()[:4].max()
+            err_token = (_IPEXDynamicQuantLinear(linear, True, True)(x) - ref).abs()[:4].max()
+        self.assertTrue(err_token < err_tensor)
+
+    def test_bf16_activation(self):
+        linear = nn.Linear(250, 37)
+        m = _IPEXDynamicQuantLinear(linear, True, False)
+        x = torch.randn(4, 250)
+        with torch.no_grad():
+            y = m(x.bfloat16())
+            self.assertEqual(y.dtype, torch.bfloat16)
+            self.assertEqual(y.float(), m(x), prec=0.1)
+
+    def test_convert(self):
+        x = torch.randn(4, 250)
+        for qconfig in [ipex.quantization.default_dynamic_qconfig,
+                        ipex.quantization.per_token_dynamic_qconfig]:
+            converted = self._convert(MLP().eval(), qconfig, x)
+            self.assertTrue(isinstance(converted.fc1, _IPEXDynamicQuantLinear))
+            self.assertEqual(converted.fc1.per_token,
+                             qconfig is ipex.quantization.per_token_dynamic_qconfig)
+        # qint8 activations keep the stock dynamic quantized linear
+        qconfig = QConfig(
+            activation=PlaceholderObserver.with_args(dtype=torch.float, compute_dtype=torch.qint8),
+            weight=MinMaxObserver.with_args(dtype=torch.qint8, qscheme=torch.per_tensor_symmetric))
+        converted = self._convert(MLP().eval(), qconfig, x)
+        self.assertTrue(isinstance(converted.fc1, torch.nn.quantized.dynamic.Linear))
+
+    def test_jit(self):
+        x = torch.randn(3, 250)
+        for act, post_op in [(nn.ReLU(), "relu"), (nn.GELU(), "gelu"), (nn.Tanh(), "none")]:
+            model = MLP(act=act).eval()
+            converted = self._convert(model, ipex.quantization.default_dynamic_qconfig, x)
+            with torch.no_grad():
+                ref = converted(x)
+                traced = torch.jit.freeze(torch.jit.trace(converted, x))
+                traced(x)
+                traced(x)
+                graph = traced.graph_for(x)
+                self.assertEqual(traced(x), ref, prec=1e-4)
+            run_nodes = [n for n in graph.nodes() if n.kind() == "ipex_prepack::dynamic_quant_linear_run"]
+            self.assertEqual(len(run_nodes), 2)
+            self.assertEqual(run_nodes[0].inputsAt(1).toIValue(), post_op)
+
+            # the op context is saved as its FP32 weight and repacked on load
+            buffer = io.BytesIO()
+            torch.jit.save(traced, buffer)
+            buffer.seek(0)
+            loaded = torch.jit.load(buffer)
+            with torch.no_grad():
+                self.assertEqual(loaded(x), ref, prec=1e-4)
+
+    def test_jit_rewrite_aten_linear(self):
+        default_config = core._jit_dynamic_quant_linear_config()
+        core._jit_set_dynamic_quant_linear_config("per_token")
+        try:
+            model = MLP().eval()
+            x = torch.randn(3, 250)
+            with torch.no_grad():
+                ref = model(x)
+                traced = torch.jit.freeze(torch.jit.trace(model, x))
+                traced(x)
+                traced(x)
+                graph = traced.graph_for(x)
+                self.assertEqual(traced(x), ref, prec=0.1)
+            kinds = [n.kind() for n in graph.nodes()]
+            self.assertEqual(kinds.count("ipex_prepack::dynamic_quant_linear_run"), 2)
+            self.assertFalse("aten::linear" in kinds)
+            self.assertFalse("aten::relu" in kinds)
+        finally:
+            core._jit_set_dynamic_quant_linear_config(*default_config)
+
+
+if __name__ == '__main__':
+    test = unittest.main()
@@ -2,6 +2,7 @@ import unittest
 import os
 import subprocess
 
+import torch
 import intel_extension_for_pytorch._C as core
 
 supported_isa_set = ["default", "avx2", "avx2_vnni", "avx512", "avx512_vnni", "avx512_bf16", "amx"]
@@ -90,5 +91,48 @@ class TestDynDisp(unittest.TestCase):
           cur_ipex_isa_1 = str(out[-1], 'utf-8').strip()
           self.assertTrue(cur_ipex_isa == cur_ipex_isa_1)
 
+    def test_dispatch_stub_profiling(self):
+        x = torch.randn(4, 1024)
+        core._reset_dispatch_stub_stats()
+        core._set_dispatch_stub_profiling(True)
+        try:
+            for _ in range(3):
+                torch.ops.torch_ipex.cumsum(x, 1)
+        finally:
+            core._set_dispatch_stub_profiling(False)
+        stats = {s['name']: s for s in core._get_dispatch_stub_stats()}
+        self.assertTrue('cumsum_kernel_stub' in stats)
+        self.assertEqual(stats['cumsum_kernel_stub']['calls'], 3)
+        self.assertTrue(stats['cumsum_kernel_stub']['total_ns'] > 0)
+        self.assertEqual(stats['cumsum_kernel_stub']['isa'].lower(), get_currnet_isa_level())
+
+        # no more counting once disabled
+        torch.ops.torch_ipex.cumsum(x, 1)
+        stats = {s['name']: s for s in core._get_dispatch_stub_stats()}
+        self.assertEqual(stats['cumsum_kernel_stub']['calls'], 3)
+
+    def test_dispatch_stub_isa_override(self):
+        x = torch.randn(4, 1024)
+        ref = torch.ops.torch_ipex.cumsum(x, 1)
+        core._set_dispatch_stub_isa('cumsum_kernel_stub', 'default')
+        try:
+            out = torch.ops.torch_ipex.cumsum(x, 1)
+            stats = {s['name']: s for s in core._get_dispatch_stub_stats()}
+            self.assertEqual(stats['cumsum_kernel_stub']['isa'], 'DEFAULT')
+            self.assertEqual(out, ref)
+        finally:
+            core._clear_dispatch_stub_isa('cumsum_kernel_stub')
+        torch.ops.torch_ipex.cumsum(x, 1)
+        stats = {s['name']: s for s in core._get_dispatch_stub_stats()}
+        self.assertEqual(stats['cumsum_kernel_stub']['isa'].lower(), get_currnet_isa_level())
+
+    def test_dispatch_stub_isa_override_env(self):
+        command = 'IPEX_STUB_ISA=cumsum_kernel_stub:default python -c "import torch; import intel_extension_for_pytorch._C as core; ' \
+            'torch.ops.torch_ipex.cumsum(torch.randn(4, 8), 1); ' \
+            'print([s[\'isa\'] for s in core._get_dispatch_stub_stats() if s[\'name\'] == \'cumsum_kernel_stub\'][0])"'
+        with subprocess.Popen(command, shell=True, stdout=subprocess.PIPE, stderr=subprocess.STDOUT) as p:
+            out = p.stdout.readlines()
+            self.assertEqual(str(out[-1], 'utf-8').strip(), 'DEFAULT')
+
 if __name__ == '__main__':
     unittest.main()
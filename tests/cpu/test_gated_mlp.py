@@ -0,0 +1,121 @@
+import unittest
+import io
+import torch
+import torch.nn as nn
+import torch.nn.functional as F
+import intel_extension_for_pytorch as ipex
+import intel_extension_for_pytorch._C as core
+from torch.testing._internal.common_utils import TestCase
+
+
+class GatedMLP(nn.Module):
+    # FFN of LLaMA (SwiGLU) or T5 v1.1 (GeGLU), the hidden size is not a
+    # multiple of the interleaving block
+    def __init__(self, act, bias=False, in_features=96, hidden_features=200, gate_first=True):
+        super(GatedMLP, self).__init__()
+        self.gate_proj = nn.Linear(in_features, hidden_features, bias=bias)
+        self.up_proj = nn.Linear(in_features, hidden_features, bias=bias)
+        self.down_proj = nn.Linear(hidden_features, in_features, bias=bias)
+        self.act = act
+        self.gate_first = gate_first
+
+    def forward(self, x):
+        if self.gate_first:
+            h = self.act(self.gate_proj(x)) * self.up_proj(x)
+        else:
+            h = self.up_proj(x) * self.act(self.gate_proj(x))
+        return self.down_proj(h)
+
+
+class TestGatedMLP(TestCase):
+    def _trace(self, model, x, dtype=torch.float32):
+        model = ipex.optimize(model.eval(), dtype=dtype)
+        with torch.no_grad(), torch.cpu.amp.autocast(enabled=dtype == torch.bfloat16):
+            traced = torch.jit.freeze(torch.jit.trace(model, x))
+            # the first two runs profile and optimize the graph
+            traced(x)
+            traced(x)
+        return traced
+
+    def _gated_mlp_nodes(self, traced, x):
+        with torch.no_grad():
+            graph = traced.graph_for(x)
+        return [n for n in graph.nodes() if n.kind() == "ipex_prepack::gated_mlp_run"]
+
+    def test_jit(self):
+        acts = [nn.SiLU(), nn.GELU(), nn.GELU(approximate="tanh")]
+        for act in acts:
+            for bias in [True, False]:
+                for gate_first in [True, False]:
+                    model = GatedMLP(act, bias, gate_first=gate_first).eval()
+                    # 3-D input, and rows split into several GEMMs
+                    for x in [torch.randn(2, 7, 96), torch.randn(1500, 96)]:
+                        with torch.no_grad():
+                            ref = model(x)
+                        traced = self._trace(model, x)
+                        self.assertEqual(len(self._gated_mlp_nodes(traced, x)), 1)
+                        with torch.no_grad():
+                            self.assertEqual(traced(x), ref, prec=1e-4)
+
+    @unittest.skipIf(not core.onednn_has_bf16_support(), "BF16 is not supported")
+    def test_bf16(self):
+        model = GatedMLP(nn.SiLU(), bias=True).eval()
+        x = torch.randn(5, 96)
+        with torch.no_grad():
+            ref = model(x)
+        traced = self._trace(model, x.bfloat16(), torch.bfloat16)
+        self.assertEqual(len(self._gated_mlp_nodes(traced, x.bfloat16())), 1)
+        with torch.no_grad(), torch.cpu.amp.autocast():
+            y = traced(x.bfloat16())
+        self.assertEqual(y.float(), ref, prec=0.1)
+
+    def test_not_fused(self):
+        # the gate output is used twice
+        class GateReused(GatedMLP):
+            def forward(self, x):
+                gate = self.gate_proj(x)
+                return self.down_proj(F.silu(gate) * self.up_proj(x) + gate)
+
+        # the projections have different inputs
+        class DifferentInputs(GatedMLP):
+            def forward(self, x):
+                return self.down_proj(F.silu(self.gate_proj(x)) * self.up_proj(x + 1))
+
+        x = torch.randn(4, 96)
+        for model in [GateReused(nn.SiLU()), DifferentInputs(nn.SiLU()), GatedMLP(nn.ReLU())]:
+            model.eval()
+            with torch.no_grad():
+                ref = model(x)
+            traced = self._trace(model, x)
+            self.assertEqual(len(self._gated_mlp_nodes(traced, x)), 0)
+            with torch.no_grad():
+                self.assertEqual(traced(x), ref, prec=1e-4)
+
+    def test_disabled(self):
+        default_enabled = core._jit_gated_mlp_fusion_enabled()
+        core._jit_set_gated_mlp_fusion_enabled(False)
+        try:
+            model = GatedMLP(nn.SiLU()).eval()
+            x = torch.randn(4, 96)
+            traced = self._trace(model, x)
+            self.assertEqual(len(self._gated_mlp_nodes(traced, x)), 0)
+        finally:
+            core._jit_set_gated_mlp_fusion_enabled(default_enabled)
+
+    def test_save_load(self):
+        # the op context is saved as the gate and up weights and repacked on load
+        model = GatedMLP(nn.GELU(), bias=True).eval()
+        x = torch.randn(3, 96)
+        with torch.no_grad():
+            ref = model(x)
+        traced = self._trace(model, x)
+        buffer = io.BytesIO()
+        torch.jit.save(traced, buffer)
+        buffer.seek(0)
+        loaded = torch.jit.load(buffer)
+        with torch.no_grad():
+            self.assertEqual(loaded(x), ref, prec=1e-4)
+
+
+if __name__ == '__main__':
+    test = unittest.main()
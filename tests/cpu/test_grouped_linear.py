@@ -0,0 +1,92 @@
+import unittest
+import torch
+import torch.nn as nn
+import intel_extension_for_pytorch as ipex
+import intel_extension_for_pytorch._C as core
+from torch.testing._internal.common_utils import TestCase
+
+
+class MultiTower(nn.Module):
+    def __init__(self):
+        super(MultiTower, self).__init__()
+        self.user = nn.Linear(32, 64)
+        self.item = nn.Linear(16, 64)
+        self.context = nn.Linear(8, 32, bias=False)
+        self.out = nn.Linear(160, 1)
+
+    def forward(self, user, item, context):
+        u = torch.relu(self.user(user))
+        i = torch.sigmoid(self.item(item))
+        c = self.context(context)
+        return self.out(torch.cat([u, i, c], dim=1))
+
+
+class DependentLinears(nn.Module):
+    def __init__(self):
+        super(DependentLinears, self).__init__()
+        self.linear1 = nn.Linear(32, 32)
+        self.linear2 = nn.Linear(32, 32)
+
+    def forward(self, x):
+        return self.linear2(torch.tanh(self.linear1(x)))
+
+
+class TestGroupedLinear(TestCase):
+    def setUp(self):
+        self.default_enabled = core._jit_grouped_linear_enabled()
+        core._jit_set_grouped_linear_enabled(True)
+
+    def tearDown(self):
+        core._jit_set_grouped_linear_enabled(self.default_enabled)
+
+    def _trace(self, model, inputs):
+        model = ipex.optimize(model.eval(), dtype=torch.float32)
+        with torch.no_grad():
+            traced = torch.jit.freeze(torch.jit.trace(model, inputs))
+            # the first two runs profile and optimize the graph
+            traced(*inputs)
+            traced(*inputs)
+        return traced
+
+    def _grouped_nodes(self, graph):
+        return [n for n in graph.nodes() if n.kind() == "ipex::grouped_linear"]
+
+    def test_multi_tower(self):
+        model = MultiTower()
+        inputs = (torch.randn(4, 32), torch.randn(4, 16), torch.randn(4, 8))
+        with torch.no_grad():
+            ref = model(*inputs)
+        traced = self._trace(model, inputs)
+        with torch.no_grad():
+            graph = traced.graph_for(*inputs)
+            self.assertEqual(traced(*inputs), ref, prec=1e-4)
+        grouped = self._grouped_nodes(graph)
+        self.assertEqual(len(grouped), 1)
+        # the relu and the sigmoid are folded into the group
+        kinds = [n.kind() for n in graph.nodes()]
+        self.assertFalse("aten::relu" in kinds)
+        self.assertFalse("aten::sigmoid" in kinds)
+
+    def test_dependent_linears_not_grouped(self):
+        model = DependentLinears()
+        x = torch.randn(4, 32)
+        with torch.no_grad():
+            ref = model(x)
+        traced = self._trace(model, (x,))
+        with torch.no_grad():
+            graph = traced.graph_for(x)
+            self.assertEqual(traced(x), ref, prec=1e-4)
+        self.assertEqual(len(self._grouped_nodes(graph)), 0)
+
+    def test_disabled(self):
+        core._jit_set_grouped_linear_enabled(False)
+        model = MultiTower()
+        inputs = (torch.randn(4, 32), torch.randn(4, 16), torch.randn(4, 8))
+        traced = self._trace(model, inputs)
+        with torch.no_grad():
+            graph = traced.graph_for(*inputs)
+        self.assertEqual(len(self._grouped_nodes(graph)), 0)
+
+
+if __name__ == '__main__':
+    test = unittest.main()
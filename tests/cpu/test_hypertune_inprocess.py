@@ -0,0 +1,172 @@
+import csv
+import os
+import tempfile
+import unittest
+import torch
+import torch.nn as nn
+from intel_extension_for_pytorch.cpu.hypertune.inprocess import (
+    InProcessTuner,
+    InProcessStrategy,
+    TrialResult,
+    INPROCESS_STRATEGIES,
+    inprocess_strategy_registry,
+)
+from torch.testing._internal.common_utils import TestCase
+
+# scripted latency in ms of each omp_num_threads, 2 threads is the best one
+LATENCY = {1: 3.0, 2: 1.0, 3: 2.0}
+SEARCH_SPACE = {'omp_num_threads': [1, 2, 3]}
+
+
+class FakeLatencyTuner(InProcessTuner):
+    # Runs the model once per trial but reports the scripted latencies, so
+    # that the best configuration does not depend on the machine.
+    def _measure(self, cfg, runner, iters):
+        with torch.no_grad():
+            runner()
+        latencies = []
+        for i in range(iters):
+            latencies.append(LATENCY[cfg['omp_num_threads']])
+            if self._should_stop(latencies) and i + 1 < iters:
+                return TrialResult(cfg, latencies, self.batch_size, True)
+        return TrialResult(cfg, latencies, self.batch_size)
+
+
+class TestTrialResult(TestCase):
+    def test_statistics(self):
+        latencies = [float(v) for v in range(1, 101)]
+        result = TrialResult({'omp_num_threads': 1}, latencies, batch_size=2)
+        self.assertEqual(result.iters, 100)
+        self.assertAlmostEqual(result.mean, 50.5)
+        self.assertAlmostEqual(result.p50, 50.5)
+        self.assertAlmostEqual(result.p90, 90.1)
+        self.assertAlmostEqual(result.p99, 99.01)
+        self.assertAlmostEqual(result.throughput, 2 * 1000.0 / 50.5)
+        self.assertFalse(result.early_stopped)
+
+    def test_score(self):
+        fast = TrialResult(None, [1.0] * 10, batch_size=4)
+        slow = TrialResult(None, [2.0] * 10, batch_size=4)
+        for objective in ['mean', 'p50', 'p90', 'p99']:
+            self.assertEqual(fast.score(objective), getattr(fast, objective))
+            self.assertLess(fast.score(objective), slow.score(objective))
+        # throughput is maximized, so the faster trial still scores lower
+        self.assertAlmostEqual(fast.throughput, 4000.0)
+        self.assertEqual(fast.score('throughput'), -fast.throughput)
+        self.assertLess(fast.score('throughput'), slow.score('throughput'))
+
+    def test_infeasible(self):
+        result = TrialResult(None, [])
+        self.assertEqual(result.iters, 0)
+        self.assertEqual(result.p50, float('inf'))
+        self.assertEqual(result.throughput, 0.0)
+        feasible = TrialResult(None, [100.0])
+        for objective in ['mean', 'p50', 'p90', 'p99', 'throughput']:
+            self.assertLess(feasible.score(objective), result.score(objective))
+
+
+class TestInProcessTuner(TestCase):
+    def _model(self):
+        return nn.Linear(4, 4).eval(), (torch.randn(2, 4),)
+
+    def _tuner(self, tuner_cls=FakeLatencyTuner, **kwargs):
+        model, inputs = self._model()
+        kwargs.setdefault('search_space', SEARCH_SPACE)
+        kwargs.setdefault('warmup', 1)
+        kwargs.setdefault('min_iters', 4)
+        kwargs.setdefault('max_iters', 12)
+        return tuner_cls(model, inputs, **kwargs)
+
+    def test_should_stop(self):
+        tuner = self._tuner(objective='p50', early_stop_ratio=1.5)
+        # nothing to compare with yet
+        self.assertFalse(tuner._should_stop([10.0] * 4))
+        tuner.best_result = TrialResult(None, [1.0] * 12)
+        self.assertTrue(tuner._should_stop([10.0] * 4))
+        self.assertFalse(tuner._should_stop([1.2] * 4))
+        # only checked every min_iters iterations
+        self.assertFalse(tuner._should_stop([10.0] * 3))
+        self.assertFalse(tuner._should_stop([10.0] * 5))
+        self.assertTrue(tuner._should_stop([10.0] * 8))
+
+        tuner.early_stop_ratio = None
+        self.assertFalse(tuner._should_stop([10.0] * 4))
+
+    def test_should_stop_objective(self):
+        # the best trial has a low median but a high tail latency
+        best = TrialResult(None, [1.0] * 90 + [10.0] * 10)
+        running = [2.0] * 4
+
+        tuner = self._tuner(objective='p50', early_stop_ratio=1.5)
+        tuner.best_result = best
+        self.assertTrue(tuner._should_stop(running))
+
+        tuner = self._tuner(objective='p99', early_stop_ratio=1.5)
+        tuner.best_result = best
+        self.assertFalse(tuner._should_stop(running))
+        self.assertTrue(tuner._should_stop([20.0] * 4))
+
+        tuner = self._tuner(objective='throughput', early_stop_ratio=1.5)
+        tuner.best_result = TrialResult(None, [1.0] * 12)
+        self.assertTrue(tuner._should_stop([2.0] * 4))
+        self.assertFalse(tuner._should_stop([1.2] * 4))
+
+    def test_strategies(self):
+        for strategy in ['grid', 'random', 'successive_halving', 'bayesian']:
+            for objective in ['p50', 'p99', 'mean', 'throughput']:
+                with tempfile.TemporaryDirectory() as output_dir:
+                    tuner = self._tuner(strategy=strategy, objective=objective, output_dir=output_dir, seed=0)
+                    best_cfg, best_result = tuner.tune()
+                    self.assertEqual(best_cfg['omp_num_threads'], 2)
+                    self.assertEqual(best_result.p50, LATENCY[2])
+                    with open(os.path.join(output_dir, "inprocess_record.csv"), newline='') as f:
+                        rows = list(csv.reader(f))
+                    self.assertEqual(rows[0][0], 'omp_num_threads')
+                    self.assertEqual(len(rows) - 1, len(tuner.results))
+
+    def test_grid_early_stop(self):
+        tuner = self._tuner(strategy='grid', objective='p50', early_stop_ratio=1.5)
+        tuner.tune()
+        # 1 thread runs first with nothing to compare with, 3 threads is cut
+        # off after min_iters as 2.0ms > 1.5 * 1.0ms
+        self.assertEqual([r.cfg['omp_num_threads'] for r in tuner.results], [1, 2, 3])
+        self.assertEqual([r.iters for r in tuner.results], [12, 12, 4])
+        self.assertEqual([r.early_stopped for r in tuner.results], [False, False, True])
+
+    def test_tune_twice(self):
+        with tempfile.TemporaryDirectory() as output_dir:
+            tuner = self._tuner(strategy='grid', output_dir=output_dir)
+            for _ in range(2):
+                best_cfg, _ = tuner.tune()
+                self.assertEqual(best_cfg['omp_num_threads'], 2)
+                self.assertEqual(len(tuner.results), 3)
+                with open(os.path.join(output_dir, "inprocess_record.csv"), newline='') as f:
+                    self.assertEqual(len(list(csv.reader(f))), 4)
+
+    def test_measure(self):
+        # real measurement, the thread number is restored afterwards
+        num_threads = torch.get_num_threads()
+        tuner = self._tuner(InProcessTuner, search_space={'omp_num_threads': [1, 2]}, strategy='grid',
+                            objective='mean', early_stop_ratio=None)
+        best_cfg, best_result = tuner.tune()
+        self.assertIn(best_cfg['omp_num_threads'], [1, 2])
+        self.assertEqual(best_result.iters, 12)
+        self.assertFalse(best_result.early_stopped)
+        self.assertEqual(torch.get_num_threads(), num_threads)
+
+    def test_strategy_registry(self):
+        self.assertEqual(set(INPROCESS_STRATEGIES), {'grid', 'random', 'successive_halving', 'bayesian'})
+        with self.assertRaises(AssertionError):
+            @inprocess_strategy_registry
+            class Grid(InProcessStrategy):
+                pass
+        with self.assertRaises(ValueError):
+            @inprocess_strategy_registry
+            class GridInProcessStrategy(InProcessStrategy):
+                pass
+        with self.assertRaises(AssertionError):
+            self._tuner(strategy='hyperband')
+
+
+if __name__ == '__main__':
+    test = unittest.main()
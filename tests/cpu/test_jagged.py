@@ -0,0 +1,132 @@
+import unittest
+import torch
+import intel_extension_for_pytorch as ipex
+from torch.testing._internal.common_utils import TestCase
+
+
+def _offsets(lengths):
+    return torch.cat([lengths.new_zeros(1), torch.cumsum(lengths, 0, dtype=lengths.dtype)])
+
+
+def _segments(values, offsets):
+    return [values[offsets[b]:offsets[b + 1]] for b in range(offsets.numel() - 1)]
+
+
+def _padded_dense(values, offsets, max_length, padding_value):
+    dense = values.new_full((offsets.numel() - 1, max_length) + values.shape[1:], padding_value)
+    for b, segment in enumerate(_segments(values, offsets)):
+        length = min(segment.size(0), max_length)
+        dense[b, :length] = segment[:length]
+    return dense
+
+
+class TestJaggedOps(TestCase):
+    # lengths with empty segments and segments longer than max_length
+    def _lengths(self, batch_size, dtype=torch.long):
+        lengths = torch.randint(0, 12, (batch_size,))
+        lengths[::5] = 0
+        return lengths.to(dtype)
+
+    def test_lengths_to_offsets(self):
+        for dtype in [torch.int, torch.long]:
+            for batch_size in [0, 1, 100, 3 * (1 << 20) + 1]:
+                lengths = self._lengths(batch_size, dtype)
+                offsets = torch.ops.torch_ipex.lengths_to_offsets(lengths)
+                self.assertEqual(offsets.dtype, dtype)
+                self.assertEqual(offsets, _offsets(lengths))
+
+    def test_jagged_to_padded_dense(self):
+        for dtype in [torch.float, torch.bfloat16, torch.long]:
+            for offsets_dtype in [torch.int, torch.long]:
+                for D in [None, 1, 3, 64]:
+                    lengths = self._lengths(37)
+                    offsets = _offsets(lengths).to(offsets_dtype)
+                    shape = (int(lengths.sum()),) if D is None else (int(lengths.sum()), D)
+                    values = torch.randint(-100, 100, shape).to(dtype)
+                    for max_length in [0, 5, 16]:
+                        dense = torch.ops.torch_ipex.jagged_to_padded_dense(values, offsets, max_length, -1.0)
+                        self.assertEqual(dense, _padded_dense(values, offsets, max_length, -1))
+                        jagged = torch.ops.torch_ipex.dense_to_jagged(dense, offsets)
+                        ref = values.clone()
+                        for segment in _segments(ref, offsets):
+                            segment[max_length:] = 0
+                        self.assertEqual(jagged, ref)
+
+    def test_jagged_dense_backward(self):
+        lengths = self._lengths(19)
+        offsets = _offsets(lengths)
+        values = torch.randn(int(lengths.sum()), 8, requires_grad=True)
+        values_ref = values.detach().clone().requires_grad_()
+        dense = torch.ops.torch_ipex.jagged_to_padded_dense(values, offsets, 6, 0.0)
+        dense_ref = _padded_dense(values_ref, offsets, 6, 0.0)
+        grad = torch.randn_like(dense)
+        dense.backward(grad)
+        dense_ref.backward(grad)
+        self.assertEqual(values.grad, values_ref.grad)
+
+        dense = torch.randn(19, 6, 8, requires_grad=True)
+        dense_ref = dense.detach().clone().requires_grad_()
+        jagged = torch.ops.torch_ipex.dense_to_jagged(dense, offsets)
+        jagged_ref = torch.cat([dense_ref[b, :min(int(lengths[b]), 6)] for b in range(19)])
+        grad = torch.randn_like(jagged)
+        jagged.backward(grad)
+        mask = torch.cat([torch.arange(int(lengths[b])) < 6 for b in range(19)])
+        jagged_ref.backward(grad[mask])
+        self.assertEqual(dense.grad, dense_ref.grad)
+
+    def test_jagged_index_select(self):
+        for dtype in [torch.float, torch.bfloat16, torch.long]:
+            for D in [None, 5]:
+                lengths = self._lengths(50)
+                offsets = _offsets(lengths)
+                shape = (int(lengths.sum()),) if D is None else (int(lengths.sum()), D)
+                values = torch.randint(-100, 100, shape).to(dtype)
+                # repeated indices, e.g. one feature shared by several samples
+                indices = torch.randint(0, 50, (80,))
+                output, output_lengths = torch.ops.torch_ipex.jagged_index_select(values, lengths, indices)
+                segments = _segments(values, offsets)
+                self.assertEqual(output_lengths, lengths[indices])
+                self.assertEqual(output, torch.cat([segments[i] for i in indices]))
+
+    def test_jagged_index_select_backward(self):
+        for dtype in [torch.float, torch.bfloat16]:
+            for D in [None, 16]:
+                lengths = self._lengths(50)
+                offsets = _offsets(lengths)
+                shape = (int(lengths.sum()),) if D is None else (int(lengths.sum()), D)
+                values = torch.randn(shape).to(dtype).requires_grad_()
+                values_ref = values.detach().float().requires_grad_()
+                indices = torch.randint(0, 50, (80,))
+                output, _ = torch.ops.torch_ipex.jagged_index_select(values, lengths, indices)
+                output_ref = torch.cat([_segments(values_ref, offsets)[i] for i in indices])
+                grad = torch.randn_like(output_ref)
+                output.backward(grad.to(dtype))
+                output_ref.backward(grad.to(dtype).float())
+                self.assertEqual(values.grad, values_ref.grad.to(dtype))
+
+    def test_segment_sum(self):
+        for dtype in [torch.float, torch.double, torch.bfloat16]:
+            for D in [None, 1, 7, 64]:
+                lengths = self._lengths(41)
+                offsets = _offsets(lengths)
+                shape = (int(lengths.sum()),) if D is None else (int(lengths.sum()), D)
+                values = torch.randn(shape).to(dtype).requires_grad_()
+                values_ref = values.detach().double().requires_grad_()
+                output = torch.ops.torch_ipex.segment_sum(values, offsets)
+                output_ref = torch.stack([s.sum(0) for s in _segments(values_ref, offsets)])
+                self.assertEqual(output, output_ref.to(dtype))
+                grad = torch.randn_like(output)
+                output.backward(grad)
+                output_ref.backward(grad.double())
+                self.assertEqual(values.grad, values_ref.grad.to(dtype))
+
+    def test_invalid_offsets(self):
+        values = torch.randn(10, 4)
+        with self.assertRaisesRegex(RuntimeError, "non-decreasing"):
+            torch.ops.torch_ipex.segment_sum(values, torch.tensor([0, 5, 3, 10]))
+        with self.assertRaisesRegex(RuntimeError, "exceed"):
+            torch.ops.torch_ipex.jagged_to_padded_dense(values, torch.tensor([0, 5, 11]), 4)
+
+
+if __name__ == '__main__':
+    test = unittest.main()
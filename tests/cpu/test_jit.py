@@ -1028,6 +1028,28 @@ class AddLayerNorm_v2(torch.nn.Module):
         z = torch.add(x,y)
         return torch.nn.functional.layer_norm(z, [self.dim,], weight=w)
 
+class GroupNormSiLU(torch.nn.Module):
+    def __init__(self, channels, groups=32, inplace=False):
+        super(GroupNormSiLU, self).__init__()
+        self.norm = torch.nn.GroupNorm(groups, channels)
+        self.silu = torch.nn.SiLU(inplace=inplace)
+    def forward(self, x):
+        return self.silu(self.norm(x))
+
+class GroupNormSiLUAdd(torch.nn.Module):
+    def __init__(self, channels, groups=32):
+        super(GroupNormSiLUAdd, self).__init__()
+        self.norm = torch.nn.GroupNorm(groups, channels)
+    def forward(self, x, y):
+        return y + torch.nn.functional.silu(self.norm(x))
+
+class GroupNormSiLUAddScalar(torch.nn.Module):
+    def __init__(self, channels, groups=32):
+        super(GroupNormSiLUAddScalar, self).__init__()
+        self.norm = torch.nn.GroupNorm(groups, channels)
+    def forward(self, x):
+        return torch.nn.functional.silu(self.norm(x)) + 1
+
 class ConcatBnRelu(torch.nn.Module):
     def __init__(self, dim, cat_dim, in_channels, **kwargs):
         super(ConcatBnRelu, self).__init__()
@@ -1120,6 +1142,27 @@ class Bottleneck_v2(nn.Module):
         y3 += x
         return y3.relu_()
 
+class DepthwisePointwise(nn.Module):
+    def __init__(self, in_channels, out_channels, stride, dw_act, pw_act, bias=True):
+        super(DepthwisePointwise, self).__init__()
+        self.dw = nn.Conv2d(in_channels, in_channels, 3, stride, 1, groups=in_channels, bias=bias)
+        self.pw = nn.Conv2d(in_channels, out_channels, 1, bias=bias)
+        self.dw_act = dw_act
+        self.pw_act = pw_act
+
+    def forward(self, x):
+        return self.pw_act(self.pw(self.dw_act(self.dw(x))))
+
+class ConvPool(nn.Module):
+    def __init__(self, in_channels, out_channels, kernel_size, stride, padding, act, pool):
+        super(ConvPool, self).__init__()
+        self.conv = nn.Conv2d(in_channels, out_channels, kernel_size, stride, padding)
+        self.act = act
+        self.pool = pool
+
+    def forward(self, x):
+        return self.pool(self.act(self.conv(x)))
+
 class EinsumAdd(nn.Module):
     def __init__(self, equation):
         super(EinsumAdd, self).__init__()
@@ -1148,6 +1191,20 @@ class EinsumAddInplaceV1(nn.Module):
     def forward(self, input1, input2, bias):
         return bias.add_(torch.einsum(self.equation, input1, input2))
 
+class EinsumChain(nn.Module):
+    def __init__(self, equation):
+        super(EinsumChain, self).__init__()
+        self.equation = equation
+    def forward(self, input1, input2, input3):
+        return torch.einsum(self.equation, input1, input2, input3)
+
+class EinsumChainAdd(nn.Module):
+    def __init__(self, equation):
+        super(EinsumChainAdd, self).__init__()
+        self.equation = equation
+    def forward(self, input1, input2, input3, bias):
+        return torch.einsum(self.equation, input1, input2, input3) + bias
+
 class AddMulDiv(nn.Module):
     def __init__(self):
         super(AddMulDiv, self).__init__()
@@ -1411,6 +1468,47 @@ class Tester(TestCase):
             linear_count_ori = check_op_count(graph_opt, ["ipex_prepack::linear_run"])
             self.assertEqual(linear_count_ori, 2)
 
+    def test_group_norm_silu(self):
+        for dtype, hw, inplace in itertools.product([torch.float, torch.bfloat16], [8, 64], [False, True]):
+            x = torch.randn(2, 320, hw, hw).to(memory_format=torch.channels_last)
+            y = torch.randn(2, 320, hw, hw).to(memory_format=torch.channels_last)
+            prec = 0.05 if dtype == torch.bfloat16 else None
+            with torch.no_grad():
+                model = GroupNormSiLU(320, inplace=inplace).eval().to(dtype)
+                x_ = x.to(dtype)
+                ref = model(x_)
+                jit_model = torch.jit.freeze(torch.jit.trace(model, x_))
+                for _ in range(2):
+                    jit_res = jit_model(x_)
+                self.assertEqual(jit_res, ref, prec=prec)
+                trace_graph = jit_model.graph_for(x_)
+                self.assertTrue(any(n.kind() == "ipex::group_norm_silu" for n in trace_graph.nodes()))
+
+                model = GroupNormSiLUAdd(320).eval().to(dtype)
+                y_ = y.to(dtype)
+                ref = model(x_, y_)
+                jit_model = torch.jit.freeze(torch.jit.trace(model, (x_, y_)))
+                for _ in range(2):
+                    jit_res = jit_model(x_, y_)
+                self.assertEqual(jit_res, ref, prec=prec)
+                trace_graph = jit_model.graph_for(x_, y_)
+                self.assertTrue(any(n.kind() == "ipex::group_norm_silu_add" for n in trace_graph.nodes()))
+
+                # contiguous input falls back to the unfused ops
+                x_cont = x_.contiguous()
+                self.assertEqual(jit_model(x_cont, y_), model(x_cont, y_), prec=prec)
+
+                # aten::add.Scalar is not fused into group_norm_silu_add
+                model = GroupNormSiLUAddScalar(320).eval().to(dtype)
+                ref = model(x_)
+                jit_model = torch.jit.freeze(torch.jit.trace(model, x_))
+                for _ in range(2):
+                    jit_res = jit_model(x_)
+                self.assertEqual(jit_res, ref, prec=prec)
+                trace_graph = jit_model.graph_for(x_)
+                self.assertTrue(any(n.kind() == "ipex::group_norm_silu" for n in trace_graph.nodes()))
+                self.assertFalse(any(n.kind() == "ipex::group_norm_silu_add" for n in trace_graph.nodes()))
+
     def test_add_layernorm(self):
         for dim in [768, 100]:
             with torch.no_grad():
@@ -2755,6 +2853,78 @@ class Tester(TestCase):
                 eager_y = m(x2)
                 self.assertEqual(eager_y, traced_y)
 
+    def test_depthwise_pointwise_fusion(self):
+        # the large inputs are computed tile by tile, the small one by the
+        # unfused convolutions
+        for x in [torch.randn(2, 32, 112, 112), torch.randn(1, 32, 99, 101), torch.randn(1, 32, 14, 14)]:
+            for stride in [1, 2]:
+                for dw_act, pw_act in [(nn.ReLU(), nn.ReLU()), (nn.ReLU6(), nn.Identity()), (nn.SiLU(), nn.Hardswish())]:
+                    self._test_output(
+                        DepthwisePointwise(32, 48, stride, dw_act, pw_act),
+                        x,
+                        kind_in_graph="ipex_prepack::convolution_depthwise_pointwise_run",
+                        use_channels_last=[True],
+                        levels=['O1'])
+        x = torch.randn(2, 32, 112, 112)
+        self._test_output(
+            DepthwisePointwise(32, 48, 1, nn.ReLU6(), nn.Identity(), bias=False),
+            x,
+            kind_in_graph="ipex_prepack::convolution_depthwise_pointwise_run",
+            use_channels_last=[True],
+            levels=['O1'])
+        self._test_output_bf16(
+            DepthwisePointwise(32, 48, 1, nn.ReLU6(), nn.Identity()),
+            x,
+            kind_in_graph="ipex_prepack::convolution_depthwise_pointwise_run",
+            prec=0.02,
+            use_channels_last=[True],
+            levels=['O1'])
+        # a clamp other than ReLU6 is not fused
+        self._test_output(
+            DepthwisePointwise(32, 48, 1, nn.Hardtanh(-1., 1.), nn.Identity()),
+            x,
+            kind_not_in_graph="ipex_prepack::convolution_depthwise_pointwise_run",
+            use_channels_last=[True],
+            levels=['O1'])
+
+    def test_conv_pool_fusion(self):
+        # ResNet stem, the small input is computed by the unfused convolution
+        for x in [torch.randn(2, 3, 224, 224), torch.randn(1, 3, 32, 32)]:
+            for act in [nn.ReLU(), nn.ReLU6(), nn.Identity()]:
+                self._test_output(
+                    ConvPool(3, 64, 7, 2, 3, act, nn.MaxPool2d(3, 2, 1)),
+                    x,
+                    kind_in_graph="ipex_prepack::convolution_pool_run",
+                    use_channels_last=[True],
+                    levels=['O1'])
+        # VGG block, with odd sizes for the ceil mode and the padding at the
+        # bottom of the last tile
+        for x in [torch.randn(1, 32, 112, 112), torch.randn(1, 32, 75, 77)]:
+            for pool in [nn.MaxPool2d(2, 2), nn.MaxPool2d(3, 2, 1, ceil_mode=True),
+                         nn.AvgPool2d(2, 2), nn.AvgPool2d(3, 2, 1, count_include_pad=False)]:
+                self._test_output(
+                    ConvPool(32, 64, 3, 1, 1, nn.ReLU(), pool),
+                    x,
+                    kind_in_graph="ipex_prepack::convolution_pool_run",
+                    use_channels_last=[True],
+                    levels=['O1'])
+        x = torch.randn(2, 3, 224, 224)
+        self._test_output_bf16(
+            ConvPool(3, 64, 7, 2, 3, nn.ReLU(), nn.MaxPool2d(3, 2, 1)),
+            x,
+            kind_in_graph="ipex_prepack::convolution_pool_run",
+            prec=0.02,
+            use_channels_last=[True],
+            levels=['O1'])
+        # dilated max pooling and a divisor override are not fused
+        for pool in [nn.MaxPool2d(3, 2, 1, dilation=2), nn.AvgPool2d(2, 2, divisor_override=3)]:
+            self._test_output(
+                ConvPool(3, 64, 7, 2, 3, nn.ReLU(), pool),
+                x,
+                kind_not_in_graph="ipex_prepack::convolution_pool_run",
+                use_channels_last=[True],
+                levels=['O1'])
+
     def test_jit_conv_sum_in_diff_block(self):
         batch_size = 8
         out_channels = 32
@@ -3499,6 +3669,34 @@ class Tester(TestCase):
                     self.assertTrue(any(n.kind() == "ipex::bmm_add" for n in fused_mod.nodes()))
                     self.assertEqual(out, expected, prec=1e-1)
 
+    def test_einsum_multi_operand(self):
+        def _test(model, inputs, kind_in_graph):
+            model = model.eval()
+            with torch.no_grad():
+                tr_model = torch.jit.freeze(torch.jit.trace(model, inputs))
+                tr_model(*inputs)
+                tr_model(*inputs)
+                trace_graph = tr_model.graph_for(*inputs)
+                self.assertTrue(any(n.kind() == kind_in_graph for n in trace_graph.nodes()))
+                # the second run replays the cached contraction path
+                for _ in range(2):
+                    self.assertEqual(tr_model(*inputs), model(*inputs), prec=1e-3)
+
+        # contracting the two small operands first is the cheaper order
+        input1 = torch.randn(64, 256)
+        input2 = torch.randn(256, 8)
+        input3 = torch.randn(8, 256)
+        _test(EinsumChain('ij,jk,kl->il'), (input1, input2, input3), 'ipex::einsum')
+        _test(EinsumChain('bi,bj,bk->bijk'), (input1[:, :4], input1[:, :5], input1[:, :6]), 'ipex::einsum')
+        bias = torch.randn(256)
+        _test(EinsumChainAdd('ij,jk,kl->il'), (input1, input2, input3, bias), 'ipex::einsum_binary')
+
+        # ellipses are left to aten::einsum at runtime
+        input1 = torch.randn(2, 3, 4)
+        input2 = torch.randn(4, 5)
+        input3 = torch.randn(5, 6)
+        _test(EinsumChain('...j,jk,kl->...l'), (input1, input2, input3), 'ipex::einsum')
+
     def test_einsum_add(self):
         def _test_fp32(model_test, input1, input2, bias=None, kind_in_graph='ipex::einsum_binary', prec=1e-3):
             model = copy.deepcopy(model_test)
@@ -449,6 +449,110 @@ class TestOp(JitLlgaTestCase):
         graph, scripted = self.checkScript(m, [x, y, z])
         self.assertGraphContainsExactly(graph, LLGA_FUSION_GROUP, 0)
 
+    @llga_fp32_bf16_test_env
+    def test_reduction(self):
+        def forward_mean(x):
+            return torch.relu(x).mean(dim=[2, 3], keepdim=True)
+
+        def forward_sum(x):
+            return torch.relu(x).sum(-1)
+
+        for forward in [forward_mean, forward_sum]:
+            x = torch.rand(2, 16, 7, 7)
+            graph, _ = self.checkTrace(forward, [x])
+            self.assertGraphContainsExactly(graph, LLGA_FUSION_GROUP, 1)
+            self.assertFused(graph, ['aten::relu', 'aten::mean', 'aten::sum'])
+
+    @llga_fp32_bf16_test_env
+    def test_interpolate(self):
+        for mode, align_corners in [('nearest', None), ('bilinear', False), ('bilinear', True)]:
+            def forward(x):
+                y = F.interpolate(x, scale_factor=2, mode=mode, align_corners=align_corners)
+                return torch.relu(y)
+
+            x = torch.rand(1, 8, 7, 9)
+            graph, _ = self.checkTrace(forward, [x])
+            self.assertGraphContainsExactly(graph, LLGA_FUSION_GROUP, 1)
+
+    @llga_fp32_bf16_test_env
+    def test_interpolate_non_integer_scale(self):
+        for mode, align_corners in [('nearest', None), ('bilinear', False)]:
+            def forward(x):
+                # 7x9 -> 14x18, but sampled with the scale 2.1 instead of 2
+                y = F.interpolate(x, scale_factor=2.1, mode=mode, align_corners=align_corners)
+                return torch.relu(y)
+
+            x = torch.rand(1, 8, 7, 9)
+            graph, _ = self.checkTrace(forward, [x])
+            self.assertGraphContainsExactly(graph, 'aten::upsample_' + mode + '2d', 1)
+
+    @llga_fp32_bf16_test_env
+    def test_pad_conv(self):
+        class M(nn.Module):
+            def __init__(self):
+                super(M, self).__init__()
+                self.conv = nn.Conv2d(8, 8, 3)
+
+            def forward(self, x):
+                return torch.relu(self.conv(F.pad(x, (1, 1, 2, 2))))
+
+        x = torch.rand(1, 8, 10, 10)
+        graph, _ = self.checkTrace(M(), [x])
+        self.assertGraphContainsExactly(graph, LLGA_FUSION_GROUP, 1)
+        self.assertFused(graph, ['aten::pad', 'aten::constant_pad_nd', 'aten::_convolution'])
+
+    @llga_fp32_bf16_test_env
+    def test_transpose_reshape(self):
+        def forward(x, y):
+            # [batch, seq, hidden] -> [batch, heads, seq, head_size]
+            q = x.view(2, 32, 4, 16).transpose(1, 2)
+            k = y.reshape(2, 32, 4, 16).permute(0, 2, 3, 1)
+            return torch.matmul(q, k).flatten(2)
+
+        x = torch.rand(2, 32, 64)
+        y = torch.rand(2, 32, 64)
+        graph, _ = self.checkTrace(forward, [x, y])
+        self.assertGraphContainsExactly(graph, LLGA_FUSION_GROUP, 1)
+        self.assertFused(graph, ['aten::view', 'aten::reshape', 'aten::transpose',
+                                 'aten::permute', 'aten::matmul', 'aten::flatten'])
+
+    @llga_fp32_bf16_test_env
+    def test_masked_softmax(self):
+        def forward_masked_fill(x, mask):
+            return torch.softmax(x.masked_fill(mask, -10000.), -1)
+
+        def forward_where(x, mask, fill):
+            return torch.softmax(torch.where(mask, fill, x), -1)
+
+        x = torch.rand(2, 4, 16, 16)
+        mask = torch.rand(2, 1, 1, 16) > 0.5
+        graph, _ = self.checkTrace(forward_masked_fill, [x, mask])
+        self.assertGraphContainsExactly(graph, LLGA_FUSION_GROUP, 1)
+        self.assertFused(graph, ['aten::masked_fill', 'aten::softmax'])
+        graph, _ = self.checkTrace(forward_where, [x, mask, torch.full([1], -10000.)])
+        self.assertGraphContainsExactly(graph, LLGA_FUSION_GROUP, 1)
+        self.assertFused(graph, ['aten::where', 'aten::softmax'])
+
+    @llga_fp32_bf16_test_env
+    def test_gelu_variants(self):
+        def forward_erf(x):
+            return x * 0.5 * (1.0 + torch.erf(x / 1.4142135623730951))
+
+        def forward_pow(x):
+            return torch.sqrt(torch.pow(x, 2) + torch.pow(x, 0.5))
+
+        for forward in [forward_erf, forward_pow]:
+            x = torch.rand(4, 32)
+            graph, _ = self.checkTrace(forward, [x])
+            self.assertGraphContainsExactly(graph, LLGA_FUSION_GROUP, 1)
+            self.assertFused(graph, ['aten::erf', 'aten::pow'])
+
+        def forward_tanh(x):
+            return F.gelu(x, approximate='tanh')
+
+        graph, _ = self.checkTrace(forward_tanh, [torch.rand(4, 32)])
+        self.assertGraphContainsExactly(graph, LLGA_FUSION_GROUP, 0)
+
 class TestFusionPattern(JitLlgaTestCase):
     @llga_fp32_bf16_test_env
     def test_conv2d_eltwise(self):
@@ -801,6 +905,43 @@ class TestAPI(JitLlgaTestCase):
         # set the value back to the default one
         ipex._C._jit_set_llga_weight_cache_enabled(weight_cache_enabled_default_value)
 
+    @llga_fp32_bf16_test_env
+    def test_profiler_api(self):
+        from intel_extension_for_pytorch.utils.llga_profiler import llga_profile
+        import json
+        import tempfile
+
+        class M(nn.Module):
+            def __init__(self):
+                super(M, self).__init__()
+                self.conv = nn.Conv2d(8, 16, 3, padding=1)
+
+            def forward(self, x):
+                return torch.relu(self.conv(x))
+
+        x = torch.rand(1, 8, 14, 14)
+        _, traced = self.checkTrace(M(), [x])
+        self.assertFalse(ipex._C._jit_llga_profiler_enabled())
+        with llga_profile() as prof:
+            with torch.no_grad():
+                for _ in range(3):
+                    traced(x)
+        self.assertFalse(ipex._C._jit_llga_profiler_enabled())
+
+        table = prof.table()
+        self.assertTrue("LlgaPartition_" in table)
+        self.assertTrue("conv" in table)
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, "trace.json")
+            prof.export_chrome_trace(path)
+            with open(path) as f:
+                events = json.load(f)["traceEvents"]
+        executes = [e for e in events if e["cat"] == "execute"]
+        self.assertEqual(len(executes), 3)
+        # conv 8 -> 16 with a 3x3 kernel on 14x14
+        self.assertTrue(executes[0]["args"]["flops"] >= 2 * 16 * 14 * 14 * 8 * 9)
+        self.assertTrue(executes[0]["args"]["bytes"] > 0)
+
 class TestDebugLog(JitLlgaTestCase):
     def test_fusion_group_name(self):
         num = 0
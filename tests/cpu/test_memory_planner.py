@@ -0,0 +1,166 @@
+import unittest
+import threading
+import torch
+import torch.nn as nn
+import intel_extension_for_pytorch as ipex
+import intel_extension_for_pytorch._C as core
+from torch.testing._internal.common_utils import TestCase
+
+
+class ConvChain(nn.Module):
+    def __init__(self):
+        super(ConvChain, self).__init__()
+        self.conv1 = nn.Conv2d(3, 16, 3, padding=1)
+        self.conv2 = nn.Conv2d(16, 16, 3, padding=1)
+        self.conv3 = nn.Conv2d(16, 16, 3, padding=1)
+        self.conv4 = nn.Conv2d(16, 8, 3, padding=1)
+
+    def forward(self, x):
+        x = torch.relu(self.conv1(x))
+        x = torch.relu(self.conv2(x))
+        x = self.conv3(x)
+        return self.conv4(x) + 1
+
+
+class ConvPair(nn.Module):
+    def __init__(self):
+        super(ConvPair, self).__init__()
+        self.conv1 = nn.Conv2d(3, 8, 3, padding=1)
+        self.conv2 = nn.Conv2d(8, 8, 3, padding=1)
+
+    def forward(self, x):
+        return self.conv2(torch.relu(self.conv1(x)))
+
+
+class MLPAttention(nn.Module):
+    def __init__(self):
+        super(MLPAttention, self).__init__()
+        self.q = nn.Linear(64, 64)
+        self.k = nn.Linear(64, 64)
+        self.v = nn.Linear(64, 64)
+        self.out = nn.Linear(64, 64)
+
+    def forward(self, x):
+        q = self.q(x)
+        k = self.k(x)
+        v = self.v(x)
+        scores = torch.bmm(q, k.transpose(1, 2))
+        probs = torch.softmax(scores, dim=-1)
+        return self.out(torch.bmm(probs, v)) * 2
+
+
+class TestActivationMemoryPlanner(TestCase):
+    def setUp(self):
+        self.default_enabled = core._jit_activation_memory_planning_enabled()
+        core._jit_set_activation_memory_planning_enabled(True)
+
+    def tearDown(self):
+        core._jit_set_activation_memory_planning_enabled(self.default_enabled)
+        core._jit_release_activation_arenas()
+
+    def _trace(self, model, x):
+        model = ipex.optimize(model.eval(), dtype=torch.float32)
+        with torch.no_grad():
+            traced = torch.jit.freeze(torch.jit.trace(model, x))
+            # the first two runs profile and optimize the graph
+            traced(x)
+            traced(x)
+        return traced
+
+    def _planned_kinds(self, graph):
+        return [n.kind() for n in graph.nodes() if n.kind().endswith("_out")]
+
+    def _check_model(self, model, x, expected_kinds):
+        with torch.no_grad():
+            ref = model(x)
+        num_plans = len(core._jit_get_activation_memory_plans())
+        traced = self._trace(model, x)
+        with torch.no_grad():
+            graph = traced.graph_for(x)
+            # run several times to make sure the reused arena is not
+            # corrupted by a previous call
+            for _ in range(3):
+                self.assertEqual(traced(x), ref, prec=1e-4)
+
+        kinds = self._planned_kinds(graph)
+        for kind in expected_kinds:
+            self.assertTrue(kind in kinds, kind + " not in " + str(kinds))
+
+        plans = core._jit_get_activation_memory_plans()
+        self.assertTrue(len(plans) > num_plans)
+        plan = plans[-1]
+        self.assertTrue(plan["arena_bytes"] % 64 == 0)
+        self.assertTrue(plan["arena_bytes"] <= plan["naive_bytes"])
+        self.assertEqual(plan["fallbacks"], 0)
+        return traced, plan
+
+    def test_conv_chain(self):
+        model = ConvChain()
+        x = torch.randn(2, 3, 32, 32)
+        _, plan = self._check_model(
+            model,
+            x,
+            ["ipex_prepack::convolution_relu_run_out",
+             "ipex_prepack::convolution_run_out"])
+        # conv1 output is dead once conv2 ran, so the chain must reuse memory
+        self.assertTrue(plan["arena_bytes"] < plan["naive_bytes"])
+
+    def test_linear_bmm_softmax(self):
+        model = MLPAttention()
+        x = torch.randn(4, 32, 64)
+        self._check_model(
+            model,
+            x,
+            ["ipex_prepack::linear_run_out",
+             "ipex::bmm_out",
+             "ipex::softmax_out"])
+
+    def test_graph_output_not_planned(self):
+        model = ConvPair()
+        x = torch.randn(1, 3, 16, 16)
+        traced = self._trace(model, x)
+        with torch.no_grad():
+            graph = traced.graph_for(x)
+            y1 = traced(x)
+            y2 = traced(x)
+        # the result of the last conv escapes the graph and must not be
+        # written into the reused arena
+        output_node = list(graph.outputs())[0].node()
+        self.assertFalse(output_node.kind().endswith("_out"))
+        self.assertEqual(y1, y2)
+        self.assertNotEqual(y1.data_ptr(), y2.data_ptr())
+
+    def test_thread_local_arena(self):
+        model = ConvChain()
+        x = torch.randn(2, 3, 32, 32)
+        with torch.no_grad():
+            ref = model(x)
+        traced = self._trace(model, x)
+        errors = []
+
+        def run():
+            try:
+                with torch.no_grad():
+                    for _ in range(10):
+                        self.assertEqual(traced(x), ref, prec=1e-4)
+            except Exception as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=run) for _ in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(len(errors), 0)
+
+    def test_shape_change_fallback(self):
+        model = ConvChain()
+        x = torch.randn(2, 3, 32, 32)
+        traced = self._trace(model, x)
+        y = torch.randn(1, 3, 20, 20)
+        with torch.no_grad():
+            self.assertEqual(traced(y), model(y), prec=1e-4)
+
+
+if __name__ == '__main__':
+    test = unittest.main()
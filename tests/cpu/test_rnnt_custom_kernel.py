@@ -171,5 +171,74 @@ class TestRNNTEmbedding(TestCase):
 
             self.assertEqual(y_embed_org, y_embed)
 
+class TestRNNTGreedyDecode(TestCase):
+    def _greedy_decode_org(self, x, out_lens, embed, lstm, enc, pred, joint, max_symbols, blank_id):
+        # per sample greedy decoding driven from Python
+        tokens = []
+        for b in range(x.size(1)):
+            f = enc(x[:, b, :])
+            hidden = None
+            label = []
+            for t in range(out_lens[b]):
+                symbols_added = 0
+                while symbols_added < max_symbols:
+                    if label:
+                        y = embed(torch.tensor([[label[-1]]]))
+                    else:
+                        y = torch.zeros([1, 1, embed.weight.size(1)])
+                    g, hidden_prime = lstm(y, hidden)
+                    k = joint(torch.relu(f[t] + pred(g[0, 0]))).argmax(-1).item()
+                    if k == blank_id:
+                        break
+                    label.append(k)
+                    hidden = hidden_prime
+                    symbols_added += 1
+            tokens.append(torch.tensor(label, dtype=torch.long))
+        return tokens
+
+    def _prepack(self, weight, bias):
+        ctx = torch.ops.ipex_prepack.linear_prepack(weight, bias, None)
+        self.ctxs.append(ctx)
+        return ctx.get_data_handle()
+
+    def test_rnnt_greedy_decode(self):
+        self._SOS = -1
+        vocab_size = 29
+        blank_id = vocab_size - 1
+        enc_n_hidden, pred_n_hidden, joint_n_hidden = 64, 32, 48
+        for batch_size, num_layers, max_symbols in product([1, 5, 16], [1, 2], [1, 3]):
+            self.ctxs = []
+            embed = torch.nn.Embedding(vocab_size - 1, pred_n_hidden)
+            lstm = torch.nn.LSTM(pred_n_hidden, pred_n_hidden, num_layers)
+            enc = torch.nn.Linear(enc_n_hidden, joint_n_hidden)
+            pred = torch.nn.Linear(pred_n_hidden, joint_n_hidden)
+            joint = torch.nn.Linear(joint_n_hidden, vocab_size)
+            time_steps = 12
+            x = torch.randn(time_steps, batch_size, enc_n_hidden)
+            out_lens = torch.randint(1, time_steps + 1, [batch_size], dtype=torch.int)
+
+            with torch.no_grad():
+                tokens_org = self._greedy_decode_org(
+                    x, out_lens, embed, lstm, enc, pred, joint, max_symbols, blank_id)
+                ih = [self._prepack(getattr(lstm, 'weight_ih_l%d' % l), getattr(lstm, 'bias_ih_l%d' % l))
+                      for l in range(num_layers)]
+                hh = [self._prepack(getattr(lstm, 'weight_hh_l%d' % l), getattr(lstm, 'bias_hh_l%d' % l))
+                      for l in range(num_layers)]
+                tokens = torch.ops.torch_ipex.rnnt_greedy_decode(
+                    x,
+                    out_lens,
+                    embed.weight,
+                    ih,
+                    hh,
+                    self._prepack(enc.weight, enc.bias),
+                    self._prepack(pred.weight, pred.bias),
+                    self._prepack(joint.weight, joint.bias),
+                    max_symbols,
+                    blank_id,
+                    self._SOS)
+            self.assertEqual(len(tokens), batch_size)
+            for token_org, token in zip(tokens_org, tokens):
+                self.assertEqual(token_org, token)
+
 if __name__ == '__main__':
     test = unittest.main()
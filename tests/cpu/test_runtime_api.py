@@ -454,5 +454,58 @@ class TestRuntimeExtensionWithNumactl(TestCase):
                         match = True
             assert match, 'Test Case Failed to create CPUPool'
 
+class TestNumaAllocator(TestCase):
+    def test_to_numa_local(self):
+        ipex.cpu.runtime.numa_allocator_empty_cache()
+        x = torch.randn(1024, 1024)
+        before = ipex.cpu.runtime.numa_allocator_stats()
+        y = ipex.cpu.runtime.to_numa_local(x)
+        self.assertEqual(x, y)
+        stats = ipex.cpu.runtime.numa_allocator_stats()
+        self.assertEqual(stats["allocations"], before["allocations"] + 1)
+        self.assertGreaterEqual(stats["bytes_in_use"], before["bytes_in_use"] + x.numel() * x.element_size())
+        # the freed block is cached and reused for the same size class
+        del y
+        y = ipex.cpu.runtime.to_numa_local(x)
+        self.assertEqual(ipex.cpu.runtime.numa_allocator_stats()["cache_hits"], stats["cache_hits"] + 1)
+        del y
+        ipex.cpu.runtime.numa_allocator_empty_cache()
+        self.assertEqual(ipex.cpu.runtime.numa_allocator_stats()["bytes_cached"], 0)
+
+    def test_numa_allocator_as_default(self):
+        ipex.cpu.runtime.enable_numa_allocator()
+        try:
+            self.assertTrue(ipex.cpu.runtime.is_numa_allocator_enabled())
+            before = ipex.cpu.runtime.numa_allocator_stats()["allocations"]
+            x = torch.ones(512, 1024)
+            y = x + 1
+            self.assertGreater(ipex.cpu.runtime.numa_allocator_stats()["allocations"], before)
+        finally:
+            ipex.cpu.runtime.disable_numa_allocator()
+        self.assertFalse(ipex.cpu.runtime.is_numa_allocator_enabled())
+        # tensors allocated before disabling stay valid
+        self.assertEqual(y, torch.full((512, 1024), 2.0))
+
+    def test_numa_local_weights(self):
+        model = nn.Conv2d(256, 256, (3, 3), padding=(1, 1)).eval()
+        x = torch.randn(1, 256, 14, 14)
+        ref = model(x)
+        before = ipex.cpu.runtime.numa_allocator_stats()["allocations"]
+        with ipex.cpu.runtime.numa_local_weights():
+            opt_model = ipex.optimize(model)
+        self.assertGreater(ipex.cpu.runtime.numa_allocator_stats()["allocations"], before)
+        with torch.no_grad():
+            self.assertEqual(opt_model(x), ref)
+
+    def test_merged_embeddingbag_numa_local(self):
+        tables = [nn.EmbeddingBag(1000, 128, mode='sum'), nn.EmbeddingBag(2000, 64, mode='mean')]
+        merged = ipex.nn.modules.MergedEmbeddingBagWithSGD.from_embeddingbag_list(tables)
+        merged_numa = ipex.nn.modules.MergedEmbeddingBagWithSGD.from_embeddingbag_list(tables, numa_local=True)
+        indices = [torch.LongTensor([1, 2, 3, 4]), torch.LongTensor([5, 6, 7, 8])]
+        offsets = [torch.LongTensor([0, 2]), torch.LongTensor([0, 1])]
+        input = (indices, offsets, [False, False])
+        for ref, out in zip(merged(input), merged_numa(input)):
+            self.assertEqual(ref, out)
+
 if __name__ == '__main__':
     test = unittest.main()
@@ -0,0 +1,131 @@
+import unittest
+import torch
+import torch.nn as nn
+import intel_extension_for_pytorch as ipex
+import intel_extension_for_pytorch._C as core
+from intel_extension_for_pytorch.nn.utils._weight_prepack import _IPEXSparseLinear
+from torch.testing._internal.common_utils import TestCase
+
+# block of output x input channels of the sparse weight layout
+N_BLOCK, K_BLOCK = 16, 4
+
+
+def _block_prune(linear, density):
+    # zero whole blocks of the weight, like structured pruning
+    out_features, in_features = linear.weight.shape
+    rows = (out_features + N_BLOCK - 1) // N_BLOCK
+    cols = (in_features + K_BLOCK - 1) // K_BLOCK
+    mask = (torch.rand(rows, cols) < density).float()
+    mask = mask.repeat_interleave(N_BLOCK, 0).repeat_interleave(K_BLOCK, 1)
+    with torch.no_grad():
+        linear.weight.mul_(mask[:out_features, :in_features])
+    return linear
+
+
+class Sparse(nn.Module):
+    def __init__(self):
+        super(Sparse, self).__init__()
+        # 0.25 block density
+        self.sparse = nn.Linear(64, 64)
+        with torch.no_grad():
+            self.sparse.weight[:, :32] = 0
+            self.sparse.weight[:32, 32:] = 0
+        self.dense = nn.Linear(64, 32)
+
+    def forward(self, x):
+        return self.dense(torch.relu(self.sparse(x)))
+
+
+class TestSparseLinear(TestCase):
+    def test_block_density(self):
+        linear = nn.Linear(64, 64)
+        self.assertEqual(torch.ops.torch_ipex.sparse_linear_block_density(linear.weight.detach()), 1.)
+        with torch.no_grad():
+            linear.weight[:, :32] = 0
+            linear.weight[:16, 32:] = 0
+        self.assertEqual(torch.ops.torch_ipex.sparse_linear_block_density(linear.weight.detach()), 0.375)
+        # the partial blocks at the N and K tails count as whole blocks
+        linear = nn.Linear(6, 20)
+        with torch.no_grad():
+            linear.weight[:16] = 0
+            linear.weight[16:, :4] = 0
+        self.assertEqual(torch.ops.torch_ipex.sparse_linear_block_density(linear.weight.detach()), 0.25)
+
+    def test_density_threshold(self):
+        model = Sparse().eval()
+        sparse_model = ipex.optimize(model, sparse_density_threshold=0.5)
+        self.assertTrue(isinstance(sparse_model.sparse, _IPEXSparseLinear))
+        self.assertFalse(isinstance(sparse_model.dense, _IPEXSparseLinear))
+        # only the non-zero blocks are stored
+        self.assertEqual(sparse_model.sparse.weight.numel(), 0.25 * 64 * 64)
+        # density above the threshold, and no threshold
+        for kwargs in [{'sparse_density_threshold': 0.2}, {}]:
+            sparse_model = ipex.optimize(model, **kwargs)
+            self.assertFalse(isinstance(sparse_model.sparse, _IPEXSparseLinear))
+
+    def test_jit_density_threshold(self):
+        x = torch.randn(3, 64)
+        default_threshold = core._jit_sparse_linear_density_threshold()
+        try:
+            for threshold, expected in [(0., 0), (0.2, 0), (0.5, 1)]:
+                core._jit_set_sparse_linear_density_threshold(threshold)
+                model = Sparse().eval()
+                with torch.no_grad():
+                    ref = model(x)
+                    traced = torch.jit.freeze(torch.jit.trace(model, x))
+                    traced(x)
+                    traced(x)
+                    graph = traced.graph_for(x)
+                    self.assertEqual(traced(x), ref, prec=1e-4)
+                kinds = [n.kind() for n in graph.nodes()]
+                self.assertEqual(kinds.count("ipex_prepack::sparse_linear_run"), expected)
+        finally:
+            core._jit_set_sparse_linear_density_threshold(default_threshold)
+
+    def test_block_layout(self):
+        # N and K not a multiple of the block, fewer channels than one block
+        for out_features, in_features in [(40, 64), (64, 30), (33, 17), (5, 3)]:
+            linear = _block_prune(nn.Linear(in_features, out_features), 0.5)
+            m = _IPEXSparseLinear(linear, torch.float32)
+            # batch sizes covering the row tail of the micro kernel
+            for x in [torch.randn(1, in_features), torch.randn(7, in_features), torch.randn(2, 3, in_features)]:
+                with torch.no_grad():
+                    self.assertEqual(m(x), linear(x), prec=1e-4)
+
+    def test_zero_blocks(self):
+        x = torch.randn(5, 64)
+        linear = nn.Linear(64, 40)
+        with torch.no_grad():
+            # the first block of output channels has no non-zero block, the
+            # second one only its last block
+            linear.weight[:32] = 0
+            linear.weight[16:32, 60:] = 1
+            # a zero block in the middle of the last block row
+            linear.weight[32:, 8:12] = 0
+        m = _IPEXSparseLinear(linear, torch.float32)
+        with torch.no_grad():
+            self.assertEqual(m(x), linear(x), prec=1e-4)
+
+        # no non-zero block at all, only the bias is left
+        linear = nn.Linear(64, 40)
+        with torch.no_grad():
+            linear.weight.zero_()
+        m = _IPEXSparseLinear(linear, torch.float32)
+        self.assertEqual(m.weight.numel(), 0)
+        with torch.no_grad():
+            self.assertEqual(m(x), linear.bias.expand(5, 40))
+
+    def test_to_public(self):
+        for out_features, in_features in [(64, 64), (33, 17)]:
+            linear = _block_prune(nn.Linear(in_features, out_features), 0.5)
+            weight = linear.weight.detach()
+            for dtype in [torch.float32, torch.bfloat16]:
+                m = _IPEXSparseLinear(linear, dtype)
+                public = m.ctx.to_public(m.weight)
+                self.assertEqual(public.shape, weight.shape)
+                self.assertEqual(public, weight.to(dtype).float())
+                self.assertEqual(m.state_dict()['weight'], public)
+
+
+if __name__ == '__main__':
+    test = unittest.main()
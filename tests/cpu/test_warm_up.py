@@ -0,0 +1,66 @@
+import unittest
+import torch
+import torch.nn as nn
+import intel_extension_for_pytorch as ipex
+from intel_extension_for_pytorch.utils.warm_up import warm_up
+from torch.testing._internal.common_utils import TestCase
+
+
+class ConvLinear(nn.Module):
+    def __init__(self):
+        super(ConvLinear, self).__init__()
+        self.conv1 = nn.Conv2d(3, 16, 3, padding=1)
+        self.conv2 = nn.Conv2d(16, 16, 3, padding=1)
+        self.linear = nn.Linear(16, 10)
+
+    def forward(self, x):
+        x = torch.relu(self.conv2(torch.relu(self.conv1(x))))
+        return self.linear(x.mean(dim=[2, 3]))
+
+
+class TestWarmUp(TestCase):
+    def _inputs(self):
+        return [torch.randn(1, 3, 16, 16), torch.randn(4, 3, 20, 20)]
+
+    def test_eager(self):
+        model = ConvLinear().eval()
+        inputs = self._inputs()
+        progress = []
+        handle = warm_up(
+            model, inputs, num_threads=[1, 2], prepack_workers=2,
+            callback=lambda *p: progress.append(p))
+        self.assertTrue(handle.wait(timeout=300))
+        # 3 prepacked modules and 2 x 2 (input, thread count) pairs
+        self.assertEqual(handle.progress(), ("ready", 7, 7))
+        self.assertEqual([p[1] for p in progress if p[0] == "prepack"], [0, 1, 2, 3])
+        ref_model = ipex.optimize(model)
+        with torch.no_grad():
+            for x in inputs:
+                self.assertEqual(handle.model(x), ref_model(x), prec=1e-4)
+
+    def test_jit(self):
+        model = ConvLinear().eval()
+        inputs = self._inputs()
+        handle = warm_up(model, inputs, num_threads=[2], jit=True, background=False)
+        self.assertTrue(handle.is_ready())
+        self.assertTrue(isinstance(handle.model, torch.jit.ScriptModule))
+        with torch.no_grad():
+            for x in inputs:
+                self.assertEqual(handle.model(x), model(x), prec=1e-4)
+
+        # a traced model is only run
+        handle = warm_up(handle.model, inputs, background=False)
+        self.assertEqual(handle.progress(), ("ready", 2, 2))
+
+    def test_failure(self):
+        model = ConvLinear().eval()
+        # the channels do not match conv1
+        handle = warm_up(model, [torch.randn(1, 4, 16, 16)])
+        with self.assertRaises(RuntimeError):
+            handle.wait(timeout=300)
+        self.assertFalse(handle.is_ready())
+        self.assertEqual(handle.progress()[0], "failed")
+
+
+if __name__ == '__main__':
+    test = unittest.main()
@@ -0,0 +1,103 @@
+import unittest
+import copy
+import torch
+import torch.nn as nn
+import intel_extension_for_pytorch as ipex
+import intel_extension_for_pytorch._C as core
+from intel_extension_for_pytorch.nn.utils._weight_prepack import _IPEXWoqLinear
+from torch.testing._internal.common_utils import TestCase
+
+
+class MLP(nn.Module):
+    def __init__(self, bias=True):
+        super(MLP, self).__init__()
+        self.fc1 = nn.Linear(256, 100, bias=bias)
+        self.fc2 = nn.Linear(100, 37, bias=bias)
+
+    def forward(self, x):
+        return self.fc2(torch.relu(self.fc1(x)))
+
+
+class TestWoqLinear(TestCase):
+    def _dequantized_model(self, model, woq_model):
+        # the reference uses the dequantized weights, so only the GEMM
+        # itself is checked
+        ref_model = copy.deepcopy(model)
+        ref_model.load_state_dict(woq_model.state_dict())
+        return ref_model
+
+    def test_eager(self):
+        for weight_dtype in [torch.qint8, torch.quint4x2]:
+            for group_size in [-1, 64]:
+                for bias in [True, False]:
+                    model = MLP(bias).eval()
+                    woq_model = ipex.optimize(
+                        model,
+                        woq_weight_dtype=weight_dtype,
+                        woq_group_size=group_size)
+                    self.assertTrue(isinstance(woq_model.fc1, _IPEXWoqLinear))
+                    ref_model = self._dequantized_model(model, woq_model)
+                    # cover the row tail of the micro kernel and 3-D input
+                    for x in [torch.randn(1, 256), torch.randn(7, 256), torch.randn(2, 5, 256)]:
+                        with torch.no_grad():
+                            self.assertEqual(woq_model(x), ref_model(x), prec=1e-4)
+                            # quantization error against the original weights
+                            self.assertEqual(
+                                woq_model(x), model(x),
+                                prec=0.1 if weight_dtype == torch.qint8 else 0.5)
+
+    def test_packed_weight_size(self):
+        model = MLP().eval()
+        int8_model = ipex.optimize(model, woq_weight_dtype=torch.qint8)
+        int4_model = ipex.optimize(model, woq_weight_dtype=torch.quint4x2)
+        # out features are padded to whole blocks of 16
+        self.assertEqual(int8_model.fc1.weight.dtype, torch.int8)
+        self.assertEqual(int8_model.fc1.weight.numel(), 112 * 256)
+        self.assertEqual(int4_model.fc1.weight.numel(), 112 * 256 // 2)
+
+    def test_bf16_activation(self):
+        model = MLP().eval()
+        woq_model = ipex.optimize(model, woq_weight_dtype=torch.qint8)
+        ref_model = self._dequantized_model(model, woq_model)
+        x = torch.randn(4, 256)
+        with torch.no_grad():
+            y = woq_model(x.bfloat16())
+        self.assertEqual(y.dtype, torch.bfloat16)
+        self.assertEqual(y.float(), ref_model(x), prec=0.1)
+
+    def test_jit(self):
+        model = MLP().eval()
+        woq_model = ipex.optimize(model, woq_weight_dtype=torch.quint4x2, woq_group_size=32)
+        x = torch.randn(3, 256)
+        with torch.no_grad():
+            ref = woq_model(x)
+            traced = torch.jit.freeze(torch.jit.trace(woq_model, x))
+            traced(x)
+            traced(x)
+            graph = traced.graph_for(x)
+            self.assertEqual(traced(x), ref, prec=1e-4)
+        kinds = [n.kind() for n in graph.nodes()]
+        self.assertEqual(kinds.count("ipex_prepack::woq_linear_run"), 2)
+
+    def test_jit_rewrite_aten_linear(self):
+        default_config = core._jit_woq_linear_config()
+        core._jit_set_woq_linear_config("int8")
+        try:
+            model = MLP().eval()
+            x = torch.randn(3, 256)
+            with torch.no_grad():
+                ref = model(x)
+                traced = torch.jit.freeze(torch.jit.trace(model, x))
+                traced(x)
+                traced(x)
+                graph = traced.graph_for(x)
+                self.assertEqual(traced(x), ref, prec=0.1)
+            kinds = [n.kind() for n in graph.nodes()]
+            self.assertEqual(kinds.count("ipex_prepack::woq_linear_run"), 2)
+            self.assertFalse("aten::linear" in kinds)
+        finally:
+            core._jit_set_woq_linear_config(*default_config)
+
+
+if __name__ == '__main__':
+    test = unittest.main()